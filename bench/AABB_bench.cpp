@@ -0,0 +1,82 @@
+#include <vector>
+
+#include "AABB.h"
+#include "Fixtures.h"
+#include "Harness.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Bench
+    namespace Bench
+    {
+        // Compare AABB/from_points with AABB/expand, one point at a time.
+
+        MATH3D_BENCHMARK_SWEEP("AABB/expand", [](State& state) {
+            const std::vector<Vector3>& points = random_vectors(state.size());
+            state.set_bytes_per_iteration(points.size() * sizeof(Vector3));
+
+            while (state.keep_running())
+            {
+                AABB box;
+                for (const Vector3& p : points)
+                    box.expand(p);
+                do_not_optimize(box);
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("AABB/from_points", [](State& state) {
+            const std::vector<Vector3>& points = random_vectors(state.size());
+            state.set_bytes_per_iteration(points.size() * sizeof(Vector3));
+
+            while (state.keep_running())
+                do_not_optimize(AABB::from_points(points.data(), points.size()));
+        });
+
+        MATH3D_BENCHMARK_SWEEP("AABB/Batch/from_points", [](State& state) {
+            const Vector3Batch points(random_vectors(state.size()));
+            state.set_bytes_per_iteration(points.size() * sizeof(Vector3));
+
+            while (state.keep_running())
+                do_not_optimize(AABB::from_points(points));
+        });
+
+        static std::vector<AABB> random_boxes(std::size_t count)
+        {
+            const std::vector<Vector3>& corners = random_vectors(count);
+            std::vector<AABB> boxes(count);
+
+            for (std::size_t i = 0; i < count; ++i)
+                boxes[i] = AABB(corners[i], corners[i] + Vector3(2.0f, 2.0f, 2.0f));
+
+            return boxes;
+        }
+
+        MATH3D_BENCHMARK_SWEEP("AABB/overlaps", [](State& state) {
+            const std::vector<AABB> boxes = random_boxes(state.size());
+            const AABB box(Vector3(-3.0f, -3.0f, -3.0f), Vector3(3.0f, 3.0f, 3.0f));
+            std::vector<unsigned char> out(boxes.size());
+            state.set_bytes_per_iteration(boxes.size() * (sizeof(AABB) + 1));
+
+            while (state.keep_running())
+            {
+                for (std::size_t i = 0; i < boxes.size(); ++i)
+                    out[i] = box.overlaps(boxes[i]);
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("AABB/Bulk/overlaps", [](State& state) {
+            const std::vector<AABB> boxes = random_boxes(state.size());
+            const AABB box(Vector3(-3.0f, -3.0f, -3.0f), Vector3(3.0f, 3.0f, 3.0f));
+            std::vector<unsigned char> out(boxes.size());
+            state.set_bytes_per_iteration(boxes.size() * (sizeof(AABB) + 1));
+
+            while (state.keep_running())
+            {
+                AABB::overlaps(box, boxes.data(), boxes.size(), out.data());
+                clobber_memory();
+            }
+        });
+    }
+}
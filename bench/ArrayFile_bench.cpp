@@ -0,0 +1,88 @@
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include "ArrayFile.h"
+#include "Fixtures.h"
+#include "Harness.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Bench
+    namespace Bench
+    {
+        // Compare ArrayFile/Matrix3/write with ArrayFile/Matrix3/text, the same
+        // matrices printed through operator<<, and ArrayFile/Vector3/map, which
+        // maps a file and reads every element, with ArrayFile/Vector3/read, which
+        // copies it into a vector through a stream.
+
+        static const char* bench_path = "math3d_array_file_bench.bin";
+
+        MATH3D_BENCHMARK_SWEEP("ArrayFile/Matrix3/write", [](State& state) {
+            const std::vector<Matrix3>& matrices = random_matrices(state.size());
+            state.set_bytes_per_iteration(matrices.size() * sizeof(Matrix3));
+
+            while (state.keep_running())
+            {
+                ArrayWriter<Matrix3> writer(bench_path);
+                writer.write(matrices.data(), matrices.size());
+                writer.close();
+            }
+
+            std::remove(bench_path);
+        });
+
+        MATH3D_BENCHMARK_SWEEP("ArrayFile/Matrix3/text", [](State& state) {
+            const std::vector<Matrix3>& matrices = random_matrices(state.size());
+            state.set_bytes_per_iteration(matrices.size() * sizeof(Matrix3));
+
+            while (state.keep_running())
+            {
+                std::ofstream file(bench_path);
+                for (const Matrix3& m : matrices)
+                    file << m;
+            }
+
+            std::remove(bench_path);
+        });
+
+        MATH3D_BENCHMARK_SWEEP("ArrayFile/Vector3/map", [](State& state) {
+            const std::vector<Vector3>& points = random_vectors(state.size());
+            ArrayWriter<Vector3>(bench_path).write(points.data(), points.size());
+            state.set_bytes_per_iteration(points.size() * sizeof(Vector3));
+
+            while (state.keep_running())
+            {
+                const MappedArray<Vector3> mapped(bench_path);
+                Vector3 sum;
+                for (const Vector3& p : mapped)
+                    sum += p;
+                do_not_optimize(sum);
+            }
+
+            std::remove(bench_path);
+        });
+
+        MATH3D_BENCHMARK_SWEEP("ArrayFile/Vector3/read", [](State& state) {
+            const std::vector<Vector3>& points = random_vectors(state.size());
+            ArrayWriter<Vector3>(bench_path).write(points.data(), points.size());
+            state.set_bytes_per_iteration(points.size() * sizeof(Vector3));
+
+            while (state.keep_running())
+            {
+                std::ifstream file(bench_path, std::ios::binary);
+                file.seekg(sizeof(ArrayFileHeader));
+                std::vector<Vector3> copy(points.size());
+                file.read(reinterpret_cast<char*>(copy.data()), static_cast<std::streamsize>(copy.size() * sizeof(Vector3)));
+
+                Vector3 sum;
+                for (const Vector3& p : copy)
+                    sum += p;
+                do_not_optimize(sum);
+            }
+
+            std::remove(bench_path);
+        });
+    }
+}
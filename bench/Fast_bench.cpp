@@ -0,0 +1,68 @@
+#include <vector>
+
+#include "Fast.h"
+#include "Fixtures.h"
+#include "Harness.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Bench
+    namespace Bench
+    {
+        // Compare with Vector3/<name> and Vector3Batch/<name>, the exact paths.
+
+        MATH3D_BENCHMARK_SWEEP("Fast/angle", [](State& state) {
+            map_binary(state, random_vectors(state.size(), 1), random_vectors(state.size(), 2),
+                [](const Vector3& v, const Vector3& w) { return Fast::angle(v, w); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Fast/magnitude", [](State& state) {
+            map_unary(state, random_vectors(state.size()),
+                [](const Vector3& v) { return Fast::magnitude(v); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Fast/normalized", [](State& state) {
+            map_unary(state, random_vectors(state.size()),
+                [](const Vector3& v) { return Fast::normalized(v); });
+        });
+
+        // Bulk functions.
+
+        MATH3D_BENCHMARK_SWEEP("Fast/Batch/angle", [](State& state) {
+            const Vector3Batch v(random_vectors(state.size(), 1));
+            const Vector3Batch w(random_vectors(state.size(), 2));
+            std::vector<float> out(v.size());
+            state.set_bytes_per_iteration(v.size() * (2 * sizeof(Vector3) + sizeof(float)));
+
+            while (state.keep_running())
+            {
+                Fast::angle(v, w, out.data());
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Fast/Batch/magnitude", [](State& state) {
+            const Vector3Batch v(random_vectors(state.size()));
+            std::vector<float> out(v.size());
+            state.set_bytes_per_iteration(v.size() * (sizeof(Vector3) + sizeof(float)));
+
+            while (state.keep_running())
+            {
+                Fast::magnitude(v, out.data());
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Fast/Batch/normalize", [](State& state) {
+            Vector3Batch v(random_vectors(state.size()));
+            state.set_bytes_per_iteration(2 * v.size() * sizeof(Vector3));
+
+            while (state.keep_running())
+            {
+                Fast::normalize(v);
+                clobber_memory();
+            }
+        });
+    }
+}
@@ -0,0 +1,186 @@
+/// @file Fixtures.h
+/// @brief This header file contains the input generators and loop drivers
+/// shared by the benchmarks.
+/// @author David Moncada
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Harness.h"
+#include "Matrix3.h"
+#include "Quaternion.h"
+#include "Vector3.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Bench
+    namespace Bench
+    {
+        /// @brief Generates reproducible vectors with components in [-10,10].
+        ///
+        /// The harness calls every benchmark several times while calibrating
+        /// the iteration count, so inputs are generated once per size and seed
+        /// and then shared.
+        inline const std::vector<Vector3>& random_vectors(std::size_t count, unsigned seed = 1)
+        {
+            static std::map<std::pair<std::size_t, unsigned>, std::vector<Vector3> > cache;
+            std::vector<Vector3>& vectors = cache[std::make_pair(count, seed)];
+
+            if (vectors.size() == count)
+                return vectors;
+
+            std::mt19937 rng(seed);
+            std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+            vectors.resize(count);
+
+            for (Vector3& v : vectors)
+                v = Vector3(dist(rng), dist(rng), dist(rng));
+
+            return vectors;
+        }
+
+        /// @brief Generates reproducible, well-conditioned matrices; they are
+        /// cached like random_vectors().
+        inline const std::vector<Matrix3>& random_matrices(std::size_t count, unsigned seed = 2)
+        {
+            static std::map<std::pair<std::size_t, unsigned>, std::vector<Matrix3> > cache;
+            std::vector<Matrix3>& matrices = cache[std::make_pair(count, seed)];
+
+            if (matrices.size() == count)
+                return matrices;
+
+            std::mt19937 rng(seed);
+            std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+            matrices.resize(count);
+
+            // A dominant diagonal keeps every matrix comfortably invertible.
+            for (Matrix3& m : matrices)
+                m = Matrix3(
+                    4.0f + dist(rng), dist(rng), dist(rng),
+                    dist(rng), 4.0f + dist(rng), dist(rng),
+                    dist(rng), dist(rng), 4.0f + dist(rng));
+
+            return matrices;
+        }
+
+        /// @brief Generates reproducible unit quaternions; they are cached like
+        /// random_vectors().
+        inline const std::vector<Quaternion>& random_quaternions(std::size_t count, unsigned seed = 3)
+        {
+            static std::map<std::pair<std::size_t, unsigned>, std::vector<Quaternion> > cache;
+            std::vector<Quaternion>& quaternions = cache[std::make_pair(count, seed)];
+
+            if (quaternions.size() == count)
+                return quaternions;
+
+            std::mt19937 rng(seed);
+            std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+            quaternions.resize(count);
+
+            for (Quaternion& q : quaternions)
+                q = Quaternion(dist(rng), dist(rng), dist(rng), dist(rng)).normalized();
+
+            return quaternions;
+        }
+
+        /// @brief Generates reproducible rotation matrices, each perturbed by
+        /// about 1e-4 as if by accumulated rounding; they are cached like
+        /// random_vectors().
+        inline const std::vector<Matrix3>& random_rotation_matrices(std::size_t count, unsigned seed = 4)
+        {
+            static std::map<std::pair<std::size_t, unsigned>, std::vector<Matrix3> > cache;
+            std::vector<Matrix3>& matrices = cache[std::make_pair(count, seed)];
+
+            if (matrices.size() == count)
+                return matrices;
+
+            std::mt19937 rng(seed);
+            std::uniform_real_distribution<float> dist(-1e-4f, 1e-4f);
+            const std::vector<Quaternion>& rotations = random_quaternions(count, seed);
+            matrices.resize(count);
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                matrices[i] = rotations[i].to_matrix();
+                for (int r = 0; r < 3; ++r)
+                {
+                    for (int c = 0; c < 3; ++c)
+                        matrices[i](r, c) += dist(rng);
+                }
+            }
+
+            return matrices;
+        }
+
+        /// @brief A rotation matrix; applying it repeatedly in place keeps the
+        /// magnitudes of the data stable across iterations.
+        inline Matrix3 rotation_matrix()
+        {
+            const float c = std::cos(0.3f), s = std::sin(0.3f);
+            const Matrix3 rz(c, -s, 0.0f, s, c, 0.0f, 0.0f, 0.0f, 1.0f);
+            const Matrix3 rx(1.0f, 0.0f, 0.0f, 0.0f, c, -s, 0.0f, s, c);
+            return rz * rx;
+        }
+
+        /// @brief Measures out[i] = op(a[i]) over the whole input.
+        template <typename A, typename Op>
+        inline void map_unary(State& state, const std::vector<A>& a, Op op)
+        {
+            typedef decltype(op(a[0])) R;
+            std::vector<R> out(a.size());
+            state.set_bytes_per_iteration(a.size() * (sizeof(A) + sizeof(R)));
+            do_not_optimize(out.data());
+
+            while (state.keep_running())
+            {
+                for (std::size_t i = 0; i < a.size(); ++i)
+                    out[i] = op(a[i]);
+
+                clobber_memory();
+            }
+        }
+
+        /// @brief Measures out[i] = op(a[i], b[i]) over the whole input.
+        template <typename A, typename B, typename Op>
+        inline void map_binary(State& state, const std::vector<A>& a, const std::vector<B>& b, Op op)
+        {
+            typedef decltype(op(a[0], b[0])) R;
+            std::vector<R> out(a.size());
+            state.set_bytes_per_iteration(a.size() * (sizeof(A) + sizeof(B) + sizeof(R)));
+            do_not_optimize(out.data());
+
+            while (state.keep_running())
+            {
+                for (std::size_t i = 0; i < a.size(); ++i)
+                    out[i] = op(a[i], b[i]);
+
+                clobber_memory();
+            }
+        }
+
+        /// @brief Measures op(x[i]) applied in place over a copy of the input;
+        /// the operation should keep the data bounded when repeated.
+        template <typename A, typename Op>
+        inline void map_in_place(State& state, const std::vector<A>& a, Op op)
+        {
+            std::vector<A> x = a;
+            state.set_bytes_per_iteration(2 * a.size() * sizeof(A));
+            do_not_optimize(x.data());
+
+            while (state.keep_running())
+            {
+                for (std::size_t i = 0; i < x.size(); ++i)
+                    op(x[i]);
+
+                clobber_memory();
+            }
+        }
+    }
+}
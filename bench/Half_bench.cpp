@@ -0,0 +1,56 @@
+#include <vector>
+
+#include "Fixtures.h"
+#include "Half.h"
+#include "Harness.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Bench
+    namespace Bench
+    {
+        // Compare Vector3Half/pack with Vector3Half/constructor, one vector at
+        // a time; run with MATH3D_SIMD=scalar to compare against the portable
+        // conversion instead of F16C.
+
+        MATH3D_BENCHMARK_SWEEP("Vector3Half/constructor", [](State& state) {
+            const std::vector<Vector3>& vectors = random_vectors(state.size());
+            std::vector<Vector3Half> packed(vectors.size());
+            state.set_bytes_per_iteration(vectors.size() * (sizeof(Vector3) + sizeof(Vector3Half)));
+
+            while (state.keep_running())
+            {
+                for (std::size_t i = 0; i < vectors.size(); ++i)
+                    packed[i] = Vector3Half(vectors[i]);
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3Half/pack", [](State& state) {
+            const std::vector<Vector3>& vectors = random_vectors(state.size());
+            std::vector<Vector3Half> packed(vectors.size());
+            state.set_bytes_per_iteration(vectors.size() * (sizeof(Vector3) + sizeof(Vector3Half)));
+
+            while (state.keep_running())
+            {
+                Vector3Half::pack(vectors.data(), packed.data(), vectors.size());
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3Half/unpack", [](State& state) {
+            const std::vector<Vector3>& vectors = random_vectors(state.size());
+            std::vector<Vector3Half> packed(vectors.size());
+            std::vector<Vector3> unpacked(vectors.size());
+            Vector3Half::pack(vectors.data(), packed.data(), vectors.size());
+            state.set_bytes_per_iteration(vectors.size() * (sizeof(Vector3) + sizeof(Vector3Half)));
+
+            while (state.keep_running())
+            {
+                Vector3Half::unpack(packed.data(), unpacked.data(), packed.size());
+                clobber_memory();
+            }
+        });
+    }
+}
@@ -0,0 +1,291 @@
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "Dispatch.h"
+#include "Harness.h"
+
+#ifndef MATH3D_BENCH_BUILD_TYPE
+#define MATH3D_BENCH_BUILD_TYPE "unknown"
+#endif
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Bench
+    namespace Bench
+    {
+        /// @brief Constructor for State.
+        /// @param size The input size the benchmark should work on.
+        /// @param iterations The number of times keep_running() returns true.
+        State::State(std::size_t size, std::size_t iterations)
+            : _size{ size }, _iterations{ iterations }, _remaining{ iterations },
+              _items{ size }, _bytes{ 0 }, _elapsed{ Clock::duration::zero() } {}
+
+        /// @brief The time spent in the measured loop, in nanoseconds.
+        double State::elapsed_ns() const
+        {
+            return std::chrono::duration<double, std::nano>(_elapsed).count();
+        }
+
+        /// @brief The number of bytes moved by one iteration, or zero if unset.
+        std::size_t State::bytes_per_iteration() const
+        {
+            return _bytes;
+        }
+
+        /// @brief The number of items processed by one iteration; defaults to
+        /// the input size.
+        std::size_t State::items_per_iteration() const
+        {
+            return _items;
+        }
+
+        /// @brief The number of iterations this run measures.
+        std::size_t State::iterations() const
+        {
+            return _iterations;
+        }
+
+        /// @brief Drives the measured loop.
+        ///
+        /// The clock starts on the first call and stops on the call that
+        /// returns @c false, so any setup done beforehand is not measured.
+        ///
+        /// @return @c true while there are iterations left to run.
+        bool State::keep_running()
+        {
+            if (_remaining == _iterations)
+            {
+                _start = Clock::now();
+            }
+
+            if (_remaining == 0)
+            {
+                _elapsed = Clock::now() - _start;
+                return false;
+            }
+
+            --_remaining;
+            return true;
+        }
+
+        /// @brief Sets the number of bytes read and written by one iteration,
+        /// so that the bandwidth can be reported.
+        void State::set_bytes_per_iteration(std::size_t bytes)
+        {
+            _bytes = bytes;
+        }
+
+        /// @brief Sets the number of items processed by one iteration.
+        void State::set_items_per_iteration(std::size_t items)
+        {
+            _items = items;
+        }
+
+        /// @brief The input size the benchmark should work on.
+        std::size_t State::size() const
+        {
+            return _size;
+        }
+
+        /// @brief Constructor for Registrar.
+        Registrar::Registrar(const char* name, Function function)
+            : Registrar(name, function, std::vector<std::size_t>(1, 1)) {}
+
+        /// @brief Constructor for Registrar.
+        Registrar::Registrar(const char* name, Function function, const std::vector<std::size_t>& sizes)
+        {
+            Benchmark benchmark;
+            benchmark.name = name;
+            benchmark.function = function;
+            benchmark.sizes = sizes;
+            registry().push_back(benchmark);
+        }
+
+        /// @brief The list of every registered benchmark.
+        std::vector<Benchmark>& registry()
+        {
+            static std::vector<Benchmark> benchmarks;
+            return benchmarks;
+        }
+
+        /// @brief Parses the command line of the benchmark runner.
+        /// @return @c false if the command line is invalid, @c true otherwise.
+        bool parse_options(int argc, char** argv, Options& options)
+        {
+            for (int i = 1; i < argc; ++i)
+            {
+                const std::string arg = argv[i];
+
+                if (arg.compare(0, 9, "--filter=") == 0)
+                {
+                    options.filter = arg.substr(9);
+                }
+                else if (arg.compare(0, 7, "--json=") == 0)
+                {
+                    options.json = arg.substr(7);
+                }
+                else if (arg.compare(0, 11, "--min-time=") == 0)
+                {
+                    options.min_time = std::atof(arg.c_str() + 11);
+                }
+                else if (arg == "--list")
+                {
+                    options.list = true;
+                }
+                else
+                {
+                    std::cerr
+                        << "Usage: " << argv[0]
+                        << " [--filter=<substring>] [--json=<file>] [--min-time=<seconds>] [--list]\n";
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        // Runs a benchmark at one size, growing the iteration count until the
+        // measured loop takes at least the minimum time.
+        static Result run_one(const Benchmark& benchmark, std::size_t size, double min_time)
+        {
+            const double min_ns = min_time * 1e9;
+            std::size_t iterations = 1;
+
+            for (;;)
+            {
+                State state(size, iterations);
+                benchmark.function(state);
+
+                const double ns = state.elapsed_ns();
+
+                if (ns >= min_ns || iterations >= 1000000000)
+                {
+                    Result result;
+                    result.name = benchmark.name;
+                    result.size = size;
+                    result.iterations = iterations;
+                    result.bytes_per_iteration = state.bytes_per_iteration();
+                    result.ns_per_iteration = ns / iterations;
+                    result.ns_per_item = result.ns_per_iteration / std::max<std::size_t>(state.items_per_iteration(), 1);
+                    result.items_per_second = 1e9 / result.ns_per_item;
+                    result.bytes_per_second = state.bytes_per_iteration() * 1e9 / result.ns_per_iteration;
+                    return result;
+                }
+
+                // Aim slightly past the target, but never grow by more than 10x.
+                double factor = ns > 0.0 ? 1.4 * min_ns / ns : 10.0;
+                factor = std::min(std::max(factor, 2.0), 10.0);
+                iterations = static_cast<std::size_t>(iterations * factor);
+            }
+        }
+
+        /// @brief Runs every registered benchmark whose name contains the filter.
+        /// @return The results, in registration order.
+        std::vector<Result> run(const Options& options)
+        {
+            std::vector<Result> results;
+
+            for (const Benchmark& benchmark : registry())
+            {
+                if (benchmark.name.find(options.filter) == std::string::npos)
+                    continue;
+
+                for (std::size_t size : benchmark.sizes)
+                {
+                    if (options.list)
+                    {
+                        std::cout << benchmark.name << '/' << size << '\n';
+                        continue;
+                    }
+
+                    Result result = run_one(benchmark, size, options.min_time);
+                    write_table(std::cout, std::vector<Result>(1, result));
+                    results.push_back(result);
+                }
+            }
+
+            return results;
+        }
+
+        // Writes a string as a JSON string literal.
+        static void write_json_string(std::ostream& os, const std::string& s)
+        {
+            os << '"';
+
+            for (char c : s)
+            {
+                if (c == '"' || c == '\\')
+                    os << '\\';
+
+                os << c;
+            }
+
+            os << '"';
+        }
+
+        /// @brief Writes the results as a JSON document, suitable for diffing
+        /// runs across commits.
+        void write_json(std::ostream& os, const std::vector<Result>& results)
+        {
+            char date[32];
+            const std::time_t now = std::time(nullptr);
+            std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+            os << "{\n  \"context\": {\n";
+            os << "    \"date\": \"" << date << "\",\n";
+            os << "    \"build_type\": ";
+            write_json_string(os, MATH3D_BENCH_BUILD_TYPE);
+            os << ",\n    \"compiler\": ";
+#if defined(__VERSION__)
+            write_json_string(os, __VERSION__);
+#else
+            write_json_string(os, "unknown");
+#endif
+            os << ",\n    \"simd_level\": ";
+            write_json_string(os, simd_level_name(simd_level()));
+            os << "\n  },\n  \"benchmarks\": [";
+
+            os << std::setprecision(6);
+
+            for (std::size_t i = 0; i < results.size(); ++i)
+            {
+                const Result& r = results[i];
+                os << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+                write_json_string(os, r.name);
+                os << ", \"size\": " << r.size
+                    << ", \"iterations\": " << r.iterations
+                    << ", \"bytes_per_iteration\": " << r.bytes_per_iteration
+                    << ", \"ns_per_iteration\": " << r.ns_per_iteration
+                    << ", \"ns_per_item\": " << r.ns_per_item
+                    << ", \"items_per_second\": " << r.items_per_second
+                    << ", \"bytes_per_second\": " << r.bytes_per_second << "}";
+            }
+
+            os << "\n  ]\n}\n";
+        }
+
+        /// @brief Writes the results as a human-readable table.
+        void write_table(std::ostream& os, const std::vector<Result>& results)
+        {
+            for (const Result& r : results)
+            {
+                os << std::left << std::setw(40) << r.name
+                    << std::right << std::setw(10) << r.size
+                    << std::fixed << std::setprecision(3)
+                    << std::setw(14) << r.ns_per_item << " ns/item";
+
+                if (r.bytes_per_iteration != 0)
+                    os << std::setw(10) << std::setprecision(2) << r.bytes_per_second / 1e9 << " GB/s";
+
+                os << '\n';
+            }
+
+            os.flush();
+        }
+    }
+}
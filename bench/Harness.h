@@ -0,0 +1,158 @@
+/// @file Harness.h
+/// @brief This header file contains the microbenchmark harness.
+/// @author David Moncada
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Bench
+    namespace Bench
+    {
+        /// @brief Input sizes swept by the size-dependent benchmarks.
+        ///
+        /// With a Vector3 input and output per element, the working sets are
+        /// roughly 24 KiB, 384 KiB, 6 MiB and 96 MiB, so that the sweep lands in
+        /// L1, L2, L3 and DRAM respectively on current x86 parts.
+        const std::size_t sweep_sizes[] = { 1 << 10, 1 << 14, 1 << 18, 1 << 22 };
+
+        /// @brief Prevents the compiler from optimizing away a computed value.
+        template <typename T>
+        inline void do_not_optimize(const T& value)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            asm volatile("" : : "r,m"(value) : "memory");
+#else
+            const volatile char* sink = reinterpret_cast<const volatile char*>(&value);
+            (void)*sink;
+#endif
+        }
+
+        /// @brief Marks a function the compiler must call rather than inline,
+        /// to measure what a call across a library boundary costs.
+#if defined(_MSC_VER)
+#define MATH3D_NOINLINE __declspec(noinline)
+#else
+#define MATH3D_NOINLINE __attribute__((noinline))
+#endif
+
+        /// @brief Forces pending writes to memory to be considered observable.
+        inline void clobber_memory()
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            asm volatile("" : : : "memory");
+#endif
+        }
+
+        /// @class State
+        /// @brief The State class declaration.
+        ///
+        /// A State is handed to every benchmark function, which does its setup,
+        /// then repeats the measured work for as long as keep_running() returns
+        /// @c true. Only the time spent inside that loop is measured.
+        class State
+        {
+        private:
+            typedef std::chrono::steady_clock Clock;
+
+            std::size_t _size;
+            std::size_t _iterations;
+            std::size_t _remaining;
+            std::size_t _items;
+            std::size_t _bytes;
+            Clock::time_point _start;
+            Clock::duration _elapsed;
+
+        public:
+            // Constructors.
+            State(std::size_t, std::size_t);
+
+            // Member functions.
+            double elapsed_ns() const;
+            std::size_t bytes_per_iteration() const;
+            std::size_t items_per_iteration() const;
+            std::size_t iterations() const;
+            bool keep_running();
+            void set_bytes_per_iteration(std::size_t);
+            void set_items_per_iteration(std::size_t);
+            std::size_t size() const;
+        };
+
+        /// @brief The signature of a benchmark function.
+        typedef void (*Function)(State&);
+
+        /// @brief A registered benchmark.
+        struct Benchmark
+        {
+            std::string name;
+            Function function;
+            std::vector<std::size_t> sizes;
+        };
+
+        /// @brief The outcome of running a benchmark at one size.
+        struct Result
+        {
+            std::string name;
+            std::size_t size;
+            std::size_t iterations;
+            std::size_t bytes_per_iteration;
+            double ns_per_iteration;
+            double ns_per_item;
+            double items_per_second;
+            double bytes_per_second;
+        };
+
+        /// @brief The command line options of the benchmark runner.
+        struct Options
+        {
+            std::string filter;
+            std::string json;
+            double min_time = 0.1;
+            bool list = false;
+        };
+
+        /// @class Registrar
+        /// @brief Adds a benchmark to the global registry at static
+        /// initialization time; use the MATH3D_BENCHMARK macros instead.
+        class Registrar
+        {
+        public:
+            Registrar(const char*, Function);
+            Registrar(const char*, Function, const std::vector<std::size_t>&);
+        };
+
+        // Runner.
+        std::vector<Benchmark>& registry();
+        bool parse_options(int, char**, Options&);
+        std::vector<Result> run(const Options&);
+        void write_json(std::ostream&, const std::vector<Result>&);
+        void write_table(std::ostream&, const std::vector<Result>&);
+    }
+}
+
+#define MATH3D_BENCH_CONCAT_IMPL(a, b) a##b
+#define MATH3D_BENCH_CONCAT(a, b) MATH3D_BENCH_CONCAT_IMPL(a, b)
+
+/// @brief Registers a benchmark that runs once, with a size of one. The
+/// function is variadic so that lambdas containing commas can be passed as is.
+#define MATH3D_BENCHMARK(name, ...) \
+    static ::Math3D::Bench::Registrar MATH3D_BENCH_CONCAT(bench_registrar_, __LINE__)(name, __VA_ARGS__)
+
+/// @brief Registers a benchmark that runs once for every size in a list; the
+/// size may stand for any parameter, such as a thread count.
+#define MATH3D_BENCHMARK_SIZES(name, sizes, ...) \
+    static ::Math3D::Bench::Registrar MATH3D_BENCH_CONCAT(bench_registrar_, __LINE__)(name, __VA_ARGS__, sizes)
+
+/// @brief Registers a benchmark that runs once for every sweep size.
+#define MATH3D_BENCHMARK_SWEEP(name, ...) \
+    static ::Math3D::Bench::Registrar MATH3D_BENCH_CONCAT(bench_registrar_, __LINE__)( \
+        name, __VA_ARGS__, std::vector<std::size_t>( \
+            std::begin(::Math3D::Bench::sweep_sizes), std::end(::Math3D::Bench::sweep_sizes)))
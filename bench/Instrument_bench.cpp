@@ -0,0 +1,36 @@
+#include "Harness.h"
+#include "Instrument.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Bench
+    namespace Bench
+    {
+        // The cost of recording one call: two clock reads and two uncontended
+        // atomic additions. Instrumented operations pay it on top of their own
+        // time; compare Matrix3/inverse in builds with and without the
+        // MATH3D_INSTRUMENT option for the end-to-end overhead.
+
+        MATH3D_BENCHMARK("Instrument/record", [](State& state) {
+            while (state.keep_running())
+            {
+                const Instrument::Timer timer(Instrument::Operation::Vector3Normalize);
+                clobber_memory();
+            }
+
+            Instrument::reset();
+        });
+
+        MATH3D_BENCHMARK("Instrument/snapshot", [](State& state) {
+            // The first snapshot calibrates the clock.
+            Instrument::count(Instrument::Operation::Vector3Normalize, 1);
+            (void)Instrument::snapshot();
+
+            while (state.keep_running())
+                do_not_optimize(Instrument::snapshot());
+
+            Instrument::reset();
+        });
+    }
+}
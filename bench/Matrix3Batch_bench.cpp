@@ -0,0 +1,111 @@
+#include <vector>
+
+#include "Fixtures.h"
+#include "Harness.h"
+#include "Matrix3Batch.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Bench
+    namespace Bench
+    {
+        MATH3D_BENCHMARK_SWEEP("Matrix3Batch/determinant", [](State& state) {
+            const Matrix3Batch in(random_matrices(state.size()));
+            std::vector<float> out(in.size());
+            state.set_bytes_per_iteration(in.size() * (sizeof(Matrix3) + sizeof(float)));
+            do_not_optimize(out.data());
+
+            while (state.keep_running())
+            {
+                Matrix3Batch::determinant(in, out.data());
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3Batch/inverse", [](State& state) {
+            const Matrix3Batch in(random_matrices(state.size()));
+            Matrix3Batch out(in.size());
+            std::vector<unsigned char> singular(in.size());
+            state.set_bytes_per_iteration(in.size() * (2 * sizeof(Matrix3) + 1));
+
+            while (state.keep_running())
+            {
+                do_not_optimize(Matrix3Batch::inverse(in, out, singular.data()));
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3Batch/symmetric_eigen", [](State& state) {
+            const Matrix3Batch in(random_matrices(state.size()));
+            Vector3Batch values, vectors[3];
+            state.set_bytes_per_iteration(in.size() * (6 + 12) * sizeof(float));
+
+            while (state.keep_running())
+            {
+                Matrix3Batch::symmetric_eigen(in, values, vectors);
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3Batch/svd", [](State& state) {
+            const Matrix3Batch in(random_matrices(state.size()));
+            Matrix3Batch u, v;
+            Vector3Batch s;
+            state.set_bytes_per_iteration(in.size() * (9 + 9 + 3 + 9) * sizeof(float));
+
+            while (state.keep_running())
+            {
+                Matrix3Batch::svd(in, u, s, v);
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3Batch/polar", [](State& state) {
+            const Matrix3Batch in(random_matrices(state.size()));
+            Matrix3Batch rotation, stretch;
+            state.set_bytes_per_iteration(3 * in.size() * sizeof(Matrix3));
+
+            while (state.keep_running())
+            {
+                Matrix3Batch::polar(in, rotation, stretch);
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3Batch/orthonormalize", [](State& state) {
+            Matrix3Batch matrices(random_rotation_matrices(state.size()));
+            state.set_bytes_per_iteration(2 * matrices.size() * sizeof(Matrix3));
+
+            while (state.keep_running())
+            {
+                Matrix3Batch::orthonormalize(matrices);
+                clobber_memory();
+            }
+        });
+
+        // Conversions.
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3Batch/from_vector", [](State& state) {
+            const std::vector<Matrix3>& matrices = random_matrices(state.size());
+            state.set_bytes_per_iteration(2 * matrices.size() * sizeof(Matrix3));
+
+            while (state.keep_running())
+            {
+                Matrix3Batch batch(matrices);
+                do_not_optimize(batch.m[0][0].data());
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3Batch/to_vector", [](State& state) {
+            const Matrix3Batch batch(random_matrices(state.size()));
+            state.set_bytes_per_iteration(2 * batch.size() * sizeof(Matrix3));
+
+            while (state.keep_running())
+            {
+                std::vector<Matrix3> matrices = batch.to_vector();
+                do_not_optimize(matrices.data());
+            }
+        });
+    }
+}
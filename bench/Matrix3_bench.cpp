@@ -0,0 +1,236 @@
+#include "Fixtures.h"
+#include "Harness.h"
+#include "Matrix3.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Bench
+    namespace Bench
+    {
+        // Static helpers.
+
+        MATH3D_BENCHMARK("Matrix3/identity", [](State& state) {
+            while (state.keep_running())
+                do_not_optimize(Matrix3::identity());
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/transpose", [](State& state) {
+            map_in_place(state, random_matrices(state.size()),
+                [](Matrix3& m) { Matrix3::transpose(m); });
+        });
+
+        // Member functions.
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/determinant", [](State& state) {
+            map_unary(state, random_matrices(state.size()),
+                [](const Matrix3& m) { return m.determinant(); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/inverse", [](State& state) {
+            map_unary(state, random_matrices(state.size()),
+                [](const Matrix3& m) { return m.inverse(); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/try_inverse", [](State& state) {
+            map_unary(state, random_matrices(state.size()),
+                [](const Matrix3& m) { return m.try_inverse().value_or(m); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/symmetric_eigen", [](State& state) {
+            map_unary(state, random_matrices(state.size()),
+                [](const Matrix3& m) { return m.symmetric_eigen(); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/svd", [](State& state) {
+            map_unary(state, random_matrices(state.size()),
+                [](const Matrix3& m) { return m.svd(); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/polar", [](State& state) {
+            map_unary(state, random_matrices(state.size()),
+                [](const Matrix3& m) { return m.polar(); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/orthonormalized", [](State& state) {
+            map_unary(state, random_rotation_matrices(state.size()),
+                [](const Matrix3& m) { return m.orthonormalized(); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/transposed", [](State& state) {
+            map_unary(state, random_matrices(state.size()),
+                [](const Matrix3& m) { return m.transposed(); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/operator()", [](State& state) {
+            map_unary(state, random_matrices(state.size()),
+                [](const Matrix3& m) { return m(0, 0) + m(1, 1) + m(2, 2); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/operator[]", [](State& state) {
+            map_unary(state, random_matrices(state.size()),
+                [](const Matrix3& m) { return m[1]; });
+        });
+
+        // Operators.
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/operator+", [](State& state) {
+            map_binary(state, random_matrices(state.size(), 1), random_matrices(state.size(), 2),
+                [](const Matrix3& m, const Matrix3& n) { return m + n; });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/operator-", [](State& state) {
+            map_binary(state, random_matrices(state.size(), 1), random_matrices(state.size(), 2),
+                [](const Matrix3& m, const Matrix3& n) { return m - n; });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/operator*(Matrix3)", [](State& state) {
+            map_binary(state, random_matrices(state.size(), 1), random_matrices(state.size(), 2),
+                [](const Matrix3& m, const Matrix3& n) { return m * n; });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/operator*(Vector3)", [](State& state) {
+            const Matrix3 m = rotation_matrix();
+            map_unary(state, random_vectors(state.size()),
+                [&m](const Vector3& v) { return m * v; });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/operator+=", [](State& state) {
+            map_in_place(state, random_matrices(state.size()),
+                [](Matrix3& m) { m += Matrix3::identity(); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/operator-=", [](State& state) {
+            map_in_place(state, random_matrices(state.size()),
+                [](Matrix3& m) { m -= Matrix3::identity(); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/operator==", [](State& state) {
+            map_binary(state, random_matrices(state.size(), 1), random_matrices(state.size(), 2),
+                [](const Matrix3& m, const Matrix3& n) { return static_cast<char>(m == n); });
+        });
+
+        // Bulk eigendecompositions.
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/symmetric_eigen(Matrix3*)", [](State& state) {
+            const std::vector<Matrix3>& in = random_matrices(state.size());
+            std::vector<SymmetricEigen> out(in.size());
+            state.set_bytes_per_iteration(in.size() * (sizeof(Matrix3) + sizeof(SymmetricEigen)));
+
+            while (state.keep_running())
+            {
+                Matrix3::symmetric_eigen(in.data(), out.data(), in.size());
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/svd(Matrix3*)", [](State& state) {
+            const std::vector<Matrix3>& in = random_matrices(state.size());
+            std::vector<Svd> out(in.size());
+            state.set_bytes_per_iteration(in.size() * (sizeof(Matrix3) + sizeof(Svd)));
+
+            while (state.keep_running())
+            {
+                Matrix3::svd(in.data(), out.data(), in.size());
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/polar(Matrix3*)", [](State& state) {
+            const std::vector<Matrix3>& in = random_matrices(state.size());
+            std::vector<PolarDecomposition> out(in.size());
+            state.set_bytes_per_iteration(in.size() * (sizeof(Matrix3) + sizeof(PolarDecomposition)));
+
+            while (state.keep_running())
+            {
+                Matrix3::polar(in.data(), out.data(), in.size());
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/orthonormalize(Matrix3*)", [](State& state) {
+            std::vector<Matrix3> matrices = random_rotation_matrices(state.size());
+            state.set_bytes_per_iteration(2 * matrices.size() * sizeof(Matrix3));
+
+            while (state.keep_running())
+            {
+                Matrix3::orthonormalize(matrices.data(), matrices.size());
+                clobber_memory();
+            }
+        });
+
+        // Bulk transforms.
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/transform(Vector3*)", [](State& state) {
+            const Matrix3 m = rotation_matrix();
+            const std::vector<Vector3>& in = random_vectors(state.size());
+            std::vector<Vector3> out(in.size());
+            state.set_bytes_per_iteration(2 * in.size() * sizeof(Vector3));
+
+            while (state.keep_running())
+            {
+                m.transform(in.data(), out.data(), in.size());
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/transform(Vector3*,in-place)", [](State& state) {
+            const Matrix3 m = rotation_matrix();
+            std::vector<Vector3> vectors = random_vectors(state.size());
+            state.set_bytes_per_iteration(2 * vectors.size() * sizeof(Vector3));
+
+            while (state.keep_running())
+            {
+                m.transform(vectors.data(), vectors.size());
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/transform(Vector3Batch)", [](State& state) {
+            const Matrix3 m = rotation_matrix();
+            const Vector3Batch in(random_vectors(state.size()));
+            Vector3Batch out(in.size());
+            state.set_bytes_per_iteration(2 * in.size() * sizeof(Vector3));
+
+            while (state.keep_running())
+            {
+                m.transform(in, out);
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/transform(Vector3Batch,in-place)", [](State& state) {
+            const Matrix3 m = rotation_matrix();
+            Vector3Batch vectors(random_vectors(state.size()));
+            state.set_bytes_per_iteration(2 * vectors.size() * sizeof(Vector3));
+
+            while (state.keep_running())
+            {
+                m.transform(vectors);
+                clobber_memory();
+            }
+        });
+
+        // Out-of-line calls; see the matching section in Vector3_bench.cpp.
+
+        static MATH3D_NOINLINE float determinant(const Matrix3& m)
+        {
+            return m.determinant();
+        }
+
+        static MATH3D_NOINLINE Vector3 multiply(const Matrix3& m, const Vector3& v)
+        {
+            return m * v;
+        }
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/determinant(call)", [](State& state) {
+            map_unary(state, random_matrices(state.size()), determinant);
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Matrix3/operator*(Vector3)(call)", [](State& state) {
+            const Matrix3 m = rotation_matrix();
+            map_unary(state, random_vectors(state.size()),
+                [&m](const Vector3& v) { return multiply(m, v); });
+        });
+    }
+}
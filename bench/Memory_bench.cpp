@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <vector>
+
+#include "Fixtures.h"
+#include "Harness.h"
+#include "Matrix3.h"
+#include "Memory.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Bench
+    namespace Bench
+    {
+        // A frame that copies its points into scratch storage and transforms
+        // them there; compare the scratch coming from std::vector, allocated
+        // every frame, with the scratch coming from an Arena, reset every
+        // frame.
+
+        MATH3D_BENCHMARK_SWEEP("Memory/frame(std::vector)", [](State& state) {
+            const std::vector<Vector3>& points = random_vectors(state.size());
+            const Matrix3& m = random_matrices(1)[0];
+            state.set_bytes_per_iteration(points.size() * 2 * sizeof(Vector3));
+
+            while (state.keep_running())
+            {
+                std::vector<Vector3> scratch(points.begin(), points.end());
+                std::vector<Vector3> out(points.size());
+                m.transform(scratch.data(), out.data(), scratch.size());
+                do_not_optimize(out.data());
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Memory/frame(Arena)", [](State& state) {
+            const std::vector<Vector3>& points = random_vectors(state.size());
+            const Matrix3& m = random_matrices(1)[0];
+            Arena arena;
+            state.set_bytes_per_iteration(points.size() * 2 * sizeof(Vector3));
+
+            while (state.keep_running())
+            {
+                Vector3* scratch = arena.allocate<Vector3>(points.size());
+                Vector3* out = arena.allocate<Vector3>(points.size());
+                std::copy(points.begin(), points.end(), scratch);
+                m.transform(scratch, out, points.size());
+                do_not_optimize(out);
+                clobber_memory();
+                arena.reset();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Memory/frame(Arena,huge pages)", [](State& state) {
+            const std::vector<Vector3>& points = random_vectors(state.size());
+            const Matrix3& m = random_matrices(1)[0];
+            Arena arena(2 * points.size() * sizeof(Vector3) + 2 * simd_alignment, PageSize::Huge);
+            state.set_bytes_per_iteration(points.size() * 2 * sizeof(Vector3));
+
+            while (state.keep_running())
+            {
+                Vector3* scratch = arena.allocate<Vector3>(points.size());
+                Vector3* out = arena.allocate<Vector3>(points.size());
+                std::copy(points.begin(), points.end(), scratch);
+                m.transform(scratch, out, points.size());
+                do_not_optimize(out);
+                clobber_memory();
+                arena.reset();
+            }
+        });
+    }
+}
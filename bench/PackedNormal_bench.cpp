@@ -0,0 +1,102 @@
+#include <vector>
+
+#include "Fixtures.h"
+#include "Harness.h"
+#include "PackedNormal.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Bench
+    namespace Bench
+    {
+        // Compare PackedNormal16/encode with PackedNormal16/constructor, one
+        // vector at a time, and PackedNormal16/dot and PackedNormal32/dot with
+        // Vector3/dot normals, the same shading loop over full vectors.
+
+        MATH3D_BENCHMARK_SWEEP("PackedNormal16/constructor", [](State& state) {
+            const std::vector<Vector3>& vectors = random_vectors(state.size());
+            std::vector<PackedNormal16> encoded(vectors.size());
+            state.set_bytes_per_iteration(vectors.size() * (sizeof(Vector3) + sizeof(PackedNormal16)));
+
+            while (state.keep_running())
+            {
+                for (std::size_t i = 0; i < vectors.size(); ++i)
+                    encoded[i] = PackedNormal16(vectors[i]);
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("PackedNormal16/encode", [](State& state) {
+            const std::vector<Vector3>& vectors = random_vectors(state.size());
+            std::vector<PackedNormal16> encoded(vectors.size());
+            state.set_bytes_per_iteration(vectors.size() * (sizeof(Vector3) + sizeof(PackedNormal16)));
+
+            while (state.keep_running())
+            {
+                PackedNormal16::encode(vectors.data(), encoded.data(), vectors.size());
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("PackedNormal16/decode", [](State& state) {
+            const std::vector<Vector3>& vectors = random_vectors(state.size());
+            std::vector<PackedNormal16> encoded(vectors.size());
+            std::vector<Vector3> decoded(vectors.size());
+            PackedNormal16::encode(vectors.data(), encoded.data(), vectors.size());
+            state.set_bytes_per_iteration(vectors.size() * (sizeof(Vector3) + sizeof(PackedNormal16)));
+
+            while (state.keep_running())
+            {
+                PackedNormal16::decode(encoded.data(), decoded.data(), encoded.size());
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("PackedNormal16/dot", [](State& state) {
+            const std::vector<Vector3>& vectors = random_vectors(state.size());
+            std::vector<PackedNormal16> encoded(vectors.size());
+            std::vector<float> dots(vectors.size());
+            PackedNormal16::encode(vectors.data(), encoded.data(), vectors.size());
+            const Vector3 light = Vector3(1.0f, 2.0f, -2.0f).normalized();
+            state.set_bytes_per_iteration(vectors.size() * (sizeof(PackedNormal16) + sizeof(float)));
+
+            while (state.keep_running())
+            {
+                PackedNormal16::dot(encoded.data(), light, dots.data(), encoded.size());
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("PackedNormal32/dot", [](State& state) {
+            const std::vector<Vector3>& vectors = random_vectors(state.size());
+            std::vector<PackedNormal32> encoded(vectors.size());
+            std::vector<float> dots(vectors.size());
+            PackedNormal32::encode(vectors.data(), encoded.data(), vectors.size());
+            const Vector3 light = Vector3(1.0f, 2.0f, -2.0f).normalized();
+            state.set_bytes_per_iteration(vectors.size() * (sizeof(PackedNormal32) + sizeof(float)));
+
+            while (state.keep_running())
+            {
+                PackedNormal32::dot(encoded.data(), light, dots.data(), encoded.size());
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/dot normals", [](State& state) {
+            std::vector<Vector3> normals = random_vectors(state.size());
+            std::vector<float> dots(normals.size());
+            for (Vector3& n : normals)
+                Vector3::normalize(n);
+            const Vector3 light = Vector3(1.0f, 2.0f, -2.0f).normalized();
+            state.set_bytes_per_iteration(normals.size() * (sizeof(Vector3) + sizeof(float)));
+
+            while (state.keep_running())
+            {
+                for (std::size_t i = 0; i < normals.size(); ++i)
+                    dots[i] = Vector3::dot(normals[i], light);
+                clobber_memory();
+            }
+        });
+    }
+}
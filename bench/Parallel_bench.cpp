@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "Fixtures.h"
+#include "Harness.h"
+#include "Parallel.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Bench
+    namespace Bench
+    {
+        // The number of elements every scaling benchmark works on; large
+        // enough for the working set to live in DRAM.
+        static const std::size_t scaling_size = 1 << 22;
+
+        // Thread counts from one up to the number of hardware threads,
+        // doubling at every step.
+        static std::vector<std::size_t> thread_sweep()
+        {
+            const std::size_t hardware = std::max(std::thread::hardware_concurrency(), 1u);
+            std::vector<std::size_t> counts;
+
+            for (std::size_t n = 1; n < hardware; n *= 2)
+                counts.push_back(n);
+
+            counts.push_back(hardware);
+            return counts;
+        }
+
+        // Runs a benchmark with the pool resized to state.size() threads.
+        template <typename Op>
+        static void with_threads(State& state, std::size_t bytes_per_element, Op op)
+        {
+            Parallel::set_thread_count(static_cast<unsigned>(state.size()));
+            state.set_items_per_iteration(scaling_size);
+            state.set_bytes_per_iteration(scaling_size * bytes_per_element);
+
+            while (state.keep_running())
+            {
+                op();
+                clobber_memory();
+            }
+
+            Parallel::set_thread_count(0);
+        }
+
+        MATH3D_BENCHMARK_SIZES("Parallel/transform/threads", thread_sweep(), [](State& state) {
+            const Matrix3 m = rotation_matrix();
+            const Vector3Batch in(random_vectors(scaling_size));
+            Vector3Batch out(in.size());
+
+            with_threads(state, 2 * sizeof(Vector3), [&] { Parallel::transform(m, in, out); });
+        });
+
+        MATH3D_BENCHMARK_SIZES("Parallel/transform_points/threads", thread_sweep(), [](State& state) {
+            const Transform t(rotation_matrix(), Vector3::one);
+            Vector3Batch points(random_vectors(scaling_size));
+
+            with_threads(state, 2 * sizeof(Vector3), [&] { Parallel::transform_points(t, points); });
+        });
+
+        MATH3D_BENCHMARK_SIZES("Parallel/normalize/threads", thread_sweep(), [](State& state) {
+            Vector3Batch vectors(random_vectors(scaling_size));
+
+            with_threads(state, 2 * sizeof(Vector3), [&] { Parallel::normalize(vectors); });
+        });
+
+        MATH3D_BENCHMARK_SIZES("Parallel/sum/threads", thread_sweep(), [](State& state) {
+            const Vector3Batch vectors(random_vectors(scaling_size));
+
+            with_threads(state, sizeof(Vector3), [&] { do_not_optimize(Parallel::sum(vectors)); });
+        });
+
+        MATH3D_BENCHMARK_SIZES("Parallel/covariance/threads", thread_sweep(), [](State& state) {
+            const Vector3Batch points(random_vectors(scaling_size));
+
+            with_threads(state, sizeof(Vector3), [&] { do_not_optimize(Parallel::covariance(points)); });
+        });
+
+        MATH3D_BENCHMARK_SIZES("Parallel/covariance(Vector3*)/threads", thread_sweep(), [](State& state) {
+            const std::vector<Vector3>& points = random_vectors(scaling_size);
+
+            with_threads(state, sizeof(Vector3), [&] { do_not_optimize(Parallel::covariance(points.data(), points.size())); });
+        });
+
+        MATH3D_BENCHMARK_SIZES("Parallel/covariance(deterministic)/threads", thread_sweep(), [](State& state) {
+            const Vector3Batch points(random_vectors(scaling_size));
+
+            Parallel::set_deterministic(true);
+            with_threads(state, sizeof(Vector3), [&] { do_not_optimize(Parallel::covariance(points)); });
+            Parallel::set_deterministic(false);
+        });
+
+        MATH3D_BENCHMARK_SIZES("Parallel/bounds/threads", thread_sweep(), [](State& state) {
+            const Vector3Batch points(random_vectors(scaling_size));
+
+            with_threads(state, sizeof(Vector3), [&] { do_not_optimize(Parallel::bounds(points)); });
+        });
+
+        // The loop the reductions replace: a centroid by operator+=, then the
+        // covariance by summing outer products.
+        MATH3D_BENCHMARK("Parallel/covariance(serial loop)", [](State& state) {
+            const std::vector<Vector3>& points = random_vectors(scaling_size);
+            state.set_items_per_iteration(scaling_size);
+            state.set_bytes_per_iteration(scaling_size * sizeof(Vector3));
+
+            while (state.keep_running())
+            {
+                Vector3 centroid = Vector3::zero;
+                for (const Vector3& p : points)
+                    centroid += p;
+                centroid /= static_cast<float>(points.size());
+
+                Matrix3 covariance(Vector3::zero, Vector3::zero, Vector3::zero);
+                for (const Vector3& p : points)
+                {
+                    const Vector3 d = p - centroid;
+                    covariance += Matrix3(d.x * d, d.y * d, d.z * d);
+                }
+
+                do_not_optimize(covariance);
+            }
+        });
+    }
+}
@@ -0,0 +1,88 @@
+#include <vector>
+
+#include "Fixtures.h"
+#include "Harness.h"
+#include "Pipeline.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Bench
+    namespace Bench
+    {
+        // Shading normals: transform by the normal matrix, normalize, dot with
+        // the light direction and clamp. The separate passes reuse
+        // preallocated temporaries, so both variants only differ in their
+        // memory traffic; the bytes counted are the input and the output.
+
+        MATH3D_BENCHMARK_SWEEP("Pipeline/shade(passes)", [](State& state) {
+            const Vector3Batch normals(random_vectors(state.size()));
+            const Matrix3& m = random_matrices(1)[0];
+            const Vector3 light = Vector3(-0.5f, 0.25f, 1.0f).normalized();
+            const Vector3Batch lights(std::vector<Vector3>(normals.size(), light));
+            Vector3Batch transformed(normals.size());
+            std::vector<float> out(normals.size());
+            state.set_bytes_per_iteration(normals.size() * (sizeof(Vector3) + sizeof(float)));
+
+            while (state.keep_running())
+            {
+                m.transform(normals, transformed);
+                Vector3Batch::normalize(transformed);
+                Vector3Batch::dot(transformed, lights, out.data());
+
+                for (float& f : out)
+                    f = f < 0.0f ? 0.0f : f > 1.0f ? 1.0f : f;
+
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Pipeline/shade(fused)", [](State& state) {
+            const Vector3Batch normals(random_vectors(state.size()));
+            const Matrix3& m = random_matrices(1)[0];
+            const Vector3 light = Vector3(-0.5f, 0.25f, 1.0f).normalized();
+            const Pipeline shade = Pipeline().transform(m).normalize().dot(light).clamp(0.0f, 1.0f);
+            std::vector<float> out(normals.size());
+            state.set_bytes_per_iteration(normals.size() * (sizeof(Vector3) + sizeof(float)));
+
+            while (state.keep_running())
+            {
+                shade.run(normals, out.data());
+                clobber_memory();
+            }
+        });
+
+        // Points through a model transform, then a rotation, written back as
+        // vectors.
+
+        MATH3D_BENCHMARK_SWEEP("Pipeline/transform2(passes)", [](State& state) {
+            const Vector3Batch points(random_vectors(state.size()));
+            const Transform t(random_matrices(1)[0], Vector3(1.0f, 2.0f, 3.0f));
+            const Matrix3& m = random_matrices(2)[1];
+            Vector3Batch out(points.size());
+            state.set_bytes_per_iteration(points.size() * 2 * sizeof(Vector3));
+
+            while (state.keep_running())
+            {
+                t.transform_points(points, out);
+                m.transform(out);
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Pipeline/transform2(fused)", [](State& state) {
+            const Vector3Batch points(random_vectors(state.size()));
+            const Transform t(random_matrices(1)[0], Vector3(1.0f, 2.0f, 3.0f));
+            const Matrix3& m = random_matrices(2)[1];
+            const Pipeline p = Pipeline().transform_points(t).transform(m);
+            Vector3Batch out(points.size());
+            state.set_bytes_per_iteration(points.size() * 2 * sizeof(Vector3));
+
+            while (state.keep_running())
+            {
+                p.run(points, out);
+                clobber_memory();
+            }
+        });
+    }
+}
@@ -0,0 +1,68 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Fixtures.h"
+#include "Harness.h"
+#include "PointText.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Bench
+    namespace Bench
+    {
+        // Compare PointText/format with PointText/to_string, which prints the
+        // same points through operator<<, and PointText/parse with
+        // PointText/istream, which reads them back with operator>>.
+
+        MATH3D_BENCHMARK_SWEEP("PointText/to_string", [](State& state) {
+            const std::vector<Vector3>& points = random_vectors(state.size());
+
+            while (state.keep_running())
+            {
+                std::ostringstream os;
+                for (const Vector3& p : points)
+                    os << p << '\n';
+                do_not_optimize(os.str());
+                state.set_bytes_per_iteration(os.str().size());
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("PointText/format", [](State& state) {
+            const std::vector<Vector3>& points = random_vectors(state.size());
+
+            while (state.keep_running())
+            {
+                const std::string text = format_points(points.data(), points.size(), PointFormat::XYZ);
+                do_not_optimize(text);
+                state.set_bytes_per_iteration(text.size());
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("PointText/istream", [](State& state) {
+            const std::vector<Vector3>& points = random_vectors(state.size());
+            const std::string text = format_points(points.data(), points.size(), PointFormat::XYZ);
+            state.set_bytes_per_iteration(text.size());
+
+            while (state.keep_running())
+            {
+                std::istringstream is(text);
+                std::vector<Vector3> read;
+                Vector3 p;
+                while (is >> p.x >> p.y >> p.z)
+                    read.push_back(p);
+                do_not_optimize(read.data());
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("PointText/parse", [](State& state) {
+            const std::vector<Vector3>& points = random_vectors(state.size());
+            const std::string text = format_points(points.data(), points.size(), PointFormat::XYZ);
+            state.set_bytes_per_iteration(text.size());
+
+            while (state.keep_running())
+                do_not_optimize(parse_points(text, PointFormat::XYZ).data());
+        });
+    }
+}
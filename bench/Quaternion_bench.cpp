@@ -0,0 +1,98 @@
+#include <vector>
+
+#include "Fixtures.h"
+#include "Harness.h"
+#include "Quaternion.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Bench
+    namespace Bench
+    {
+        // Composition, against the equivalent Matrix3 product.
+
+        MATH3D_BENCHMARK_SWEEP("Quaternion/operator*(Quaternion)", [](State& state) {
+            map_binary(state, random_quaternions(state.size(), 1), random_quaternions(state.size(), 2),
+                [](const Quaternion& p, const Quaternion& q) { return p * q; });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Quaternion/to_matrix", [](State& state) {
+            map_unary(state, random_quaternions(state.size()),
+                [](const Quaternion& q) { return q.to_matrix(); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Quaternion/from_matrix", [](State& state) {
+            std::vector<Matrix3> matrices;
+            for (const Quaternion& q : random_quaternions(state.size()))
+                matrices.push_back(q.to_matrix());
+
+            map_unary(state, matrices,
+                [](const Matrix3& m) { return Quaternion::from_matrix(m); });
+        });
+
+        // Rotation, against Matrix3 * Vector3.
+
+        MATH3D_BENCHMARK_SWEEP("Quaternion/operator*(Vector3)", [](State& state) {
+            const Quaternion q = Quaternion::from_matrix(rotation_matrix());
+            map_unary(state, random_vectors(state.size()),
+                [&q](const Vector3& v) { return q * v; });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Quaternion/rotate(Vector3*)", [](State& state) {
+            const Quaternion q = Quaternion::from_matrix(rotation_matrix());
+            const std::vector<Vector3>& in = random_vectors(state.size());
+            std::vector<Vector3> out(in.size());
+            state.set_bytes_per_iteration(2 * in.size() * sizeof(Vector3));
+
+            while (state.keep_running())
+            {
+                q.rotate(in.data(), out.data(), in.size());
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Quaternion/rotate(Quaternion*,Vector3*)/scalar", [](State& state) {
+            map_binary(state, random_quaternions(state.size()), random_vectors(state.size()),
+                [](const Quaternion& q, const Vector3& v) { return q.rotate(v); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Quaternion/rotate(Quaternion*,Vector3*)/bulk", [](State& state) {
+            const std::vector<Quaternion>& q = random_quaternions(state.size());
+            const std::vector<Vector3>& in = random_vectors(state.size());
+            std::vector<Vector3> out(in.size());
+            state.set_bytes_per_iteration(in.size() * (sizeof(Quaternion) + 2 * sizeof(Vector3)));
+
+            while (state.keep_running())
+            {
+                Quaternion::rotate(q.data(), in.data(), out.data(), in.size());
+                clobber_memory();
+            }
+        });
+
+        // Interpolation.
+
+        MATH3D_BENCHMARK_SWEEP("Quaternion/nlerp", [](State& state) {
+            map_binary(state, random_quaternions(state.size(), 1), random_quaternions(state.size(), 2),
+                [](const Quaternion& p, const Quaternion& q) { return Quaternion::nlerp(p, q, 0.3f); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Quaternion/slerp/scalar", [](State& state) {
+            map_binary(state, random_quaternions(state.size(), 1), random_quaternions(state.size(), 2),
+                [](const Quaternion& p, const Quaternion& q) { return Quaternion::slerp(p, q, 0.3f); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Quaternion/slerp/bulk", [](State& state) {
+            const std::vector<Quaternion>& a = random_quaternions(state.size(), 1);
+            const std::vector<Quaternion>& b = random_quaternions(state.size(), 2);
+            std::vector<Quaternion> out(a.size());
+            state.set_bytes_per_iteration(3 * a.size() * sizeof(Quaternion));
+
+            while (state.keep_running())
+            {
+                Quaternion::slerp(a.data(), b.data(), 0.3f, out.data(), a.size());
+                clobber_memory();
+            }
+        });
+    }
+}
@@ -0,0 +1,97 @@
+#include <vector>
+
+#include "Fixtures.h"
+#include "Harness.h"
+#include "Ray.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Bench
+    namespace Bench
+    {
+        // Rays from random origins, aimed at random points near the volumes,
+        // so that hits and misses are mixed and the branches of the scalar
+        // tests are unpredictable.
+        static std::vector<Ray> random_rays(std::size_t count)
+        {
+            const std::vector<Vector3>& origins = random_vectors(count, 1);
+            const std::vector<Vector3>& targets = random_vectors(count, 2);
+            std::vector<Ray> rays(count);
+
+            for (std::size_t i = 0; i < count; ++i)
+                rays[i] = Ray(origins[i], targets[i] * 0.3f - origins[i]);
+
+            return rays;
+        }
+
+        static const AABB box(Vector3(-2.0f, -1.0f, -3.0f), Vector3(2.0f, 3.0f, 1.0f));
+        static const Sphere sphere(Vector3(0.5f, -0.5f, 1.0f), 2.5f);
+
+        template <typename Volume>
+        static void scalar_rays(State& state, const Volume& volume)
+        {
+            const std::vector<Ray> rays = random_rays(state.size());
+            state.set_items_per_iteration(rays.size());
+
+            while (state.keep_running())
+            {
+                unsigned hits = 0;
+                for (const Ray& ray : rays)
+                {
+                    float t;
+                    hits += ray.intersect(volume, t);
+                }
+                do_not_optimize(hits);
+            }
+        }
+
+        // Packets are built once, as a renderer would build them when
+        // generating its rays, and then tested against the volume.
+        template <std::size_t N, typename Volume>
+        static void packet_rays(State& state, const Volume& volume)
+        {
+            const std::vector<Ray> rays = random_rays(state.size() - state.size() % N);
+            std::vector<RayPacket<N> > packets;
+            for (std::size_t i = 0; i < rays.size(); i += N)
+                packets.push_back(RayPacket<N>(&rays[i]));
+
+            state.set_items_per_iteration(rays.size());
+
+            while (state.keep_running())
+            {
+                unsigned hits = 0;
+                for (const RayPacket<N>& packet : packets)
+                {
+                    float t[N];
+                    hits += static_cast<unsigned>(__builtin_popcount(packet.intersect(volume, t)));
+                }
+                do_not_optimize(hits);
+            }
+        }
+
+        MATH3D_BENCHMARK_SWEEP("Ray/intersect(AABB)", [](State& state) {
+            scalar_rays(state, box);
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Ray/intersect(Sphere)", [](State& state) {
+            scalar_rays(state, sphere);
+        });
+
+        MATH3D_BENCHMARK_SWEEP("RayPacket4/intersect(AABB)", [](State& state) {
+            packet_rays<4>(state, box);
+        });
+
+        MATH3D_BENCHMARK_SWEEP("RayPacket4/intersect(Sphere)", [](State& state) {
+            packet_rays<4>(state, sphere);
+        });
+
+        MATH3D_BENCHMARK_SWEEP("RayPacket8/intersect(AABB)", [](State& state) {
+            packet_rays<8>(state, box);
+        });
+
+        MATH3D_BENCHMARK_SWEEP("RayPacket8/intersect(Sphere)", [](State& state) {
+            packet_rays<8>(state, sphere);
+        });
+    }
+}
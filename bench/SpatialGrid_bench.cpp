@@ -0,0 +1,130 @@
+#include <vector>
+
+#include "Fixtures.h"
+#include "Harness.h"
+#include "SpatialGrid.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Bench
+    namespace Bench
+    {
+        // The size is the number of indexed points; the query benchmarks
+        // report their time per query.
+        static const std::size_t query_count = 1024;
+
+        MATH3D_BENCHMARK_SWEEP("SpatialGrid/build", [](State& state) {
+            const std::vector<Vector3>& points = random_vectors(state.size());
+            state.set_bytes_per_iteration(points.size() * sizeof(Vector3));
+
+            while (state.keep_running())
+            {
+                SpatialGrid grid(points.data(), points.size());
+                do_not_optimize(grid.size());
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("SpatialGrid/update", [](State& state) {
+            const std::vector<Vector3>& points = random_vectors(state.size());
+            const std::vector<Vector3>& moves = random_vectors(state.size(), 2);
+            SpatialGrid grid(points.data(), points.size());
+            std::vector<Vector3> positions = points;
+
+            while (state.keep_running())
+            {
+                // Small steps, back and forth, so the points stay in place.
+                for (std::size_t i = 0; i < positions.size(); ++i)
+                {
+                    positions[i] += moves[i] * 0.01f;
+                    grid.update(i, positions[i]);
+                }
+
+                for (std::size_t i = 0; i < positions.size(); ++i)
+                {
+                    positions[i] -= moves[i] * 0.01f;
+                    grid.update(i, positions[i]);
+                }
+            }
+
+            state.set_items_per_iteration(2 * positions.size());
+        });
+
+        MATH3D_BENCHMARK_SWEEP("SpatialGrid/nearest(8)/brute_force", [](State& state) {
+            const std::vector<Vector3>& points = random_vectors(state.size());
+            const std::vector<Vector3>& queries = random_vectors(16, 3);
+            state.set_items_per_iteration(queries.size());
+
+            while (state.keep_running())
+            {
+                for (const Vector3& q : queries)
+                {
+                    // A single nearest neighbor already needs a full pass.
+                    std::size_t best = 0;
+                    float best_distance = (points[0] - q).sqr_magnitude();
+
+                    for (std::size_t i = 1; i < points.size(); ++i)
+                    {
+                        const float d = (points[i] - q).sqr_magnitude();
+                        if (d < best_distance)
+                        {
+                            best_distance = d;
+                            best = i;
+                        }
+                    }
+
+                    do_not_optimize(best);
+                }
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("SpatialGrid/nearest(8)", [](State& state) {
+            const std::vector<Vector3>& points = random_vectors(state.size());
+            const std::vector<Vector3>& queries = random_vectors(query_count, 3);
+            const SpatialGrid grid(points.data(), points.size());
+            std::vector<std::size_t> ids;
+            state.set_items_per_iteration(queries.size());
+
+            while (state.keep_running())
+            {
+                for (const Vector3& q : queries)
+                {
+                    grid.nearest(q, 8, ids);
+                    do_not_optimize(ids.data());
+                }
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("SpatialGrid/nearest(8)/bulk", [](State& state) {
+            const std::vector<Vector3>& points = random_vectors(state.size());
+            const std::vector<Vector3>& queries = random_vectors(query_count, 3);
+            const SpatialGrid grid(points.data(), points.size());
+            std::vector<std::size_t> ids(8 * queries.size());
+            state.set_items_per_iteration(queries.size());
+
+            while (state.keep_running())
+            {
+                grid.nearest(queries.data(), queries.size(), 8, ids.data());
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("SpatialGrid/radius", [](State& state) {
+            const std::vector<Vector3>& points = random_vectors(state.size());
+            const std::vector<Vector3>& queries = random_vectors(query_count, 3);
+            const SpatialGrid grid(points.data(), points.size());
+            const float r = grid.cell_size();
+            std::vector<std::size_t> ids;
+            state.set_items_per_iteration(queries.size());
+
+            while (state.keep_running())
+            {
+                for (const Vector3& q : queries)
+                {
+                    grid.radius(q, r, ids);
+                    do_not_optimize(ids.data());
+                }
+            }
+        });
+    }
+}
@@ -0,0 +1,90 @@
+#include <cstdlib>
+#include <vector>
+
+#include "Fixtures.h"
+#include "Harness.h"
+#include "TransformHierarchy.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Bench
+    namespace Bench
+    {
+        // The size of the scene.
+        static const std::size_t scene_nodes = 200000;
+
+        // The numbers of nodes moved per frame: 0.5%, 5% and all of them.
+        static const std::vector<std::size_t> moved_nodes = { scene_nodes / 200, scene_nodes / 20, scene_nodes };
+
+        // A scene of random depth: every node hangs off a random earlier node,
+        // with a root every 1000 nodes or so.
+        static std::vector<std::size_t> scene_parents()
+        {
+            std::vector<std::size_t> parents(scene_nodes, TransformHierarchy::none);
+            std::srand(9);
+
+            for (std::size_t i = 1; i < scene_nodes; ++i)
+            {
+                if (std::rand() % 1000 != 0)
+                    parents[i] = static_cast<std::size_t>(std::rand()) % i;
+            }
+
+            return parents;
+        }
+
+        // Recomputes every world transform each frame, parents first.
+        MATH3D_BENCHMARK_SIZES("TransformHierarchy/full_recompute", moved_nodes, [](State& state) {
+            const std::vector<std::size_t> parents = scene_parents();
+            const std::vector<Matrix3>& matrices = random_rotation_matrices(scene_nodes);
+            std::vector<Transform> local(scene_nodes), world(scene_nodes);
+
+            for (std::size_t i = 0; i < scene_nodes; ++i)
+                local[i] = Transform(matrices[i], Vector3(1.0f, 0.0f, 0.0f));
+
+            std::size_t next = 0;
+            state.set_items_per_iteration(scene_nodes);
+
+            while (state.keep_running())
+            {
+                for (std::size_t m = 0; m < state.size(); ++m, next = (next + 7919) % scene_nodes)
+                    local[next].translation.y += 0.001f;
+
+                for (std::size_t i = 0; i < scene_nodes; ++i)
+                    world[i] = parents[i] == TransformHierarchy::none ? local[i] : world[parents[i]] * local[i];
+
+                do_not_optimize(world.data());
+                clobber_memory();
+            }
+        });
+
+        // Recomputes only the moved nodes and their descendants.
+        MATH3D_BENCHMARK_SIZES("TransformHierarchy/update", moved_nodes, [](State& state) {
+            const std::vector<std::size_t> parents = scene_parents();
+            const std::vector<Matrix3>& matrices = random_rotation_matrices(scene_nodes);
+            TransformHierarchy h;
+            h.reserve(scene_nodes);
+
+            for (std::size_t i = 0; i < scene_nodes; ++i)
+                h.add(Transform(matrices[i], Vector3(1.0f, 0.0f, 0.0f)), parents[i]);
+
+            h.update();
+
+            std::size_t next = 0;
+            state.set_items_per_iteration(scene_nodes);
+
+            while (state.keep_running())
+            {
+                for (std::size_t m = 0; m < state.size(); ++m, next = (next + 7919) % scene_nodes)
+                {
+                    Transform t = h.local(next);
+                    t.translation.y += 0.001f;
+                    h.set_local(next, t);
+                }
+
+                do_not_optimize(h.update());
+                clobber_memory();
+            }
+        });
+    }
+}
@@ -0,0 +1,83 @@
+#include <vector>
+
+#include "Fixtures.h"
+#include "Harness.h"
+#include "Transform.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Bench
+    namespace Bench
+    {
+        // A rigid transform, so repeated in-place application stays bounded.
+        static Transform rigid_transform()
+        {
+            return Transform(rotation_matrix(), Vector3(1.0f, -2.0f, 0.5f));
+        }
+
+        // Inverses.
+
+        MATH3D_BENCHMARK_SWEEP("Transform/inverse", [](State& state) {
+            std::vector<Transform> transforms;
+            for (const Matrix3& m : random_matrices(state.size()))
+                transforms.push_back(Transform(m, Vector3::one));
+
+            map_unary(state, transforms,
+                [](const Transform& t) { return t.inverse(); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Transform/rigid_inverse", [](State& state) {
+            std::vector<Transform> transforms;
+            for (const Quaternion& q : random_quaternions(state.size()))
+                transforms.push_back(Transform(q, Vector3::one));
+
+            map_unary(state, transforms,
+                [](const Transform& t) { return t.rigid_inverse(); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Transform/operator*", [](State& state) {
+            std::vector<Transform> transforms;
+            for (const Matrix3& m : random_matrices(state.size()))
+                transforms.push_back(Transform(m, Vector3::one));
+
+            const Transform t = rigid_transform();
+            map_unary(state, transforms,
+                [&t](const Transform& u) { return t * u; });
+        });
+
+        // Points.
+
+        MATH3D_BENCHMARK_SWEEP("Transform/transform_point", [](State& state) {
+            const Transform t = rigid_transform();
+            map_unary(state, random_vectors(state.size()),
+                [&t](const Vector3& p) { return t.transform_point(p); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Transform/transform_points(Vector3*)", [](State& state) {
+            const Transform t = rigid_transform();
+            const std::vector<Vector3>& in = random_vectors(state.size());
+            std::vector<Vector3> out(in.size());
+            state.set_bytes_per_iteration(2 * in.size() * sizeof(Vector3));
+
+            while (state.keep_running())
+            {
+                t.transform_points(in.data(), out.data(), in.size());
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Transform/transform_points(Vector3Batch)", [](State& state) {
+            const Transform t = rigid_transform();
+            const Vector3Batch in(random_vectors(state.size()));
+            Vector3Batch out(in.size());
+            state.set_bytes_per_iteration(2 * in.size() * sizeof(Vector3));
+
+            while (state.keep_running())
+            {
+                t.transform_points(in, out);
+                clobber_memory();
+            }
+        });
+    }
+}
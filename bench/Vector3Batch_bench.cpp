@@ -0,0 +1,129 @@
+#include <vector>
+
+#include "Fixtures.h"
+#include "Harness.h"
+#include "Vector3Batch.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Bench
+    namespace Bench
+    {
+        // Measures a bulk helper producing one float per element.
+        template <typename Op>
+        static void batch_to_scalars(State& state, Op op)
+        {
+            const Vector3Batch v(random_vectors(state.size(), 1));
+            const Vector3Batch w(random_vectors(state.size(), 2));
+            std::vector<float> out(v.size());
+            state.set_bytes_per_iteration(v.size() * (2 * sizeof(Vector3) + sizeof(float)));
+            do_not_optimize(out.data());
+
+            while (state.keep_running())
+            {
+                op(v, w, out.data());
+                clobber_memory();
+            }
+        }
+
+        // Measures a bulk helper producing one vector per element.
+        template <typename Op>
+        static void batch_to_batch(State& state, Op op)
+        {
+            const Vector3Batch v(random_vectors(state.size(), 1));
+            const Vector3Batch w(random_vectors(state.size(), 2));
+            Vector3Batch out(v.size());
+            state.set_bytes_per_iteration(v.size() * 3 * sizeof(Vector3));
+
+            while (state.keep_running())
+            {
+                op(v, w, out);
+                clobber_memory();
+            }
+        }
+
+        MATH3D_BENCHMARK_SWEEP("Vector3Batch/cross", [](State& state) {
+            batch_to_batch(state, [](const Vector3Batch& v, const Vector3Batch& w, Vector3Batch& out) {
+                Vector3Batch::cross(v, w, out);
+            });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3Batch/distance", [](State& state) {
+            batch_to_scalars(state, [](const Vector3Batch& v, const Vector3Batch& w, float* out) {
+                Vector3Batch::distance(v, w, out);
+            });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3Batch/dot", [](State& state) {
+            batch_to_scalars(state, [](const Vector3Batch& v, const Vector3Batch& w, float* out) {
+                Vector3Batch::dot(v, w, out);
+            });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3Batch/lerp", [](State& state) {
+            batch_to_batch(state, [](const Vector3Batch& v, const Vector3Batch& w, Vector3Batch& out) {
+                Vector3Batch::lerp(v, w, 0.3f, out);
+            });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3Batch/magnitude", [](State& state) {
+            batch_to_scalars(state, [](const Vector3Batch& v, const Vector3Batch&, float* out) {
+                Vector3Batch::magnitude(v, out);
+            });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3Batch/normalize", [](State& state) {
+            Vector3Batch v(random_vectors(state.size()));
+            state.set_bytes_per_iteration(2 * v.size() * sizeof(Vector3));
+
+            while (state.keep_running())
+            {
+                Vector3Batch::normalize(v);
+                clobber_memory();
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3Batch/project", [](State& state) {
+            batch_to_batch(state, [](const Vector3Batch& v, const Vector3Batch& w, Vector3Batch& out) {
+                Vector3Batch::project(v, w, out);
+            });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3Batch/reject", [](State& state) {
+            batch_to_batch(state, [](const Vector3Batch& v, const Vector3Batch& w, Vector3Batch& out) {
+                Vector3Batch::reject(v, w, out);
+            });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3Batch/scale", [](State& state) {
+            batch_to_batch(state, [](const Vector3Batch& v, const Vector3Batch& w, Vector3Batch& out) {
+                Vector3Batch::scale(v, w, out);
+            });
+        });
+
+        // Conversions.
+
+        MATH3D_BENCHMARK_SWEEP("Vector3Batch/from_vector", [](State& state) {
+            const std::vector<Vector3>& vectors = random_vectors(state.size());
+            state.set_bytes_per_iteration(2 * vectors.size() * sizeof(Vector3));
+
+            while (state.keep_running())
+            {
+                Vector3Batch batch(vectors);
+                do_not_optimize(batch.x.data());
+            }
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3Batch/to_vector", [](State& state) {
+            const Vector3Batch batch(random_vectors(state.size()));
+            state.set_bytes_per_iteration(2 * batch.size() * sizeof(Vector3));
+
+            while (state.keep_running())
+            {
+                std::vector<Vector3> vectors = batch.to_vector();
+                do_not_optimize(vectors.data());
+            }
+        });
+    }
+}
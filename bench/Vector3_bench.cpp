@@ -0,0 +1,166 @@
+#include "Fixtures.h"
+#include "Harness.h"
+#include "Vector3.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Bench
+    namespace Bench
+    {
+        // Operators.
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/operator+", [](State& state) {
+            map_binary(state, random_vectors(state.size(), 1), random_vectors(state.size(), 2),
+                [](const Vector3& v, const Vector3& w) { return v + w; });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/operator-", [](State& state) {
+            map_binary(state, random_vectors(state.size(), 1), random_vectors(state.size(), 2),
+                [](const Vector3& v, const Vector3& w) { return v - w; });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/operator-(unary)", [](State& state) {
+            map_unary(state, random_vectors(state.size()),
+                [](const Vector3& v) { return -v; });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/operator*(float)", [](State& state) {
+            map_unary(state, random_vectors(state.size()),
+                [](const Vector3& v) { return v * 1.5f; });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/operator/(float)", [](State& state) {
+            map_unary(state, random_vectors(state.size()),
+                [](const Vector3& v) { return v / 1.5f; });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/operator+=", [](State& state) {
+            map_in_place(state, random_vectors(state.size()),
+                [](Vector3& v) { v += Vector3::one; });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/operator-=", [](State& state) {
+            map_in_place(state, random_vectors(state.size()),
+                [](Vector3& v) { v -= Vector3::one; });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/operator*=", [](State& state) {
+            map_in_place(state, random_vectors(state.size()),
+                [](Vector3& v) { v *= -1.0f; });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/operator/=", [](State& state) {
+            map_in_place(state, random_vectors(state.size()),
+                [](Vector3& v) { v /= -1.0f; });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/operator==", [](State& state) {
+            map_binary(state, random_vectors(state.size(), 1), random_vectors(state.size(), 2),
+                [](const Vector3& v, const Vector3& w) { return static_cast<char>(v == w); });
+        });
+
+        // Member functions.
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/magnitude", [](State& state) {
+            map_unary(state, random_vectors(state.size()),
+                [](const Vector3& v) { return v.magnitude(); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/normalized", [](State& state) {
+            map_unary(state, random_vectors(state.size()),
+                [](const Vector3& v) { return v.normalized(); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/scale(member)", [](State& state) {
+            map_in_place(state, random_vectors(state.size()),
+                [](Vector3& v) { v.scale(Vector3(-1.0f, 1.0f, -1.0f)); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/sqr_magnitude", [](State& state) {
+            map_unary(state, random_vectors(state.size()),
+                [](const Vector3& v) { return v.sqr_magnitude(); });
+        });
+
+        // Static helpers.
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/angle", [](State& state) {
+            map_binary(state, random_vectors(state.size(), 1), random_vectors(state.size(), 2),
+                [](const Vector3& v, const Vector3& w) { return Vector3::angle(v, w); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/cross", [](State& state) {
+            map_binary(state, random_vectors(state.size(), 1), random_vectors(state.size(), 2),
+                [](const Vector3& v, const Vector3& w) { return Vector3::cross(v, w); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/distance", [](State& state) {
+            map_binary(state, random_vectors(state.size(), 1), random_vectors(state.size(), 2),
+                [](const Vector3& v, const Vector3& w) { return Vector3::distance(v, w); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/dot", [](State& state) {
+            map_binary(state, random_vectors(state.size(), 1), random_vectors(state.size(), 2),
+                [](const Vector3& v, const Vector3& w) { return Vector3::dot(v, w); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/lerp", [](State& state) {
+            map_binary(state, random_vectors(state.size(), 1), random_vectors(state.size(), 2),
+                [](const Vector3& v, const Vector3& w) { return Vector3::lerp(v, w, 0.3f); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/normalize", [](State& state) {
+            map_in_place(state, random_vectors(state.size()),
+                [](Vector3& v) { Vector3::normalize(v); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/project", [](State& state) {
+            map_binary(state, random_vectors(state.size(), 1), random_vectors(state.size(), 2),
+                [](const Vector3& v, const Vector3& w) { return Vector3::project(v, w); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/reject", [](State& state) {
+            map_binary(state, random_vectors(state.size(), 1), random_vectors(state.size(), 2),
+                [](const Vector3& v, const Vector3& w) { return Vector3::reject(v, w); });
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/scale", [](State& state) {
+            map_binary(state, random_vectors(state.size(), 1), random_vectors(state.size(), 2),
+                [](const Vector3& v, const Vector3& w) { return Vector3::scale(v, w); });
+        });
+
+        // Out-of-line calls.
+        //
+        // Every Vector3 function is inlined from the header. These variants
+        // go through a call the compiler may not inline, as every operator did
+        // while it was compiled into the shared library; compare them with the
+        // matching benchmarks above.
+
+        static MATH3D_NOINLINE Vector3 add(const Vector3& v, const Vector3& w)
+        {
+            return v + w;
+        }
+
+        static MATH3D_NOINLINE float magnitude(const Vector3& v)
+        {
+            return v.magnitude();
+        }
+
+        static MATH3D_NOINLINE Vector3 normalized(const Vector3& v)
+        {
+            return v.normalized();
+        }
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/operator+(call)", [](State& state) {
+            map_binary(state, random_vectors(state.size(), 1), random_vectors(state.size(), 2), add);
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/magnitude(call)", [](State& state) {
+            map_unary(state, random_vectors(state.size()), magnitude);
+        });
+
+        MATH3D_BENCHMARK_SWEEP("Vector3/normalized(call)", [](State& state) {
+            map_unary(state, random_vectors(state.size()), normalized);
+        });
+    }
+}
@@ -0,0 +1,29 @@
+#include <fstream>
+#include <iostream>
+
+#include "Harness.h"
+
+int main(int argc, char** argv)
+{
+    Math3D::Bench::Options options;
+
+    if (!Math3D::Bench::parse_options(argc, argv, options))
+        return 1;
+
+    const std::vector<Math3D::Bench::Result> results = Math3D::Bench::run(options);
+
+    if (!options.json.empty())
+    {
+        std::ofstream file(options.json);
+
+        if (!file)
+        {
+            std::cerr << "Cannot open " << options.json << " for writing.\n";
+            return 1;
+        }
+
+        Math3D::Bench::write_json(file, results);
+    }
+
+    return 0;
+}
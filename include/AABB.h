@@ -0,0 +1,90 @@
+/// @file AABB.h
+/// @brief This header file contains the declaration of the AABB class.
+/// @author David Moncada
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+#include "MathObject.h"
+#include "Vector3.h"
+#include "Vector3Batch.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @class AABB
+    /// @brief The AABB class declaration.
+    ///
+    /// An axis-aligned bounding box, given by its two extreme corners. Boxes
+    /// are the cheapest bounding volume to test against rays and against each
+    /// other, and merging two of them is just a component-wise min and max.
+    ///
+    /// A default-constructed box is empty: its minimum corner is at positive
+    /// infinity and its maximum at negative infinity, so that expanding it by a
+    /// point yields a box around just that point.
+    class AABB
+    {
+    public:
+        Vector3 min = Vector3(
+            std::numeric_limits<float>::infinity(),
+            std::numeric_limits<float>::infinity(),
+            std::numeric_limits<float>::infinity());
+        Vector3 max = Vector3(
+            -std::numeric_limits<float>::infinity(),
+            -std::numeric_limits<float>::infinity(),
+            -std::numeric_limits<float>::infinity());
+
+        /// @brief Computes the smallest box containing two boxes.
+        /// @return The union of the two inputs.
+        static AABB merge(const AABB& a, const AABB& b)
+        {
+            return AABB(
+                Vector3(std::fmin(a.min.x, b.min.x), std::fmin(a.min.y, b.min.y), std::fmin(a.min.z, b.min.z)),
+                Vector3(std::fmax(a.max.x, b.max.x), std::fmax(a.max.y, b.max.y), std::fmax(a.max.z, b.max.z)));
+        }
+
+        // Static functions.
+        static AABB from_points(const Vector3*, std::size_t);
+        static AABB from_points(const Vector3Batch&);
+
+        // Bulk functions.
+        static std::size_t overlaps(const AABB&, const AABB*, std::size_t, unsigned char*);
+
+        // Constructors.
+        AABB() = default;
+        AABB(const Vector3&, const Vector3&);
+
+        // Member functions.
+        Vector3 center() const;
+        Vector3 closest_point(const Vector3&) const;
+        bool contains(const Vector3&) const;
+        bool contains(const AABB&) const;
+        bool empty() const;
+        void expand(const Vector3&);
+        void expand(const AABB&);
+        Vector3 extents() const;
+        bool overlaps(const AABB&) const;
+        float sqr_distance(const Vector3&) const;
+        float surface_area() const;
+        float volume() const;
+
+        // Comparison operators overloads.
+        bool operator==(const AABB&) const;
+    };
+
+    static_assert(sizeof(AABB) == 6 * sizeof(float),
+        "AABB must be exactly six packed floats.");
+    static_assert(std::is_standard_layout<AABB>::value,
+        "AABB must be a standard-layout type.");
+    static_assert(std::is_trivially_copyable<AABB>::value,
+        "AABB must be trivially copyable.");
+
+    // Printing.
+    std::ostream& to_string(std::ostream&, const AABB&);
+    std::ostream& operator<<(std::ostream&, const AABB&);
+}
@@ -0,0 +1,173 @@
+/// @file ArrayFile.h
+/// @brief This header file contains the declaration of the binary array file
+/// format, and of its ArrayWriter and MappedArray classes.
+/// @author David Moncada
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <type_traits>
+
+#include "Half.h"
+#include "Matrix3.h"
+#include "Vector3.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @brief The element types an array file can hold.
+    enum class ArrayType : std::uint32_t
+    {
+        Vector3 = 1,
+        Matrix3 = 2,
+        Vector3Half = 3
+    };
+
+    /// @brief Maps an element type to its ArrayType.
+    template <typename T> struct ArrayTypeOf;
+
+    template <> struct ArrayTypeOf<Vector3>
+    {
+        static constexpr ArrayType value = ArrayType::Vector3;
+    };
+
+    template <> struct ArrayTypeOf<Matrix3>
+    {
+        static constexpr ArrayType value = ArrayType::Matrix3;
+    };
+
+    template <> struct ArrayTypeOf<Vector3Half>
+    {
+        static constexpr ArrayType value = ArrayType::Vector3Half;
+    };
+
+    /// @struct ArrayFileHeader
+    /// @brief The header at the start of every array file.
+    ///
+    /// An array file is this 64-byte header followed by the elements, stored
+    /// exactly as they are laid out in memory, starting at data_offset. The
+    /// byte order field holds 0x01020304 as written by the producing machine,
+    /// so a reader can tell whether the file matches its own byte order; it
+    /// comes right after the magic, before any field whose value depends on
+    /// it.
+    struct ArrayFileHeader
+    {
+        /// @brief The bytes "M3DARRAY".
+        char magic[8];
+        /// @brief 0x01020304, in the byte order of the writer.
+        std::uint32_t byte_order;
+        /// @brief The version of the format.
+        std::uint32_t version;
+        /// @brief The ArrayType of the elements.
+        std::uint32_t type;
+        /// @brief The size of one element, in bytes.
+        std::uint32_t element_size;
+        /// @brief The number of elements.
+        std::uint64_t count;
+        /// @brief The offset of the first element from the start of the file.
+        std::uint64_t data_offset;
+        /// @brief The alignment data_offset is a multiple of.
+        std::uint32_t alignment;
+        std::uint32_t reserved[5];
+
+        /// @brief The version written by this library.
+        static constexpr std::uint32_t current_version = 1;
+        /// @brief The alignment of the elements, a cache line.
+        static constexpr std::uint32_t data_alignment = 64;
+    };
+
+    static_assert(sizeof(ArrayFileHeader) == 64,
+        "ArrayFileHeader must be exactly 64 bytes.");
+    static_assert(std::is_trivially_copyable<ArrayFileHeader>::value,
+        "ArrayFileHeader must be trivially copyable.");
+
+    /// @class ArrayWriter
+    /// @brief The ArrayWriter class declaration.
+    ///
+    /// Writes an array file one element or one block at a time, so that
+    /// arrays larger than memory can be produced. The header is written
+    /// first with a count of zero and completed by close(); a file that was
+    /// never closed therefore reads as empty rather than truncated.
+    ///
+    /// Defined for Vector3, Matrix3 and Vector3Half. Errors throw
+    /// std::runtime_error.
+    template <typename T>
+    class ArrayWriter
+    {
+    private:
+        std::ofstream _file;
+        std::string _path;
+        std::uint64_t _count;
+
+    public:
+        // Constructors.
+        explicit ArrayWriter(const std::string&);
+        ArrayWriter(const ArrayWriter&) = delete;
+        ArrayWriter& operator=(const ArrayWriter&) = delete;
+        ~ArrayWriter();
+
+        // Member functions.
+        void close();
+        std::size_t size() const;
+        void write(const T&);
+        void write(const T*, std::size_t);
+
+    private:
+        bool finish();
+    };
+
+    /// @class MappedArray
+    /// @brief The MappedArray class declaration.
+    ///
+    /// A read-only view of an array file, mapped into memory: the elements
+    /// are read in place, with no copy and no parse step, and only the pages
+    /// actually touched are loaded from disk.
+    ///
+    /// Opening a file checks its header against the element type, and throws
+    /// std::runtime_error if the file is not an array file of that type, was
+    /// written with the other byte order, or is shorter than its header says.
+    ///
+    /// Defined for Vector3, Matrix3 and Vector3Half.
+    template <typename T>
+    class MappedArray
+    {
+    private:
+        const T* _data;
+        std::size_t _size;
+        void* _mapping;
+        std::size_t _mapping_size;
+
+    public:
+        // Constructors.
+        explicit MappedArray(const std::string&);
+        MappedArray(MappedArray&&) noexcept;
+        MappedArray& operator=(MappedArray&&) noexcept;
+        MappedArray(const MappedArray&) = delete;
+        MappedArray& operator=(const MappedArray&) = delete;
+        ~MappedArray();
+
+        // Member functions.
+        const T* begin() const { return _data; }
+        const T* data() const { return _data; }
+        bool empty() const { return _size == 0; }
+        const T* end() const { return _data + _size; }
+        std::size_t size() const { return _size; }
+
+        // [] overloads.
+        const T& operator[](std::size_t index) const { return _data[index]; }
+
+    private:
+        void unmap();
+    };
+
+    // Compiled in the library, for the supported element types.
+    extern template class ArrayWriter<Vector3>;
+    extern template class ArrayWriter<Matrix3>;
+    extern template class ArrayWriter<Vector3Half>;
+    extern template class MappedArray<Vector3>;
+    extern template class MappedArray<Matrix3>;
+    extern template class MappedArray<Vector3Half>;
+}
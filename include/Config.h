@@ -0,0 +1,60 @@
+/// @file Config.h
+/// @brief This header file contains the build-time settings of the library:
+/// whether errors are reported by exceptions, and whether element accesses are
+/// checked.
+/// @author David Moncada
+
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+
+/// @def MATH3D_EXCEPTIONS
+/// @brief 1 if the library is compiled with C++ exceptions, 0 otherwise.
+///
+/// Detected from the compiler; with exceptions disabled (e.g. GCC's
+/// -fno-exceptions, or the MATH3D_EXCEPTIONS CMake option set to OFF), every
+/// error the library would throw prints a message and aborts instead.
+#if !defined(MATH3D_EXCEPTIONS)
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define MATH3D_EXCEPTIONS 1
+#else
+#define MATH3D_EXCEPTIONS 0
+#endif
+#endif
+
+/// @def MATH3D_CHECKED
+/// @brief 1 if element accesses such as Matrix3::operator() check their
+/// indices, 0 if they trust them.
+///
+/// Defaults to checked in debug builds and unchecked when NDEBUG is defined;
+/// define it to 0 or 1 to override. It must have the same value in every
+/// translation unit of a program, since it changes inline functions.
+#if !defined(MATH3D_CHECKED)
+#if defined(NDEBUG)
+#define MATH3D_CHECKED 0
+#else
+#define MATH3D_CHECKED 1
+#endif
+#endif
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @brief Reports an unrecoverable error when exceptions are disabled.
+    /// @param what A description of the error.
+    [[noreturn]] inline void fatal_error(const char* what)
+    {
+        std::fprintf(stderr, "Math3D: %s\n", what);
+        std::abort();
+    }
+}
+
+/// @def MATH3D_THROW
+/// @brief Throws an exception, or, when exceptions are disabled, aborts with
+/// the text of the throw expression as the message.
+#if MATH3D_EXCEPTIONS
+#define MATH3D_THROW(exception) throw exception
+#else
+#define MATH3D_THROW(exception) ::Math3D::fatal_error(#exception)
+#endif
@@ -0,0 +1,53 @@
+/// @file Dispatch.h
+/// @brief This header file contains the runtime selection of the SIMD kernels.
+/// @author David Moncada
+
+#pragma once
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @brief The instruction sets the bulk kernels are compiled for, from the
+    /// least to the most capable.
+    enum class SimdLevel
+    {
+        Scalar,
+        SSE42,
+        /// @brief AVX2 with FMA and F16C, as found on every AVX2 CPU.
+        AVX2,
+        /// @brief AVX-512 F, VL, DQ and BW, on top of the AVX2 level.
+        AVX512
+    };
+
+    /// @brief Detects the most capable SIMD level supported by this CPU and
+    /// operating system.
+    ///
+    /// Only x86 builds carry SIMD kernels; on other architectures this is
+    /// always SimdLevel::Scalar.
+    ///
+    /// @return The best SimdLevel available.
+    SimdLevel detect_simd_level();
+
+    /// @brief The SIMD level the bulk kernels currently dispatch to.
+    ///
+    /// The level is chosen when the library is loaded: it is the detected one,
+    /// unless the @c MATH3D_SIMD environment variable names another. Accepted
+    /// values are @c scalar, @c sse4.2, @c avx2 and @c avx512. A request for a
+    /// level the CPU does not support falls back to the detected one.
+    ///
+    /// @return The active SimdLevel.
+    SimdLevel simd_level();
+
+    /// @brief Switches the bulk kernels to another SIMD level.
+    ///
+    /// Meant for testing and benchmarking; the switch is not synchronized with
+    /// bulk calls already running on other threads.
+    ///
+    /// @param level The SimdLevel to use.
+    /// @return @c true on success, @c false if this CPU does not support the
+    /// level, in which case the active one is left unchanged.
+    bool set_simd_level(SimdLevel level);
+
+    /// @brief The name of a SIMD level, as accepted by @c MATH3D_SIMD.
+    const char* simd_level_name(SimdLevel level);
+}
@@ -0,0 +1,123 @@
+/// @file Fast.h
+/// @brief This header file contains approximate versions of the most common
+/// vector operations, trading accuracy for speed.
+/// @author David Moncada
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "MathObject.h"
+#include "Vector3.h"
+#include "Vector3Batch.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Fast
+    /// @brief The fast approximation precision policy.
+    ///
+    /// The functions in this namespace mirror those of Vector3 and Vector3Batch
+    /// with the same names, without any division or std::acos call: the
+    /// reciprocal square root is approximated from the bits of its input, and
+    /// the inverse cosine by a polynomial, which still takes one square root.
+    /// They are opt-in: code that can live with the documented error bounds
+    /// calls Fast::normalize() instead of Vector3::normalize().
+    namespace Fast
+    {
+        /// @brief Maximum relative error of rsqrt(), magnitude(), and of the
+        /// magnitude of the vectors returned by normalize().
+        const float rsqrt_max_error = 5e-6f;
+
+        /// @brief Maximum absolute error of acos(), in radians.
+        const float acos_max_error = 6.8e-5f;
+
+        /// @brief Maximum absolute error of angle(), in degrees.
+        ///
+        /// The error peaks for nearly parallel vectors, where the inverse cosine
+        /// amplifies any error in its argument; the exact path loses about a
+        /// quarter of this there too, from float rounding alone.
+        const float angle_max_error = 0.2f;
+
+        /// @brief Computes an approximate reciprocal square root.
+        ///
+        /// A first guess is read off the bits of the input, then refined with
+        /// two Newton-Raphson iterations.
+        ///
+        /// @param x A positive, finite number; zero yields a large finite value
+        /// rather than infinity.
+        /// @return 1 / sqrt(x), within rsqrt_max_error.
+        inline float rsqrt(float x)
+        {
+            std::int32_t i;
+            float y;
+            std::memcpy(&i, &x, sizeof(i));
+            i = 0x5f375a86 - (i >> 1);
+            std::memcpy(&y, &i, sizeof(y));
+
+            const float half = 0.5f * x;
+            y = y * (1.5f - half * y * y);
+            y = y * (1.5f - half * y * y);
+            return y;
+        }
+
+        /// @brief Computes an approximate inverse cosine.
+        ///
+        /// Uses the polynomial approximation 4.4.45 from Abramowitz and Stegun,
+        /// mirrored for negative inputs.
+        ///
+        /// @param x A number in [-1,1].
+        /// @return acos(x) in radians, within acos_max_error.
+        inline float acos(float x)
+        {
+            const float a = std::fabs(x);
+            const float r = std::sqrt(1.0f - a) *
+                (1.5707288f + a * (-0.2121144f + a * (0.0742610f + a * -0.0187293f)));
+            return x < 0.0f ? pi - r : r;
+        }
+
+        /// @brief Approximates the magnitude of a vector.
+        /// @return The length of the vector, within rsqrt_max_error.
+        inline float magnitude(const Vector3& v)
+        {
+            const float s = v.sqr_magnitude();
+            return s * rsqrt(s);
+        }
+
+        /// @brief Turns an arbitrary vector into an approximate unit vector.
+        /// @param v The Vector3 to normalize.
+        inline Vector3& normalize(Vector3& v)
+        {
+            v *= rsqrt(v.sqr_magnitude());
+            return v;
+        }
+
+        /// @brief Returns an approximate unit vector with the direction of v.
+        inline Vector3 normalized(const Vector3& v)
+        {
+            Vector3 u = v;
+            return normalize(u);
+        }
+
+        /// @brief Approximates the angle between two vectors.
+        ///
+        /// Both magnitudes are folded into a single reciprocal square root.
+        ///
+        /// @return The angle between the inputs in degrees, within
+        /// angle_max_error.
+        inline float angle(const Vector3& v, const Vector3& w)
+        {
+            float c = Vector3::dot(v, w) * rsqrt(v.sqr_magnitude() * w.sqr_magnitude());
+            c = std::fmax(c, -1.0f);
+            c = std::fmin(c, 1.0f);
+            return rad2deg(acos(c));
+        }
+
+        // Bulk functions.
+        void angle(const Vector3Batch&, const Vector3Batch&, float*);
+        void magnitude(const Vector3Batch&, float*);
+        void normalize(Vector3Batch&);
+    }
+}
@@ -0,0 +1,159 @@
+/// @file Half.h
+/// @brief This header file contains the declaration of the Half and
+/// Vector3Half storage types.
+/// @author David Moncada
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "Vector3.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @class Half
+    /// @brief The Half class declaration.
+    ///
+    /// An IEEE 754 half-precision float: a sign bit, five exponent bits and ten
+    /// mantissa bits. Halves hold about three significant decimal digits, up to
+    /// 65504, in half the space of a float, which makes them a storage format
+    /// for large archived arrays rather than a type to compute with; convert
+    /// them to floats first.
+    ///
+    /// Conversions from float round to nearest even; overflows become
+    /// infinities and NaNs stay NaNs. Conversions to float are exact. The bulk
+    /// conversions use the F16C instructions when the CPU has them, and a
+    /// portable bit-manipulation routine producing the same results otherwise.
+    class Half
+    {
+    public:
+        /// @brief The bits of the half.
+        std::uint16_t bits = 0;
+
+        /// @brief Makes a half from its bit pattern.
+        static constexpr Half from_bits(std::uint16_t bits)
+        {
+            Half h;
+            h.bits = bits;
+            return h;
+        }
+
+        // Bulk conversions.
+        static void from_floats(const float*, Half*, std::size_t);
+        static void to_floats(const Half*, float*, std::size_t);
+
+        // Constructors.
+        Half() = default;
+
+        /// @brief Converts a float to the nearest half.
+        explicit Half(float f)
+        {
+            std::uint32_t x;
+            std::memcpy(&x, &f, sizeof(x));
+
+            const std::uint32_t sign = (x >> 16) & 0x8000u;
+            x &= 0x7fffffffu;
+
+            if (x >= 0x47800000u)
+            {
+                // Infinity, NaN, or too large for a half.
+                bits = static_cast<std::uint16_t>(sign | (x > 0x7f800000u ? 0x7e00u : 0x7c00u));
+            }
+            else if (x < 0x38800000u)
+            {
+                // Subnormal or zero; adding 0.5 shifts and rounds the mantissa.
+                float g;
+                std::memcpy(&g, &x, sizeof(g));
+                g += 0.5f;
+                std::memcpy(&x, &g, sizeof(x));
+                bits = static_cast<std::uint16_t>(sign | (x - 0x3f000000u));
+            }
+            else
+            {
+                // Normal; rebias the exponent and round to nearest even.
+                bits = static_cast<std::uint16_t>(sign | ((x + 0xc8000fffu + ((x >> 13) & 1u)) >> 13));
+            }
+        }
+
+        // Conversion operators.
+
+        /// @brief Converts this half to a float, exactly.
+        explicit operator float() const
+        {
+            const std::uint32_t exponent = (bits >> 10) & 0x1fu;
+            const std::uint32_t mantissa = bits & 0x3ffu;
+            std::uint32_t x = static_cast<std::uint32_t>(bits & 0x8000u) << 16;
+
+            if (exponent == 0x1fu)
+            {
+                // Infinity or NaN.
+                x |= 0x7f800000u | (mantissa << 13);
+            }
+            else if (exponent != 0)
+            {
+                x |= ((exponent + 112) << 23) | (mantissa << 13);
+            }
+            else if (mantissa != 0)
+            {
+                // Subnormal: mantissa * 2^-24, which a float holds exactly.
+                float f = static_cast<float>(mantissa) * 5.9604644775390625e-08f;
+                if (bits & 0x8000u)
+                    f = -f;
+                return f;
+            }
+
+            float f;
+            std::memcpy(&f, &x, sizeof(f));
+            return f;
+        }
+    };
+
+    static_assert(sizeof(Half) == 2,
+        "Half must be exactly two bytes.");
+    static_assert(std::is_trivially_copyable<Half>::value,
+        "Half must be trivially copyable.");
+
+    /// @class Vector3Half
+    /// @brief The Vector3Half class declaration.
+    ///
+    /// A Vector3 stored as three packed halves, six bytes instead of twelve,
+    /// for point buffers that are archived or streamed rather than computed
+    /// with. Arrays are converted to and from Vector3 in bulk with pack() and
+    /// unpack().
+    class Vector3Half
+    {
+    public:
+        Half x;
+        Half y;
+        Half z;
+
+        // Bulk conversions.
+        static void pack(const Vector3*, Vector3Half*, std::size_t);
+        static void unpack(const Vector3Half*, Vector3*, std::size_t);
+
+        // Constructors.
+        Vector3Half() = default;
+
+        /// @brief Converts a vector to the nearest halves.
+        explicit Vector3Half(const Vector3& v) : x{ v.x }, y{ v.y }, z{ v.z } {}
+
+        // Conversion operators.
+
+        /// @brief Converts this vector to single precision, exactly.
+        explicit operator Vector3() const
+        {
+            return Vector3(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z));
+        }
+    };
+
+    static_assert(sizeof(Vector3Half) == 3 * sizeof(Half),
+        "Vector3Half must be exactly three packed halves.");
+    static_assert(std::is_standard_layout<Vector3Half>::value,
+        "Vector3Half must be a standard-layout type.");
+    static_assert(std::is_trivially_copyable<Vector3Half>::value,
+        "Vector3Half must be trivially copyable.");
+}
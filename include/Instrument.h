@@ -0,0 +1,168 @@
+/// @file Instrument.h
+/// @brief This header file contains the optional instrumentation of the
+/// library: per-operation call counts and time totals, and their JSON dump.
+/// @author David Moncada
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "Config.h"
+
+/// @def MATH3D_INSTRUMENT
+/// @brief 1 if the library counts the calls and time of its operations, 0 if
+/// it does not.
+///
+/// Off by default; turn it on with the MATH3D_INSTRUMENT CMake option, which
+/// defines it for the library and everything built with it. Like
+/// MATH3D_CHECKED, it must have the same value in every translation unit of a
+/// program. When it is 0, the instrumentation macros expand to nothing and the
+/// kernels are called directly, so the instrumentation costs nothing. When it
+/// is 1, even the header-only types must be linked against the library, which
+/// holds the counters.
+#if !defined(MATH3D_INSTRUMENT)
+#define MATH3D_INSTRUMENT 0
+#endif
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Instrument
+    namespace Instrument
+    {
+        /// @brief Whether this build is instrumented.
+        constexpr bool enabled = MATH3D_INSTRUMENT != 0;
+
+        /// @brief The operations of the header-only types that are counted;
+        /// the bulk kernels are counted too, under their own names. Every
+        /// precision is counted under the same operation.
+        enum class Operation
+        {
+            Matrix3Inverse,
+            /// @brief Not timed: the number of singular matrices met by
+            /// inverse(), try_inverse() and Matrix3Batch::inverse().
+            Matrix3InverseFailure,
+            Matrix3MultiplyMatrix,
+            Matrix3MultiplyVector,
+            Vector3Normalize,
+            Vector3Angle,
+            Count
+        };
+
+        /// @brief The totals of one operation, over every thread.
+        struct OperationStats
+        {
+            /// @brief The name of the operation, such as "Matrix3::inverse"
+            /// or "kernel.transform".
+            const char* name = nullptr;
+            /// @brief The number of calls.
+            std::uint64_t calls = 0;
+            /// @brief The time spent in the calls, in ticks of the
+            /// timestamp counter, or nanoseconds where there is none.
+            std::uint64_t ticks = 0;
+            /// @brief The time spent in the calls, in nanoseconds, converted
+            /// from the ticks.
+            double nanoseconds = 0.0;
+        };
+
+        // Totals.
+        std::vector<OperationStats> snapshot();
+        void reset();
+        void dump_json(std::ostream&);
+
+        // Recording, used by the macros below.
+        std::uint64_t now();
+        void record(std::size_t, std::uint64_t);
+        void count(Operation, std::uint64_t);
+
+        /// @class Timer
+        /// @brief Records a call of an operation, and the time until the
+        /// Timer is destroyed.
+        class Timer
+        {
+        private:
+            std::size_t _operation;
+            std::uint64_t _start;
+
+        public:
+            explicit Timer(std::size_t operation) : _operation(operation), _start(now()) {}
+            explicit Timer(Operation operation) : Timer(static_cast<std::size_t>(operation)) {}
+            ~Timer() { record(_operation, now() - _start); }
+
+            Timer(const Timer&) = delete;
+            Timer& operator=(const Timer&) = delete;
+        };
+
+        /// @brief Calls a function, recording the call and its time.
+        template <typename F>
+        inline auto timed(Operation operation, F f) -> decltype(f())
+        {
+            const Timer timer(operation);
+            return f();
+        }
+    }
+}
+
+// Instrumented constexpr functions must tell compile-time evaluations, which
+// cannot be recorded, from run-time calls. C++17 has no standard way to, so
+// instrumented builds, and only they, need the compiler builtin (GCC 9, Clang 9
+// or MSVC 19.25 and later).
+#if MATH3D_INSTRUMENT
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define MATH3D_HAS_IS_CONSTANT_EVALUATED 1
+#endif
+#endif
+#if !defined(MATH3D_HAS_IS_CONSTANT_EVALUATED)
+#if (defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#define MATH3D_HAS_IS_CONSTANT_EVALUATED 1
+#else
+#error "MATH3D_INSTRUMENT needs a compiler providing __builtin_is_constant_evaluated()."
+#endif
+#endif
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Instrument
+    namespace Instrument
+    {
+        /// @brief Whether the caller is being evaluated at compile time,
+        /// where nothing may be recorded.
+        constexpr bool is_constant_evaluated()
+        {
+            return __builtin_is_constant_evaluated();
+        }
+    }
+}
+#endif
+
+/// @def MATH3D_INSTRUMENT_SCOPE
+/// @brief Records a call of an operation, timed until the end of the
+/// enclosing scope. Not usable in constexpr functions.
+///
+/// @def MATH3D_INSTRUMENT_CALL
+/// @brief Evaluates an expression, recording a call of an operation and its
+/// time; usable in constexpr functions, where compile-time evaluations are
+/// not recorded.
+///
+/// @def MATH3D_INSTRUMENT_COUNT
+/// @brief Records events of an operation, without time; usable in constexpr
+/// functions.
+#if MATH3D_INSTRUMENT
+#define MATH3D_INSTRUMENT_SCOPE(operation) \
+    const ::Math3D::Instrument::Timer math3d_instrument_timer(operation)
+#define MATH3D_INSTRUMENT_CALL(operation, expression) \
+    (::Math3D::Instrument::is_constant_evaluated() ? (expression) : \
+        ::Math3D::Instrument::timed(operation, [&]() { return expression; }))
+#define MATH3D_INSTRUMENT_COUNT(operation, events) \
+    (::Math3D::Instrument::is_constant_evaluated() ? (void)0 : \
+        ::Math3D::Instrument::count(operation, events))
+#else
+#define MATH3D_INSTRUMENT_SCOPE(operation) ((void)0)
+#define MATH3D_INSTRUMENT_CALL(operation, expression) (expression)
+#define MATH3D_INSTRUMENT_COUNT(operation, events) ((void)0)
+#endif
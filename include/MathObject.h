@@ -1,5 +1,5 @@
 /// @file MathObject.h
-/// @brief This header file contains the MathObject interface.
+/// @brief This header file contains the helpers shared by the math objects.
 /// @author David Moncada
 
 #pragma once
@@ -11,37 +11,38 @@
 /// @namespace Math3D
 namespace Math3D
 {
+    /// @brief The pi mathematical constant, in a given precision.
+    template <typename T>
+    constexpr T pi_v = static_cast<T>(3.14159265358979323846L);
+
     /// @brief The pi mathematical constant.
-    const float pi = std::atanf(1.0f) * 4.0f;
+    constexpr float pi = pi_v<float>;
 
     /// @brief Helper function to convert from radians to degrees.
     /// @return The input in degrees.
-    inline float rad2deg(const float rad)
+    constexpr float rad2deg(const float rad)
     {
         return 180.0f * rad / pi;
     }
 
+    /// @brief Helper function to convert from degrees to radians.
+    /// @return The input in radians.
+    constexpr float deg2rad(const float deg)
+    {
+        return pi * deg / 180.0f;
+    }
+
     /// @brief Helper function to assert if two floats are reasonably close.
     /// @returns @c true if the inputs are within epsilon from each other, @c
     /// false otherwise.
-    inline bool is_almost_equal(const float a, const float b, float e = 0.001f)
+    constexpr bool is_almost_equal(const float a, const float b, float e = 0.001f)
     {
-        return std::fabsf(a - b) < e;
+        return a - b < e && b - a < e;
     }
 
-    /// @class MathObject
-    /// @brief Interface for mathematical objects.
-    class MathObject
-    {
-    public:
-        virtual ~MathObject() = default;
-        virtual std::ostream& to_string(std::ostream&) const = 0;
-    };
-
-    /// @brief Override for the output stream insertion operator, for classes
-    /// deriving from MathObject.
-    inline std::ostream& operator<<(std::ostream& os, MathObject& obj)
+    /// @brief Helper function to assert if two doubles are reasonably close.
+    constexpr bool is_almost_equal(const double a, const double b, double e = 0.001)
     {
-        return obj.to_string(os);
+        return a - b < e && b - a < e;
     }
 }
\ No newline at end of file
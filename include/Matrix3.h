@@ -1,85 +1,784 @@
 /// @file Matrix3.h
-/// @brief This header file contains the declaration of the Matrix3 class.
+/// @brief This header file contains the declaration of the Matrix3T class
+/// template, and of its Matrix3 and Matrix3d instances.
 /// @author David Moncada
 
 #pragma once
 
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Config.h"
+#include "Instrument.h"
 #include "MathObject.h"
 #include "Vector3.h"
+#include "Vector3Batch.h"
 
 /// @namespace Math3D
 namespace Math3D
 {
-    /// @class Matrix3
-    /// @brief The Matrix3 class declaration.
+    /// @brief The eigenvalues and eigenvectors of a symmetric matrix.
+    template <typename T>
+    struct SymmetricEigenT
+    {
+        /// @brief The eigenvalues, in increasing order: x is the smallest and
+        /// z the largest.
+        Vector3T<T> values;
+
+        /// @brief The unit eigenvectors, vectors[i] belonging to the i-th
+        /// eigenvalue; they are mutually orthogonal. Each is only defined up
+        /// to its sign.
+        Vector3T<T> vectors[3];
+    };
+
+    typedef SymmetricEigenT<float> SymmetricEigen;
+    typedef SymmetricEigenT<double> SymmetricEigend;
+
+    template <typename T> struct SvdT;
+    template <typename T> struct PolarDecompositionT;
+
+    /// @class Matrix3T
+    /// @brief The Matrix3T class template declaration.
     ///
     /// Matrices represent coordinate system transformations; they are used to
     /// describe how a vector, point, line, plane, or even another transformation
     /// can be moved from one coordinate system with its own origin and set of
     /// axes to a different one.
-    class Matrix3 : public MathObject
+    ///
+    /// Like Vector3T, Matrix3T is a plain value type holding nine packed
+    /// elements of type T in row-major order, with no virtual functions and
+    /// implicit copies; Matrix3 is the single precision instance, and Matrix3d
+    /// the double precision one.
+    ///
+    /// As with Vector3T, everything but the bulk transforms is defined in this
+    /// header, and everything but the decompositions is constexpr, so rotation
+    /// tables and other constant matrices can be built at compile time. The
+    /// bulk operations run the vectorized kernels for Matrix3, and a plain
+    /// loop for other precisions.
+    template <typename T>
+    class Matrix3T
     {
     private:
-        float _m[3][3];
+        T _m[3][3];
 
     public:
+        /// @brief The type of the elements.
+        typedef T value_type;
+
         /// @brief Returns the identity matrix.
-        /// @return A Matrix3 with ones in its main diagonal and zeros elsewhere.
-        static Matrix3 identity()
+        /// @return A Matrix3T with ones in its main diagonal and zeros elsewhere.
+        static constexpr Matrix3T identity()
         {
-            return Matrix3(1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+            return Matrix3T(1, 0, 0, 0, 1, 0, 0, 0, 1);
         }
 
         /// @brief Transposes a matrix.
-        /// @param mat The Matrix3 to transpose.
-        static Matrix3& transpose(Matrix3& mat)
+        /// @param mat The Matrix3T to transpose.
+        static constexpr Matrix3T& transpose(Matrix3T& mat)
         {
             for (int i = 0; i < 3 - 1; ++i)
+            {
                 for (int j = i + 1; j < 3; ++j)
-                    std::swap(mat._m[i][j], mat._m[j][i]);
+                {
+                    const T t = mat._m[i][j];
+                    mat._m[i][j] = mat._m[j][i];
+                    mat._m[j][i] = t;
+                }
+            }
 
             return mat;
         }
 
         // Constructors.
-        Matrix3() = default;
-        Matrix3(const Matrix3&);
-        Matrix3(const Vector3&, const Vector3&, const Vector3&);
-        Matrix3(float, float, float, float, float, float, float, float, float);
+        Matrix3T() = default;
+
+        /// @brief Constructor for Matrix3T.
+        constexpr Matrix3T(const Vector3T<T>& u, const Vector3T<T>& v, const Vector3T<T>& w)
+            : _m{ { u.x, v.x, w.x }, { u.y, v.y, w.y }, { u.z, v.z, w.z } } {}
+
+        /// @brief Constructor for Matrix3T.
+        constexpr Matrix3T(
+            T m00, T m01, T m02,
+            T m10, T m11, T m12,
+            T m20, T m21, T m22)
+            : _m{ { m00, m01, m02 }, { m10, m11, m12 }, { m20, m21, m22 } } {}
+
+        /// @brief Converts a matrix of another precision, element by element.
+        template <typename U>
+        explicit constexpr Matrix3T(const Matrix3T<U>& m)
+            : Matrix3T(
+                static_cast<T>(m(0, 0)), static_cast<T>(m(0, 1)), static_cast<T>(m(0, 2)),
+                static_cast<T>(m(1, 0)), static_cast<T>(m(1, 1)), static_cast<T>(m(1, 2)),
+                static_cast<T>(m(2, 0)), static_cast<T>(m(2, 1)), static_cast<T>(m(2, 2))) {}
 
         // Member functions.
-        float determinant() const;
-        Matrix3 inverse() const;
-        Matrix3 transposed() const;
+
+        /// @brief The element at a given row and column, with checked indices.
+        /// @throw std::out_of_range If either index is not 0, 1 or 2, whatever
+        /// the value of MATH3D_CHECKED.
+        constexpr T& at(int row, int col)
+        {
+            if (!is_in_range(row) || !is_in_range(col))
+            {
+                MATH3D_THROW(std::out_of_range("Index out of range."));
+            }
+
+            return _m[row][col];
+        }
+
+        /// @brief The element at a given row and column, with checked indices.
+        constexpr const T& at(int row, int col) const
+        {
+            if (!is_in_range(row) || !is_in_range(col))
+            {
+                MATH3D_THROW(std::out_of_range("Index out of range."));
+            }
+
+            return _m[row][col];
+        }
+
+        /// @brief The determinant of this matrix.
+        ///
+        /// The determinant can be thought of as a sort of magnitude for the matrix.
+        /// It can be positive of negative depending on the orientation of the set of
+        /// vectors consisting of the n rows (or columns) of the matrix.
+        ///
+        /// The determinant is computed using _expansion by minors_, where _minor_ is
+        /// the determinant of a submatrix that excludes a row and a column.
+        ///
+        /// @return The determinant of this matrix.
+        constexpr T determinant() const
+        {
+            return
+                _m[0][0] * (_m[1][1] * _m[2][2] - _m[1][2] * _m[2][1]) +
+                _m[0][1] * (_m[1][2] * _m[2][0] - _m[1][0] * _m[2][2]) +
+                _m[0][2] * (_m[1][0] * _m[2][1] - _m[1][1] * _m[2][0]);
+        }
+
+        /// @brief The inverse of this matrix.
+        ///
+        /// The inverse is found using _Gauss-Jordan elimination_, in which elementary
+        /// row operations are successively applied to the matrix until it is
+        /// transformed into the identity matrix. A matrix has an inverse if and only
+        /// if its determinant is not zero.
+        ///
+        /// @return The inverse of this matrix as a new Matrix3T.
+        /// @throw const char* If the matrix is singular; prefer try_inverse()
+        /// where singular matrices are expected.
+        constexpr Matrix3T inverse() const
+        {
+            const std::optional<Matrix3T> m = MATH3D_INSTRUMENT_CALL(Instrument::Operation::Matrix3Inverse, try_inverse());
+
+            if (!m)
+            {
+                MATH3D_THROW("The determinant of the matrix is zero.");
+            }
+
+            return *m;
+        }
+
+        /// @brief The inverse of this matrix, if it has one.
+        ///
+        /// Computes the same result as inverse(), but reports a singular matrix
+        /// through its return value instead of throwing, so it can be used in
+        /// inner loops and in builds without exceptions.
+        ///
+        /// @return The inverse of this matrix, or an empty optional if its
+        /// determinant is zero.
+        constexpr std::optional<Matrix3T> try_inverse() const
+        {
+            const Vector3T<T> a = (*this)[0];
+            const Vector3T<T> b = (*this)[1];
+            const Vector3T<T> c = (*this)[2];
+
+            Vector3T<T> u = Vector3T<T>::cross(b, c);
+            Vector3T<T> v = Vector3T<T>::cross(c, a);
+            Vector3T<T> w = Vector3T<T>::cross(a, b);
+
+            T det = Vector3T<T>::dot(w, c);
+
+            if (is_almost_equal(det, T(0), T(0.000001)))
+            {
+                MATH3D_INSTRUMENT_COUNT(Instrument::Operation::Matrix3InverseFailure, 1);
+                return std::nullopt;
+            }
+
+            T inv_det = T(1) / det;
+
+            u *= inv_det;
+            v *= inv_det;
+            w *= inv_det;
+
+            return Matrix3T(u.x, u.y, u.z, v.x, v.y, v.z, w.x, w.y, w.z);
+        }
+
+        /// @brief Returns the transpose of this matrix.
+        /// @return The transpose of this matrix as a new Matrix3T.
+        constexpr Matrix3T transposed() const
+        {
+            Matrix3T m = *this;
+            Matrix3T::transpose(m);
+            return m;
+        }
+
+        /// @brief The eigendecomposition of this matrix, which must be
+        /// symmetric; only its upper triangle is read.
+        ///
+        /// Uses the cyclic Jacobi method: every rotation zeroes one
+        /// off-diagonal element, and sweeps over the three of them repeat
+        /// until they are negligible against the diagonal, which takes at
+        /// most four sweeps in single precision. Jacobi is accurate even for
+        /// repeated or nearly repeated eigenvalues, where the analytic cubic
+        /// solutions lose their eigenvectors. The matrix is scaled by its
+        /// largest element first, so that no intermediate overflows.
+        ///
+        /// @return The eigenvalues, in increasing order, and their
+        /// eigenvectors.
+        SymmetricEigenT<T> symmetric_eigen() const
+        {
+            T a[3][3] = {
+                { _m[0][0], _m[0][1], _m[0][2] },
+                { _m[0][1], _m[1][1], _m[1][2] },
+                { _m[0][2], _m[1][2], _m[2][2] } };
+            T v[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+
+            T largest = 0;
+            for (int i = 0; i < 3; ++i)
+            {
+                for (int j = i; j < 3; ++j)
+                    largest = std::fmax(largest, std::fabs(a[i][j]));
+            }
+
+            const T scale = largest > 0 ? largest : T(1);
+            for (int i = 0; i < 3; ++i)
+            {
+                for (int j = 0; j < 3; ++j)
+                    a[i][j] /= scale;
+            }
+
+            const T epsilon = std::numeric_limits<T>::epsilon();
+
+            for (int sweep = 0; sweep < 16; ++sweep)
+            {
+                const T off = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+                const T diagonal = a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2];
+
+                if (off <= epsilon * epsilon * diagonal || off == 0)
+                    break;
+
+                jacobi_rotate(a, v, 0, 1);
+                jacobi_rotate(a, v, 0, 2);
+                jacobi_rotate(a, v, 1, 2);
+            }
+
+            // Sort the eigenpairs, the eigenvectors being the columns of v.
+            T values[3] = { a[0][0] * scale, a[1][1] * scale, a[2][2] * scale };
+            int order[3] = { 0, 1, 2 };
+
+            for (int i = 0; i < 2; ++i)
+            {
+                for (int j = 0; j < 2 - i; ++j)
+                {
+                    if (values[order[j + 1]] < values[order[j]])
+                    {
+                        const int k = order[j];
+                        order[j] = order[j + 1];
+                        order[j + 1] = k;
+                    }
+                }
+            }
+
+            SymmetricEigenT<T> e;
+            e.values = Vector3T<T>(values[order[0]], values[order[1]], values[order[2]]);
+
+            for (int i = 0; i < 3; ++i)
+                e.vectors[i] = Vector3T<T>(v[0][order[i]], v[1][order[i]], v[2][order[i]]);
+
+            return e;
+        }
+
+        /// @brief The singular value decomposition of this matrix,
+        /// M = U diag(s) V^T.
+        ///
+        /// U and V are rotations, with a determinant of one, and the singular
+        /// values s are sorted by decreasing magnitude; when the matrix
+        /// reflects, the last one is negative rather than U or V being a
+        /// reflection, which is the form deformation solvers expect.
+        ///
+        /// V holds the eigenvectors of M^T M, from symmetric_eigen(). The
+        /// columns of M V are orthogonal; Givens rotations turn them into U,
+        /// and what is left on the diagonal are the singular values. Unlike
+        /// the square roots of the eigenvalues of M^T M, these stay accurate
+        /// for small singular values.
+        ///
+        /// @return The rotations U and V, and the singular values.
+        SvdT<T> svd() const
+        {
+            T largest = 0;
+            for (int i = 0; i < 3; ++i)
+            {
+                for (int j = 0; j < 3; ++j)
+                    largest = std::fmax(largest, std::fabs(_m[i][j]));
+            }
+
+            // Scaled, so that M^T M neither overflows nor underflows.
+            const T scale = largest > 0 ? largest : T(1);
+            Matrix3T a;
+            for (int i = 0; i < 3; ++i)
+            {
+                for (int j = 0; j < 3; ++j)
+                    a._m[i][j] = _m[i][j] / scale;
+            }
+
+            // The eigenvectors by decreasing eigenvalue; flipping the last one
+            // if needed makes V a rotation.
+            const SymmetricEigenT<T> e = (a.transposed() * a).symmetric_eigen();
+            const Vector3T<T> v2 = Vector3T<T>::cross(e.vectors[2], e.vectors[1]);
+            const Matrix3T v(e.vectors[2], e.vectors[1], Vector3T<T>::dot(v2, e.vectors[0]) < 0 ? -e.vectors[0] : e.vectors[0]);
+
+            const Matrix3T av = a * v;
+            T b[3][3], u[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+            for (int i = 0; i < 3; ++i)
+            {
+                for (int j = 0; j < 3; ++j)
+                    b[i][j] = av._m[i][j];
+            }
+
+            givens_rotate(b, u, 0, 1, 0);
+            givens_rotate(b, u, 0, 2, 0);
+            givens_rotate(b, u, 1, 2, 1);
+
+            SvdT<T> d;
+            d.u = Matrix3T(u[0][0], u[0][1], u[0][2], u[1][0], u[1][1], u[1][2], u[2][0], u[2][1], u[2][2]);
+            d.singular_values = Vector3T<T>(b[0][0] * scale, b[1][1] * scale, b[2][2] * scale);
+            d.v = v;
+            return d;
+        }
+
+        /// @brief The polar decomposition of this matrix, M = R S, into a
+        /// rotation and a symmetric stretch.
+        ///
+        /// R is the rotation closest to M, the one shape matching and
+        /// corotated solvers extract. It is a rotation even when M reflects,
+        /// in which case S has a negative eigenvalue. Both come from svd():
+        /// R = U V^T and S = V diag(s) V^T.
+        ///
+        /// @return The rotation and the stretch.
+        PolarDecompositionT<T> polar() const
+        {
+            const SvdT<T> d = svd();
+            const Vector3T<T>& s = d.singular_values;
+            const Matrix3T vt = d.v.transposed();
+
+            PolarDecompositionT<T> p;
+            p.rotation = d.u * vt;
+            p.stretch = d.v * Matrix3T(s.x, 0, 0, 0, s.y, 0, 0, 0, s.z) * vt;
+            return p;
+        }
+
+        /// @brief The rotation closest to this matrix, which must already be
+        /// nearly one, such as a rotation that drifted through many products.
+        ///
+        /// Runs the Newton-Schulz iteration X' = X (3 I - X^T X) / 2, which
+        /// needs no division and squares the distance to orthogonality at
+        /// every step; it converges as long as that distance is below one,
+        /// far more drift than rounding ever causes. The result is the same
+        /// rotation as polar() gives, at a fraction of the cost, and unlike
+        /// Gram-Schmidt it does not favour any axis.
+        ///
+        /// @return The orthonormalized matrix.
+        constexpr Matrix3T orthonormalized() const
+        {
+            const T epsilon = std::numeric_limits<T>::epsilon();
+            Matrix3T x = *this;
+
+            for (int step = 0; step < 8; ++step)
+            {
+                const Matrix3T p = x.transposed() * x;
+                Matrix3T q = identity();
+                T error = 0;
+
+                for (int i = 0; i < 3; ++i)
+                {
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        const T e = p._m[i][j] - q._m[i][j];
+                        error = e > error ? e : (-e > error ? -e : error);
+                        q._m[i][j] -= e / 2;
+                    }
+                }
+
+                if (error <= epsilon)
+                    break;
+
+                x = x * q;
+            }
+
+            return x;
+        }
+
+        // Bulk eigendecompositions.
+        static void symmetric_eigen(const Matrix3T*, SymmetricEigenT<T>*, std::size_t);
+
+        // Bulk decompositions.
+        static void svd(const Matrix3T*, SvdT<T>*, std::size_t);
+        static void polar(const Matrix3T*, PolarDecompositionT<T>*, std::size_t);
+        static void orthonormalize(Matrix3T*, std::size_t);
+
+        // Bulk transforms.
+        void transform(const Vector3T<T>*, Vector3T<T>*, std::size_t) const;
+        void transform(Vector3T<T>*, std::size_t) const;
+        void transform(const Vector3Batch&, Vector3Batch&) const;
+        void transform(Vector3Batch&) const;
 
         // () overloads.
-        float& operator()(int, int);
-        const float& operator()(int, int) const;
+
+        /// @brief Overload for the parenthesis operator.
+        ///
+        /// The indices are only checked when MATH3D_CHECKED is 1, as in debug
+        /// builds; otherwise an index out of range is undefined behavior, and
+        /// the access compiles to a plain load or store. Use at() for indices
+        /// that are not known to be valid.
+        constexpr T& operator()(int row, int col)
+        {
+            if (MATH3D_CHECKED && (!is_in_range(row) || !is_in_range(col)))
+            {
+                MATH3D_THROW(std::out_of_range("Index out of range."));
+            }
+
+            return _m[row][col];
+        }
+
+        /// @brief Overload for the parenthesis operator.
+        constexpr const T& operator()(int row, int col) const
+        {
+            if (MATH3D_CHECKED && (!is_in_range(row) || !is_in_range(col)))
+            {
+                MATH3D_THROW(std::out_of_range("Index out of range."));
+            }
+
+            return _m[row][col];
+        }
 
         // [] overloads.
-        Vector3 operator[](int);
-        const Vector3 operator[](int) const;
+
+        /// @brief Overload for the brackets operator.
+        constexpr Vector3T<T> operator[](int col)
+        {
+            return Vector3T<T>(_m[0][col], _m[1][col], _m[2][col]);
+        }
+
+        /// @brief Overload for the brackets operator.
+        constexpr const Vector3T<T> operator[](int col) const
+        {
+            return Vector3T<T>(_m[0][col], _m[1][col], _m[2][col]);
+        }
 
         // Arithmetic operators overloads.
-        Matrix3 operator+(const Matrix3&) const;
-        Matrix3 operator-(const Matrix3&) const;
-        Matrix3 operator*(const Matrix3&) const;
-        Vector3 operator*(const Vector3&) const;
+
+        /// @brief Overload for the addition operator.
+        constexpr Matrix3T operator+(const Matrix3T& other) const
+        {
+            return Matrix3T(*this) += other;
+        }
+
+        /// @brief Overload for the subtraction operator.
+        constexpr Matrix3T operator-(const Matrix3T& other) const
+        {
+            return Matrix3T(*this) -= other;
+        }
+
+        /// @brief Overload for the multiplication operator.
+        constexpr Matrix3T operator*(const Matrix3T& other) const
+        {
+            return MATH3D_INSTRUMENT_CALL(Instrument::Operation::Matrix3MultiplyMatrix, Matrix3T(
+                _m[0][0] * other._m[0][0] + _m[0][1] * other._m[1][0] + _m[0][2] * other._m[2][0],
+                _m[0][0] * other._m[0][1] + _m[0][1] * other._m[1][1] + _m[0][2] * other._m[2][1],
+                _m[0][0] * other._m[0][2] + _m[0][1] * other._m[1][2] + _m[0][2] * other._m[2][2],
+                _m[1][0] * other._m[0][0] + _m[1][1] * other._m[1][0] + _m[1][2] * other._m[2][0],
+                _m[1][0] * other._m[0][1] + _m[1][1] * other._m[1][1] + _m[1][2] * other._m[2][1],
+                _m[1][0] * other._m[0][2] + _m[1][1] * other._m[1][2] + _m[1][2] * other._m[2][2],
+                _m[2][0] * other._m[0][0] + _m[2][1] * other._m[1][0] + _m[2][2] * other._m[2][0],
+                _m[2][0] * other._m[0][1] + _m[2][1] * other._m[1][1] + _m[2][2] * other._m[2][1],
+                _m[2][0] * other._m[0][2] + _m[2][1] * other._m[1][2] + _m[2][2] * other._m[2][2]
+            ));
+        }
+
+        /// @brief Overload for the multiplication operator.
+        constexpr Vector3T<T> operator*(const Vector3T<T>& v) const
+        {
+            return MATH3D_INSTRUMENT_CALL(Instrument::Operation::Matrix3MultiplyVector, Vector3T<T>(
+                _m[0][0] * v.x + _m[0][1] * v.y + _m[0][2] * v.z,
+                _m[1][0] * v.x + _m[1][1] * v.y + _m[1][2] * v.z,
+                _m[2][0] * v.x + _m[2][1] * v.y + _m[2][2] * v.z
+            ));
+        }
 
         // Compound assignment operators overloads.
-        Matrix3& operator+=(const Matrix3&);
-        Matrix3& operator-=(const Matrix3&);
 
-        // Assignment operator overload.
-        Matrix3& operator=(const Matrix3&);
+        /// @brief Overload for the addition-assignment operator.
+        constexpr Matrix3T& operator+=(const Matrix3T& other)
+        {
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    _m[i][j] += other._m[i][j];
+
+            return *this;
+        }
+
+        /// @brief Overload for the subtraction-assignment operator.
+        constexpr Matrix3T& operator-=(const Matrix3T& other)
+        {
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    _m[i][j] -= other._m[i][j];
+
+            return *this;
+        }
 
         // Comparison operators overloads.
-        bool operator==(const Matrix3&) const;
 
-        // to_string() overload.
-        std::ostream& to_string(std::ostream& os) const override;
+        /// @brief Overload for the equality comparison operator.
+        constexpr bool operator==(const Matrix3T& other) const
+        {
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    if (!is_almost_equal(_m[i][j], other._m[i][j]))
+                        return false;
+
+            return true;
+        }
 
     private:
-        bool is_in_range(int index) const;
+        // Determines if the given index is within range.
+        static constexpr bool is_in_range(int index)
+        {
+            return 0 <= index && index < 3;
+        }
+
+        // Applies the Jacobi rotation zeroing a[p][q] to the symmetric matrix
+        // a, and accumulates it into the columns of v. The tangent of the
+        // rotation angle is the smaller root of t^2 + 2 theta t - 1 = 0, with
+        // theta = (a[q][q] - a[p][p]) / (2 a[p][q]), written without the
+        // division by a[p][q] so that a zero element gives t = 0.
+        static void jacobi_rotate(T (&a)[3][3], T (&v)[3][3], int p, int q)
+        {
+            const int r = 3 - p - q;
+            const T apq = a[p][q];
+            const T d = a[q][q] - a[p][p];
+            const T denominator = std::fabs(d) + std::sqrt(d * d + 4 * apq * apq);
+            const T t = (d < 0 ? -2 * apq : 2 * apq) / (denominator > 0 ? denominator : T(1));
+            const T c = 1 / std::sqrt(1 + t * t);
+            const T s = t * c;
+
+            a[p][p] -= t * apq;
+            a[q][q] += t * apq;
+            a[p][q] = a[q][p] = 0;
+
+            const T arp = a[r][p], arq = a[r][q];
+            a[r][p] = a[p][r] = c * arp - s * arq;
+            a[r][q] = a[q][r] = s * arp + c * arq;
+
+            for (int k = 0; k < 3; ++k)
+            {
+                const T vkp = v[k][p], vkq = v[k][q];
+                v[k][p] = c * vkp - s * vkq;
+                v[k][q] = s * vkp + c * vkq;
+            }
+        }
+
+        // Applies the Givens rotation zeroing b[q][col] against b[p][col] to
+        // the rows of b, and accumulates its transpose into the columns of u,
+        // so that the product of u and b is unchanged. A zero pair is left
+        // alone.
+        static void givens_rotate(T (&b)[3][3], T (&u)[3][3], int p, int q, int col)
+        {
+            const T x = b[p][col], y = b[q][col];
+            const T r = std::sqrt(x * x + y * y);
+            const T c = r > 0 ? x / r : T(1);
+            const T s = r > 0 ? y / r : T(0);
+
+            for (int k = 0; k < 3; ++k)
+            {
+                const T bpk = b[p][k], bqk = b[q][k];
+                b[p][k] = c * bpk + s * bqk;
+                b[q][k] = c * bqk - s * bpk;
+
+                const T ukp = u[k][p], ukq = u[k][q];
+                u[k][p] = c * ukp + s * ukq;
+                u[k][q] = c * ukq - s * ukp;
+            }
+        }
     };
-}
\ No newline at end of file
+
+    /// @brief The single precision matrix used throughout the library.
+    typedef Matrix3T<float> Matrix3;
+    /// @brief The double precision matrix.
+    typedef Matrix3T<double> Matrix3d;
+
+    /// @brief The singular value decomposition of a matrix, M = U diag(s) V^T.
+    template <typename T>
+    struct SvdT
+    {
+        /// @brief The left singular vectors, as the columns of a rotation.
+        Matrix3T<T> u;
+
+        /// @brief The singular values s, by decreasing magnitude; only the
+        /// last one can be negative, when the matrix reflects.
+        Vector3T<T> singular_values;
+
+        /// @brief The right singular vectors, as the columns of a rotation.
+        Matrix3T<T> v;
+    };
+
+    typedef SvdT<float> Svd;
+    typedef SvdT<double> Svdd;
+
+    /// @brief The polar decomposition of a matrix, M = R S.
+    template <typename T>
+    struct PolarDecompositionT
+    {
+        /// @brief The rotation R closest to the matrix.
+        Matrix3T<T> rotation;
+
+        /// @brief The symmetric stretch S, applied before the rotation.
+        Matrix3T<T> stretch;
+    };
+
+    typedef PolarDecompositionT<float> PolarDecomposition;
+    typedef PolarDecompositionT<double> PolarDecompositiond;
+
+    /// @brief Multiplies an array of vectors by this matrix.
+    /// @param in The array of vectors to transform.
+    /// @param out The array receiving the transformed vectors; it may be the
+    /// same array as @p in.
+    /// @param count The number of vectors in both arrays.
+    template <typename T>
+    void Matrix3T<T>::transform(const Vector3T<T>* in, Vector3T<T>* out, std::size_t count) const
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = *this * in[i];
+    }
+
+    /// @brief Multiplies an array of vectors by this matrix, in place.
+    template <typename T>
+    void Matrix3T<T>::transform(Vector3T<T>* vectors, std::size_t count) const
+    {
+        transform(vectors, vectors, count);
+    }
+
+    /// @brief Multiplies every vector in a batch by this matrix; batches hold
+    /// single precision vectors, so only Matrix3 defines it.
+    template <typename T>
+    void Matrix3T<T>::transform(const Vector3Batch&, Vector3Batch&) const
+    {
+        static_assert(std::is_same<T, float>::value, "Vector3Batch holds single precision vectors.");
+    }
+
+    /// @brief Multiplies every vector in a batch by this matrix, in place.
+    template <typename T>
+    void Matrix3T<T>::transform(Vector3Batch&) const
+    {
+        static_assert(std::is_same<T, float>::value, "Vector3Batch holds single precision vectors.");
+    }
+
+    /// @brief Computes the eigendecomposition of every matrix in an array of
+    /// symmetric matrices; see symmetric_eigen().
+    /// @param in The array of matrices.
+    /// @param out The array receiving the eigendecompositions.
+    /// @param count The number of elements in both arrays.
+    template <typename T>
+    void Matrix3T<T>::symmetric_eigen(const Matrix3T* in, SymmetricEigenT<T>* out, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = in[i].symmetric_eigen();
+    }
+
+    /// @brief Computes the singular value decomposition of every matrix in an
+    /// array; see svd().
+    /// @param in The array of matrices.
+    /// @param out The array receiving the decompositions.
+    /// @param count The number of elements in both arrays.
+    template <typename T>
+    void Matrix3T<T>::svd(const Matrix3T* in, SvdT<T>* out, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = in[i].svd();
+    }
+
+    /// @brief Computes the polar decomposition of every matrix in an array;
+    /// see polar().
+    /// @param in The array of matrices.
+    /// @param out The array receiving the decompositions.
+    /// @param count The number of elements in both arrays.
+    template <typename T>
+    void Matrix3T<T>::polar(const Matrix3T* in, PolarDecompositionT<T>* out, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = in[i].polar();
+    }
+
+    /// @brief Orthonormalizes every matrix in an array of nearly orthonormal
+    /// matrices, in place; see orthonormalized().
+    /// @param matrices The array of matrices.
+    /// @param count The number of matrices.
+    template <typename T>
+    void Matrix3T<T>::orthonormalize(Matrix3T* matrices, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            matrices[i] = matrices[i].orthonormalized();
+    }
+
+    // Vectorized in the library.
+    template <> void Matrix3::symmetric_eigen(const Matrix3*, SymmetricEigen*, std::size_t);
+    template <> void Matrix3::svd(const Matrix3*, Svd*, std::size_t);
+    template <> void Matrix3::polar(const Matrix3*, PolarDecomposition*, std::size_t);
+    template <> void Matrix3::orthonormalize(Matrix3*, std::size_t);
+    template <> void Matrix3::transform(const Vector3*, Vector3*, std::size_t) const;
+    template <> void Matrix3::transform(Vector3*, std::size_t) const;
+    template <> void Matrix3::transform(const Vector3Batch&, Vector3Batch&) const;
+    template <> void Matrix3::transform(Vector3Batch&) const;
+
+    static_assert(sizeof(Matrix3) == 9 * sizeof(float),
+        "Matrix3 must be exactly nine packed floats.");
+    static_assert(sizeof(Matrix3d) == 9 * sizeof(double),
+        "Matrix3d must be exactly nine packed doubles.");
+    static_assert(std::is_standard_layout<Matrix3>::value && std::is_standard_layout<Matrix3d>::value,
+        "Matrix3T must be a standard-layout type.");
+    static_assert(std::is_trivially_copyable<Matrix3>::value && std::is_trivially_copyable<Matrix3d>::value,
+        "Matrix3T must be trivially copyable.");
+
+    // Printing.
+
+    /// @brief Writes a textual representation of a matrix to a stream.
+    ///
+    /// Rows end with a plain newline rather than std::endl, so that writing
+    /// many matrices does not flush the stream after every row.
+    template <typename T>
+    inline std::ostream& to_string(std::ostream& os, const Matrix3T<T>& m)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            os << '|';
+
+            for (int j = 0; j < 3; ++j)
+                os << ' ' << std::fixed << std::setw(3) << m(i, j);
+
+            os << " |\n";
+        }
+
+        return os;
+    }
+
+    /// @brief Override for the output stream insertion operator.
+    template <typename T>
+    inline std::ostream& operator<<(std::ostream& os, const Matrix3T<T>& m)
+    {
+        return to_string(os, m);
+    }
+}
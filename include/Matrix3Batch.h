@@ -0,0 +1,131 @@
+/// @file Matrix3Batch.h
+/// @brief This header file contains the declaration of the Matrix3Batch class.
+/// @author David Moncada
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Matrix3.h"
+#include "Memory.h"
+#include "Vector3Batch.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @class Matrix3Batch
+    /// @brief The Matrix3Batch class declaration.
+    ///
+    /// A structure-of-arrays container of matrices: element (row, col) of every
+    /// matrix lives in its own contiguous array, m[row][col], giving nine lanes
+    /// in total. With this layout, the bulk helpers below work on 8 or 16
+    /// matrices per SIMD instruction, depending on the vector width.
+    ///
+    /// Unlike Matrix3::inverse(), the bulk inverse never throws: singular
+    /// matrices are reported through an output mask, so one bad matrix does not
+    /// abort the rest of the batch.
+    ///
+    /// Like those of Vector3Batch, the lanes start on simd_alignment
+    /// boundaries and keep their capacity when the batch shrinks.
+    class Matrix3Batch
+    {
+    public:
+        AlignedVector<float> m[3][3];
+
+        /// @brief Computes the determinant of every matrix.
+        /// @param in The Matrix3Batch to evaluate.
+        /// @param out The array receiving the determinants; it must hold at
+        /// least in.size() floats.
+        static void determinant(const Matrix3Batch& in, float* out);
+
+        /// @brief Computes the inverse of every matrix.
+        ///
+        /// A matrix is singular when its determinant is within 1e-6 of zero,
+        /// the same threshold used by Matrix3::inverse(). The inverse of a
+        /// singular matrix is reported as the zero matrix.
+        ///
+        /// @param in The Matrix3Batch to invert.
+        /// @param out The Matrix3Batch receiving the inverses; it is resized to
+        /// match the input, and may be the input itself.
+        /// @param singular An optional array of at least in.size() bytes; each
+        /// entry is set to one if the matching matrix is singular, and to zero
+        /// otherwise.
+        /// @return The number of singular matrices in the batch.
+        static std::size_t inverse(const Matrix3Batch& in, Matrix3Batch& out, unsigned char* singular = nullptr);
+
+        /// @brief Computes the eigendecomposition of every matrix, which must
+        /// be symmetric; only the upper triangles are read.
+        ///
+        /// Runs the Jacobi method of Matrix3::symmetric_eigen() with a fixed
+        /// number of sweeps, one matrix per SIMD lane: 8 matrices per
+        /// iteration with AVX2, 16 with AVX-512.
+        ///
+        /// @param in The Matrix3Batch to decompose.
+        /// @param values The Vector3Batch receiving the eigenvalues of every
+        /// matrix, in increasing order; it is resized to match the input.
+        /// @param vectors The Vector3Batches receiving the unit eigenvectors,
+        /// vectors[i] belonging to the i-th eigenvalue; they are resized to
+        /// match the input.
+        static void symmetric_eigen(const Matrix3Batch& in, Vector3Batch& values, Vector3Batch (&vectors)[3]);
+
+        /// @brief Computes the singular value decomposition of every matrix;
+        /// see Matrix3::svd().
+        ///
+        /// Runs with a fixed number of Jacobi sweeps and no branches, one
+        /// matrix per SIMD lane, so every batch of a given size takes the
+        /// same time whatever its contents.
+        ///
+        /// The outputs are resized to match the input, and the rotations may
+        /// be written over the input itself, but not over each other.
+        ///
+        /// @param in The Matrix3Batch to decompose.
+        /// @param u The Matrix3Batch receiving the left rotations.
+        /// @param s The Vector3Batch receiving the singular values, by
+        /// decreasing magnitude.
+        /// @param v The Matrix3Batch receiving the right rotations.
+        /// @throw std::invalid_argument If @p u and @p v are the same batch.
+        static void svd(const Matrix3Batch& in, Matrix3Batch& u, Vector3Batch& s, Matrix3Batch& v);
+
+        /// @brief Computes the polar decomposition of every matrix; see
+        /// Matrix3::polar().
+        ///
+        /// Runs the kernel of svd() and composes the factors in registers. The
+        /// outputs are resized to match the input, and either may be the
+        /// input itself, but not the other output.
+        ///
+        /// @param in The Matrix3Batch to decompose.
+        /// @param rotation The Matrix3Batch receiving the rotations.
+        /// @param stretch The Matrix3Batch receiving the symmetric stretches.
+        /// @throw std::invalid_argument If @p rotation and @p stretch are the
+        /// same batch.
+        static void polar(const Matrix3Batch& in, Matrix3Batch& rotation, Matrix3Batch& stretch);
+
+        /// @brief Orthonormalizes every matrix in place; see
+        /// Matrix3::orthonormalized().
+        ///
+        /// Runs a fixed three Newton-Schulz steps, enough for the drift that
+        /// rotations accumulate through many products.
+        ///
+        /// @param matrices The Matrix3Batch of nearly orthonormal matrices.
+        static void orthonormalize(Matrix3Batch& matrices);
+
+        // Constructors.
+        Matrix3Batch() = default;
+        explicit Matrix3Batch(std::size_t);
+        explicit Matrix3Batch(const std::vector<Matrix3>&);
+
+        // Member functions.
+        void clear();
+        bool empty() const;
+        void push_back(const Matrix3&);
+        void reserve(std::size_t);
+        void resize(std::size_t);
+        void set(std::size_t, const Matrix3&);
+        std::size_t size() const;
+        std::vector<Matrix3> to_vector() const;
+
+        // [] overloads.
+        Matrix3 operator[](std::size_t) const;
+    };
+}
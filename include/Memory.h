@@ -0,0 +1,217 @@
+/// @file Memory.h
+/// @brief This header file contains the aligned allocator, the Arena class and
+/// the allocation counters of the library.
+/// @author David Moncada
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @brief The alignment of the buffers the library allocates: a cache
+    /// line, and the width of an AVX-512 register, so that no SIMD load of a
+    /// buffer ever straddles two lines.
+    const std::size_t simd_alignment = 64;
+
+    /// @brief The counters of the memory the library allocates from the
+    /// system, through aligned_allocate() or the pages of an Arena.
+    ///
+    /// Allocations carved out of an existing Arena block are not counted, so
+    /// a frame loop that only uses arenas and reuses its buffers should see
+    /// allocations stay constant once it reaches a steady state.
+    ///
+    /// The bulk operations on batches and arrays, Matrix3Batch included, the
+    /// Parallel operations and reductions, and Pipeline::run() allocate
+    /// nothing once their outputs are sized, so such a frame makes no other
+    /// allocation either. A few APIs do use the ordinary heap, which these
+    /// counters do not see: functions returning a std::vector, the
+    /// SpatialGrid cell table and queries, TransformHierarchy::update() after
+    /// nodes were added or reparented, the text and file readers, the
+    /// Instrument registry, and the creation of the Parallel thread pool.
+    struct MemoryStats
+    {
+        /// @brief The number of allocations made.
+        std::size_t allocations = 0;
+        /// @brief The number of allocations released.
+        std::size_t deallocations = 0;
+        /// @brief The number of bytes allocated and not yet released.
+        std::size_t bytes_in_use = 0;
+    };
+
+    // Counters.
+    MemoryStats memory_stats();
+    void reset_memory_stats();
+
+    // Aligned allocation.
+    void* aligned_allocate(std::size_t, std::size_t = simd_alignment);
+    void aligned_deallocate(void*, std::size_t, std::size_t = simd_alignment);
+
+    /// @class AlignedAllocator
+    /// @brief The AlignedAllocator class template declaration.
+    ///
+    /// A standard allocator returning storage aligned to @p Alignment bytes,
+    /// and counted in memory_stats().
+    template <typename T, std::size_t Alignment = simd_alignment>
+    class AlignedAllocator
+    {
+        static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0,
+            "The alignment must be a power of two no smaller than the type's.");
+
+    public:
+        typedef T value_type;
+
+        template <typename U>
+        struct rebind
+        {
+            typedef AlignedAllocator<U, Alignment> other;
+        };
+
+        // Constructors.
+        AlignedAllocator() = default;
+
+        template <typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+        // Member functions.
+        T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(aligned_allocate(n * sizeof(T), Alignment));
+        }
+
+        void deallocate(T* p, std::size_t n)
+        {
+            aligned_deallocate(p, n * sizeof(T), Alignment);
+        }
+
+        // Operators.
+        template <typename U>
+        bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+
+        template <typename U>
+        bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+    };
+
+    /// @brief A std::vector whose elements start on a simd_alignment boundary.
+    template <typename T>
+    using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+    /// @brief The pages an Arena is backed by.
+    enum class PageSize
+    {
+        /// @brief Ordinary pages from the heap.
+        Default,
+        /// @brief Huge pages, which save TLB misses on arenas of megabytes.
+        /// Explicit huge pages are used when the system has them reserved,
+        /// transparent huge pages are requested otherwise, and the arena falls
+        /// back to ordinary pages when neither is available.
+        Huge
+    };
+
+    /// @class Arena
+    /// @brief The Arena class declaration.
+    ///
+    /// A bump allocator for scratch buffers that live for one frame, or one
+    /// task: allocations are carved out of a block in order, nothing is freed
+    /// individually, and reset() releases everything at once in constant
+    /// time. Every allocation is aligned to at least simd_alignment.
+    ///
+    /// An arena that runs out of room chains another block, twice as large,
+    /// and the next reset() merges the chain into one block holding them all;
+    /// from then on, frames that allocate no more than before never touch the
+    /// system allocator again.
+    ///
+    /// An arena is not thread-safe; every thread should use its own, such as
+    /// the one returned by Arena::local().
+    class Arena
+    {
+    private:
+        struct Block;
+
+        Block* _block = nullptr;
+        std::size_t _offset = 0;
+        std::size_t _capacity = 0;
+        std::size_t _used = 0;
+        PageSize _pages;
+
+        Block* new_block(std::size_t, Block*);
+        void release();
+
+    public:
+        /// @brief The capacity of the first block of an arena created without
+        /// one.
+        static const std::size_t default_capacity = 64 * 1024;
+
+        // Constructors and destructor.
+        explicit Arena(std::size_t capacity = 0, PageSize pages = PageSize::Default);
+        ~Arena();
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        // Static functions.
+        static Arena& local();
+
+        // Member functions.
+        void* allocate(std::size_t, std::size_t = simd_alignment);
+        std::size_t capacity() const;
+        bool huge_pages() const;
+        void reset();
+        std::size_t used() const;
+
+        /// @brief Allocates an uninitialized array.
+        /// @param count The number of elements.
+        /// @return The first element, aligned to simd_alignment.
+        template <typename T>
+        T* allocate(std::size_t count)
+        {
+            static_assert(std::is_trivially_destructible<T>::value,
+                "Arena memory is released without running destructors.");
+            static_assert(alignof(T) <= simd_alignment,
+                "The type needs more than simd_alignment.");
+
+            return static_cast<T*>(allocate(count * sizeof(T), simd_alignment));
+        }
+    };
+
+    /// @class ArenaAllocator
+    /// @brief The ArenaAllocator class template declaration.
+    ///
+    /// A standard allocator carving its storage out of an Arena, so that
+    /// standard containers can be used as per-frame scratch; deallocation does
+    /// nothing, and the container must not outlive the arena's next reset().
+    template <typename T>
+    class ArenaAllocator
+    {
+    public:
+        typedef T value_type;
+
+        /// @brief The arena the storage comes from.
+        Arena* arena;
+
+        // Constructors.
+        explicit ArenaAllocator(Arena& a) : arena(&a) {}
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+        // Member functions.
+        T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T) > simd_alignment ? alignof(T) : simd_alignment));
+        }
+
+        void deallocate(T*, std::size_t) {}
+
+        // Operators.
+        template <typename U>
+        bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+
+        template <typename U>
+        bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+    };
+}
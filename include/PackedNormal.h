@@ -0,0 +1,126 @@
+/// @file PackedNormal.h
+/// @brief This header file contains the declaration of the PackedNormalT
+/// class template and its PackedNormal16 and PackedNormal32 instantiations.
+/// @author David Moncada
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "Vector3.h"
+#include "Vector3Batch.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @class PackedNormalT
+    /// @brief The PackedNormalT class template declaration.
+    ///
+    /// A unit vector compressed with the octahedral encoding: the vector is
+    /// projected onto the octahedron |x| + |y| + |z| = 1, the lower half of
+    /// the octahedron is folded over the upper one, and the two remaining
+    /// coordinates, both in [-1,1], are stored as signed normalized integers
+    /// of type C. The encoding spreads its precision almost evenly over the
+    /// sphere, so the angular error is bounded by max_angle_error everywhere.
+    ///
+    /// Normals are stored in 2 or 4 bytes instead of the 12 of a Vector3.
+    /// Arrays are converted in bulk with encode() and decode(), and dot()
+    /// takes dot products straight from the encoded form, without writing the
+    /// decoded vectors back to memory. Encoding assumes a nonzero vector; its
+    /// length is ignored.
+    template <typename C>
+    class PackedNormalT
+    {
+        static_assert(std::is_same<C, std::int8_t>::value || std::is_same<C, std::int16_t>::value,
+            "PackedNormalT stores 8-bit or 16-bit coordinates.");
+
+    public:
+        typedef C component_type;
+
+        /// @brief The integer a coordinate of 1 is stored as.
+        static constexpr int scale = std::numeric_limits<C>::max();
+
+        /// @brief The largest angle, in degrees, between a unit vector and its
+        /// decoded encoding: 1 for PackedNormal16 and 0.004 for PackedNormal32.
+        ///
+        /// Rounding to the nearest coordinates is off by at most half a step
+        /// in each, which the sphere stretches most near the diagonals of the
+        /// folded half; sampling the sphere densely gives worst cases of 0.95
+        /// and 0.0037 degrees.
+        static constexpr float max_angle_error = sizeof(C) == 1 ? 1.0f : 0.004f;
+
+        /// @brief The octahedral coordinates.
+        C u = 0;
+        C v = 0;
+
+        // Bulk conversions.
+        static void encode(const Vector3*, PackedNormalT*, std::size_t);
+        static void encode(const Vector3Batch&, PackedNormalT*);
+        static void decode(const PackedNormalT*, Vector3*, std::size_t);
+        static void decode(const PackedNormalT*, std::size_t, Vector3Batch&);
+        static void dot(const PackedNormalT*, const Vector3&, float*, std::size_t);
+
+        // Constructors.
+        PackedNormalT() = default;
+
+        /// @brief Encodes a vector.
+        /// @param n The vector to encode; it must not be the zero vector.
+        explicit PackedNormalT(const Vector3& n)
+        {
+            const float inv_l1 = 1.0f / (std::fabs(n.x) + std::fabs(n.y) + std::fabs(n.z));
+            float px = n.x * inv_l1;
+            float py = n.y * inv_l1;
+
+            if (n.z < 0.0f)
+            {
+                const float fx = (1.0f - std::fabs(py)) * (px < 0.0f ? -1.0f : 1.0f);
+                const float fy = (1.0f - std::fabs(px)) * (py < 0.0f ? -1.0f : 1.0f);
+                px = fx;
+                py = fy;
+            }
+
+            // Round to nearest, ties away from zero, as the bulk kernels do.
+            const float ex = px * scale;
+            const float ey = py * scale;
+            u = static_cast<C>(static_cast<int>(ex + (ex < 0.0f ? -0.5f : 0.5f)));
+            v = static_cast<C>(static_cast<int>(ey + (ey < 0.0f ? -0.5f : 0.5f)));
+        }
+
+        // Conversion operators.
+
+        /// @brief Decodes this normal to a unit vector.
+        explicit operator Vector3() const
+        {
+            const float ex = static_cast<float>(u) / scale;
+            const float ey = static_cast<float>(v) / scale;
+            const float z = 1.0f - std::fabs(ex) - std::fabs(ey);
+            const float t = z < 0.0f ? -z : 0.0f;
+
+            return Vector3(ex + (ex < 0.0f ? t : -t), ey + (ey < 0.0f ? t : -t), z).normalized();
+        }
+
+        // Operators.
+        bool operator==(const PackedNormalT& other) const { return u == other.u && v == other.v; }
+        bool operator!=(const PackedNormalT& other) const { return !(*this == other); }
+    };
+
+    /// @brief A normal in two bytes, two 8-bit octahedral coordinates.
+    typedef PackedNormalT<std::int8_t> PackedNormal16;
+
+    /// @brief A normal in four bytes, two 16-bit octahedral coordinates.
+    typedef PackedNormalT<std::int16_t> PackedNormal32;
+
+    static_assert(sizeof(PackedNormal16) == 2,
+        "PackedNormal16 must be exactly two bytes.");
+    static_assert(sizeof(PackedNormal32) == 4,
+        "PackedNormal32 must be exactly four bytes.");
+    static_assert(std::is_trivially_copyable<PackedNormal16>::value && std::is_trivially_copyable<PackedNormal32>::value,
+        "PackedNormalT must be trivially copyable.");
+
+    extern template class PackedNormalT<std::int8_t>;
+    extern template class PackedNormalT<std::int16_t>;
+}
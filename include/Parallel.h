@@ -0,0 +1,180 @@
+/// @file Parallel.h
+/// @brief This header file contains the thread pool the bulk operations can
+/// be spread over, and the parallel versions of those operations.
+/// @author David Moncada
+
+#pragma once
+
+#include <cstddef>
+
+#include "AABB.h"
+#include "Matrix3.h"
+#include "Transform.h"
+#include "Vector3.h"
+#include "Vector3Batch.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Parallel
+    /// @brief Multithreaded execution of the bulk operations.
+    ///
+    /// Work is split into a grid of fixed-size chunks, which depends only on
+    /// the input size and never on the number of threads. The chunks are dealt
+    /// out to per-thread queues in contiguous runs; a thread that runs out of
+    /// work steals from the far end of another thread's queue, so uneven chunks
+    /// and busy cores are balanced without a central bottleneck.
+    ///
+    /// Element-wise operations produce exactly the same results as their serial
+    /// counterparts. Reductions combine one partial result per chunk, always
+    /// in chunk order, so their results do not depend on the thread count
+    /// either; in deterministic mode they do not depend on the CPU either.
+    namespace Parallel
+    {
+        /// @brief The number of bytes every chunk should touch; chunks this size
+        /// fit in the L2 cache of current x86 parts, alongside the stack and
+        /// the code.
+        const std::size_t chunk_bytes = 256 * 1024;
+
+        /// @brief The largest number of partial results a reduction holds at
+        /// once. They live on the stack of the calling thread; larger inputs
+        /// are reduced in passes of this many chunks.
+        const std::size_t reduction_chunks = 256;
+
+        /// @brief The signature of the function run for every chunk.
+        typedef void (*ChunkFunction)(void* context, std::size_t chunk);
+
+        /// @brief The number of threads parallel work is spread over.
+        ///
+        /// This includes the calling thread, which always takes part in the
+        /// work. By default it is the number of hardware threads, unless the
+        /// @c MATH3D_THREADS environment variable sets another count.
+        ///
+        /// @return The size of the pool.
+        unsigned thread_count();
+
+        /// @brief Resizes the pool.
+        ///
+        /// Must not be called while parallel work is running.
+        ///
+        /// @param count The number of threads, including the calling thread;
+        /// zero restores the default. One makes every operation serial.
+        void set_thread_count(unsigned count);
+
+        /// @brief The number of elements per chunk for an operation touching
+        /// the given number of bytes per element.
+        ///
+        /// The result is a multiple of 64 elements, so that chunk boundaries
+        /// never split a SIMD vector.
+        std::size_t grain_size(std::size_t bytes_per_element);
+
+        /// @brief Runs a function for every chunk index in [0,chunks), spread
+        /// over the pool, and waits for all of them to finish.
+        ///
+        /// Calls made from inside a chunk run serially on the calling thread.
+        /// If a chunk throws, the remaining chunks still run, and the first
+        /// exception is rethrown to the caller.
+        void run(std::size_t chunks, ChunkFunction function, void* context);
+
+        /// @brief Runs f(begin, end) over consecutive ranges covering [0,count).
+        /// @param count The number of elements.
+        /// @param grain The number of elements per range, except the last.
+        /// @param f The function to run for every range.
+        template <typename F>
+        void parallel_for(std::size_t count, std::size_t grain, F f)
+        {
+            struct Context
+            {
+                F* f;
+                std::size_t count;
+                std::size_t grain;
+            };
+
+            if (count == 0)
+                return;
+
+            Context context = { &f, count, grain };
+
+            run((count + grain - 1) / grain, [](void* p, std::size_t chunk) {
+                const Context& c = *static_cast<Context*>(p);
+                const std::size_t begin = chunk * c.grain;
+                const std::size_t end = c.count - begin < c.grain ? c.count : begin + c.grain;
+                (*c.f)(begin, end);
+            }, &context);
+        }
+
+        /// @brief Reduces consecutive ranges covering [0,count).
+        ///
+        /// Every range is mapped to a partial result, and the partial results
+        /// are then combined serially, in order, starting from @p identity.
+        /// No more than reduction_chunks partial results are held at a time,
+        /// on the stack, so @p T must be default-constructible, and the
+        /// reduction allocates nothing beyond what @p map and @p combine do.
+        ///
+        /// @param count The number of elements.
+        /// @param grain The number of elements per range, except the last.
+        /// @param identity The initial value of the reduction.
+        /// @param map The function computing the partial result of a range
+        /// [begin,end).
+        /// @param combine The function combining two partial results.
+        /// @return The combined result.
+        template <typename T, typename Map, typename Combine>
+        T parallel_reduce(std::size_t count, std::size_t grain, T identity, Map map, Combine combine)
+        {
+            const std::size_t pass = reduction_chunks * grain;
+            T partials[reduction_chunks];
+            T result = identity;
+
+            for (std::size_t first = 0; first < count; first += pass)
+            {
+                const std::size_t n = count - first < pass ? count - first : pass;
+
+                parallel_for(n, grain, [&](std::size_t begin, std::size_t end) {
+                    partials[begin / grain] = map(first + begin, first + end);
+                });
+
+                for (std::size_t chunk = 0; chunk < (n + grain - 1) / grain; ++chunk)
+                    result = combine(result, partials[chunk]);
+            }
+
+            return result;
+        }
+
+        /// @brief Whether the reductions are in deterministic mode.
+        ///
+        /// The reductions always return the same bits whatever the thread
+        /// count. By default they run the kernels of the active SIMD level,
+        /// though, whose vector widths and fused multiply-adds round
+        /// differently, so two machines can disagree in the last bits. In
+        /// deterministic mode they run the scalar reference kernels instead,
+        /// and return the same bits on every machine running the same build.
+        bool deterministic();
+        void set_deterministic(bool);
+
+        // Bulk operations.
+        void normalize(Vector3Batch&);
+        void transform(const Matrix3&, const Vector3Batch&, Vector3Batch&);
+        void transform(const Matrix3&, Vector3Batch&);
+        void transform_points(const Transform&, const Vector3Batch&, Vector3Batch&);
+        void transform_points(const Transform&, Vector3Batch&);
+
+        // Reductions.
+        //
+        // The sums are compensated: every chunk is summed in float with
+        // Kahan's algorithm, one accumulator per SIMD lane, and the chunks are
+        // then added pairwise in double, reduction_chunks at a time, so the
+        // error hardly grows with the number of points. The second moments
+        // are summed about the first point, which keeps the covariance of a
+        // cloud far from the origin accurate.
+        Vector3 sum(const Vector3Batch&);
+        Vector3 sum(const Vector3*, std::size_t);
+        Vector3 centroid(const Vector3Batch&);
+        Vector3 centroid(const Vector3*, std::size_t);
+        AABB bounds(const Vector3Batch&);
+        AABB bounds(const Vector3*, std::size_t);
+        Matrix3 covariance(const Vector3Batch&);
+        Matrix3 covariance(const Vector3*, std::size_t);
+        Matrix3 second_moment(const Vector3Batch&);
+        Matrix3 second_moment(const Vector3*, std::size_t);
+    }
+}
@@ -0,0 +1,90 @@
+/// @file Pipeline.h
+/// @brief This header file contains the declaration of the Pipeline class.
+/// @author David Moncada
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Matrix3.h"
+#include "Transform.h"
+#include "Vector3.h"
+#include "Vector3Batch.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @class Pipeline
+    /// @brief The Pipeline class declaration.
+    ///
+    /// A chain of element-wise operations over vectors, recorded by the stage
+    /// functions and applied later by run() in a single pass over memory:
+    ///
+    /// @code
+    /// const Pipeline shade = Pipeline().transform(normal_matrix).normalize().dot(light).clamp(0.0f, 1.0f);
+    /// shade.run(normals, intensities);
+    /// @endcode
+    ///
+    /// Chaining the equivalent bulk operations writes every intermediate
+    /// result out to a temporary array and reads it back in the next pass. A
+    /// pipeline instead takes block_size vectors at a time, runs every stage on
+    /// them while they sit in the L1 cache, and writes out only the final
+    /// result. Every stage runs the vectorized kernel of the active SIMD level
+    /// that the matching bulk operation runs.
+    ///
+    /// Stages either map vectors to vectors or, for dot() and magnitude(),
+    /// vectors to one float each; after such a stage the pipeline is scalar,
+    /// and only clamp() may follow. The stage parameters are copied when the
+    /// stage is added.
+    class Pipeline
+    {
+    private:
+        enum class Stage
+        {
+            Transform,
+            Affine,
+            Normalize,
+            Dot,
+            Magnitude,
+            Clamp
+        };
+
+        struct Step
+        {
+            Stage stage;
+            float parameters[12];
+        };
+
+        std::vector<Step> _steps;
+        bool _scalar = false;
+
+        Pipeline& add(Stage, bool, const float*, std::size_t);
+        void run_block(const float*, const float*, const float*, float*, float*, float*, float*, std::size_t) const;
+
+    public:
+        /// @brief The number of vectors every stage processes at a time; the
+        /// block's components and scalars take 16 KiB, within L1.
+        static constexpr std::size_t block_size = 1024;
+
+        // Stages.
+        Pipeline& transform(const Matrix3&);
+        Pipeline& transform_points(const Transform&);
+        Pipeline& transform_directions(const Transform&);
+        Pipeline& normalize();
+        Pipeline& dot(const Vector3&);
+        Pipeline& magnitude();
+        Pipeline& clamp(float, float);
+
+        // Member functions.
+        bool empty() const;
+        bool scalar() const;
+        std::size_t stages() const;
+
+        // Execution.
+        void run(const Vector3Batch&, Vector3Batch&) const;
+        void run(const Vector3Batch&, float*) const;
+        void run(const Vector3*, Vector3*, std::size_t) const;
+        void run(const Vector3*, float*, std::size_t) const;
+    };
+}
@@ -0,0 +1,74 @@
+/// @file PointText.h
+/// @brief This header file contains the bulk text import and export functions
+/// for arrays of points.
+/// @author David Moncada
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Vector3.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @brief The text formats point lists can be read from and written to.
+    ///
+    /// In every format a point is one line; lines may end in "\n" or "\r\n",
+    /// and columns after the third coordinate are ignored, so that files
+    /// carrying colors or normals can still be read.
+    enum class PointFormat
+    {
+        /// @brief Coordinates separated by spaces or tabs. Blank lines and
+        /// lines starting with '#' are skipped.
+        XYZ,
+        /// @brief Coordinates separated by commas. Blank lines and lines
+        /// starting with '#' are skipped, and so is a first line holding
+        /// column names.
+        CSV,
+        /// @brief Wavefront OBJ vertices, "v x y z"; every line other than a
+        /// vertex line is skipped.
+        OBJ
+    };
+
+    /// @brief The longest text a single point is formatted into, line break
+    /// included.
+    ///
+    /// Three shortest round-trip floats take at most 15 characters each.
+    const std::size_t max_point_chars = 52;
+
+    /// @brief Parses a point list.
+    ///
+    /// Numbers are converted with std::from_chars, so parsing does not depend
+    /// on the locale and does not allocate beyond the output. Texts larger than
+    /// a chunk are split at line breaks and the pieces parsed in parallel.
+    ///
+    /// @param text The text to parse.
+    /// @param length The length of the text, in bytes.
+    /// @param format The format of the text.
+    /// @return The points, in the order they appear.
+    /// @throw std::runtime_error If a line that should hold a point does not;
+    /// the message gives the line number.
+    std::vector<Vector3> parse_points(const char* text, std::size_t length, PointFormat format);
+    std::vector<Vector3> parse_points(const std::string&, PointFormat);
+
+    /// @brief Formats a point list.
+    ///
+    /// Numbers are converted with std::to_chars, to the shortest text that
+    /// parses back to exactly the same float.
+    ///
+    /// @param points The array of points.
+    /// @param count The number of points.
+    /// @param format The format to write.
+    /// @param out The buffer receiving the text; it must hold at least
+    /// @p count * max_point_chars bytes. No terminating null is written.
+    /// @return The number of bytes written.
+    std::size_t format_points(const Vector3* points, std::size_t count, PointFormat format, char* out);
+    std::string format_points(const Vector3*, std::size_t, PointFormat);
+
+    // File I/O.
+    std::vector<Vector3> read_points(const std::string&, PointFormat);
+    void write_points(const std::string&, const Vector3*, std::size_t, PointFormat);
+}
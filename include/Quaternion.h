@@ -0,0 +1,156 @@
+/// @file Quaternion.h
+/// @brief This header file contains the declaration of the Quaternion class.
+/// @author David Moncada
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <type_traits>
+
+#include "MathObject.h"
+#include "Matrix3.h"
+#include "Vector3.h"
+#include "Vector3Batch.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @class Quaternion
+    /// @brief The Quaternion class declaration.
+    ///
+    /// Unit quaternions represent rotations in a compact form: composing two of
+    /// them takes 16 multiplications, against the 27 of a Matrix3 product, and
+    /// renormalizing one is enough to remove the drift that accumulates over
+    /// many compositions. They also interpolate smoothly, which makes them the
+    /// representation of choice for animation.
+    ///
+    /// The vector part is (x, y, z) and the scalar part is w. Like Vector3, a
+    /// Quaternion is a plain value type of four packed floats.
+    class Quaternion
+    {
+    public:
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+        float w = 1.0f;
+
+        /// @brief Returns the identity rotation.
+        /// @return A Quaternion that leaves every vector unchanged.
+        static Quaternion identity()
+        {
+            return Quaternion(0.0f, 0.0f, 0.0f, 1.0f);
+        }
+
+        /// @brief Creates a rotation around an axis.
+        /// @param degrees The angle of rotation, in degrees.
+        /// @param axis The axis of rotation; it does not need to be normalized.
+        /// @return The unit Quaternion representing the rotation.
+        static Quaternion angle_axis(float degrees, const Vector3& axis)
+        {
+            const float half = 0.5f * deg2rad(degrees);
+            const Vector3 v = axis.normalized() * std::sin(half);
+            return Quaternion(v.x, v.y, v.z, std::cos(half));
+        }
+
+        /// @brief Computes the angle between two rotations.
+        /// @return The angle of the rotation taking a to b, in degrees, which is
+        /// in the range [0,180].
+        static float angle(const Quaternion& a, const Quaternion& b)
+        {
+            const float d = std::fmin(std::fabs(dot(a, b)), 1.0f);
+            return rad2deg(2.0f * std::acos(d));
+        }
+
+        /// @brief Computes the dot product of two quaternions.
+        ///
+        /// For unit quaternions, the dot product is the cosine of half the angle
+        /// between the rotations they represent.
+        ///
+        /// @return The dot product of the two inputs.
+        static float dot(const Quaternion& a, const Quaternion& b)
+        {
+            return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+        }
+
+        /// @brief Normalized linear interpolation between two rotations.
+        ///
+        /// Cheaper than slerp, at the cost of a non-constant angular velocity;
+        /// the interpolation always follows the shortest path.
+        ///
+        /// @param a The first Quaternion.
+        /// @param b The second Quaternion.
+        /// @param t The interpolant parameter, clamped to [0,1].
+        /// @return The interpolated unit Quaternion.
+        static Quaternion nlerp(const Quaternion& a, const Quaternion& b, float t)
+        {
+            // Clamp t to [0,1]
+            t = std::fmax(t, 0.0f);
+            t = std::fmin(t, 1.0f);
+
+            const float s = dot(a, b) < 0.0f ? -t : t;
+            const Quaternion q = a * (1.0f - t) + b * s;
+            return q.normalized();
+        }
+
+        /// @brief Turns an arbitrary quaternion into a unit quaternion.
+        /// @param q The Quaternion to normalize.
+        static Quaternion& normalize(Quaternion& q)
+        {
+            q = q * (1.0f / q.magnitude());
+            return q;
+        }
+
+        // Static functions.
+        static Quaternion from_matrix(const Matrix3&);
+        static Quaternion slerp(const Quaternion&, const Quaternion&, float);
+
+        // Bulk functions.
+        static void rotate(const Quaternion*, const Vector3*, Vector3*, std::size_t);
+        static void slerp(const Quaternion*, const Quaternion*, float, Quaternion*, std::size_t);
+
+        // Constructors.
+        Quaternion() = default;
+        Quaternion(float, float, float, float);
+        Quaternion(const Vector3&, float);
+
+        // Member functions.
+        Quaternion conjugate() const;
+        Quaternion inverse() const;
+        float magnitude() const;
+        Quaternion normalized() const;
+        Vector3 rotate(const Vector3&) const;
+        float sqr_magnitude() const;
+        Matrix3 to_matrix() const;
+        Vector3 vector() const;
+
+        // Bulk member functions.
+        void rotate(const Vector3*, Vector3*, std::size_t) const;
+        void rotate(const Vector3Batch&, Vector3Batch&) const;
+
+        // Arithmetic operators overloads.
+        Quaternion operator+(const Quaternion&) const;
+        Quaternion operator-(const Quaternion&) const;
+        Quaternion operator-() const;
+        Quaternion operator*(const Quaternion&) const;
+        Quaternion operator*(const float) const;
+        Vector3 operator*(const Vector3&) const;
+
+        // Compound assignment operators overloads.
+        Quaternion& operator*=(const Quaternion&);
+
+        // Comparison operators overloads.
+        bool operator==(const Quaternion&) const;
+    };
+
+    static_assert(sizeof(Quaternion) == 4 * sizeof(float),
+        "Quaternion must be exactly four packed floats.");
+    static_assert(std::is_standard_layout<Quaternion>::value,
+        "Quaternion must be a standard-layout type.");
+    static_assert(std::is_trivially_copyable<Quaternion>::value,
+        "Quaternion must be trivially copyable.");
+
+    // Printing.
+    std::ostream& to_string(std::ostream&, const Quaternion&);
+    std::ostream& operator<<(std::ostream&, const Quaternion&);
+}
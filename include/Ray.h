@@ -0,0 +1,106 @@
+/// @file Ray.h
+/// @brief This header file contains the declaration of the Ray and RayPacket
+/// classes.
+/// @author David Moncada
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+#include "AABB.h"
+#include "MathObject.h"
+#include "Sphere.h"
+#include "Vector3.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @class Ray
+    /// @brief The Ray class declaration.
+    ///
+    /// A half-line, made of the points origin + t direction for every t >= 0.
+    /// The direction need not be a unit vector, in which case distances along
+    /// the ray are measured in multiples of its magnitude.
+    ///
+    /// Boxes and spheres are treated as solids: a ray starting inside one hits
+    /// it at a distance of zero.
+    class Ray
+    {
+    public:
+        Vector3 origin;
+        Vector3 direction = Vector3(0.0f, 0.0f, 1.0f);
+
+        // Constructors.
+        Ray() = default;
+        Ray(const Vector3&, const Vector3&);
+
+        // Member functions.
+        bool intersect(const AABB&, float&, float = std::numeric_limits<float>::infinity()) const;
+        bool intersect(const Sphere&, float&, float = std::numeric_limits<float>::infinity()) const;
+        Vector3 point_at(float) const;
+
+        // Comparison operators overloads.
+        bool operator==(const Ray&) const;
+    };
+
+    static_assert(sizeof(Ray) == 6 * sizeof(float),
+        "Ray must be exactly six packed floats.");
+    static_assert(std::is_standard_layout<Ray>::value,
+        "Ray must be a standard-layout type.");
+    static_assert(std::is_trivially_copyable<Ray>::value,
+        "Ray must be trivially copyable.");
+
+    /// @class RayPacket
+    /// @brief The RayPacket class declaration.
+    ///
+    /// A group of N rays, 4 or 8, tested against the same volume in a single
+    /// call. The rays are stored as one array per component, so that every
+    /// test runs on all of them at once with SIMD instructions, through the
+    /// kernels selected by the current SIMD level (see Dispatch.h); the
+    /// reciprocals of the directions, which the box test needs, are computed
+    /// once when a ray is stored.
+    ///
+    /// Every lane gives the same result as the matching Ray::intersect, up to
+    /// rounding. The tests return a mask with bit i set when ray i hits.
+    template <std::size_t N>
+    class RayPacket
+    {
+        static_assert(N == 4 || N == 8, "RayPacket holds either 4 or 8 rays.");
+
+    public:
+        /// @brief The number of rays in the packet.
+        static const std::size_t size = N;
+
+        alignas(32) float origin[3][N];
+        alignas(32) float direction[3][N];
+        alignas(32) float inv_direction[3][N];
+
+        // Constructors.
+        RayPacket();
+        explicit RayPacket(const Ray*);
+
+        // Member functions.
+        unsigned intersect(const AABB&, float*, const float* = nullptr) const;
+        unsigned intersect(const Sphere&, float*, const float* = nullptr) const;
+        void set(std::size_t, const Ray&);
+
+        // [] overloads.
+        Ray operator[](std::size_t) const;
+    };
+
+    // Compiled in the library, for the two supported widths.
+    extern template class RayPacket<4>;
+    extern template class RayPacket<8>;
+
+    /// @brief A packet of four rays, the width of an SSE register.
+    typedef RayPacket<4> RayPacket4;
+    /// @brief A packet of eight rays, the width of an AVX register.
+    typedef RayPacket<8> RayPacket8;
+
+    // Printing.
+    std::ostream& to_string(std::ostream&, const Ray&);
+    std::ostream& operator<<(std::ostream&, const Ray&);
+}
@@ -0,0 +1,105 @@
+/// @file SpatialGrid.h
+/// @brief This header file contains the declaration of the SpatialGrid class.
+/// @author David Moncada
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Vector3.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @class SpatialGrid
+    /// @brief The SpatialGrid class declaration.
+    ///
+    /// A spatial index over a set of points, for nearest-neighbor, radius and
+    /// box queries without visiting every point. Space is divided into cubic
+    /// cells of equal size, and only the occupied cells are stored, in a hash
+    /// table; a query only looks at the cells overlapping the region it asks
+    /// about.
+    ///
+    /// Unlike a tree, the grid needs no rebalancing: inserting, removing or
+    /// moving a point touches at most two cells, which makes it suited to
+    /// points that move every frame. Queries are fastest when the cell size is
+    /// close to the typical query radius, or to the typical distance between a
+    /// point and its nearest neighbors.
+    ///
+    /// Points are identified by the index returned when they were inserted;
+    /// when built from an array, the identifiers are the array indices. The
+    /// identifier of a removed point may be reused by a later insertion. All
+    /// distances are compared squared.
+    class SpatialGrid
+    {
+    private:
+        // Mixes the packed cell coordinates, so that neighboring cells do not
+        // land in neighboring buckets.
+        struct KeyHash
+        {
+            std::size_t operator()(std::uint64_t key) const
+            {
+                key ^= key >> 33;
+                key *= 0xff51afd7ed558ccdULL;
+                key ^= key >> 33;
+                return static_cast<std::size_t>(key);
+            }
+        };
+
+        typedef std::unordered_map<std::uint64_t, std::vector<std::size_t>, KeyHash> CellMap;
+
+        float _cell_size;
+        float _inv_cell_size;
+        std::vector<Vector3> _points;
+        std::vector<std::uint64_t> _keys;
+        std::vector<std::size_t> _slots;
+        std::vector<std::size_t> _free;
+        CellMap _cells;
+        std::size_t _size;
+        int _lo[3];
+        int _hi[3];
+
+    public:
+        /// @brief The identifier padding the results of bulk nearest-neighbor
+        /// queries when the grid holds fewer points than requested.
+        static const std::size_t none;
+
+        // Constructors.
+        explicit SpatialGrid(float);
+        SpatialGrid(const Vector3*, std::size_t, float = 0.0f);
+
+        // Member functions.
+        float cell_size() const;
+        void clear();
+        bool contains(std::size_t) const;
+        bool empty() const;
+        std::size_t insert(const Vector3&);
+        void remove(std::size_t);
+        std::size_t size() const;
+        void update(std::size_t, const Vector3&);
+
+        // Queries.
+        std::vector<std::size_t> box(const Vector3&, const Vector3&) const;
+        void box(const Vector3&, const Vector3&, std::vector<std::size_t>&) const;
+        std::vector<std::size_t> nearest(const Vector3&, std::size_t) const;
+        void nearest(const Vector3&, std::size_t, std::vector<std::size_t>&) const;
+        std::vector<std::size_t> radius(const Vector3&, float) const;
+        void radius(const Vector3&, float, std::vector<std::size_t>&) const;
+
+        // Bulk queries.
+        void nearest(const Vector3*, std::size_t, std::size_t, std::size_t*) const;
+        std::vector<std::vector<std::size_t> > radius(const Vector3*, std::size_t, float) const;
+
+        // [] overloads.
+        const Vector3& operator[](std::size_t) const;
+
+    private:
+        void add_to_cell(std::size_t);
+        int cell_coordinate(float) const;
+        template <typename F> void for_each_cell(const int*, const int*, F) const;
+        void remove_from_cell(std::size_t);
+    };
+}
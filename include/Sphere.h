@@ -0,0 +1,53 @@
+/// @file Sphere.h
+/// @brief This header file contains the declaration of the Sphere class.
+/// @author David Moncada
+
+#pragma once
+
+#include <ostream>
+#include <type_traits>
+
+#include "AABB.h"
+#include "MathObject.h"
+#include "Vector3.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @class Sphere
+    /// @brief The Sphere class declaration.
+    ///
+    /// A solid sphere, given by its center and radius. Spheres fit round
+    /// objects more tightly than boxes and do not change when the object
+    /// rotates, at the cost of a square root when testing a ray against them.
+    class Sphere
+    {
+    public:
+        Vector3 center;
+        float radius = 0.0f;
+
+        // Constructors.
+        Sphere() = default;
+        Sphere(const Vector3&, float);
+
+        // Member functions.
+        AABB bounds() const;
+        bool contains(const Vector3&) const;
+        bool overlaps(const Sphere&) const;
+        bool overlaps(const AABB&) const;
+
+        // Comparison operators overloads.
+        bool operator==(const Sphere&) const;
+    };
+
+    static_assert(sizeof(Sphere) == 4 * sizeof(float),
+        "Sphere must be exactly four packed floats.");
+    static_assert(std::is_standard_layout<Sphere>::value,
+        "Sphere must be a standard-layout type.");
+    static_assert(std::is_trivially_copyable<Sphere>::value,
+        "Sphere must be trivially copyable.");
+
+    // Printing.
+    std::ostream& to_string(std::ostream&, const Sphere&);
+    std::ostream& operator<<(std::ostream&, const Sphere&);
+}
@@ -0,0 +1,91 @@
+/// @file Transform.h
+/// @brief This header file contains the declaration of the Transform class.
+/// @author David Moncada
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <type_traits>
+
+#include "MathObject.h"
+#include "Matrix3.h"
+#include "Quaternion.h"
+#include "Vector3.h"
+#include "Vector3Batch.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @class Transform
+    /// @brief The Transform class declaration.
+    ///
+    /// An affine transformation: a linear part followed by a translation,
+    /// which maps a point p to linear * p + translation. It is the 4x4
+    /// homogeneous matrix used by scene graphs and cameras, without the
+    /// constant bottom row.
+    ///
+    /// Points are affected by the translation, directions are not. Transforms
+    /// made only of rotations and translations are _rigid_; their inverse is
+    /// found with a transpose instead of a full matrix inversion.
+    class Transform
+    {
+    public:
+        Matrix3 linear = Matrix3::identity();
+        Vector3 translation;
+
+        /// @brief Returns the identity transform.
+        /// @return A Transform that leaves every point unchanged.
+        static Transform identity()
+        {
+            return Transform(Matrix3::identity(), Vector3::zero);
+        }
+
+        // Static functions.
+        static Transform from_matrix4(const float*);
+
+        // Constructors.
+        Transform() = default;
+        Transform(const Matrix3&, const Vector3&);
+        Transform(const Quaternion&, const Vector3&);
+
+        // Member functions.
+        Transform inverse() const;
+        Transform rigid_inverse() const;
+        void to_matrix4(float*) const;
+        std::optional<Transform> try_inverse() const;
+        Vector3 transform_direction(const Vector3&) const;
+        Vector3 transform_point(const Vector3&) const;
+
+        // Bulk transforms.
+        void transform_directions(const Vector3*, Vector3*, std::size_t) const;
+        void transform_directions(Vector3*, std::size_t) const;
+        void transform_directions(const Vector3Batch&, Vector3Batch&) const;
+        void transform_directions(Vector3Batch&) const;
+        void transform_points(const Vector3*, Vector3*, std::size_t) const;
+        void transform_points(Vector3*, std::size_t) const;
+        void transform_points(const Vector3Batch&, Vector3Batch&) const;
+        void transform_points(Vector3Batch&) const;
+
+        // Arithmetic operators overloads.
+        Transform operator*(const Transform&) const;
+
+        // Compound assignment operators overloads.
+        Transform& operator*=(const Transform&);
+
+        // Comparison operators overloads.
+        bool operator==(const Transform&) const;
+    };
+
+    static_assert(sizeof(Transform) == 12 * sizeof(float),
+        "Transform must be exactly twelve packed floats.");
+    static_assert(std::is_standard_layout<Transform>::value,
+        "Transform must be a standard-layout type.");
+    static_assert(std::is_trivially_copyable<Transform>::value,
+        "Transform must be trivially copyable.");
+
+    // Printing.
+    std::ostream& to_string(std::ostream&, const Transform&);
+    std::ostream& operator<<(std::ostream&, const Transform&);
+}
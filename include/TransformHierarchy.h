@@ -0,0 +1,94 @@
+/// @file TransformHierarchy.h
+/// @brief This header file contains the declaration of the TransformHierarchy
+/// class.
+/// @author David Moncada
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Transform.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @class TransformHierarchy
+    /// @brief The TransformHierarchy class declaration.
+    ///
+    /// The transforms of a scene graph: every node has a local Transform,
+    /// relative to its parent, and a world Transform, the product of the local
+    /// transforms from its root down to it. update() recomputes the world
+    /// transforms of the nodes whose local transform, or an ancestor's, changed
+    /// since the last update, and of no other node, so a frame in which few
+    /// nodes move costs little however large the scene is.
+    ///
+    /// The nodes are stored in flat arrays in depth-first order, so that every
+    /// subtree occupies a contiguous range, right after its root; a changed
+    /// node marks its range dirty, and update() recomposes every outermost
+    /// dirty range front to back, parents before children. Disjoint ranges are
+    /// independent, and are spread over the Parallel thread pool; large ranges
+    /// are split at their root's children first.
+    ///
+    /// Nodes are identified by the index returned when they were added, which
+    /// never changes. Adding or reparenting nodes only appends to the arrays;
+    /// the next update() restores the depth-first order, in time linear in the
+    /// number of nodes.
+    class TransformHierarchy
+    {
+    private:
+        struct Range
+        {
+            std::size_t begin;
+            std::size_t end;
+        };
+
+        // Indexed by position, in depth-first order once the layout is valid.
+        std::vector<Transform> _local;
+        std::vector<Transform> _world;
+        std::vector<std::size_t> _parent;
+        std::vector<std::size_t> _end;
+        std::vector<std::size_t> _node;
+
+        // Indexed by node.
+        std::vector<std::size_t> _position;
+        std::vector<unsigned char> _dirty;
+
+        std::vector<std::size_t> _dirty_nodes;
+        std::vector<Range> _ranges;
+        std::vector<std::size_t> _batches;
+        bool _ordered = true;
+
+    public:
+        /// @brief The parent of the roots.
+        static constexpr std::size_t none = static_cast<std::size_t>(-1);
+
+        /// @brief The number of nodes below which a dirty range is recomposed
+        /// by a single thread, and the number of nodes handed to a thread at a
+        /// time.
+        static constexpr std::size_t chunk_nodes = 4096;
+
+        // Constructors.
+        TransformHierarchy() = default;
+
+        // Member functions.
+        std::size_t add(const Transform&, std::size_t = none);
+        void clear();
+        bool contains(std::size_t) const;
+        bool empty() const;
+        const Transform& local(std::size_t) const;
+        std::size_t parent(std::size_t) const;
+        void reserve(std::size_t);
+        void set_local(std::size_t, const Transform&);
+        void set_parent(std::size_t, std::size_t);
+        std::size_t size() const;
+        std::size_t update();
+        const Transform& world(std::size_t) const;
+
+    private:
+        void check(std::size_t) const;
+        void mark_dirty(std::size_t);
+        void recompose(std::size_t, std::size_t);
+        void reorder();
+    };
+}
@@ -1,50 +1,73 @@
 /// @file Vector3.h
-/// @brief This header file contains the declaration of the Vector3 class.
+/// @brief This header file contains the declaration of the Vector3T class
+/// template, and of its Vector3 and Vector3d instances.
 /// @author David Moncada
 
 #pragma once
 
+#include <ostream>
+#include <type_traits>
+
+#include "Instrument.h"
 #include "MathObject.h"
 
 /// @namespace Math3D
 namespace Math3D
 {
-    /// @class Vector3
-    /// @brief The Vector3 class declaration.
+    /// @class Vector3T
+    /// @brief The Vector3T class template declaration.
     ///
     /// Basic mathematical building block used almost ubiquitously in game
     /// development. Used to describe such concepts as points in space and
     /// coordinate transforms.
-    class Vector3 : public MathObject
+    ///
+    /// The components are of type T, float or double; Vector3 is the single
+    /// precision vector used throughout the library, and Vector3d the double
+    /// precision one, for coordinates too large for a float to resolve.
+    ///
+    /// Vector3T is a plain value type: it has no virtual functions and uses the
+    /// implicit copy operations, so arrays of vectors are tightly packed and
+    /// can be copied with memcpy or handed to SIMD and I/O code directly.
+    ///
+    /// Every function is defined in this header, so that arithmetic is
+    /// inlined and vectorized at the call site rather than called across the
+    /// library boundary; everything but the square roots is constexpr and can
+    /// be evaluated at compile time.
+    template <typename T>
+    class Vector3T
     {
     public:
-        float x = 0.0f;
-        float y = 0.0f;
-        float z = 0.0f;
-
-        /// @brief Shorthand for Vector3(0, 0, 0).
-        static const Vector3 zero;
-        /// @brief Shorthand for Vector3(1, 1, 1).
-        static const Vector3 one;
-        /// @brief Shorthand for Vector3(1, 0, 0).
-        static const Vector3 right;
-        /// @brief Shorthand for Vector3(0, 1, 0).
-        static const Vector3 up;
-        /// @brief Shorthand for Vector3(0, 0, 1).
-        static const Vector3 forward;
-        /// @brief Shorthand for Vector3(-1, 0, 0).
-        static const Vector3 left;
-        /// @brief Shorthand for Vector3(0, -1, 0).
-        static const Vector3 down;
-        /// @brief Shorthand for Vector3(0, 0, -1).
-        static const Vector3 back;
+        /// @brief The type of the components.
+        typedef T value_type;
+
+        T x = T(0);
+        T y = T(0);
+        T z = T(0);
+
+        /// @brief Shorthand for Vector3T(0, 0, 0).
+        static const Vector3T zero;
+        /// @brief Shorthand for Vector3T(1, 1, 1).
+        static const Vector3T one;
+        /// @brief Shorthand for Vector3T(1, 0, 0).
+        static const Vector3T right;
+        /// @brief Shorthand for Vector3T(0, 1, 0).
+        static const Vector3T up;
+        /// @brief Shorthand for Vector3T(0, 0, 1).
+        static const Vector3T forward;
+        /// @brief Shorthand for Vector3T(-1, 0, 0).
+        static const Vector3T left;
+        /// @brief Shorthand for Vector3T(0, -1, 0).
+        static const Vector3T down;
+        /// @brief Shorthand for Vector3T(0, 0, -1).
+        static const Vector3T back;
 
         /// @brief Computes the angle between two vectors.
         /// @return The angle between the inputs in degrees, which is in the range
         /// [0,180].
-        static float angle(const Vector3& v, const Vector3& w)
+        static T angle(const Vector3T& v, const Vector3T& w)
         {
-            return rad2deg(std::acosf(dot(v, w) / (v.magnitude() * w.magnitude())));
+            MATH3D_INSTRUMENT_SCOPE(Instrument::Operation::Vector3Angle);
+            return T(180) * std::acos(dot(v, w) / (v.magnitude() * w.magnitude())) / pi_v<T>;
         }
 
         /// @brief Computes the cross product of two vectors.
@@ -57,12 +80,12 @@ namespace Math3D
         /// The direction of the resulting vector is determined by the _handedness_
         /// of the underlying coordinate system.
         ///
-        /// @param v The first Vector3.
-        /// @param w The second Vector3.
-        /// @return The Vector3 resulting from the cross product of the two inputs.
-        static Vector3 cross(const Vector3& v, const Vector3& w)
+        /// @param v The first Vector3T.
+        /// @param w The second Vector3T.
+        /// @return The Vector3T resulting from the cross product of the two inputs.
+        static constexpr Vector3T cross(const Vector3T& v, const Vector3T& w)
         {
-            return Vector3(
+            return Vector3T(
                 v.y * w.z - v.z * w.y,
                 v.z * w.x - v.x * w.z,
                 v.x * w.y - v.y * w.x
@@ -70,10 +93,10 @@ namespace Math3D
         }
 
         /// @brief Computes the distance between two points.
-        /// @param v The first Vector3.
-        /// @param w The second Vector3.
+        /// @param v The first Vector3T.
+        /// @param w The second Vector3T.
         /// @return The distance between the given points.
-        static float distance(const Vector3& v, const Vector3& w)
+        static T distance(const Vector3T& v, const Vector3T& w)
         {
             return (v - w).magnitude();
         }
@@ -89,87 +112,252 @@ namespace Math3D
         /// positive (resp. negative) value when both vectors are parallel and point
         /// in the same (resp. opposite) direction.
         ///
-        /// @param v The first Vector3.
-        /// @param w The second Vector3.
+        /// @param v The first Vector3T.
+        /// @param w The second Vector3T.
         /// @return The dot product of the two inputs.
-        static float dot(const Vector3& v, const Vector3& w)
+        static constexpr T dot(const Vector3T& v, const Vector3T& w)
         {
             return v.x * w.x + v.y * w.y + v.z * w.z;
         }
 
         /// @brief Linearly interpolates between two points.
-        /// @param v The first Vector3.
-        /// @param w The second Vector3.
+        /// @param v The first Vector3T.
+        /// @param w The second Vector3T.
         /// @param t The interpolant parameter, clamped to [0,1].
         /// @return The fraction of the way along a line between the given points.
-        static Vector3 lerp(const Vector3& v, const Vector3& w, float t)
+        static Vector3T lerp(const Vector3T& v, const Vector3T& w, T t)
         {
             // Clamp t to [0,1]
-            t = std::fmax(t, 0.0f);
-            t = std::fmin(t, 1.0f);
+            t = std::fmax(t, T(0));
+            t = std::fmin(t, T(1));
             return v + (w - v) * t;
         }
 
         /// @brief Turns an arbitrary vector into a unit vector.
-        /// @param v The Vector3 to normalize.
-        static Vector3& normalize(Vector3& v)
+        /// @param v The Vector3T to normalize.
+        static Vector3T& normalize(Vector3T& v)
         {
+            MATH3D_INSTRUMENT_SCOPE(Instrument::Operation::Vector3Normalize);
             v /= v.magnitude();
             return v;
         }
 
         /// @brief Computes the projection of a vector onto another.
         /// @return The component of vector v that is parallel to vector w.
-        static Vector3 project(const Vector3& v, const Vector3& w)
+        static constexpr Vector3T project(const Vector3T& v, const Vector3T& w)
         {
-            return w * (dot(v, w) * dot(w, w));
+            return w * (dot(v, w) / dot(w, w));
         }
 
         /// @brief Computes the rejection of a vector onto another.
         /// @return The component of vector v that is perpendicular to vector w.
-        static Vector3 reject(const Vector3& v, const Vector3& w)
+        static constexpr Vector3T reject(const Vector3T& v, const Vector3T& w)
         {
             return v - project(v, w);
         }
 
         /// @brief Multiplies two vectors component-wise.
         /// @return The result of scaling vector v by vector w.
-        static Vector3 scale(const Vector3& v, const Vector3& w)
+        static constexpr Vector3T scale(const Vector3T& v, const Vector3T& w)
         {
-            return Vector3(v.x * w.x, v.y * w.y, v.z * w.z);
+            return Vector3T(v.x * w.x, v.y * w.y, v.z * w.z);
         }
 
         // Constructors.
-        Vector3() = default;
-        Vector3(const Vector3&);
-        Vector3(float, float, float);
+        Vector3T() = default;
+
+        /// @brief Constructor for Vector3T.
+        constexpr Vector3T(T x, T y, T z) : x{ x }, y{ y }, z{ z } {}
+
+        /// @brief Converts a vector of another precision, component by
+        /// component.
+        template <typename U>
+        explicit constexpr Vector3T(const Vector3T<U>& v)
+            : x{ static_cast<T>(v.x) }, y{ static_cast<T>(v.y) }, z{ static_cast<T>(v.z) } {}
 
         // Member functions.
-        float magnitude() const;
-        Vector3 normalized() const;
-        void scale(const Vector3&);
-        float sqr_magnitude() const;
+
+        /// @brief The magnitude of this vector.
+        /// @return The length of the line segment represented by this vector.
+        T magnitude() const
+        {
+            return std::sqrt(sqr_magnitude());
+        }
+
+        /// @brief Returns this vector as a unit vector.
+        /// @return A Vector3T with a magnitude of one that points in the same
+        /// direction as this.
+        Vector3T normalized() const
+        {
+            Vector3T v = *this;
+            Vector3T::normalize(v);
+            return v;
+        }
+
+        /// @brief Multiplies every component of this vector by the same component of
+        /// scale.
+        /// @return The result of scaling this vector by the given vector.
+        constexpr void scale(const Vector3T& scale)
+        {
+            x *= scale.x;
+            y *= scale.y;
+            z *= scale.z;
+        }
+
+        /// @brief The squared magnitude of this vector.
+        ///
+        /// Computing the squared magnitude of a vector is cheaper than computing its
+        /// magnitude; when doing simple distance comparisons, it is usually faster to
+        /// compare squared magnitudes against the squares of distances, since the
+        /// comparison will yield the same result.
+        ///
+        /// @return The square of the magnitude of this vector.
+        constexpr T sqr_magnitude() const
+        {
+            return x * x + y * y + z * z;
+        }
 
         // Arithmetic operators overloads.
-        Vector3 operator+(const Vector3&) const;
-        Vector3 operator-(const Vector3&) const;
-        Vector3 operator-() const;
-        Vector3 operator*(const float) const;
-        Vector3 operator/(const float) const;
+
+        /// @brief Overload for the addition operator.
+        constexpr Vector3T operator+(const Vector3T& other) const
+        {
+            return Vector3T(*this) += other;
+        }
+
+        /// @brief Overload for the subtraction operator.
+        constexpr Vector3T operator-(const Vector3T& other) const
+        {
+            return Vector3T(*this) -= other;
+        }
+
+        /// @brief Overload for the unary negation operator.
+        constexpr Vector3T operator-() const
+        {
+            return Vector3T(*this) *= T(-1);
+        }
+
+        /// @brief Overload for the multiplication operator.
+        constexpr Vector3T operator*(const T s) const
+        {
+            return Vector3T(*this) *= s;
+        }
+
+        /// @brief Overload for the division operator.
+        constexpr Vector3T operator/(const T s) const
+        {
+            return Vector3T(*this) /= s;
+        }
 
         // Compound assignment operators overloads.
-        Vector3& operator+=(const Vector3&);
-        Vector3& operator-=(const Vector3&);
-        Vector3& operator*=(const float);
-        Vector3& operator/=(const float);
 
-        // Assignment operator overload.
-        Vector3& operator=(const Vector3&);
+        /// @brief Overload for the addition-assignment operator.
+        constexpr Vector3T& operator+=(const Vector3T& other)
+        {
+            x += other.x;
+            y += other.y;
+            z += other.z;
+            return *this;
+        }
+
+        /// @brief Overload for the subtraction-assignment operator.
+        constexpr Vector3T& operator-=(const Vector3T& other)
+        {
+            x -= other.x;
+            y -= other.y;
+            z -= other.z;
+            return *this;
+        }
+
+        /// @brief Overload for the multiplication-assignment operator.
+        constexpr Vector3T& operator*=(const T s)
+        {
+            x *= s;
+            y *= s;
+            z *= s;
+            return *this;
+        }
+
+        /// @brief Overload for the division-assignment operator.
+        constexpr Vector3T& operator/=(const T s)
+        {
+            T t = T(1) / s;
+            x *= t;
+            y *= t;
+            z *= t;
+            return *this;
+        }
 
         // Comparison operators overloads.
-        bool operator==(const Vector3&) const;
 
-        // to_string() overload.
-        std::ostream& to_string(std::ostream& os) const override;
+        /// @brief Overload for the equality comparison operator.
+        constexpr bool operator==(const Vector3T& other) const
+        {
+            return
+                is_almost_equal(x, other.x) &&
+                is_almost_equal(y, other.y) &&
+                is_almost_equal(z, other.z);
+        }
     };
+
+
+    /// @brief The single precision vector used throughout the library.
+    typedef Vector3T<float> Vector3;
+    /// @brief The double precision vector.
+    typedef Vector3T<double> Vector3d;
+
+    /// @brief Shorthand for Vector3T(0, 0, 0).
+    template <typename T> inline constexpr Vector3T<T> Vector3T<T>::zero = Vector3T<T>(0, 0, 0);
+    /// @brief Shorthand for Vector3T(1, 1, 1).
+    template <typename T> inline constexpr Vector3T<T> Vector3T<T>::one = Vector3T<T>(1, 1, 1);
+    /// @brief Shorthand for Vector3T(1, 0, 0).
+    template <typename T> inline constexpr Vector3T<T> Vector3T<T>::right = Vector3T<T>(1, 0, 0);
+    /// @brief Shorthand for Vector3T(0, 1, 0).
+    template <typename T> inline constexpr Vector3T<T> Vector3T<T>::up = Vector3T<T>(0, 1, 0);
+    /// @brief Shorthand for Vector3T(0, 0, 1).
+    template <typename T> inline constexpr Vector3T<T> Vector3T<T>::forward = Vector3T<T>(0, 0, 1);
+    /// @brief Shorthand for Vector3T(-1, 0, 0).
+    template <typename T> inline constexpr Vector3T<T> Vector3T<T>::left = Vector3T<T>(-1, 0, 0);
+    /// @brief Shorthand for Vector3T(0, -1, 0).
+    template <typename T> inline constexpr Vector3T<T> Vector3T<T>::down = Vector3T<T>(0, -1, 0);
+    /// @brief Shorthand for Vector3T(0, 0, -1).
+    template <typename T> inline constexpr Vector3T<T> Vector3T<T>::back = Vector3T<T>(0, 0, -1);
+
+    /// @brief Overload for the multiplication operator.
+    ///
+    /// The scalar does not take part in deduction, so that any arithmetic
+    /// type converts to the component type, as with the member operator.
+    template <typename T>
+    constexpr Vector3T<T> operator*(const typename Vector3T<T>::value_type s, const Vector3T<T>& v)
+    {
+        return Vector3T<T>(v) *= s;
+    }
+
+    static_assert(sizeof(Vector3) == 3 * sizeof(float),
+        "Vector3 must be exactly three packed floats.");
+    static_assert(sizeof(Vector3d) == 3 * sizeof(double),
+        "Vector3d must be exactly three packed doubles.");
+    static_assert(std::is_standard_layout<Vector3>::value && std::is_standard_layout<Vector3d>::value,
+        "Vector3T must be a standard-layout type.");
+    static_assert(std::is_trivially_copyable<Vector3>::value && std::is_trivially_copyable<Vector3d>::value,
+        "Vector3T must be trivially copyable.");
+
+    // Printing.
+
+    /// @brief Writes a textual representation of a vector to a stream.
+    template <typename T>
+    inline std::ostream& to_string(std::ostream& os, const Vector3T<T>& v)
+    {
+        return os << "("
+            << std::setw(1) << v.x << ", "
+            << std::setw(1) << v.y << ", "
+            << std::setw(1) << v.z << ")";
+    }
+
+    /// @brief Override for the output stream insertion operator.
+    template <typename T>
+    inline std::ostream& operator<<(std::ostream& os, const Vector3T<T>& v)
+    {
+        return to_string(os, v);
+    }
 }
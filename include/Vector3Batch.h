@@ -0,0 +1,109 @@
+/// @file Vector3Batch.h
+/// @brief This header file contains the declaration of the Vector3Batch class.
+/// @author David Moncada
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Memory.h"
+#include "Vector3.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @class Vector3Batch
+    /// @brief The Vector3Batch class declaration.
+    ///
+    /// A structure-of-arrays container of vectors: the x, y and z components of
+    /// every element live in three separate, contiguous arrays. Laying the data
+    /// out this way lets the bulk helpers below process several vectors per
+    /// instruction, instead of one Vector3 per call.
+    ///
+    /// The bulk helpers mirror the static helpers in Vector3 and are applied
+    /// element-wise; every input batch must have the same size. Batch outputs
+    /// are resized to match the inputs and may alias any of them, while scalar
+    /// outputs must point to at least size() floats.
+    ///
+    /// The component arrays start on simd_alignment boundaries, and keep their
+    /// capacity when the batch is cleared or shrunk, so a batch reused from one
+    /// frame to the next stops allocating once it has reached its largest size.
+    class Vector3Batch
+    {
+    public:
+        AlignedVector<float> x;
+        AlignedVector<float> y;
+        AlignedVector<float> z;
+
+        /// @brief Computes the cross product of every pair of vectors.
+        /// @param v The first Vector3Batch.
+        /// @param w The second Vector3Batch.
+        /// @param out The Vector3Batch receiving the cross products.
+        static void cross(const Vector3Batch& v, const Vector3Batch& w, Vector3Batch& out);
+
+        /// @brief Computes the distance between every pair of points.
+        /// @param v The first Vector3Batch.
+        /// @param w The second Vector3Batch.
+        /// @param out The array receiving the distances.
+        static void distance(const Vector3Batch& v, const Vector3Batch& w, float* out);
+
+        /// @brief Computes the dot product of every pair of vectors.
+        /// @param v The first Vector3Batch.
+        /// @param w The second Vector3Batch.
+        /// @param out The array receiving the dot products.
+        static void dot(const Vector3Batch& v, const Vector3Batch& w, float* out);
+
+        /// @brief Linearly interpolates between every pair of points.
+        /// @param v The first Vector3Batch.
+        /// @param w The second Vector3Batch.
+        /// @param t The interpolant parameter, clamped to [0,1].
+        /// @param out The Vector3Batch receiving the interpolated points.
+        static void lerp(const Vector3Batch& v, const Vector3Batch& w, float t, Vector3Batch& out);
+
+        /// @brief Computes the magnitude of every vector.
+        /// @param v The Vector3Batch to measure.
+        /// @param out The array receiving the magnitudes.
+        static void magnitude(const Vector3Batch& v, float* out);
+
+        /// @brief Turns every vector in the batch into a unit vector.
+        /// @param v The Vector3Batch to normalize in place.
+        static void normalize(Vector3Batch& v);
+
+        /// @brief Computes the projection of every vector onto another.
+        /// @param v The Vector3Batch to project.
+        /// @param w The Vector3Batch to project onto.
+        /// @param out The Vector3Batch receiving the projections.
+        static void project(const Vector3Batch& v, const Vector3Batch& w, Vector3Batch& out);
+
+        /// @brief Computes the rejection of every vector onto another.
+        /// @param v The Vector3Batch to reject.
+        /// @param w The Vector3Batch to reject from.
+        /// @param out The Vector3Batch receiving the rejections.
+        static void reject(const Vector3Batch& v, const Vector3Batch& w, Vector3Batch& out);
+
+        /// @brief Multiplies every pair of vectors component-wise.
+        /// @param v The first Vector3Batch.
+        /// @param w The second Vector3Batch.
+        /// @param out The Vector3Batch receiving the scaled vectors.
+        static void scale(const Vector3Batch& v, const Vector3Batch& w, Vector3Batch& out);
+
+        // Constructors.
+        Vector3Batch() = default;
+        explicit Vector3Batch(std::size_t);
+        explicit Vector3Batch(const std::vector<Vector3>&);
+
+        // Member functions.
+        void clear();
+        bool empty() const;
+        void push_back(const Vector3&);
+        void reserve(std::size_t);
+        void resize(std::size_t);
+        void set(std::size_t, const Vector3&);
+        std::size_t size() const;
+        std::vector<Vector3> to_vector() const;
+
+        // [] overloads.
+        Vector3 operator[](std::size_t) const;
+    };
+}
@@ -0,0 +1,163 @@
+#include "AABB.h"
+#include "Kernels.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @brief Constructor for AABB.
+    /// @param min The corner with the smallest coordinates.
+    /// @param max The corner with the largest coordinates.
+    AABB::AABB(const Vector3& min, const Vector3& max) : min{ min }, max{ max } {}
+
+    /// @brief Computes the bounding box of an array of points.
+    ///
+    /// The bounds are reduced by a vectorized kernel, directly on the packed
+    /// array.
+    ///
+    /// @param points The array of points.
+    /// @param count The number of points; the box of zero points is empty.
+    /// @return The smallest AABB containing every point.
+    AABB AABB::from_points(const Vector3* points, std::size_t count)
+    {
+        AABB box;
+        Kernels::active().bounds_packed(&points->x, &box.min.x, count);
+        return box;
+    }
+
+    /// @brief Computes the bounding box of a batch of points.
+    /// @param points The Vector3Batch of points.
+    /// @return The smallest AABB containing every point.
+    AABB AABB::from_points(const Vector3Batch& points)
+    {
+        AABB box;
+        Kernels::active().bounds(points.x.data(), points.y.data(), points.z.data(), &box.min.x, points.size());
+        return box;
+    }
+
+    /// @brief Tests a box against an array of boxes.
+    /// @param box The box to test.
+    /// @param boxes The array of boxes to test against.
+    /// @param count The number of boxes in the array.
+    /// @param out The array receiving, for every box, 1 if it overlaps @p box
+    /// and 0 otherwise.
+    /// @return The number of overlapping boxes.
+    std::size_t AABB::overlaps(const AABB& box, const AABB* boxes, std::size_t count, unsigned char* out)
+    {
+        return Kernels::active().box_overlaps(&box.min.x, &boxes->min.x, out, count);
+    }
+
+    /// @brief The center of this box.
+    Vector3 AABB::center() const
+    {
+        return (min + max) * 0.5f;
+    }
+
+    /// @brief The point of this box closest to a given point.
+    /// @return The point itself if it is inside the box, or else the closest
+    /// point on its surface.
+    Vector3 AABB::closest_point(const Vector3& p) const
+    {
+        return Vector3(
+            std::fmin(std::fmax(p.x, min.x), max.x),
+            std::fmin(std::fmax(p.y, min.y), max.y),
+            std::fmin(std::fmax(p.z, min.z), max.z));
+    }
+
+    /// @brief Checks whether a point lies inside this box, boundary included.
+    bool AABB::contains(const Vector3& p) const
+    {
+        return
+            min.x <= p.x && p.x <= max.x &&
+            min.y <= p.y && p.y <= max.y &&
+            min.z <= p.z && p.z <= max.z;
+    }
+
+    /// @brief Checks whether another box lies entirely inside this box.
+    bool AABB::contains(const AABB& other) const
+    {
+        return contains(other.min) && contains(other.max);
+    }
+
+    /// @brief Checks whether this box contains no point at all.
+    bool AABB::empty() const
+    {
+        return min.x > max.x || min.y > max.y || min.z > max.z;
+    }
+
+    /// @brief Grows this box to contain a point.
+    void AABB::expand(const Vector3& p)
+    {
+        expand(AABB(p, p));
+    }
+
+    /// @brief Grows this box to contain another box.
+    void AABB::expand(const AABB& other)
+    {
+        *this = merge(*this, other);
+    }
+
+    /// @brief The half-sizes of this box along every axis.
+    Vector3 AABB::extents() const
+    {
+        return (max - min) * 0.5f;
+    }
+
+    /// @brief Checks whether this box and another share at least one point.
+    bool AABB::overlaps(const AABB& other) const
+    {
+        return
+            min.x <= other.max.x && other.min.x <= max.x &&
+            min.y <= other.max.y && other.min.y <= max.y &&
+            min.z <= other.max.z && other.min.z <= max.z;
+    }
+
+    /// @brief The squared distance from a point to this box.
+    /// @return Zero if the point is inside the box.
+    float AABB::sqr_distance(const Vector3& p) const
+    {
+        return (closest_point(p) - p).sqr_magnitude();
+    }
+
+    /// @brief The total area of the six faces of this box.
+    ///
+    /// The surface area is proportional to the chance that a random ray hits
+    /// the box, which makes it the usual cost metric when building bounding
+    /// volume hierarchies.
+    float AABB::surface_area() const
+    {
+        const Vector3 d = max - min;
+        return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    /// @brief The volume of this box.
+    float AABB::volume() const
+    {
+        const Vector3 d = max - min;
+        return d.x * d.y * d.z;
+    }
+
+    /// @brief Overload for the equality comparison operator.
+    ///
+    /// All empty boxes compare equal, since they contain the same points.
+    bool AABB::operator==(const AABB& other) const
+    {
+        if (empty() || other.empty())
+        {
+            return empty() && other.empty();
+        }
+
+        return min == other.min && max == other.max;
+    }
+
+    /// @brief Writes a textual representation of a box to a stream.
+    std::ostream& to_string(std::ostream& os, const AABB& box)
+    {
+        return os << "[" << box.min << ", " << box.max << "]";
+    }
+
+    /// @brief Override for the output stream insertion operator.
+    std::ostream& operator<<(std::ostream& os, const AABB& box)
+    {
+        return to_string(os, box);
+    }
+}
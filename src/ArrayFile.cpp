@@ -0,0 +1,322 @@
+#include <cstring>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "ArrayFile.h"
+#include "Config.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    static const char array_magic[8] = { 'M', '3', 'D', 'A', 'R', 'R', 'A', 'Y' };
+    static const std::uint32_t native_byte_order = 0x01020304;
+
+    // The header of a file holding count elements of type T.
+    template <typename T>
+    static ArrayFileHeader make_header(std::uint64_t count)
+    {
+        ArrayFileHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, array_magic, sizeof(array_magic));
+        header.byte_order = native_byte_order;
+        header.version = ArrayFileHeader::current_version;
+        header.type = static_cast<std::uint32_t>(ArrayTypeOf<T>::value);
+        header.element_size = sizeof(T);
+        header.count = count;
+        header.data_offset = sizeof(ArrayFileHeader);
+        header.alignment = ArrayFileHeader::data_alignment;
+        return header;
+    }
+
+    // Checks that a header describes a readable file of file_size bytes
+    // holding elements of type T; returns what is wrong with it, or nullptr.
+    template <typename T>
+    static const char* check_header(const ArrayFileHeader& header, std::uint64_t file_size)
+    {
+        if (std::memcmp(header.magic, array_magic, sizeof(array_magic)) != 0)
+        {
+            return "Not an array file: ";
+        }
+
+        if (header.byte_order != native_byte_order)
+        {
+            return "Array file written with another byte order: ";
+        }
+
+        if (header.version != ArrayFileHeader::current_version)
+        {
+            return "Unsupported array file version: ";
+        }
+
+        if (header.type != static_cast<std::uint32_t>(ArrayTypeOf<T>::value) || header.element_size != sizeof(T))
+        {
+            return "Array file holds another element type: ";
+        }
+
+        if (header.alignment < alignof(T) || header.data_offset < sizeof(ArrayFileHeader) ||
+            header.data_offset % header.alignment != 0)
+        {
+            return "Misaligned array file: ";
+        }
+
+        if (header.data_offset > file_size || header.count > (file_size - header.data_offset) / sizeof(T))
+        {
+            return "Truncated array file: ";
+        }
+
+        return nullptr;
+    }
+
+    /// @brief Constructor for ArrayWriter.
+    ///
+    /// Creates or truncates the file, and writes a header for an empty
+    /// array.
+    ///
+    /// @param path The path of the file to write.
+    template <typename T>
+    ArrayWriter<T>::ArrayWriter(const std::string& path)
+        : _file(path, std::ios::binary | std::ios::trunc), _path{ path }, _count{ 0 }
+    {
+        if (!_file)
+        {
+            MATH3D_THROW(std::runtime_error("Cannot open array file for writing: " + path));
+        }
+
+        const ArrayFileHeader header = make_header<T>(0);
+        _file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
+    /// @brief Destructor for ArrayWriter; closes the file if still open,
+    /// ignoring errors. Call close() to be told about them.
+    template <typename T>
+    ArrayWriter<T>::~ArrayWriter()
+    {
+        finish();
+    }
+
+    /// @brief Completes the header and closes the file.
+    ///
+    /// Nothing can be written afterwards; closing again has no effect.
+    template <typename T>
+    void ArrayWriter<T>::close()
+    {
+        if (!finish())
+        {
+            MATH3D_THROW(std::runtime_error("Cannot write array file: " + _path));
+        }
+    }
+
+    /// @brief The number of elements written so far.
+    template <typename T>
+    std::size_t ArrayWriter<T>::size() const
+    {
+        return static_cast<std::size_t>(_count);
+    }
+
+    /// @brief Appends one element to the file.
+    template <typename T>
+    void ArrayWriter<T>::write(const T& element)
+    {
+        write(&element, 1);
+    }
+
+    /// @brief Appends an array of elements to the file.
+    ///
+    /// The elements are written as they are laid out in memory, in one call;
+    /// large arrays bypass the stream buffer entirely.
+    ///
+    /// @param elements The array of elements.
+    /// @param count The number of elements in the array.
+    template <typename T>
+    void ArrayWriter<T>::write(const T* elements, std::size_t count)
+    {
+        if (!_file.is_open())
+        {
+            MATH3D_THROW(std::runtime_error("Array file already closed: " + _path));
+        }
+
+        _file.write(reinterpret_cast<const char*>(elements), static_cast<std::streamsize>(count * sizeof(T)));
+
+        if (!_file)
+        {
+            MATH3D_THROW(std::runtime_error("Cannot write array file: " + _path));
+        }
+
+        _count += count;
+    }
+
+    // Completes the header and closes the file, if still open; returns false
+    // if anything failed to be written.
+    template <typename T>
+    bool ArrayWriter<T>::finish()
+    {
+        if (!_file.is_open())
+        {
+            return true;
+        }
+
+        const ArrayFileHeader header = make_header<T>(_count);
+        _file.seekp(0);
+        _file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        _file.close();
+        return static_cast<bool>(_file);
+    }
+
+    /// @brief Constructor for MappedArray.
+    ///
+    /// Maps the whole file read-only and checks its header.
+    ///
+    /// @param path The path of the array file.
+    template <typename T>
+    MappedArray<T>::MappedArray(const std::string& path)
+        : _data{ nullptr }, _size{ 0 }, _mapping{ nullptr }, _mapping_size{ 0 }
+    {
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            MATH3D_THROW(std::runtime_error("Cannot open array file: " + path));
+        }
+
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart < static_cast<LONGLONG>(sizeof(ArrayFileHeader)))
+        {
+            CloseHandle(file);
+            MATH3D_THROW(std::runtime_error("Not an array file: " + path));
+        }
+
+        // The view keeps the file and the mapping alive once it exists.
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+
+        if (mapping == nullptr)
+        {
+            MATH3D_THROW(std::runtime_error("Cannot map array file: " + path));
+        }
+
+        _mapping = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+
+        if (_mapping == nullptr)
+        {
+            MATH3D_THROW(std::runtime_error("Cannot map array file: " + path));
+        }
+
+        _mapping_size = static_cast<std::size_t>(file_size.QuadPart);
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+
+        if (fd < 0)
+        {
+            MATH3D_THROW(std::runtime_error("Cannot open array file: " + path));
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(ArrayFileHeader)))
+        {
+            ::close(fd);
+            MATH3D_THROW(std::runtime_error("Not an array file: " + path));
+        }
+
+        // The mapping keeps the file alive once it exists.
+        void* mapping = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+
+        if (mapping == MAP_FAILED)
+        {
+            MATH3D_THROW(std::runtime_error("Cannot map array file: " + path));
+        }
+
+        _mapping = mapping;
+        _mapping_size = static_cast<std::size_t>(info.st_size);
+#endif
+
+        ArrayFileHeader header;
+        std::memcpy(&header, _mapping, sizeof(header));
+
+        if (const char* error = check_header<T>(header, _mapping_size))
+        {
+            unmap();
+            MATH3D_THROW(std::runtime_error(error + path));
+        }
+
+        _data = reinterpret_cast<const T*>(static_cast<const char*>(_mapping) + header.data_offset);
+        _size = static_cast<std::size_t>(header.count);
+    }
+
+    /// @brief Move constructor for MappedArray; the source is left empty.
+    template <typename T>
+    MappedArray<T>::MappedArray(MappedArray&& other) noexcept
+        : _data{ other._data }, _size{ other._size }, _mapping{ other._mapping }, _mapping_size{ other._mapping_size }
+    {
+        other._data = nullptr;
+        other._size = 0;
+        other._mapping = nullptr;
+        other._mapping_size = 0;
+    }
+
+    /// @brief Move assignment for MappedArray; the source is left empty.
+    template <typename T>
+    MappedArray<T>& MappedArray<T>::operator=(MappedArray&& other) noexcept
+    {
+        if (this != &other)
+        {
+            unmap();
+            _data = other._data;
+            _size = other._size;
+            _mapping = other._mapping;
+            _mapping_size = other._mapping_size;
+            other._data = nullptr;
+            other._size = 0;
+            other._mapping = nullptr;
+            other._mapping_size = 0;
+        }
+
+        return *this;
+    }
+
+    /// @brief Destructor for MappedArray; unmaps the file.
+    template <typename T>
+    MappedArray<T>::~MappedArray()
+    {
+        unmap();
+    }
+
+    // Releases the mapping, if any.
+    template <typename T>
+    void MappedArray<T>::unmap()
+    {
+        if (_mapping != nullptr)
+        {
+#if defined(_WIN32)
+            UnmapViewOfFile(_mapping);
+#else
+            ::munmap(_mapping, _mapping_size);
+#endif
+        }
+
+        _data = nullptr;
+        _size = 0;
+        _mapping = nullptr;
+        _mapping_size = 0;
+    }
+
+    template class ArrayWriter<Vector3>;
+    template class ArrayWriter<Matrix3>;
+    template class ArrayWriter<Vector3Half>;
+    template class MappedArray<Vector3>;
+    template class MappedArray<Matrix3>;
+    template class MappedArray<Vector3Half>;
+}
@@ -0,0 +1,63 @@
+/// @file Blocks.h
+/// @brief This header file contains the blocking shared by the operations on
+/// arrays of structures. It is private to the library.
+/// @author David Moncada
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+#include "Vector3.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Blocks
+    namespace Blocks
+    {
+        /// @brief Number of elements deinterleaved at a time by the
+        /// array-of-structures operations; small enough for the scratch arrays
+        /// to stay in L1.
+        constexpr std::size_t size = 256;
+
+        /// @brief Runs an in-place component array kernel over an array of
+        /// vectors, a block at a time.
+        ///
+        /// Every block is deinterleaved into component arrays, passed to the
+        /// kernel, and interleaved back; it is read before it is written, so
+        /// @p out may be the same array as @p in, but the two must not
+        /// otherwise overlap.
+        ///
+        /// @param in The array of vectors to process.
+        /// @param out The array receiving the results.
+        /// @param count The number of vectors in both arrays.
+        /// @param kernel Called as kernel(x, y, z, n) on every block.
+        template <typename Kernel>
+        void transform(const Vector3* in, Vector3* out, std::size_t count, Kernel kernel)
+        {
+            float x[size], y[size], z[size];
+
+            for (std::size_t begin = 0; begin < count; begin += size)
+            {
+                const std::size_t n = std::min(size, count - begin);
+
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    x[i] = in[begin + i].x;
+                    y[i] = in[begin + i].y;
+                    z[i] = in[begin + i].z;
+                }
+
+                kernel(x, y, z, n);
+
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    out[begin + i].x = x[i];
+                    out[begin + i].y = y[i];
+                    out[begin + i].z = z[i];
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,262 @@
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(MATH3D_X86_DISPATCH)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#include "Dispatch.h"
+#include "Instrument.h"
+#include "Kernels.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    // The table every bulk call goes through, and the level it belongs to.
+    // Both are constant-initialized, so they are usable from the static
+    // initializers of other translation units.
+    static std::atomic<const Kernels::Table*> active_table(nullptr);
+    static std::atomic<SimdLevel> active_level(SimdLevel::Scalar);
+
+#if defined(MATH3D_X86_DISPATCH)
+    // Runs the cpuid instruction for the given leaf and subleaf.
+    static void cpuid(unsigned leaf, unsigned subleaf, unsigned (&regs)[4])
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+
+        for (int i = 0; i < 4; ++i)
+            regs[i] = static_cast<unsigned>(info[i]);
+#else
+        __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+    }
+
+    // Reads the XCR0 register, which tells which register files the
+    // operating system saves on context switches.
+    static unsigned long long xgetbv0()
+    {
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        unsigned eax, edx;
+        __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+    }
+
+    // Checks the CPU and OS for every feature the kernels of each level are
+    // compiled with.
+    static SimdLevel detect()
+    {
+        unsigned regs[4];
+        cpuid(0, 0, regs);
+        const unsigned max_leaf = regs[0];
+
+        if (max_leaf < 1)
+            return SimdLevel::Scalar;
+
+        cpuid(1, 0, regs);
+        const unsigned ecx1 = regs[2];
+
+        const bool sse42 = (ecx1 & (1u << 19)) && (ecx1 & (1u << 20));
+        const bool osxsave = (ecx1 & (1u << 27)) != 0;
+        const bool avx = (ecx1 & (1u << 28)) != 0;
+        const bool fma = (ecx1 & (1u << 12)) != 0;
+        const bool f16c = (ecx1 & (1u << 29)) != 0;
+
+        if (!sse42)
+            return SimdLevel::Scalar;
+
+        if (!osxsave || !avx || !fma || !f16c || max_leaf < 7)
+            return SimdLevel::SSE42;
+
+        const unsigned long long xcr0 = xgetbv0();
+        const bool ymm_state = (xcr0 & 0x06) == 0x06;
+        const bool zmm_state = (xcr0 & 0xE6) == 0xE6;
+
+        cpuid(7, 0, regs);
+        const unsigned ebx7 = regs[1];
+
+        const bool avx2 = (ebx7 & (1u << 5)) != 0;
+        const bool avx512 =
+            (ebx7 & (1u << 16)) && (ebx7 & (1u << 17)) &&
+            (ebx7 & (1u << 30)) && (ebx7 & (1u << 31));
+
+        if (!ymm_state || !avx2)
+            return SimdLevel::SSE42;
+
+        if (!zmm_state || !avx512)
+            return SimdLevel::AVX2;
+
+        return SimdLevel::AVX512;
+    }
+#else
+    // Only x86 builds carry SIMD kernels.
+    static SimdLevel detect()
+    {
+        return SimdLevel::Scalar;
+    }
+#endif
+
+    // Maps a level to its kernel table.
+    static const Kernels::Table& table_for(SimdLevel level)
+    {
+        switch (level)
+        {
+#if defined(MATH3D_X86_DISPATCH)
+        case SimdLevel::SSE42:
+            return Kernels::SSE42::table;
+        case SimdLevel::AVX2:
+            return Kernels::AVX2::table;
+        case SimdLevel::AVX512:
+            return Kernels::AVX512::table;
+#endif
+        default:
+            return Kernels::Scalar::table;
+        }
+    }
+
+    // Parses a level name, as produced by simd_level_name().
+    static bool parse_simd_level(const char* name, SimdLevel& level)
+    {
+        const SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::SSE42, SimdLevel::AVX2, SimdLevel::AVX512 };
+
+        for (SimdLevel candidate : levels)
+        {
+            if (std::strcmp(name, simd_level_name(candidate)) == 0)
+            {
+                level = candidate;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Picks the initial level, honoring the MATH3D_SIMD override.
+    static void initialize()
+    {
+        SimdLevel level = detect_simd_level();
+        SimdLevel requested;
+        const char* env = std::getenv("MATH3D_SIMD");
+
+        if (env != nullptr && parse_simd_level(env, requested) && requested <= level)
+            level = requested;
+
+        active_level.store(level);
+        active_table.store(&table_for(level), std::memory_order_release);
+    }
+
+    // The table of the current SIMD level.
+    static const Kernels::Table& selected()
+    {
+        const Kernels::Table* table = active_table.load(std::memory_order_acquire);
+
+        if (table == nullptr)
+        {
+            initialize();
+            table = active_table.load(std::memory_order_acquire);
+        }
+
+        return *table;
+    }
+
+#if MATH3D_INSTRUMENT
+    // The index of every kernel in Kernels::Table, as counted by the
+    // instrumentation.
+    struct KernelIndex
+    {
+#define MATH3D_KERNEL_INDEX(entry) entry,
+        enum : std::size_t { MATH3D_KERNEL_ENTRIES(MATH3D_KERNEL_INDEX) count };
+#undef MATH3D_KERNEL_INDEX
+    };
+
+    static_assert(sizeof(Kernels::Table) == KernelIndex::count * sizeof(Kernels::MatrixInPlace),
+        "MATH3D_KERNEL_ENTRIES must name every entry of Kernels::Table.");
+
+    // A kernel that records its calls, then forwards them to the same entry
+    // of the current level's table.
+    template <typename Kernel, Kernel Kernels::Table::*entry, std::size_t index>
+    struct Counted;
+
+    template <typename R, typename... Args, R (*Kernels::Table::*entry)(Args...), std::size_t index>
+    struct Counted<R (*)(Args...), entry, index>
+    {
+        static R call(Args... args)
+        {
+            const Instrument::Timer timer(static_cast<std::size_t>(Instrument::Operation::Count) + index);
+            return (selected().*entry)(args...);
+        }
+    };
+
+#define MATH3D_COUNTED_KERNEL(entry) \
+    &Counted<decltype(Kernels::Table::entry), &Kernels::Table::entry, KernelIndex::entry>::call,
+
+    // The table every bulk call goes through in instrumented builds.
+    static const Kernels::Table counted_table = { MATH3D_KERNEL_ENTRIES(MATH3D_COUNTED_KERNEL) };
+
+#undef MATH3D_COUNTED_KERNEL
+#endif
+
+    /// @brief The table selected by the current SIMD level; in instrumented
+    /// builds, a table of wrappers that count the calls of its kernels.
+    const Kernels::Table& Kernels::active()
+    {
+#if MATH3D_INSTRUMENT
+        return counted_table;
+#else
+        return selected();
+#endif
+    }
+
+    // Resolves the dispatch table when the library is loaded.
+    static const bool initialized = (selected(), true);
+
+    /// @brief Detects the most capable SIMD level supported by this CPU.
+    SimdLevel detect_simd_level()
+    {
+        static const SimdLevel detected = detect();
+        return detected;
+    }
+
+    /// @brief The SIMD level the bulk kernels currently dispatch to.
+    SimdLevel simd_level()
+    {
+        selected();
+        return active_level.load();
+    }
+
+    /// @brief Switches the bulk kernels to another SIMD level.
+    bool set_simd_level(SimdLevel level)
+    {
+        if (level > detect_simd_level())
+            return false;
+
+        active_level.store(level);
+        active_table.store(&table_for(level), std::memory_order_release);
+        return true;
+    }
+
+    /// @brief The name of a SIMD level, as accepted by @c MATH3D_SIMD.
+    const char* simd_level_name(SimdLevel level)
+    {
+        switch (level)
+        {
+        case SimdLevel::SSE42:
+            return "sse4.2";
+        case SimdLevel::AVX2:
+            return "avx2";
+        case SimdLevel::AVX512:
+            return "avx512";
+        default:
+            return "scalar";
+        }
+    }
+}
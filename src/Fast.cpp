@@ -0,0 +1,46 @@
+#include <stdexcept>
+
+#include "Config.h"
+#include "Fast.h"
+#include "Kernels.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Fast
+    namespace Fast
+    {
+        /// @brief Approximates the angle between every pair of vectors.
+        /// @param v The first Vector3Batch.
+        /// @param w The second Vector3Batch, of the same size.
+        /// @param out The array receiving the angles in degrees, within
+        /// angle_max_error.
+        void angle(const Vector3Batch& v, const Vector3Batch& w, float* out)
+        {
+            if (v.size() != w.size())
+            {
+                MATH3D_THROW(std::invalid_argument("Batch sizes do not match."));
+            }
+
+            Kernels::active().fast_angle(
+                v.x.data(), v.y.data(), v.z.data(),
+                w.x.data(), w.y.data(), w.z.data(), out, v.size());
+        }
+
+        /// @brief Approximates the magnitude of every vector in a batch.
+        /// @param v The Vector3Batch.
+        /// @param out The array receiving the magnitudes, within
+        /// rsqrt_max_error.
+        void magnitude(const Vector3Batch& v, float* out)
+        {
+            Kernels::active().fast_magnitude(v.x.data(), v.y.data(), v.z.data(), out, v.size());
+        }
+
+        /// @brief Turns every vector in a batch into an approximate unit vector.
+        /// @param v The Vector3Batch to normalize.
+        void normalize(Vector3Batch& v)
+        {
+            Kernels::active().fast_normalize(v.x.data(), v.y.data(), v.z.data(), v.size());
+        }
+    }
+}
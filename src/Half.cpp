@@ -0,0 +1,46 @@
+#include "Half.h"
+#include "Kernels.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @brief Converts an array of floats to halves.
+    /// @param in The array of floats.
+    /// @param out The array receiving the halves.
+    /// @param count The number of elements in both arrays.
+    void Half::from_floats(const float* in, Half* out, std::size_t count)
+    {
+        Kernels::active().float_to_half(in, &out->bits, count);
+    }
+
+    /// @brief Converts an array of halves to floats.
+    /// @param in The array of halves.
+    /// @param out The array receiving the floats.
+    /// @param count The number of elements in both arrays.
+    void Half::to_floats(const Half* in, float* out, std::size_t count)
+    {
+        Kernels::active().half_to_float(&in->bits, out, count);
+    }
+
+    /// @brief Converts an array of vectors to half precision.
+    ///
+    /// Both types are packed, so the array is converted as one run of
+    /// components.
+    ///
+    /// @param in The array of vectors.
+    /// @param out The array receiving the packed vectors.
+    /// @param count The number of vectors in both arrays.
+    void Vector3Half::pack(const Vector3* in, Vector3Half* out, std::size_t count)
+    {
+        Kernels::active().float_to_half(&in->x, &out->x.bits, 3 * count);
+    }
+
+    /// @brief Converts an array of half-precision vectors back to Vector3.
+    /// @param in The array of packed vectors.
+    /// @param out The array receiving the vectors.
+    /// @param count The number of vectors in both arrays.
+    void Vector3Half::unpack(const Vector3Half* in, Vector3* out, std::size_t count)
+    {
+        Kernels::active().half_to_float(&in->x.bits, &out->x, 3 * count);
+    }
+}
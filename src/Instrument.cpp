@@ -0,0 +1,261 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#if defined(MATH3D_X86_DISPATCH)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+#include "Dispatch.h"
+#include "Instrument.h"
+#include "Kernels.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Instrument
+    namespace Instrument
+    {
+#define MATH3D_KERNEL_NAME(entry) "kernel." #entry,
+
+        // The name of every counted operation: the header-only ones, in the
+        // order of Operation, then the bulk kernels, in the order of
+        // Kernels::Table.
+        static const char* const names[] = {
+            "Matrix3::inverse",
+            "Matrix3::inverse failures",
+            "Matrix3::operator*(Matrix3)",
+            "Matrix3::operator*(Vector3)",
+            "Vector3::normalize",
+            "Vector3::angle",
+            MATH3D_KERNEL_ENTRIES(MATH3D_KERNEL_NAME)
+        };
+
+#undef MATH3D_KERNEL_NAME
+
+        static const std::size_t operation_count = sizeof(names) / sizeof(names[0]);
+
+        static_assert(static_cast<std::size_t>(Operation::Count) == 6,
+            "Every Operation must be named.");
+
+        // The counters of one thread. Only their thread writes them, so the
+        // atomic additions are uncontended; they are atomic so that snapshot()
+        // and reset() may touch them from other threads.
+        struct ThreadCounters;
+
+        // Every live thread's counters, and the totals of the threads that
+        // exited. Never destroyed, since threads may exit after the static
+        // destructors have run.
+        struct Registry
+        {
+            std::mutex mutex;
+            std::vector<ThreadCounters*> threads;
+            std::uint64_t retired_calls[operation_count] = {};
+            std::uint64_t retired_ticks[operation_count] = {};
+        };
+
+        static Registry& registry()
+        {
+            static Registry* r = new Registry();
+            return *r;
+        }
+
+        struct ThreadCounters
+        {
+            std::atomic<std::uint64_t> calls[operation_count] = {};
+            std::atomic<std::uint64_t> ticks[operation_count] = {};
+
+            ThreadCounters()
+            {
+                Registry& r = registry();
+                const std::lock_guard<std::mutex> lock(r.mutex);
+                r.threads.push_back(this);
+            }
+
+            // Folds the thread's counts into the retired totals.
+            ~ThreadCounters()
+            {
+                Registry& r = registry();
+                const std::lock_guard<std::mutex> lock(r.mutex);
+
+                for (std::size_t i = 0; i < operation_count; ++i)
+                {
+                    r.retired_calls[i] += calls[i].load(std::memory_order_relaxed);
+                    r.retired_ticks[i] += ticks[i].load(std::memory_order_relaxed);
+                }
+
+                r.threads.erase(std::find(r.threads.begin(), r.threads.end(), this));
+            }
+        };
+
+        static ThreadCounters& local()
+        {
+            static thread_local ThreadCounters counters;
+            return counters;
+        }
+
+        // The nanoseconds per tick of now(), measured once over 10 ms.
+        static double nanoseconds_per_tick()
+        {
+#if defined(MATH3D_X86_DISPATCH)
+            static const double ratio = []()
+            {
+                typedef std::chrono::steady_clock Clock;
+                const Clock::time_point start = Clock::now();
+                const std::uint64_t start_ticks = now();
+                Clock::time_point end;
+
+                do
+                    end = Clock::now();
+                while (end - start < std::chrono::milliseconds(10));
+
+                const std::uint64_t ticks = now() - start_ticks;
+                return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(ticks);
+            }();
+
+            return ratio;
+#else
+            return 1.0;
+#endif
+        }
+
+        /// @brief Reads the clock the operations are timed with: the
+        /// timestamp counter on x86, a steady clock in nanoseconds elsewhere.
+        std::uint64_t now()
+        {
+#if defined(MATH3D_X86_DISPATCH)
+            return __rdtsc();
+#else
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+        }
+
+        /// @brief Records a call of an operation on the calling thread.
+        /// @param operation The index of the operation: an Operation, or
+        /// Operation::Count plus the index of a bulk kernel.
+        /// @param ticks The duration of the call, in ticks of now().
+        void record(std::size_t operation, std::uint64_t ticks)
+        {
+            ThreadCounters& counters = local();
+            counters.calls[operation].fetch_add(1, std::memory_order_relaxed);
+            counters.ticks[operation].fetch_add(ticks, std::memory_order_relaxed);
+        }
+
+        /// @brief Records untimed events of an operation on the calling
+        /// thread.
+        /// @param operation The operation.
+        /// @param events The number of events.
+        void count(Operation operation, std::uint64_t events)
+        {
+            local().calls[static_cast<std::size_t>(operation)].fetch_add(events, std::memory_order_relaxed);
+        }
+
+        /// @brief Merges the counters of every thread, live or exited.
+        ///
+        /// Threads that record while the snapshot is taken may be counted
+        /// partly; nothing is ever lost, it shows up in the next snapshot.
+        ///
+        /// @return The operations called at least once since the last
+        /// reset(), in a fixed order; always empty in builds that are not
+        /// instrumented.
+        std::vector<OperationStats> snapshot()
+        {
+            std::uint64_t calls[operation_count];
+            std::uint64_t ticks[operation_count];
+
+            {
+                Registry& r = registry();
+                const std::lock_guard<std::mutex> lock(r.mutex);
+
+                for (std::size_t i = 0; i < operation_count; ++i)
+                {
+                    calls[i] = r.retired_calls[i];
+                    ticks[i] = r.retired_ticks[i];
+                }
+
+                for (const ThreadCounters* t : r.threads)
+                {
+                    for (std::size_t i = 0; i < operation_count; ++i)
+                    {
+                        calls[i] += t->calls[i].load(std::memory_order_relaxed);
+                        ticks[i] += t->ticks[i].load(std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            std::vector<OperationStats> stats;
+
+            for (std::size_t i = 0; i < operation_count; ++i)
+            {
+                if (calls[i] == 0)
+                    continue;
+
+                OperationStats s;
+                s.name = names[i];
+                s.calls = calls[i];
+                s.ticks = ticks[i];
+                s.nanoseconds = static_cast<double>(ticks[i]) * nanoseconds_per_tick();
+                stats.push_back(s);
+            }
+
+            return stats;
+        }
+
+        /// @brief Sets the counters of every thread back to zero.
+        void reset()
+        {
+            Registry& r = registry();
+            const std::lock_guard<std::mutex> lock(r.mutex);
+
+            for (std::size_t i = 0; i < operation_count; ++i)
+            {
+                r.retired_calls[i] = 0;
+                r.retired_ticks[i] = 0;
+            }
+
+            for (ThreadCounters* t : r.threads)
+            {
+                for (std::size_t i = 0; i < operation_count; ++i)
+                {
+                    t->calls[i].store(0, std::memory_order_relaxed);
+                    t->ticks[i].store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /// @brief Writes a snapshot() as a JSON document, in the layout of the
+        /// benchmark results.
+        /// @param os The stream to write to.
+        void dump_json(std::ostream& os)
+        {
+            const std::vector<OperationStats> stats = snapshot();
+
+            os << "{\n  \"enabled\": " << (enabled ? "true" : "false")
+                << ",\n  \"simd_level\": \"" << simd_level_name(simd_level())
+                << "\",\n  \"operations\": [";
+
+            const std::streamsize precision = os.precision(6);
+
+            // The names are ours, and need no escaping.
+            for (std::size_t i = 0; i < stats.size(); ++i)
+            {
+                const OperationStats& s = stats[i];
+                os << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << s.name << "\""
+                    << ", \"calls\": " << s.calls
+                    << ", \"ticks\": " << s.ticks
+                    << ", \"nanoseconds\": " << s.nanoseconds << "}";
+            }
+
+            os << "\n  ]\n}\n";
+            os.precision(precision);
+        }
+    }
+}
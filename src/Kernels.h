@@ -0,0 +1,330 @@
+/// @file Kernels.h
+/// @brief This header file contains the table of bulk kernels the library
+/// dispatches through. It is private to the library.
+/// @author David Moncada
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// @def MATH3D_KERNEL_INLINE
+/// @brief Forces a per-element helper into the kernel loop calling it; a call
+/// left in the loop body keeps the loop from vectorizing.
+#if defined(_MSC_VER)
+#define MATH3D_KERNEL_INLINE __forceinline
+#else
+#define MATH3D_KERNEL_INLINE inline __attribute__((always_inline))
+#endif
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Kernels
+    namespace Kernels
+    {
+        /// @brief Kernel over two component arrays, producing three of them.
+        typedef void (*VectorVectorToVector)(
+            const float*, const float*, const float*,
+            const float*, const float*, const float*,
+            float*, float*, float*, std::size_t);
+
+        /// @brief Kernel over two component arrays, producing one scalar array.
+        typedef void (*VectorVectorToScalar)(
+            const float*, const float*, const float*,
+            const float*, const float*, const float*,
+            float*, std::size_t);
+
+        /// @brief Kernel over two component arrays and a scalar parameter.
+        typedef void (*VectorVectorScalarToVector)(
+            const float*, const float*, const float*,
+            const float*, const float*, const float*, float,
+            float*, float*, float*, std::size_t);
+
+        /// @brief Kernel over one component array, producing one scalar array.
+        typedef void (*VectorToScalar)(
+            const float*, const float*, const float*, float*, std::size_t);
+
+        /// @brief Kernel updating one component array in place.
+        typedef void (*VectorInPlace)(float*, float*, float*, std::size_t);
+
+        /// @brief Kernel applying a row-major 3x3 matrix to component arrays.
+        typedef void (*MatrixVectorToVector)(
+            const float*,
+            const float*, const float*, const float*,
+            float*, float*, float*, std::size_t);
+
+        /// @brief Kernel applying a row-major 3x3 matrix in place.
+        typedef void (*MatrixVectorInPlace)(const float*, float*, float*, float*, std::size_t);
+
+        /// @brief Kernel applying a row-major 3x3 matrix and a translation to
+        /// component arrays.
+        typedef void (*AffineVectorToVector)(
+            const float*, const float*,
+            const float*, const float*, const float*,
+            float*, float*, float*, std::size_t);
+
+        /// @brief Kernel applying a row-major 3x3 matrix and a translation in
+        /// place.
+        typedef void (*AffineVectorInPlace)(const float*, const float*, float*, float*, float*, std::size_t);
+
+        /// @brief Kernel over the nine lanes of a matrix batch, producing one
+        /// scalar array.
+        typedef void (*MatrixToScalar)(
+            const float*, const float*, const float*,
+            const float*, const float*, const float*,
+            const float*, const float*, const float*,
+            float*, std::size_t);
+
+        /// @brief Kernel over the nine lanes of a matrix batch, producing nine
+        /// lanes and a byte mask; returns the number of flagged entries.
+        typedef std::size_t (*MatrixToMatrixMasked)(
+            const float*, const float*, const float*,
+            const float*, const float*, const float*,
+            const float*, const float*, const float*,
+            float*, float*, float*,
+            float*, float*, float*,
+            float*, float*, float*,
+            unsigned char*, std::size_t);
+
+        /// @brief Kernel rotating an array of packed vectors (x, y, z) by an
+        /// array of packed quaternions (x, y, z, w), element by element.
+        typedef void (*QuaternionVectorToVector)(const float*, const float*, float*, std::size_t);
+
+        /// @brief Kernel over two arrays of packed quaternions and a scalar
+        /// parameter, producing one array of packed quaternions.
+        typedef void (*QuaternionQuaternionScalarToQuaternion)(
+            const float*, const float*, float, float*, std::size_t);
+
+        /// @brief Kernel reducing three component arrays to their bounding box,
+        /// written as (min x, min y, min z, max x, max y, max z).
+        typedef void (*VectorToBounds)(const float*, const float*, const float*, float*, std::size_t);
+
+        /// @brief Kernel reducing an array of packed vectors (x, y, z) to their
+        /// bounding box, written as for VectorToBounds.
+        typedef void (*PackedToBounds)(const float*, float*, std::size_t);
+
+        /// @brief Kernel testing one packed box against an array of packed
+        /// boxes, producing a byte mask; returns the number of flagged entries.
+        typedef std::size_t (*BoxBoxesMasked)(const float*, const float*, unsigned char*, std::size_t);
+
+        /// @brief Kernel testing a packet of rays, given as component arrays
+        /// of a fixed length, against one packed volume, up to per-ray maximum
+        /// distances; produces the entry distances and returns the mask of
+        /// the rays hitting.
+        typedef unsigned (*RayPacketVolume)(
+            const float*, const float*, const float*,
+            const float*, const float*, const float*,
+            const float*, const float*, float*);
+
+        /// @brief Kernel converting floats to half-precision bit patterns.
+        typedef void (*FloatToHalf)(const float*, std::uint16_t*, std::size_t);
+
+        /// @brief Kernel converting half-precision bit patterns to floats.
+        typedef void (*HalfToFloat)(const std::uint16_t*, float*, std::size_t);
+
+        /// @brief Kernel encoding component arrays of unit vectors as
+        /// interleaved octahedral coordinates of 8 bits each.
+        typedef void (*VectorToOct8)(const float*, const float*, const float*, std::int8_t*, std::size_t);
+
+        /// @brief Kernel encoding component arrays of unit vectors as
+        /// interleaved octahedral coordinates of 16 bits each.
+        typedef void (*VectorToOct16)(const float*, const float*, const float*, std::int16_t*, std::size_t);
+
+        /// @brief Kernel decoding 8-bit octahedral coordinates to component
+        /// arrays.
+        typedef void (*Oct8ToVector)(const std::int8_t*, float*, float*, float*, std::size_t);
+
+        /// @brief Kernel decoding 16-bit octahedral coordinates to component
+        /// arrays.
+        typedef void (*Oct16ToVector)(const std::int16_t*, float*, float*, float*, std::size_t);
+
+        /// @brief Kernel taking the dot product of decoded 8-bit octahedral
+        /// vectors with one packed vector.
+        typedef void (*Oct8VectorToScalar)(const std::int8_t*, const float*, float*, std::size_t);
+
+        /// @brief Kernel taking the dot product of decoded 16-bit octahedral
+        /// vectors with one packed vector.
+        typedef void (*Oct16VectorToScalar)(const std::int16_t*, const float*, float*, std::size_t);
+
+        /// @brief Kernel summing component arrays, shifted by a packed vector,
+        /// into doubles: the three sums, and for second-order kernels the six
+        /// distinct sums of the outer products, xx, xy, xz, yy, yz and zz.
+        typedef void (*VectorToMoments)(
+            const float*, const float*, const float*, const float*, double*, std::size_t);
+
+        /// @brief Kernel over the upper triangle of a symmetric matrix batch,
+        /// m00, m01, m02, m11, m12 and m22, producing three eigenvalue arrays
+        /// and the three components of each of the three eigenvectors.
+        typedef void (*SymmetricToEigen)(
+            const float*, const float*, const float*,
+            const float*, const float*, const float*,
+            float*, float*, float*,
+            float*, float*, float*,
+            float*, float*, float*,
+            float*, float*, float*,
+            std::size_t);
+
+        /// @brief Kernel over the nine lanes of a matrix batch, producing the
+        /// nine lanes of U, three singular value arrays and the nine lanes of
+        /// V.
+        typedef void (*MatrixToSvd)(
+            const float*, const float*, const float*,
+            const float*, const float*, const float*,
+            const float*, const float*, const float*,
+            float*, float*, float*,
+            float*, float*, float*,
+            float*, float*, float*,
+            float*, float*, float*,
+            float*, float*, float*,
+            float*, float*, float*,
+            float*, float*, float*, std::size_t);
+
+        /// @brief Kernel over the nine lanes of a matrix batch, producing the
+        /// nine lanes of two matrix batches.
+        typedef void (*MatrixToMatrixPair)(
+            const float*, const float*, const float*,
+            const float*, const float*, const float*,
+            const float*, const float*, const float*,
+            float*, float*, float*,
+            float*, float*, float*,
+            float*, float*, float*,
+            float*, float*, float*,
+            float*, float*, float*,
+            float*, float*, float*, std::size_t);
+
+        /// @brief Kernel updating the nine lanes of a matrix batch in place.
+        typedef void (*MatrixInPlace)(
+            float*, float*, float*,
+            float*, float*, float*,
+            float*, float*, float*, std::size_t);
+
+        /// @brief Kernel taking the dot product of component arrays with one
+        /// constant vector, producing one scalar array.
+        typedef void (*VectorConstantToScalar)(
+            const float*, const float*, const float*, const float*, float*, std::size_t);
+
+        /// @brief Kernel clamping a scalar array to a range, in place.
+        typedef void (*ScalarClampInPlace)(float*, float, float, std::size_t);
+
+        /// @brief The set of bulk kernels compiled for one instruction set.
+        ///
+        /// Every kernel assumes its arrays do not overlap, except for the
+        /// in-place ones; callers are responsible for going through a
+        /// temporary otherwise.
+        struct Table
+        {
+            // Vector3Batch.
+            VectorVectorToVector cross;
+            VectorVectorToScalar distance;
+            VectorVectorToScalar dot;
+            VectorVectorScalarToVector lerp;
+            VectorToScalar magnitude;
+            VectorInPlace normalize;
+            VectorVectorToVector project;
+            VectorVectorToVector reject;
+            VectorVectorToVector scale;
+
+            // Fast.
+            VectorVectorToScalar fast_angle;
+            VectorToScalar fast_magnitude;
+            VectorInPlace fast_normalize;
+
+            // Matrix3.
+            MatrixVectorToVector transform;
+            MatrixVectorInPlace transform_in_place;
+
+            // Transform.
+            AffineVectorToVector affine_transform;
+            AffineVectorInPlace affine_transform_in_place;
+
+            // Matrix3Batch.
+            MatrixToScalar determinant;
+            MatrixToMatrixMasked inverse;
+
+            // Quaternion.
+            QuaternionVectorToVector quaternion_rotate;
+            QuaternionQuaternionScalarToQuaternion quaternion_slerp;
+
+            // AABB.
+            VectorToBounds bounds;
+            PackedToBounds bounds_packed;
+            BoxBoxesMasked box_overlaps;
+
+            // RayPacket.
+            RayPacketVolume ray_box4;
+            RayPacketVolume ray_box8;
+            RayPacketVolume ray_sphere4;
+            RayPacketVolume ray_sphere8;
+
+            // Half.
+            FloatToHalf float_to_half;
+            HalfToFloat half_to_float;
+
+            // PackedNormal.
+            VectorToOct8 oct_encode16;
+            VectorToOct16 oct_encode32;
+            Oct8ToVector oct_decode16;
+            Oct16ToVector oct_decode32;
+            Oct8VectorToScalar oct_dot16;
+            Oct16VectorToScalar oct_dot32;
+
+            // Reductions.
+            VectorToMoments sum;
+            VectorToMoments moments;
+
+            // Symmetric eigendecomposition.
+            SymmetricToEigen symmetric_eigen;
+
+            // Singular value and polar decompositions.
+            MatrixToSvd svd;
+            MatrixToMatrixPair polar;
+            MatrixInPlace orthonormalize;
+
+            // Pipeline.
+            VectorConstantToScalar dot_constant;
+            ScalarClampInPlace clamp;
+        };
+
+/// @def MATH3D_KERNEL_ENTRIES
+/// @brief Applies a macro to the name of every entry of Table, in order;
+/// instrumented builds use it to wrap each kernel in a counter. Dispatch.cpp
+/// checks that it names as many entries as the table has.
+#define MATH3D_KERNEL_ENTRIES(X) \
+    X(cross) X(distance) X(dot) X(lerp) X(magnitude) X(normalize) \
+    X(project) X(reject) X(scale) \
+    X(fast_angle) X(fast_magnitude) X(fast_normalize) \
+    X(transform) X(transform_in_place) X(affine_transform) X(affine_transform_in_place) \
+    X(determinant) X(inverse) \
+    X(quaternion_rotate) X(quaternion_slerp) \
+    X(bounds) X(bounds_packed) X(box_overlaps) \
+    X(ray_box4) X(ray_box8) X(ray_sphere4) X(ray_sphere8) \
+    X(float_to_half) X(half_to_float) \
+    X(oct_encode16) X(oct_encode32) X(oct_decode16) X(oct_decode32) X(oct_dot16) X(oct_dot32) \
+    X(sum) X(moments) \
+    X(symmetric_eigen) \
+    X(svd) X(polar) X(orthonormalize) \
+    X(dot_constant) X(clamp)
+
+        /// @namespace Math3D::Kernels::Scalar
+        /// @brief Reference kernels, compiled without vectorization.
+        namespace Scalar { extern const Table table; }
+
+#if defined(MATH3D_X86_DISPATCH)
+        /// @namespace Math3D::Kernels::SSE42
+        /// @brief Kernels compiled for SSE4.2.
+        namespace SSE42 { extern const Table table; }
+
+        /// @namespace Math3D::Kernels::AVX2
+        /// @brief Kernels compiled for AVX2 and FMA.
+        namespace AVX2 { extern const Table table; }
+
+        /// @namespace Math3D::Kernels::AVX512
+        /// @brief Kernels compiled for AVX-512 (F, VL, DQ and BW).
+        namespace AVX512 { extern const Table table; }
+#endif
+
+        /// @brief The table selected by the current SIMD level.
+        const Table& active();
+    }
+}
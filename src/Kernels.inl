@@ -0,0 +1,1352 @@
+// The bulk kernels, compiled once per instruction set. Each Kernels*.cpp file
+// defines MATH3D_KERNEL_NAMESPACE and includes this file, and the build gives
+// that translation unit the matching target flags.
+//
+// Every kernel runs a branch-free loop over restrict-qualified arrays, so
+// the compiler turns it into packed SIMD instructions for whatever target the
+// file is built for. Everything here must have internal linkage, and this
+// file must not include headers defining inline functions: an out-of-line
+// copy compiled for, say, AVX2 could otherwise be picked by the linker and
+// executed on a CPU without it. That is why the C math functions are used
+// rather than the inline std:: overloads from <cmath>.
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// F16C converts eight halves per instruction. GCC and Clang announce it with
+// -mf16c; MSVC has no flag for it, but every AVX2 CPU carries it.
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define MATH3D_KERNEL_F16C
+#include <immintrin.h>
+#endif
+
+#include "Kernels.h"
+
+#ifndef MATH3D_KERNEL_NAMESPACE
+#error "MATH3D_KERNEL_NAMESPACE must be defined before including Kernels.inl"
+#endif
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Kernels
+    namespace Kernels
+    {
+        namespace MATH3D_KERNEL_NAMESPACE
+        {
+            // Vector3Batch.
+
+            static void cross(
+                const float* __restrict vx, const float* __restrict vy, const float* __restrict vz,
+                const float* __restrict wx, const float* __restrict wy, const float* __restrict wz,
+                float* __restrict ox, float* __restrict oy, float* __restrict oz, std::size_t n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    ox[i] = vy[i] * wz[i] - vz[i] * wy[i];
+                    oy[i] = vz[i] * wx[i] - vx[i] * wz[i];
+                    oz[i] = vx[i] * wy[i] - vy[i] * wx[i];
+                }
+            }
+
+            static void distance(
+                const float* __restrict vx, const float* __restrict vy, const float* __restrict vz,
+                const float* __restrict wx, const float* __restrict wy, const float* __restrict wz,
+                float* __restrict out, std::size_t n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const float dx = vx[i] - wx[i];
+                    const float dy = vy[i] - wy[i];
+                    const float dz = vz[i] - wz[i];
+                    out[i] = ::sqrtf(dx * dx + dy * dy + dz * dz);
+                }
+            }
+
+            static void dot(
+                const float* __restrict vx, const float* __restrict vy, const float* __restrict vz,
+                const float* __restrict wx, const float* __restrict wy, const float* __restrict wz,
+                float* __restrict out, std::size_t n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                    out[i] = vx[i] * wx[i] + vy[i] * wy[i] + vz[i] * wz[i];
+            }
+
+            static void lerp(
+                const float* __restrict vx, const float* __restrict vy, const float* __restrict vz,
+                const float* __restrict wx, const float* __restrict wy, const float* __restrict wz,
+                float t, float* __restrict ox, float* __restrict oy, float* __restrict oz, std::size_t n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    ox[i] = vx[i] + (wx[i] - vx[i]) * t;
+                    oy[i] = vy[i] + (wy[i] - vy[i]) * t;
+                    oz[i] = vz[i] + (wz[i] - vz[i]) * t;
+                }
+            }
+
+            static void magnitude(
+                const float* __restrict vx, const float* __restrict vy, const float* __restrict vz,
+                float* __restrict out, std::size_t n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                    out[i] = ::sqrtf(vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i]);
+            }
+
+            static void normalize(
+                float* __restrict vx, float* __restrict vy, float* __restrict vz, std::size_t n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const float t = 1.0f / ::sqrtf(vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i]);
+                    vx[i] *= t;
+                    vy[i] *= t;
+                    vz[i] *= t;
+                }
+            }
+
+            static void project(
+                const float* __restrict vx, const float* __restrict vy, const float* __restrict vz,
+                const float* __restrict wx, const float* __restrict wy, const float* __restrict wz,
+                float* __restrict ox, float* __restrict oy, float* __restrict oz, std::size_t n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const float vw = vx[i] * wx[i] + vy[i] * wy[i] + vz[i] * wz[i];
+                    const float ww = wx[i] * wx[i] + wy[i] * wy[i] + wz[i] * wz[i];
+                    const float s = vw / ww;
+                    ox[i] = wx[i] * s;
+                    oy[i] = wy[i] * s;
+                    oz[i] = wz[i] * s;
+                }
+            }
+
+            static void reject(
+                const float* __restrict vx, const float* __restrict vy, const float* __restrict vz,
+                const float* __restrict wx, const float* __restrict wy, const float* __restrict wz,
+                float* __restrict ox, float* __restrict oy, float* __restrict oz, std::size_t n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const float vw = vx[i] * wx[i] + vy[i] * wy[i] + vz[i] * wz[i];
+                    const float ww = wx[i] * wx[i] + wy[i] * wy[i] + wz[i] * wz[i];
+                    const float s = vw / ww;
+                    ox[i] = vx[i] - wx[i] * s;
+                    oy[i] = vy[i] - wy[i] * s;
+                    oz[i] = vz[i] - wz[i] * s;
+                }
+            }
+
+            static void scale(
+                const float* __restrict vx, const float* __restrict vy, const float* __restrict vz,
+                const float* __restrict wx, const float* __restrict wy, const float* __restrict wz,
+                float* __restrict ox, float* __restrict oy, float* __restrict oz, std::size_t n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    ox[i] = vx[i] * wx[i];
+                    oy[i] = vy[i] * wy[i];
+                    oz[i] = vz[i] * wz[i];
+                }
+            }
+
+            // Fast.
+
+            // Mirrors Fast::rsqrt(); the bits are reinterpreted through a union,
+            // which the vectorizer handles, rather than with memcpy.
+            static float fast_rsqrt(float x)
+            {
+                union { float f; int32_t i; } bits;
+                bits.f = x;
+                bits.i = 0x5f375a86 - (bits.i >> 1);
+
+                const float half = 0.5f * x;
+                float y = bits.f;
+                y = y * (1.5f - half * y * y);
+                y = y * (1.5f - half * y * y);
+                return y;
+            }
+
+            // Mirrors Fast::acos().
+            static float fast_acos(float x)
+            {
+                const float a = ::fabsf(x);
+                const float r = ::sqrtf(1.0f - a) *
+                    (1.5707288f + a * (-0.2121144f + a * (0.0742610f + a * -0.0187293f)));
+                return x < 0.0f ? 3.14159265f - r : r;
+            }
+
+            static void fast_angle(
+                const float* __restrict vx, const float* __restrict vy, const float* __restrict vz,
+                const float* __restrict wx, const float* __restrict wy, const float* __restrict wz,
+                float* __restrict out, std::size_t n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const float vw = vx[i] * wx[i] + vy[i] * wy[i] + vz[i] * wz[i];
+                    const float vv = vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i];
+                    const float ww = wx[i] * wx[i] + wy[i] * wy[i] + wz[i] * wz[i];
+
+                    float c = vw * fast_rsqrt(vv * ww);
+                    c = c < -1.0f ? -1.0f : c;
+                    c = c > 1.0f ? 1.0f : c;
+                    out[i] = 57.2957795f * fast_acos(c);
+                }
+            }
+
+            static void fast_magnitude(
+                const float* __restrict vx, const float* __restrict vy, const float* __restrict vz,
+                float* __restrict out, std::size_t n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const float s = vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i];
+                    out[i] = s * fast_rsqrt(s);
+                }
+            }
+
+            static void fast_normalize(
+                float* __restrict vx, float* __restrict vy, float* __restrict vz, std::size_t n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const float t = fast_rsqrt(vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i]);
+                    vx[i] *= t;
+                    vy[i] *= t;
+                    vz[i] *= t;
+                }
+            }
+
+            // Matrix3.
+
+            // The matrix is loaded into locals once, so it stays in registers
+            // while the loop processes several vectors per instruction.
+            static void transform(const float* __restrict m,
+                const float* __restrict x, const float* __restrict y, const float* __restrict z,
+                float* __restrict ox, float* __restrict oy, float* __restrict oz, std::size_t n)
+            {
+                const float m00 = m[0], m01 = m[1], m02 = m[2];
+                const float m10 = m[3], m11 = m[4], m12 = m[5];
+                const float m20 = m[6], m21 = m[7], m22 = m[8];
+
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const float vx = x[i], vy = y[i], vz = z[i];
+                    ox[i] = m00 * vx + m01 * vy + m02 * vz;
+                    oy[i] = m10 * vx + m11 * vy + m12 * vz;
+                    oz[i] = m20 * vx + m21 * vy + m22 * vz;
+                }
+            }
+
+            static void transform_in_place(const float* __restrict m,
+                float* __restrict x, float* __restrict y, float* __restrict z, std::size_t n)
+            {
+                const float m00 = m[0], m01 = m[1], m02 = m[2];
+                const float m10 = m[3], m11 = m[4], m12 = m[5];
+                const float m20 = m[6], m21 = m[7], m22 = m[8];
+
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const float vx = x[i], vy = y[i], vz = z[i];
+                    x[i] = m00 * vx + m01 * vy + m02 * vz;
+                    y[i] = m10 * vx + m11 * vy + m12 * vz;
+                    z[i] = m20 * vx + m21 * vy + m22 * vz;
+                }
+            }
+
+            // Transform.
+
+            static void affine_transform(const float* __restrict m, const float* __restrict t,
+                const float* __restrict x, const float* __restrict y, const float* __restrict z,
+                float* __restrict ox, float* __restrict oy, float* __restrict oz, std::size_t n)
+            {
+                const float m00 = m[0], m01 = m[1], m02 = m[2];
+                const float m10 = m[3], m11 = m[4], m12 = m[5];
+                const float m20 = m[6], m21 = m[7], m22 = m[8];
+                const float tx = t[0], ty = t[1], tz = t[2];
+
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const float vx = x[i], vy = y[i], vz = z[i];
+                    ox[i] = m00 * vx + m01 * vy + m02 * vz + tx;
+                    oy[i] = m10 * vx + m11 * vy + m12 * vz + ty;
+                    oz[i] = m20 * vx + m21 * vy + m22 * vz + tz;
+                }
+            }
+
+            static void affine_transform_in_place(const float* __restrict m, const float* __restrict t,
+                float* __restrict x, float* __restrict y, float* __restrict z, std::size_t n)
+            {
+                const float m00 = m[0], m01 = m[1], m02 = m[2];
+                const float m10 = m[3], m11 = m[4], m12 = m[5];
+                const float m20 = m[6], m21 = m[7], m22 = m[8];
+                const float tx = t[0], ty = t[1], tz = t[2];
+
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const float vx = x[i], vy = y[i], vz = z[i];
+                    x[i] = m00 * vx + m01 * vy + m02 * vz + tx;
+                    y[i] = m10 * vx + m11 * vy + m12 * vz + ty;
+                    z[i] = m20 * vx + m21 * vy + m22 * vz + tz;
+                }
+            }
+
+            // Matrix3Batch.
+
+            static void determinant(
+                const float* __restrict m00, const float* __restrict m01, const float* __restrict m02,
+                const float* __restrict m10, const float* __restrict m11, const float* __restrict m12,
+                const float* __restrict m20, const float* __restrict m21, const float* __restrict m22,
+                float* __restrict out, std::size_t n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    out[i] =
+                        m00[i] * (m11[i] * m22[i] - m12[i] * m21[i]) +
+                        m01[i] * (m12[i] * m20[i] - m10[i] * m22[i]) +
+                        m02[i] * (m10[i] * m21[i] - m11[i] * m20[i]);
+                }
+            }
+
+            // Mirrors Matrix3::inverse(): the rows of the inverse are the cross
+            // products of pairs of columns, divided by the determinant. Instead
+            // of branching on singular matrices, the reciprocal is always
+            // computed and then replaced by zero, which keeps the loop free of
+            // control flow.
+            static std::size_t inverse(
+                const float* __restrict m00, const float* __restrict m01, const float* __restrict m02,
+                const float* __restrict m10, const float* __restrict m11, const float* __restrict m12,
+                const float* __restrict m20, const float* __restrict m21, const float* __restrict m22,
+                float* __restrict o00, float* __restrict o01, float* __restrict o02,
+                float* __restrict o10, float* __restrict o11, float* __restrict o12,
+                float* __restrict o20, float* __restrict o21, float* __restrict o22,
+                unsigned char* __restrict singular, std::size_t n)
+            {
+                std::size_t count = 0;
+
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const float ux = m11[i] * m22[i] - m21[i] * m12[i];
+                    const float uy = m21[i] * m02[i] - m01[i] * m22[i];
+                    const float uz = m01[i] * m12[i] - m11[i] * m02[i];
+
+                    const float vx = m12[i] * m20[i] - m22[i] * m10[i];
+                    const float vy = m22[i] * m00[i] - m02[i] * m20[i];
+                    const float vz = m02[i] * m10[i] - m12[i] * m00[i];
+
+                    const float wx = m10[i] * m21[i] - m20[i] * m11[i];
+                    const float wy = m20[i] * m01[i] - m00[i] * m21[i];
+                    const float wz = m00[i] * m11[i] - m10[i] * m01[i];
+
+                    const float det = wx * m02[i] + wy * m12[i] + wz * m22[i];
+                    const bool is_singular = ::fabsf(det) < 0.000001f;
+                    const float reciprocal = 1.0f / det;
+                    const float inv_det = is_singular ? 0.0f : reciprocal;
+
+                    o00[i] = ux * inv_det; o01[i] = uy * inv_det; o02[i] = uz * inv_det;
+                    o10[i] = vx * inv_det; o11[i] = vy * inv_det; o12[i] = vz * inv_det;
+                    o20[i] = wx * inv_det; o21[i] = wy * inv_det; o22[i] = wz * inv_det;
+
+                    singular[i] = is_singular;
+                    count += is_singular;
+                }
+
+                return count;
+            }
+
+            // Quaternion.
+
+            // The arrays are packed Quaternion and Vector3 objects; the compiler
+            // deinterleaves them with shuffles. The rotation expands to
+            // v' = v + w t + u x t with t = 2 (u x v), where u is the vector
+            // part of the quaternion, which takes fewer operations than
+            // building the rotation matrix for every element.
+            static void quaternion_rotate(const float* __restrict q,
+                const float* __restrict v, float* __restrict out, std::size_t n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const float ux = q[4 * i], uy = q[4 * i + 1], uz = q[4 * i + 2], uw = q[4 * i + 3];
+                    const float vx = v[3 * i], vy = v[3 * i + 1], vz = v[3 * i + 2];
+
+                    const float tx = 2.0f * (uy * vz - uz * vy);
+                    const float ty = 2.0f * (uz * vx - ux * vz);
+                    const float tz = 2.0f * (ux * vy - uy * vx);
+
+                    out[3 * i] = vx + uw * tx + (uy * tz - uz * ty);
+                    out[3 * i + 1] = vy + uw * ty + (uz * tx - ux * tz);
+                    out[3 * i + 2] = vz + uw * tz + (ux * ty - uy * tx);
+                }
+            }
+
+            // Number of terms of the series used by quaternion_slerp.
+            static const int slerp_terms = 12;
+
+            // Evaluates sin(t theta) / sin(theta), with cos(theta) = x in [0,1],
+            // as the polynomial approximation by D. Eberly, "A Fast and Accurate
+            // Algorithm for Computing SLERP". The coefficients depend only on t,
+            // so they are computed once per call, and the series is evaluated
+            // with multiply-adds, without any acos, sin or division. With twelve
+            // terms the absolute error stays below 1e-6 over the whole domain.
+            static void quaternion_slerp(const float* __restrict a,
+                const float* __restrict b, float t, float* __restrict out, std::size_t n)
+            {
+                // Chosen to minimize the maximum error of the truncated series.
+                const float mu = 1.8938f;
+                const float s = 1.0f - t;
+
+                float ct[slerp_terms], cs[slerp_terms];
+
+                for (int k = 0; k < slerp_terms; ++k)
+                {
+                    const float i = static_cast<float>(k + 1);
+                    const float u = 1.0f / (i * (2.0f * i + 1.0f));
+                    const float v = i / (2.0f * i + 1.0f);
+                    const float scale = k == slerp_terms - 1 ? mu : 1.0f;
+                    ct[k] = (u * t * t - v) * scale;
+                    cs[k] = (u * s * s - v) * scale;
+                }
+
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const float ax = a[4 * i], ay = a[4 * i + 1], az = a[4 * i + 2], aw = a[4 * i + 3];
+                    const float bx = b[4 * i], by = b[4 * i + 1], bz = b[4 * i + 2], bw = b[4 * i + 3];
+
+                    // Interpolate along the shortest path.
+                    const float d = ax * bx + ay * by + az * bz + aw * bw;
+                    const float sign = d < 0.0f ? -1.0f : 1.0f;
+                    const float xm1 = d * sign - 1.0f;
+
+                    float ft = 1.0f, fs = 1.0f;
+
+                    for (int k = slerp_terms - 1; k >= 0; --k)
+                    {
+                        ft = 1.0f + ct[k] * xm1 * ft;
+                        fs = 1.0f + cs[k] * xm1 * fs;
+                    }
+
+                    const float wa = s * fs;
+                    const float wb = t * ft * sign;
+
+                    out[4 * i] = wa * ax + wb * bx;
+                    out[4 * i + 1] = wa * ay + wb * by;
+                    out[4 * i + 2] = wa * az + wb * bz;
+                    out[4 * i + 3] = wa * aw + wb * bw;
+                }
+            }
+
+            // AABB.
+
+            // Number of independent running minima and maxima kept by the bounds
+            // kernels. A reduction through a select does not vectorize by itself,
+            // since reordering it could change which of two equal values wins;
+            // keeping one accumulator per lane turns it into element-wise
+            // selects, which do. With fewer lanes, the compiler splits the
+            // accumulators into scalars instead of vectors.
+            static const std::size_t bounds_lanes = 32;
+
+            // Merges the per-lane accumulators and the leftover elements.
+            static void finish_bounds(const float* lo, const float* hi, float* __restrict out)
+            {
+                for (int c = 0; c < 3; ++c)
+                {
+                    for (std::size_t j = 0; j < bounds_lanes; ++j)
+                    {
+                        const float l = lo[c * bounds_lanes + j], h = hi[c * bounds_lanes + j];
+                        out[c] = l < out[c] ? l : out[c];
+                        out[3 + c] = h > out[3 + c] ? h : out[3 + c];
+                    }
+                }
+            }
+
+            // Reduces one component array to its smallest and largest values.
+            static void bounds_component(const float* __restrict p, std::size_t n,
+                float* __restrict min, float* __restrict max)
+            {
+                float lo[bounds_lanes], hi[bounds_lanes];
+
+                for (std::size_t j = 0; j < bounds_lanes; ++j)
+                {
+                    lo[j] = HUGE_VALF;
+                    hi[j] = -HUGE_VALF;
+                }
+
+                const std::size_t blocked = n - n % bounds_lanes;
+
+                for (std::size_t i = 0; i < blocked; i += bounds_lanes)
+                {
+                    for (std::size_t j = 0; j < bounds_lanes; ++j)
+                    {
+                        const float v = p[i + j];
+                        lo[j] = v < lo[j] ? v : lo[j];
+                        hi[j] = v > hi[j] ? v : hi[j];
+                    }
+                }
+
+                float l = HUGE_VALF, h = -HUGE_VALF;
+
+                for (std::size_t j = 0; j < bounds_lanes; ++j)
+                {
+                    l = lo[j] < l ? lo[j] : l;
+                    h = hi[j] > h ? hi[j] : h;
+                }
+
+                for (std::size_t i = blocked; i < n; ++i)
+                {
+                    l = p[i] < l ? p[i] : l;
+                    h = p[i] > h ? p[i] : h;
+                }
+
+                *min = l;
+                *max = h;
+            }
+
+            static void bounds(const float* __restrict x, const float* __restrict y,
+                const float* __restrict z, float* __restrict out, std::size_t n)
+            {
+                bounds_component(x, n, out, out + 3);
+                bounds_component(y, n, out + 1, out + 4);
+                bounds_component(z, n, out + 2, out + 5);
+            }
+
+            // The array holds packed Vector3 objects; every block of vectors is
+            // deinterleaved by the compiler with shuffles.
+            static void bounds_packed(const float* __restrict p, float* __restrict out, std::size_t n)
+            {
+                float lo[3 * bounds_lanes], hi[3 * bounds_lanes];
+
+                for (std::size_t j = 0; j < 3 * bounds_lanes; ++j)
+                {
+                    lo[j] = HUGE_VALF;
+                    hi[j] = -HUGE_VALF;
+                }
+
+                const std::size_t blocked = n - n % bounds_lanes;
+
+                for (std::size_t i = 0; i < blocked; i += bounds_lanes)
+                {
+                    for (std::size_t j = 0; j < bounds_lanes; ++j)
+                    {
+                        const float vx = p[3 * (i + j)], vy = p[3 * (i + j) + 1], vz = p[3 * (i + j) + 2];
+                        lo[j] = vx < lo[j] ? vx : lo[j];
+                        lo[bounds_lanes + j] = vy < lo[bounds_lanes + j] ? vy : lo[bounds_lanes + j];
+                        lo[2 * bounds_lanes + j] = vz < lo[2 * bounds_lanes + j] ? vz : lo[2 * bounds_lanes + j];
+                        hi[j] = vx > hi[j] ? vx : hi[j];
+                        hi[bounds_lanes + j] = vy > hi[bounds_lanes + j] ? vy : hi[bounds_lanes + j];
+                        hi[2 * bounds_lanes + j] = vz > hi[2 * bounds_lanes + j] ? vz : hi[2 * bounds_lanes + j];
+                    }
+                }
+
+                for (std::size_t i = blocked; i < n; ++i)
+                {
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        const float v = p[3 * i + c];
+                        lo[c * bounds_lanes] = v < lo[c * bounds_lanes] ? v : lo[c * bounds_lanes];
+                        hi[c * bounds_lanes] = v > hi[c * bounds_lanes] ? v : hi[c * bounds_lanes];
+                    }
+                }
+
+                for (int c = 0; c < 3; ++c)
+                {
+                    out[c] = HUGE_VALF;
+                    out[3 + c] = -HUGE_VALF;
+                }
+
+                finish_bounds(lo, hi, out);
+            }
+
+            // Both the box and the array hold packed AABB objects.
+            static std::size_t box_overlaps(const float* __restrict box,
+                const float* __restrict boxes, unsigned char* __restrict out, std::size_t n)
+            {
+                std::size_t count = 0;
+
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const float* b = boxes + 6 * i;
+                    const unsigned char overlap =
+                        (box[0] <= b[3]) & (b[0] <= box[3]) &
+                        (box[1] <= b[4]) & (b[1] <= box[4]) &
+                        (box[2] <= b[5]) & (b[2] <= box[5]);
+                    out[i] = overlap;
+                    count += overlap;
+                }
+
+                return count;
+            }
+
+            // Ray.
+
+            // The ray kernels run on packets of a fixed number of rays, so that
+            // the compiler can turn every loop into whole vectors with no
+            // remainder; with a run-time count, a packet narrower than the
+            // vector width would go down the scalar remainder loop. The lane
+            // flags are 32-bit, the width of the floats, for the same reason.
+
+            // The slab test, on rays given by their origins and the reciprocals
+            // of their directions. The entry distance is the largest of the
+            // distances at which the ray enters each pair of planes, and the
+            // exit distance the smallest at which it leaves one; the ray hits
+            // the box when it enters before it leaves. A direction component of
+            // zero has an infinite reciprocal, so the slab is either never left
+            // or never entered. The selects are written so that a NaN, from a
+            // zero times an infinity, leaves the running distances unchanged.
+            template <std::size_t N>
+            static unsigned ray_box(
+                const float* __restrict ox, const float* __restrict oy, const float* __restrict oz,
+                const float* __restrict ix, const float* __restrict iy, const float* __restrict iz,
+                const float* __restrict box, const float* __restrict t_max, float* __restrict t_near)
+            {
+                int hit[N];
+
+                for (std::size_t i = 0; i < N; ++i)
+                {
+                    const float x1 = (box[0] - ox[i]) * ix[i], x2 = (box[3] - ox[i]) * ix[i];
+                    const float y1 = (box[1] - oy[i]) * iy[i], y2 = (box[4] - oy[i]) * iy[i];
+                    const float z1 = (box[2] - oz[i]) * iz[i], z2 = (box[5] - oz[i]) * iz[i];
+
+                    float enter = 0.0f, exit = t_max[i];
+
+                    const float xn = x1 < x2 ? x1 : x2, xf = x1 < x2 ? x2 : x1;
+                    enter = xn > enter ? xn : enter;
+                    exit = xf < exit ? xf : exit;
+
+                    const float yn = y1 < y2 ? y1 : y2, yf = y1 < y2 ? y2 : y1;
+                    enter = yn > enter ? yn : enter;
+                    exit = yf < exit ? yf : exit;
+
+                    const float zn = z1 < z2 ? z1 : z2, zf = z1 < z2 ? z2 : z1;
+                    enter = zn > enter ? zn : enter;
+                    exit = zf < exit ? zf : exit;
+
+                    t_near[i] = enter;
+                    hit[i] = enter <= exit;
+                }
+
+                unsigned mask = 0;
+
+                for (std::size_t i = 0; i < N; ++i)
+                {
+                    mask |= static_cast<unsigned>(hit[i]) << i;
+                }
+
+                return mask;
+            }
+
+            // Solves |o + t d - c|^2 = r^2 for t, with the sphere packed as
+            // (center x, y, z, radius). The directions need not be unit
+            // vectors. A ray starting inside the sphere enters it at zero.
+            template <std::size_t N>
+            static unsigned ray_sphere(
+                const float* __restrict ox, const float* __restrict oy, const float* __restrict oz,
+                const float* __restrict dx, const float* __restrict dy, const float* __restrict dz,
+                const float* __restrict sphere, const float* __restrict t_max, float* __restrict t_near)
+            {
+                int hit[N];
+
+                for (std::size_t i = 0; i < N; ++i)
+                {
+                    const float px = ox[i] - sphere[0], py = oy[i] - sphere[1], pz = oz[i] - sphere[2];
+
+                    const float a = dx[i] * dx[i] + dy[i] * dy[i] + dz[i] * dz[i];
+                    const float b = px * dx[i] + py * dy[i] + pz * dz[i];
+                    const float c = px * px + py * py + pz * pz - sphere[3] * sphere[3];
+                    const float discriminant = b * b - a * c;
+
+                    const float root = ::sqrtf(discriminant > 0.0f ? discriminant : 0.0f);
+                    const float inv_a = 1.0f / a;
+                    const float t0 = (-b - root) * inv_a;
+                    const float t1 = (-b + root) * inv_a;
+                    const float enter = t0 > 0.0f ? t0 : 0.0f;
+
+                    t_near[i] = enter;
+                    hit[i] = (discriminant >= 0.0f) & (t1 >= 0.0f) & (enter <= t_max[i]);
+                }
+
+                unsigned mask = 0;
+
+                for (std::size_t i = 0; i < N; ++i)
+                {
+                    mask |= static_cast<unsigned>(hit[i]) << i;
+                }
+
+                return mask;
+            }
+
+            // Half.
+
+            // Converts floats to halves, rounding to nearest even. The bits are
+            // computed for the three possible cases and the right one selected,
+            // so that the loop has no branch. A half too small to be normal is
+            // found by adding 0.5: the float addition itself shifts the mantissa
+            // into place and rounds it. A normal half is found by rebiasing the
+            // exponent and rounding the mantissa up on a tie when it is odd;
+            // a carry out of the mantissa correctly bumps the exponent, which
+            // turns the values just below 2^16 into infinity. Anything at or
+            // above 2^16 is infinity, or a quiet NaN if it was a NaN.
+            static void float_to_half(const float* __restrict in, uint16_t* __restrict out, std::size_t n)
+            {
+                std::size_t i = 0;
+
+#if defined(MATH3D_KERNEL_F16C)
+                for (; i + 8 <= n; i += 8)
+                {
+                    const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), h);
+                }
+#endif
+
+                for (; i < n; ++i)
+                {
+                    uint32_t x;
+                    memcpy(&x, in + i, sizeof(x));
+
+                    const uint32_t sign = (x >> 16) & 0x8000u;
+                    x &= 0x7fffffffu;
+
+                    float f;
+                    memcpy(&f, &x, sizeof(f));
+                    f += 0.5f;
+
+                    uint32_t subnormal;
+                    memcpy(&subnormal, &f, sizeof(subnormal));
+                    subnormal -= 0x3f000000u;
+
+                    const uint32_t normal = (x + 0xc8000fffu + ((x >> 13) & 1u)) >> 13;
+                    const uint32_t special = x > 0x7f800000u ? 0x7e00u : 0x7c00u;
+
+                    uint32_t h = x < 0x38800000u ? subnormal : normal;
+                    h = x >= 0x47800000u ? special : h;
+                    out[i] = static_cast<uint16_t>(h | sign);
+                }
+            }
+
+            // Converts halves to floats, exactly. The exponent is rebiased, and
+            // rebiased again to all ones for infinities and NaNs. A subnormal
+            // half is given an implicit leading one, which a float subtraction
+            // then takes away again, leaving the value normalized.
+            static void half_to_float(const uint16_t* __restrict in, float* __restrict out, std::size_t n)
+            {
+                std::size_t i = 0;
+
+#if defined(MATH3D_KERNEL_F16C)
+                for (; i + 8 <= n; i += 8)
+                {
+                    const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                    _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+                }
+#endif
+
+                for (; i < n; ++i)
+                {
+                    const uint32_t h = in[i];
+                    const uint32_t shifted = (h & 0x7fffu) << 13;
+                    const uint32_t exponent = shifted & 0x0f800000u;
+
+                    uint32_t o = shifted + 0x38000000u;
+                    o += exponent == 0x0f800000u ? 0x38000000u : 0u;
+
+                    const uint32_t denormal_bits = o + 0x00800000u;
+                    float denormal;
+                    memcpy(&denormal, &denormal_bits, sizeof(denormal));
+                    denormal -= 6.103515625e-05f;
+
+                    uint32_t renormalized;
+                    memcpy(&renormalized, &denormal, sizeof(renormalized));
+                    o = exponent == 0 ? renormalized : o;
+                    o |= (h & 0x8000u) << 16;
+
+                    memcpy(out + i, &o, sizeof(o));
+                }
+            }
+
+            // PackedNormal.
+
+            // Octahedral encoding projects a unit vector onto the octahedron
+            // |x| + |y| + |z| = 1, folds the lower half over the upper one, and
+            // keeps the resulting x and y, each in [-1,1], as signed integers
+            // scaled to Max. Rounding is to nearest, away from zero on ties,
+            // written as a truncation so that it vectorizes.
+            template <typename C, int Max>
+            static void oct_encode(
+                const float* __restrict x, const float* __restrict y, const float* __restrict z,
+                C* __restrict out, std::size_t n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const float ax = x[i] < 0.0f ? -x[i] : x[i];
+                    const float ay = y[i] < 0.0f ? -y[i] : y[i];
+                    const float az = z[i] < 0.0f ? -z[i] : z[i];
+                    const float inv_l1 = 1.0f / (ax + ay + az);
+
+                    const float px = x[i] * inv_l1;
+                    const float py = y[i] * inv_l1;
+                    const float apx = ax * inv_l1;
+                    const float apy = ay * inv_l1;
+
+                    const float fx = (1.0f - apy) * (px < 0.0f ? -1.0f : 1.0f);
+                    const float fy = (1.0f - apx) * (py < 0.0f ? -1.0f : 1.0f);
+                    const float ex = (z[i] < 0.0f ? fx : px) * static_cast<float>(Max);
+                    const float ey = (z[i] < 0.0f ? fy : py) * static_cast<float>(Max);
+
+                    out[2 * i] = static_cast<C>(static_cast<int>(ex + (ex < 0.0f ? -0.5f : 0.5f)));
+                    out[2 * i + 1] = static_cast<C>(static_cast<int>(ey + (ey < 0.0f ? -0.5f : 0.5f)));
+                }
+            }
+
+            // Unfolds one octahedral coordinate pair into the unnormalized
+            // direction it encodes.
+            template <typename C, int Max>
+            static inline void oct_unfold(const C* __restrict in, std::size_t i, float& x, float& y, float& z)
+            {
+                const float ex = static_cast<float>(in[2 * i]) * (1.0f / static_cast<float>(Max));
+                const float ey = static_cast<float>(in[2 * i + 1]) * (1.0f / static_cast<float>(Max));
+                const float aex = ex < 0.0f ? -ex : ex;
+                const float aey = ey < 0.0f ? -ey : ey;
+
+                z = 1.0f - aex - aey;
+                const float t = z < 0.0f ? -z : 0.0f;
+                x = ex + (ex < 0.0f ? t : -t);
+                y = ey + (ey < 0.0f ? t : -t);
+            }
+
+            template <typename C, int Max>
+            static void oct_decode(
+                const C* __restrict in,
+                float* __restrict ox, float* __restrict oy, float* __restrict oz, std::size_t n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    float x, y, z;
+                    oct_unfold<C, Max>(in, i, x, y, z);
+
+                    const float inv = 1.0f / ::sqrtf(x * x + y * y + z * z);
+                    ox[i] = x * inv;
+                    oy[i] = y * inv;
+                    oz[i] = z * inv;
+                }
+            }
+
+            // Decodes in registers and dots with v, never storing the vectors.
+            template <typename C, int Max>
+            static void oct_dot(const C* __restrict in, const float* __restrict v, float* __restrict out, std::size_t n)
+            {
+                const float vx = v[0], vy = v[1], vz = v[2];
+
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    float x, y, z;
+                    oct_unfold<C, Max>(in, i, x, y, z);
+
+                    out[i] = (x * vx + y * vy + z * vz) / ::sqrtf(x * x + y * y + z * z);
+                }
+            }
+
+            // Reductions.
+
+            // Number of independent compensated accumulators kept per sum by
+            // the moment kernels; as for the bounds, one per lane lets the
+            // loop vectorize without reassociating anything.
+            static const std::size_t moment_lanes = 16;
+
+            // Adds v to the compensated sum (s, c), Kahan's way.
+            static inline void kahan_add(float& s, float& c, float v)
+            {
+                const float y = v - c;
+                const float t = s + y;
+                c = (t - s) - y;
+                s = t;
+            }
+
+            // Sums the coordinates, shifted by d, and if Second, their outer
+            // products. Element i goes to lane i % moment_lanes whatever the
+            // vector width, and the lanes are folded in order, in double.
+            template <bool Second>
+            static void moments_sum(
+                const float* __restrict x, const float* __restrict y, const float* __restrict z,
+                const float* __restrict d, double* __restrict out, std::size_t n)
+            {
+                const int sums = Second ? 9 : 3;
+                float s[9][moment_lanes], c[9][moment_lanes];
+
+                for (int k = 0; k < sums; ++k)
+                {
+                    for (std::size_t j = 0; j < moment_lanes; ++j)
+                    {
+                        s[k][j] = 0.0f;
+                        c[k][j] = 0.0f;
+                    }
+                }
+
+                const std::size_t blocked = n - n % moment_lanes;
+
+                for (std::size_t i = 0; i < blocked; i += moment_lanes)
+                {
+                    for (std::size_t j = 0; j < moment_lanes; ++j)
+                    {
+                        const float dx = x[i + j] - d[0];
+                        const float dy = y[i + j] - d[1];
+                        const float dz = z[i + j] - d[2];
+
+                        kahan_add(s[0][j], c[0][j], dx);
+                        kahan_add(s[1][j], c[1][j], dy);
+                        kahan_add(s[2][j], c[2][j], dz);
+
+                        if (Second)
+                        {
+                            kahan_add(s[3][j], c[3][j], dx * dx);
+                            kahan_add(s[4][j], c[4][j], dx * dy);
+                            kahan_add(s[5][j], c[5][j], dx * dz);
+                            kahan_add(s[6][j], c[6][j], dy * dy);
+                            kahan_add(s[7][j], c[7][j], dy * dz);
+                            kahan_add(s[8][j], c[8][j], dz * dz);
+                        }
+                    }
+                }
+
+                for (std::size_t i = blocked; i < n; ++i)
+                {
+                    const std::size_t j = i - blocked;
+                    const float dx = x[i] - d[0];
+                    const float dy = y[i] - d[1];
+                    const float dz = z[i] - d[2];
+
+                    kahan_add(s[0][j], c[0][j], dx);
+                    kahan_add(s[1][j], c[1][j], dy);
+                    kahan_add(s[2][j], c[2][j], dz);
+
+                    if (Second)
+                    {
+                        kahan_add(s[3][j], c[3][j], dx * dx);
+                        kahan_add(s[4][j], c[4][j], dx * dy);
+                        kahan_add(s[5][j], c[5][j], dx * dz);
+                        kahan_add(s[6][j], c[6][j], dy * dy);
+                        kahan_add(s[7][j], c[7][j], dy * dz);
+                        kahan_add(s[8][j], c[8][j], dz * dz);
+                    }
+                }
+
+                for (int k = 0; k < sums; ++k)
+                {
+                    double total = 0.0;
+
+                    for (std::size_t j = 0; j < moment_lanes; ++j)
+                        total += static_cast<double>(s[k][j]) - static_cast<double>(c[k][j]);
+
+                    out[k] = total;
+                }
+            }
+
+            // Symmetric eigendecomposition.
+
+            // Number of Jacobi sweeps run by the batched eigensolver. Instead
+            // of testing for convergence, which would split the lanes, every
+            // matrix gets the same number of sweeps: convergence is quadratic,
+            // and float matrices, random or with nearly repeated eigenvalues,
+            // reach the tolerance of Matrix3::symmetric_eigen() in four.
+            static const int eigen_sweeps = 4;
+
+            // Mirrors Matrix3::jacobi_rotate(); p and q are template
+            // parameters so that the matrices stay in registers.
+            template <int p, int q>
+            static inline void jacobi_rotate(float (&a)[3][3], float (&v)[3][3])
+            {
+                const int r = 3 - p - q;
+                const float apq = a[p][q];
+                const float d = a[q][q] - a[p][p];
+                const float denominator = ::fabsf(d) + ::sqrtf(d * d + 4.0f * apq * apq);
+                const float t = (d < 0.0f ? -2.0f * apq : 2.0f * apq) / (denominator > 0.0f ? denominator : 1.0f);
+                const float c = 1.0f / ::sqrtf(1.0f + t * t);
+                const float s = t * c;
+
+                a[p][p] -= t * apq;
+                a[q][q] += t * apq;
+                a[p][q] = a[q][p] = 0.0f;
+
+                const float arp = a[r][p], arq = a[r][q];
+                a[r][p] = a[p][r] = c * arp - s * arq;
+                a[r][q] = a[q][r] = s * arp + c * arq;
+
+                for (int k = 0; k < 3; ++k)
+                {
+                    const float vkp = v[k][p], vkq = v[k][q];
+                    v[k][p] = c * vkp - s * vkq;
+                    v[k][q] = s * vkp + c * vkq;
+                }
+            }
+
+            // Runs the given number of cyclic Jacobi sweeps, unrolled: a loop
+            // around the rotations would keep the loop over the matrices from
+            // vectorizing.
+            template <int sweeps>
+            static inline void jacobi_sweeps(float (&a)[3][3], float (&v)[3][3])
+            {
+                jacobi_rotate<0, 1>(a, v);
+                jacobi_rotate<0, 2>(a, v);
+                jacobi_rotate<1, 2>(a, v);
+
+                if constexpr (sweeps > 1)
+                    jacobi_sweeps<sweeps - 1>(a, v);
+            }
+
+            // Orders eigenpairs i and j by value, through selects.
+            template <int i, int j>
+            static inline void eigen_order(float (&l)[3], float (&v)[3][3])
+            {
+                const bool swap = l[j] < l[i];
+                const float li = l[i], lj = l[j];
+                l[i] = swap ? lj : li;
+                l[j] = swap ? li : lj;
+
+                for (int k = 0; k < 3; ++k)
+                {
+                    const float vi = v[k][i], vj = v[k][j];
+                    v[k][i] = swap ? vj : vi;
+                    v[k][j] = swap ? vi : vj;
+                }
+            }
+
+            // Mirrors Matrix3::symmetric_eigen() with a fixed sweep count; the
+            // whole solve stays in registers, one matrix per SIMD lane.
+            static void symmetric_eigen(
+                const float* __restrict m00, const float* __restrict m01, const float* __restrict m02,
+                const float* __restrict m11, const float* __restrict m12, const float* __restrict m22,
+                float* __restrict l0, float* __restrict l1, float* __restrict l2,
+                float* __restrict v0x, float* __restrict v0y, float* __restrict v0z,
+                float* __restrict v1x, float* __restrict v1y, float* __restrict v1z,
+                float* __restrict v2x, float* __restrict v2y, float* __restrict v2z,
+                std::size_t n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const float b00 = ::fabsf(m00[i]), b01 = ::fabsf(m01[i]), b02 = ::fabsf(m02[i]);
+                    const float b11 = ::fabsf(m11[i]), b12 = ::fabsf(m12[i]), b22 = ::fabsf(m22[i]);
+                    float largest = b00 > b01 ? b00 : b01;
+                    largest = b02 > largest ? b02 : largest;
+                    largest = b11 > largest ? b11 : largest;
+                    largest = b12 > largest ? b12 : largest;
+                    largest = b22 > largest ? b22 : largest;
+
+                    const float scale = largest > 0.0f ? largest : 1.0f;
+                    const float inv = 1.0f / scale;
+
+                    float a[3][3] = {
+                        { m00[i] * inv, m01[i] * inv, m02[i] * inv },
+                        { m01[i] * inv, m11[i] * inv, m12[i] * inv },
+                        { m02[i] * inv, m12[i] * inv, m22[i] * inv } };
+                    float v[3][3] = { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } };
+
+                    jacobi_sweeps<eigen_sweeps>(a, v);
+
+                    float l[3] = { a[0][0] * scale, a[1][1] * scale, a[2][2] * scale };
+                    eigen_order<0, 1>(l, v);
+                    eigen_order<1, 2>(l, v);
+                    eigen_order<0, 1>(l, v);
+
+                    l0[i] = l[0]; l1[i] = l[1]; l2[i] = l[2];
+                    v0x[i] = v[0][0]; v0y[i] = v[1][0]; v0z[i] = v[2][0];
+                    v1x[i] = v[0][1]; v1y[i] = v[1][1]; v1z[i] = v[2][1];
+                    v2x[i] = v[0][2]; v2y[i] = v[1][2]; v2z[i] = v[2][2];
+                }
+            }
+
+            // Singular value and polar decompositions.
+
+            // Number of Newton-Schulz steps run by the batched
+            // orthonormalization. Every step squares the distance to
+            // orthonormality, so three take a matrix 5% off to float precision,
+            // far more drift than rounding ever accumulates.
+            static const int orthonormalize_steps = 3;
+
+            // Mirrors Matrix3::givens_rotate(), for constant rows and column.
+            template <int p, int q, int col>
+            static inline void givens_rotate(float (&b)[3][3], float (&u)[3][3])
+            {
+                const float x = b[p][col], y = b[q][col];
+                const float r = ::sqrtf(x * x + y * y);
+                const float inv = 1.0f / (r > 0.0f ? r : 1.0f);
+                const float c = r > 0.0f ? x * inv : 1.0f;
+                const float s = y * inv;
+
+                for (int k = 0; k < 3; ++k)
+                {
+                    const float bpk = b[p][k], bqk = b[q][k];
+                    b[p][k] = c * bpk + s * bqk;
+                    b[q][k] = c * bqk - s * bpk;
+
+                    const float ukp = u[k][p], ukq = u[k][q];
+                    u[k][p] = c * ukp + s * ukq;
+                    u[k][q] = c * ukq - s * ukp;
+                }
+            }
+
+            // Mirrors Matrix3::svd() for one lane, with the fixed sweep count
+            // of the batched eigensolver; shared by the SVD and polar kernels.
+            static MATH3D_KERNEL_INLINE void svd3(const float (&m)[3][3], float (&u)[3][3], float (&s)[3], float (&v)[3][3])
+            {
+                float largest = 0.0f;
+                for (int i = 0; i < 3; ++i)
+                {
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        const float e = ::fabsf(m[i][j]);
+                        largest = e > largest ? e : largest;
+                    }
+                }
+
+                const float scale = largest > 0.0f ? largest : 1.0f;
+                const float inv = 1.0f / scale;
+
+                float a[3][3];
+                for (int i = 0; i < 3; ++i)
+                {
+                    for (int j = 0; j < 3; ++j)
+                        a[i][j] = m[i][j] * inv;
+                }
+
+                float ata[3][3];
+                for (int i = 0; i < 3; ++i)
+                {
+                    for (int j = 0; j < 3; ++j)
+                        ata[i][j] = a[0][i] * a[0][j] + a[1][i] * a[1][j] + a[2][i] * a[2][j];
+                }
+
+                for (int i = 0; i < 3; ++i)
+                {
+                    for (int j = 0; j < 3; ++j)
+                        v[i][j] = i == j ? 1.0f : 0.0f;
+                }
+
+                jacobi_sweeps<eigen_sweeps>(ata, v);
+
+                // Decreasing eigenvalues; then flip the last column if the
+                // swaps left V a reflection.
+                float l[3] = { ata[0][0], ata[1][1], ata[2][2] };
+                eigen_order<1, 0>(l, v);
+                eigen_order<2, 1>(l, v);
+                eigen_order<1, 0>(l, v);
+
+                const float det =
+                    v[0][2] * (v[1][0] * v[2][1] - v[2][0] * v[1][1]) +
+                    v[1][2] * (v[2][0] * v[0][1] - v[0][0] * v[2][1]) +
+                    v[2][2] * (v[0][0] * v[1][1] - v[1][0] * v[0][1]);
+                const float flip = det < 0.0f ? -1.0f : 1.0f;
+                v[0][2] *= flip;
+                v[1][2] *= flip;
+                v[2][2] *= flip;
+
+                float b[3][3];
+                for (int i = 0; i < 3; ++i)
+                {
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        b[i][j] = a[i][0] * v[0][j] + a[i][1] * v[1][j] + a[i][2] * v[2][j];
+                        u[i][j] = i == j ? 1.0f : 0.0f;
+                    }
+                }
+
+                givens_rotate<0, 1, 0>(b, u);
+                givens_rotate<0, 2, 0>(b, u);
+                givens_rotate<1, 2, 1>(b, u);
+
+                s[0] = b[0][0] * scale;
+                s[1] = b[1][1] * scale;
+                s[2] = b[2][2] * scale;
+            }
+
+            static void svd(
+                const float* __restrict m00, const float* __restrict m01, const float* __restrict m02,
+                const float* __restrict m10, const float* __restrict m11, const float* __restrict m12,
+                const float* __restrict m20, const float* __restrict m21, const float* __restrict m22,
+                float* __restrict u00, float* __restrict u01, float* __restrict u02,
+                float* __restrict u10, float* __restrict u11, float* __restrict u12,
+                float* __restrict u20, float* __restrict u21, float* __restrict u22,
+                float* __restrict s0, float* __restrict s1, float* __restrict s2,
+                float* __restrict v00, float* __restrict v01, float* __restrict v02,
+                float* __restrict v10, float* __restrict v11, float* __restrict v12,
+                float* __restrict v20, float* __restrict v21, float* __restrict v22,
+                std::size_t n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const float m[3][3] = {
+                        { m00[i], m01[i], m02[i] },
+                        { m10[i], m11[i], m12[i] },
+                        { m20[i], m21[i], m22[i] } };
+                    float u[3][3], s[3], v[3][3];
+
+                    svd3(m, u, s, v);
+
+                    u00[i] = u[0][0]; u01[i] = u[0][1]; u02[i] = u[0][2];
+                    u10[i] = u[1][0]; u11[i] = u[1][1]; u12[i] = u[1][2];
+                    u20[i] = u[2][0]; u21[i] = u[2][1]; u22[i] = u[2][2];
+                    s0[i] = s[0]; s1[i] = s[1]; s2[i] = s[2];
+                    v00[i] = v[0][0]; v01[i] = v[0][1]; v02[i] = v[0][2];
+                    v10[i] = v[1][0]; v11[i] = v[1][1]; v12[i] = v[1][2];
+                    v20[i] = v[2][0]; v21[i] = v[2][1]; v22[i] = v[2][2];
+                }
+            }
+
+            // Mirrors Matrix3::polar(): R = U V^T and S = V diag(s) V^T.
+            static void polar(
+                const float* __restrict m00, const float* __restrict m01, const float* __restrict m02,
+                const float* __restrict m10, const float* __restrict m11, const float* __restrict m12,
+                const float* __restrict m20, const float* __restrict m21, const float* __restrict m22,
+                float* __restrict r00, float* __restrict r01, float* __restrict r02,
+                float* __restrict r10, float* __restrict r11, float* __restrict r12,
+                float* __restrict r20, float* __restrict r21, float* __restrict r22,
+                float* __restrict s00, float* __restrict s01, float* __restrict s02,
+                float* __restrict s10, float* __restrict s11, float* __restrict s12,
+                float* __restrict s20, float* __restrict s21, float* __restrict s22,
+                std::size_t n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const float m[3][3] = {
+                        { m00[i], m01[i], m02[i] },
+                        { m10[i], m11[i], m12[i] },
+                        { m20[i], m21[i], m22[i] } };
+                    float u[3][3], s[3], v[3][3];
+
+                    svd3(m, u, s, v);
+
+                    float r[3][3], t[3][3];
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        for (int k = 0; k < 3; ++k)
+                        {
+                            r[j][k] = u[j][0] * v[k][0] + u[j][1] * v[k][1] + u[j][2] * v[k][2];
+                            t[j][k] = v[j][0] * s[0] * v[k][0] + v[j][1] * s[1] * v[k][1] + v[j][2] * s[2] * v[k][2];
+                        }
+                    }
+
+                    r00[i] = r[0][0]; r01[i] = r[0][1]; r02[i] = r[0][2];
+                    r10[i] = r[1][0]; r11[i] = r[1][1]; r12[i] = r[1][2];
+                    r20[i] = r[2][0]; r21[i] = r[2][1]; r22[i] = r[2][2];
+                    s00[i] = t[0][0]; s01[i] = t[0][1]; s02[i] = t[0][2];
+                    s10[i] = t[1][0]; s11[i] = t[1][1]; s12[i] = t[1][2];
+                    s20[i] = t[2][0]; s21[i] = t[2][1]; s22[i] = t[2][2];
+                }
+            }
+
+            // Mirrors Matrix3::orthonormalized() with a fixed step count.
+            static void orthonormalize(
+                float* __restrict m00, float* __restrict m01, float* __restrict m02,
+                float* __restrict m10, float* __restrict m11, float* __restrict m12,
+                float* __restrict m20, float* __restrict m21, float* __restrict m22,
+                std::size_t n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    float x[3][3] = {
+                        { m00[i], m01[i], m02[i] },
+                        { m10[i], m11[i], m12[i] },
+                        { m20[i], m21[i], m22[i] } };
+
+                    for (int step = 0; step < orthonormalize_steps; ++step)
+                    {
+                        float q[3][3];
+                        for (int j = 0; j < 3; ++j)
+                        {
+                            for (int k = 0; k < 3; ++k)
+                            {
+                                const float p = x[0][j] * x[0][k] + x[1][j] * x[1][k] + x[2][j] * x[2][k];
+                                q[j][k] = (j == k ? 1.5f : 0.0f) - 0.5f * p;
+                            }
+                        }
+
+                        float y[3][3];
+                        for (int j = 0; j < 3; ++j)
+                        {
+                            for (int k = 0; k < 3; ++k)
+                                y[j][k] = x[j][0] * q[0][k] + x[j][1] * q[1][k] + x[j][2] * q[2][k];
+                        }
+
+                        for (int j = 0; j < 3; ++j)
+                        {
+                            for (int k = 0; k < 3; ++k)
+                                x[j][k] = y[j][k];
+                        }
+                    }
+
+                    m00[i] = x[0][0]; m01[i] = x[0][1]; m02[i] = x[0][2];
+                    m10[i] = x[1][0]; m11[i] = x[1][1]; m12[i] = x[1][2];
+                    m20[i] = x[2][0]; m21[i] = x[2][1]; m22[i] = x[2][2];
+                }
+            }
+
+            // Pipeline.
+
+            static void dot_constant(const float* __restrict w,
+                const float* __restrict vx, const float* __restrict vy, const float* __restrict vz,
+                float* __restrict out, std::size_t n)
+            {
+                const float wx = w[0], wy = w[1], wz = w[2];
+
+                for (std::size_t i = 0; i < n; ++i)
+                    out[i] = vx[i] * wx + vy[i] * wy + vz[i] * wz;
+            }
+
+            // NaNs are passed through, as by std::clamp.
+            static void clamp(float* __restrict v, float lo, float hi, std::size_t n)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const float c = v[i] < lo ? lo : v[i];
+                    v[i] = hi < c ? hi : c;
+                }
+            }
+
+            /// @brief The kernels compiled for this instruction set.
+            const Table table =
+            {
+                cross,
+                distance,
+                dot,
+                lerp,
+                magnitude,
+                normalize,
+                project,
+                reject,
+                scale,
+                fast_angle,
+                fast_magnitude,
+                fast_normalize,
+                transform,
+                transform_in_place,
+                affine_transform,
+                affine_transform_in_place,
+                determinant,
+                inverse,
+                quaternion_rotate,
+                quaternion_slerp,
+                bounds,
+                bounds_packed,
+                box_overlaps,
+                ray_box<4>,
+                ray_box<8>,
+                ray_sphere<4>,
+                ray_sphere<8>,
+                float_to_half,
+                half_to_float,
+                oct_encode<int8_t, 127>,
+                oct_encode<int16_t, 32767>,
+                oct_decode<int8_t, 127>,
+                oct_decode<int16_t, 32767>,
+                oct_dot<int8_t, 127>,
+                oct_dot<int16_t, 32767>,
+                moments_sum<false>,
+                moments_sum<true>,
+                symmetric_eigen,
+                svd,
+                polar,
+                orthonormalize,
+                dot_constant,
+                clamp,
+            };
+        }
+    }
+}
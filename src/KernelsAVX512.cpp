@@ -0,0 +1,5 @@
+// The kernels built for AVX-512; only compiled in on x86.
+#if defined(MATH3D_X86_DISPATCH)
+#define MATH3D_KERNEL_NAMESPACE AVX512
+#include "Kernels.inl"
+#endif
@@ -0,0 +1,5 @@
+// The kernels built for SSE4.2; only compiled in on x86.
+#if defined(MATH3D_X86_DISPATCH)
+#define MATH3D_KERNEL_NAMESPACE SSE42
+#include "Kernels.inl"
+#endif
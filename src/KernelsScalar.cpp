@@ -0,0 +1,3 @@
+// The reference kernels, built without auto-vectorization so that every other level can be checked against them.
+#define MATH3D_KERNEL_NAMESPACE Scalar
+#include "Kernels.inl"
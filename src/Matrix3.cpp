@@ -1,221 +1,225 @@
+#include <algorithm>
+
+#include "Blocks.h"
+#include "Kernels.h"
 #include "Matrix3.h"
 
 /// @namespace Math3D
 namespace Math3D
 {
-    /// @brief Copy constructor for Matrix3.
-    Matrix3::Matrix3(const Matrix3& other)
-    {
-        for (int i = 0; i < 3; ++i)
-            for (int j = 0; j < 3; ++j)
-                _m[i][j] = other._m[i][j];
-    }
-
-    /// @brief Constructor for Matrix3.
-    Matrix3::Matrix3(
-        float m00, float m01, float m02,
-        float m10, float m11, float m12,
-        float m20, float m21, float m22)
-        : _m{ { m00, m01, m02 }, { m10, m11, m12 }, { m20, m21, m22 } } {}
-
-    /// @brief Constructor for Matrix3.
-    Matrix3::Matrix3(const Vector3& u, const Vector3& v, const Vector3& w)
-        : _m{ { u.x, v.x, w.x }, { u.y, v.y, w.y }, { u.z, v.z, w.z } } {}
-
-    /// @brief The determinant of this matrix.
-    ///
-    /// The determinant can be thought of as a sort of magnitude for the matrix.
-    /// It can be positive of negative depending on the orientation of the set of
-    /// vectors consisting of the n rows (or columns) of the matrix.
+    /// @brief Computes the eigendecomposition of every matrix in an array of
+    /// symmetric matrices.
     ///
-    /// The determinant is computed using _expansion by minors_, where _minor_ is
-    /// the determinant of a submatrix that excludes a row and a column.
+    /// The upper triangles are deinterleaved into blocks of lanes, which are
+    /// solved by the same vectorized kernel as Matrix3Batch::symmetric_eigen(),
+    /// one matrix per SIMD lane. Every matrix gets the same fixed number of
+    /// Jacobi sweeps, so results can differ from symmetric_eigen() in the last
+    /// bits.
     ///
-    /// @return The determinant of this matrix.
-    float Matrix3::determinant() const
+    /// @param in The array of matrices.
+    /// @param out The array receiving the eigendecompositions.
+    /// @param count The number of elements in both arrays.
+    template <>
+    void Matrix3::symmetric_eigen(const Matrix3* in, SymmetricEigen* out, std::size_t count)
     {
-        return
-            _m[0][0] * (_m[1][1] * _m[2][2] - _m[1][2] * _m[2][1]) +
-            _m[0][1] * (_m[1][2] * _m[2][0] - _m[1][0] * _m[2][2]) +
-            _m[0][2] * (_m[1][0] * _m[2][1] - _m[1][1] * _m[2][0]);
-    }
-
-    /// @brief The inverse of this matrix.
-    ///
-    /// The inverse is found using _Gauss-Jordan elimination_, in which elementary
-    /// row operations are successively applied to the matrix until it is
-    /// transformed into the identity matrix. A matrix has an inverse if and only
-    /// if its determinant is not zero.
-    ///
-    /// @return The inverse of this matrix as a new Matrix3.
-    Matrix3 Matrix3::inverse() const
-    {
-        const Vector3 a = (*this)[0];
-        const Vector3 b = (*this)[1];
-        const Vector3 c = (*this)[2];
-
-        Vector3 u = Vector3::cross(b, c);
-        Vector3 v = Vector3::cross(c, a);
-        Vector3 w = Vector3::cross(a, b);
-
-        float det = Vector3::dot(w, c);
+        const Kernels::Table& kernels = Kernels::active();
+        float a[6][Blocks::size], r[12][Blocks::size];
 
-        if (is_almost_equal(det, 0.0f, 0.000001))
+        for (std::size_t begin = 0; begin < count; begin += Blocks::size)
         {
-            throw "The determinant of the matrix is zero.";
+            const std::size_t n = std::min(Blocks::size, count - begin);
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const Matrix3& m = in[begin + i];
+                a[0][i] = m._m[0][0]; a[1][i] = m._m[0][1]; a[2][i] = m._m[0][2];
+                a[3][i] = m._m[1][1]; a[4][i] = m._m[1][2]; a[5][i] = m._m[2][2];
+            }
+
+            kernels.symmetric_eigen(a[0], a[1], a[2], a[3], a[4], a[5],
+                r[0], r[1], r[2], r[3], r[4], r[5], r[6], r[7], r[8], r[9], r[10], r[11], n);
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                SymmetricEigen& e = out[begin + i];
+                e.values = Vector3(r[0][i], r[1][i], r[2][i]);
+                e.vectors[0] = Vector3(r[3][i], r[4][i], r[5][i]);
+                e.vectors[1] = Vector3(r[6][i], r[7][i], r[8][i]);
+                e.vectors[2] = Vector3(r[9][i], r[10][i], r[11][i]);
+            }
         }
-
-        float inv_det = 1.0f / det;
-
-        u *= inv_det;
-        v *= inv_det;
-        w *= inv_det;
-
-        return Matrix3(u.x, u.y, u.z, v.x, v.y, v.z, w.x, w.y, w.z);
     }
 
-    /// @brief Returns the transpose of this matrix.
-    /// @return The transpose of this matrix as a new Matrix3.
-    Matrix3 Matrix3::transposed() const
+    // Deinterleaves n matrices into nine lanes, row-major.
+    static void to_lanes(const Matrix3* in, float (*lanes)[Blocks::size], std::size_t n)
     {
-        Matrix3 m = *this;
-        Matrix3::transpose(m);
-        return m;
-    }
-
-    /// @brief Overload for the parenthesis operator.
-    float& Matrix3::operator()(int row, int col)
-    {
-        if (is_in_range(row) && is_in_range(col))
+        for (std::size_t i = 0; i < n; ++i)
         {
-            return _m[row][col];
+            for (int j = 0; j < 9; ++j)
+                lanes[j][i] = in[i](j / 3, j % 3);
         }
-
-        throw std::out_of_range("Index out of range.");
     }
 
-    /// @brief Overload for the parenthesis operator.
-    const float& Matrix3::operator()(int row, int col) const
+    // The matrix at index i of nine lanes.
+    static Matrix3 from_lanes(const float (*lanes)[Blocks::size], std::size_t i)
     {
-        if (is_in_range(row) && is_in_range(col))
-        {
-            return _m[row][col];
-        }
-
-        throw std::out_of_range("Index out of range.");
+        return Matrix3(
+            lanes[0][i], lanes[1][i], lanes[2][i],
+            lanes[3][i], lanes[4][i], lanes[5][i],
+            lanes[6][i], lanes[7][i], lanes[8][i]);
     }
 
-    /// @brief Overload for the brackets operator.
-    Vector3 Matrix3::operator[](int col)
+    /// @brief Computes the singular value decomposition of every matrix in an
+    /// array.
+    ///
+    /// The matrices are deinterleaved into blocks of lanes, which are solved
+    /// by the same vectorized kernel as Matrix3Batch::svd(), one matrix per
+    /// SIMD lane, with a fixed number of Jacobi sweeps; results can differ
+    /// from svd() in the last bits.
+    ///
+    /// @param in The array of matrices.
+    /// @param out The array receiving the decompositions.
+    /// @param count The number of elements in both arrays.
+    template <>
+    void Matrix3::svd(const Matrix3* in, Svd* out, std::size_t count)
     {
-        return Vector3(_m[0][col], _m[1][col], _m[2][col]);
-    }
+        const Kernels::Table& kernels = Kernels::active();
+        float a[9][Blocks::size], u[9][Blocks::size], s[3][Blocks::size], v[9][Blocks::size];
 
-    /// @brief Overload for the brackets operator.
-    const Vector3 Matrix3::operator[](int col) const
-    {
-        return Vector3(_m[0][col], _m[1][col], _m[2][col]);
+        for (std::size_t begin = 0; begin < count; begin += Blocks::size)
+        {
+            const std::size_t n = std::min(Blocks::size, count - begin);
+
+            to_lanes(in + begin, a, n);
+
+            kernels.svd(a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8],
+                u[0], u[1], u[2], u[3], u[4], u[5], u[6], u[7], u[8],
+                s[0], s[1], s[2],
+                v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8], n);
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                Svd& d = out[begin + i];
+                d.u = from_lanes(u, i);
+                d.singular_values = Vector3(s[0][i], s[1][i], s[2][i]);
+                d.v = from_lanes(v, i);
+            }
+        }
     }
 
-    /// @brief Overload for the addition operator.
-    Matrix3 Matrix3::operator+(const Matrix3& other) const
+    /// @brief Computes the polar decomposition of every matrix in an array.
+    ///
+    /// Blocked and vectorized like the bulk svd(), with the same kernel as
+    /// Matrix3Batch::polar().
+    ///
+    /// @param in The array of matrices.
+    /// @param out The array receiving the decompositions.
+    /// @param count The number of elements in both arrays.
+    template <>
+    void Matrix3::polar(const Matrix3* in, PolarDecomposition* out, std::size_t count)
     {
-        return Matrix3(*this) += other;
-    }
+        const Kernels::Table& kernels = Kernels::active();
+        float a[9][Blocks::size], r[9][Blocks::size], t[9][Blocks::size];
 
-    /// @brief Overload for the subtraction operator.
-    Matrix3 Matrix3::operator-(const Matrix3& other) const
-    {
-        return Matrix3(*this) -= other;
-    }
+        for (std::size_t begin = 0; begin < count; begin += Blocks::size)
+        {
+            const std::size_t n = std::min(Blocks::size, count - begin);
 
-    /// @brief Overload for the multiplication operator.
-    Matrix3 Matrix3::operator*(const Matrix3& other) const
-    {
-        return Matrix3(
-            _m[0][0] * other._m[0][0] + _m[0][1] * other._m[1][0] + _m[0][2] * other._m[2][0],
-            _m[0][0] * other._m[0][1] + _m[0][1] * other._m[1][1] + _m[0][2] * other._m[2][1],
-            _m[0][0] * other._m[0][2] + _m[0][1] * other._m[1][2] + _m[0][2] * other._m[2][2],
-            _m[1][0] * other._m[0][0] + _m[1][1] * other._m[1][0] + _m[1][2] * other._m[2][0],
-            _m[1][0] * other._m[0][1] + _m[1][1] * other._m[1][1] + _m[1][2] * other._m[2][1],
-            _m[1][0] * other._m[0][2] + _m[1][1] * other._m[1][2] + _m[1][2] * other._m[2][2],
-            _m[2][0] * other._m[0][0] + _m[2][1] * other._m[1][0] + _m[2][2] * other._m[2][0],
-            _m[2][0] * other._m[0][1] + _m[2][1] * other._m[1][1] + _m[2][2] * other._m[2][1],
-            _m[2][0] * other._m[0][2] + _m[2][1] * other._m[1][2] + _m[2][2] * other._m[2][2]
-        );
-    }
+            to_lanes(in + begin, a, n);
 
-    /// @brief Overload for the multiplication operator.
-    Vector3 Matrix3::operator*(const Vector3& v) const
-    {
-        return Vector3(
-            _m[0][0] * v.x + _m[0][1] * v.y + _m[0][2] * v.z,
-            _m[1][0] * v.x + _m[1][1] * v.y + _m[1][2] * v.z,
-            _m[2][0] * v.x + _m[2][1] * v.y + _m[2][2] * v.z
-        );
+            kernels.polar(a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8],
+                r[0], r[1], r[2], r[3], r[4], r[5], r[6], r[7], r[8],
+                t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7], t[8], n);
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                out[begin + i].rotation = from_lanes(r, i);
+                out[begin + i].stretch = from_lanes(t, i);
+            }
+        }
     }
 
-    /// @brief Overload for the addition-assignment operator.
-    Matrix3& Matrix3::operator+=(const Matrix3& other)
+    /// @brief Orthonormalizes every matrix in an array of nearly orthonormal
+    /// matrices, in place.
+    ///
+    /// Blocked and vectorized like the bulk svd(), with the same kernel as
+    /// Matrix3Batch::orthonormalize(), which runs a fixed number of
+    /// Newton-Schulz steps instead of testing for convergence.
+    ///
+    /// @param matrices The array of matrices.
+    /// @param count The number of matrices.
+    template <>
+    void Matrix3::orthonormalize(Matrix3* matrices, std::size_t count)
     {
-        for (int i = 0; i < 3; ++i)
-            for (int j = 0; j < 3; ++j)
-                _m[i][j] += other._m[i][j];
+        const Kernels::Table& kernels = Kernels::active();
+        float a[9][Blocks::size];
 
-        return *this;
-    }
+        for (std::size_t begin = 0; begin < count; begin += Blocks::size)
+        {
+            const std::size_t n = std::min(Blocks::size, count - begin);
 
-    /// @brief Overload for the subtraction-assignment operator.
-    Matrix3& Matrix3::operator-=(const Matrix3& other)
-    {
-        for (int i = 0; i < 3; ++i)
-            for (int j = 0; j < 3; ++j)
-                _m[i][j] -= other._m[i][j];
+            to_lanes(matrices + begin, a, n);
+            kernels.orthonormalize(a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8], n);
 
-        return *this;
+            for (std::size_t i = 0; i < n; ++i)
+                matrices[begin + i] = from_lanes(a, i);
+        }
     }
 
-    /// @brief Overload for the assignment operator.
-    Matrix3& Matrix3::operator=(const Matrix3& other)
+    /// @brief Multiplies an array of vectors by this matrix.
+    ///
+    /// The vectors are deinterleaved into blocks of component arrays, which
+    /// are transformed by the same vectorized kernel as the batch overloads.
+    /// Every block is read before it is written, so @p out may be the same
+    /// array as @p in, but the two must not otherwise overlap.
+    ///
+    /// @param in The array of vectors to transform.
+    /// @param out The array receiving the transformed vectors.
+    /// @param count The number of vectors in both arrays.
+    template <>
+    void Matrix3::transform(const Vector3* in, Vector3* out, std::size_t count) const
     {
-        if (this != &other)
-            for (int i = 0; i < 3; ++i)
-                for (int j = 0; j < 3; ++j)
-                    _m[i][j] = other._m[i][j];
+        const Kernels::Table& kernels = Kernels::active();
 
-        return *this;
+        Blocks::transform(in, out, count, [&](float* x, float* y, float* z, std::size_t n) {
+            kernels.transform_in_place(&_m[0][0], x, y, z, n);
+        });
     }
 
-    /// @brief Overload for the equality comparison operator.
-    bool Matrix3::operator==(const Matrix3& other) const
+    /// @brief Multiplies an array of vectors by this matrix, in place.
+    /// @param vectors The array of vectors to transform.
+    /// @param count The number of vectors in the array.
+    template <>
+    void Matrix3::transform(Vector3* vectors, std::size_t count) const
     {
-        for (int i = 0; i < 3; ++i)
-            for (int j = 0; j < 3; ++j)
-                if (!is_almost_equal(_m[i][j], other._m[i][j]))
-                    return false;
-
-        return true;
+        transform(vectors, vectors, count);
     }
 
-    /// @brief Overload for the to_string() member function in the base class.
-    std::ostream& Matrix3::to_string(std::ostream& os) const
+    /// @brief Multiplies every vector in a batch by this matrix.
+    /// @param in The Vector3Batch to transform.
+    /// @param out The Vector3Batch receiving the transformed vectors; it is
+    /// resized to match the input, and may be the input itself.
+    template <>
+    void Matrix3::transform(const Vector3Batch& in, Vector3Batch& out) const
     {
-        for (int i = 0; i < 3; ++i)
+        if (&in == &out)
         {
-            os << '|';
-
-            for (int j = 0; j < 3; ++j)
-                os << ' ' << std::fixed << std::setw(3) << _m[i][j];
-
-            os << " |" << std::endl;
+            transform(out);
+            return;
         }
 
-        return os;
+        out.resize(in.size());
+        Kernels::active().transform(&_m[0][0],
+            in.x.data(), in.y.data(), in.z.data(),
+            out.x.data(), out.y.data(), out.z.data(), in.size());
     }
 
-    // Determines if the given index is within range.
-    bool Matrix3::is_in_range(int index) const
+    /// @brief Multiplies every vector in a batch by this matrix, in place.
+    /// @param vectors The Vector3Batch to transform.
+    template <>
+    void Matrix3::transform(Vector3Batch& vectors) const
     {
-        return 0 <= index && index < 3;
+        Kernels::active().transform_in_place(&_m[0][0],
+            vectors.x.data(), vectors.y.data(), vectors.z.data(), vectors.size());
     }
-}
\ No newline at end of file
+}
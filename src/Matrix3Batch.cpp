@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "Config.h"
+#include "Instrument.h"
+#include "Kernels.h"
+#include "Matrix3Batch.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    // Number of matrices inverted at a time when the caller wants no mask, so
+    // that the mask the kernel writes fits on the stack.
+    static const std::size_t mask_block = 1024;
+
+    /// @brief Computes the determinant of every matrix.
+    void Matrix3Batch::determinant(const Matrix3Batch& in, float* out)
+    {
+        const AlignedVector<float> (&m)[3][3] = in.m;
+
+        Kernels::active().determinant(
+            m[0][0].data(), m[0][1].data(), m[0][2].data(),
+            m[1][0].data(), m[1][1].data(), m[1][2].data(),
+            m[2][0].data(), m[2][1].data(), m[2][2].data(), out, in.size());
+    }
+
+    /// @brief Computes the inverse of every matrix.
+    std::size_t Matrix3Batch::inverse(const Matrix3Batch& in, Matrix3Batch& out, unsigned char* singular)
+    {
+        if (&out == &in)
+        {
+            Matrix3Batch tmp;
+            const std::size_t count = inverse(in, tmp, singular);
+            out = std::move(tmp);
+            return count;
+        }
+
+        out.resize(in.size());
+
+        const Kernels::Table& kernels = Kernels::active();
+        const AlignedVector<float> (&m)[3][3] = in.m;
+        AlignedVector<float> (&o)[3][3] = out.m;
+
+        const auto invert = [&](std::size_t begin, std::size_t n, unsigned char* mask) {
+            return kernels.inverse(
+                m[0][0].data() + begin, m[0][1].data() + begin, m[0][2].data() + begin,
+                m[1][0].data() + begin, m[1][1].data() + begin, m[1][2].data() + begin,
+                m[2][0].data() + begin, m[2][1].data() + begin, m[2][2].data() + begin,
+                o[0][0].data() + begin, o[0][1].data() + begin, o[0][2].data() + begin,
+                o[1][0].data() + begin, o[1][1].data() + begin, o[1][2].data() + begin,
+                o[2][0].data() + begin, o[2][1].data() + begin, o[2][2].data() + begin, mask, n);
+        };
+
+        std::size_t count = 0;
+
+        if (singular != nullptr)
+        {
+            count = invert(0, in.size(), singular);
+        }
+        else
+        {
+            // The kernel always writes the mask; a block's worth of scratch
+            // on the stack keeps the call free of heap allocations.
+            unsigned char scratch[mask_block];
+
+            for (std::size_t begin = 0; begin < in.size(); begin += mask_block)
+                count += invert(begin, std::min(mask_block, in.size() - begin), scratch);
+        }
+
+        MATH3D_INSTRUMENT_COUNT(Instrument::Operation::Matrix3InverseFailure, count);
+        return count;
+    }
+
+    /// @brief Computes the eigendecomposition of every symmetric matrix.
+    void Matrix3Batch::symmetric_eigen(const Matrix3Batch& in, Vector3Batch& values, Vector3Batch (&vectors)[3])
+    {
+        values.resize(in.size());
+        for (Vector3Batch& v : vectors)
+            v.resize(in.size());
+
+        const AlignedVector<float> (&m)[3][3] = in.m;
+
+        Kernels::active().symmetric_eigen(
+            m[0][0].data(), m[0][1].data(), m[0][2].data(),
+            m[1][1].data(), m[1][2].data(), m[2][2].data(),
+            values.x.data(), values.y.data(), values.z.data(),
+            vectors[0].x.data(), vectors[0].y.data(), vectors[0].z.data(),
+            vectors[1].x.data(), vectors[1].y.data(), vectors[1].z.data(),
+            vectors[2].x.data(), vectors[2].y.data(), vectors[2].z.data(), in.size());
+    }
+
+    /// @brief Computes the singular value decomposition of every matrix.
+    void Matrix3Batch::svd(const Matrix3Batch& in, Matrix3Batch& u, Vector3Batch& s, Matrix3Batch& v)
+    {
+        if (&u == &v)
+        {
+            MATH3D_THROW(std::invalid_argument("The two rotations cannot share a batch."));
+        }
+
+        if (&u == &in || &v == &in)
+        {
+            const Matrix3Batch copy(in);
+            svd(copy, u, s, v);
+            return;
+        }
+
+        u.resize(in.size());
+        s.resize(in.size());
+        v.resize(in.size());
+
+        const AlignedVector<float> (&m)[3][3] = in.m;
+        AlignedVector<float> (&um)[3][3] = u.m;
+        AlignedVector<float> (&vm)[3][3] = v.m;
+
+        Kernels::active().svd(
+            m[0][0].data(), m[0][1].data(), m[0][2].data(),
+            m[1][0].data(), m[1][1].data(), m[1][2].data(),
+            m[2][0].data(), m[2][1].data(), m[2][2].data(),
+            um[0][0].data(), um[0][1].data(), um[0][2].data(),
+            um[1][0].data(), um[1][1].data(), um[1][2].data(),
+            um[2][0].data(), um[2][1].data(), um[2][2].data(),
+            s.x.data(), s.y.data(), s.z.data(),
+            vm[0][0].data(), vm[0][1].data(), vm[0][2].data(),
+            vm[1][0].data(), vm[1][1].data(), vm[1][2].data(),
+            vm[2][0].data(), vm[2][1].data(), vm[2][2].data(), in.size());
+    }
+
+    /// @brief Computes the polar decomposition of every matrix.
+    void Matrix3Batch::polar(const Matrix3Batch& in, Matrix3Batch& rotation, Matrix3Batch& stretch)
+    {
+        if (&rotation == &stretch)
+        {
+            MATH3D_THROW(std::invalid_argument("The rotation and the stretch cannot share a batch."));
+        }
+
+        if (&rotation == &in || &stretch == &in)
+        {
+            const Matrix3Batch copy(in);
+            polar(copy, rotation, stretch);
+            return;
+        }
+
+        rotation.resize(in.size());
+        stretch.resize(in.size());
+
+        const AlignedVector<float> (&m)[3][3] = in.m;
+        AlignedVector<float> (&r)[3][3] = rotation.m;
+        AlignedVector<float> (&t)[3][3] = stretch.m;
+
+        Kernels::active().polar(
+            m[0][0].data(), m[0][1].data(), m[0][2].data(),
+            m[1][0].data(), m[1][1].data(), m[1][2].data(),
+            m[2][0].data(), m[2][1].data(), m[2][2].data(),
+            r[0][0].data(), r[0][1].data(), r[0][2].data(),
+            r[1][0].data(), r[1][1].data(), r[1][2].data(),
+            r[2][0].data(), r[2][1].data(), r[2][2].data(),
+            t[0][0].data(), t[0][1].data(), t[0][2].data(),
+            t[1][0].data(), t[1][1].data(), t[1][2].data(),
+            t[2][0].data(), t[2][1].data(), t[2][2].data(), in.size());
+    }
+
+    /// @brief Orthonormalizes every matrix in place.
+    void Matrix3Batch::orthonormalize(Matrix3Batch& matrices)
+    {
+        AlignedVector<float> (&m)[3][3] = matrices.m;
+
+        Kernels::active().orthonormalize(
+            m[0][0].data(), m[0][1].data(), m[0][2].data(),
+            m[1][0].data(), m[1][1].data(), m[1][2].data(),
+            m[2][0].data(), m[2][1].data(), m[2][2].data(), matrices.size());
+    }
+
+    /// @brief Constructor for Matrix3Batch.
+    /// @param size The number of zero matrices in the batch.
+    Matrix3Batch::Matrix3Batch(std::size_t size)
+    {
+        resize(size);
+    }
+
+    /// @brief Constructor for Matrix3Batch.
+    /// @param matrices The matrices to copy into the batch.
+    Matrix3Batch::Matrix3Batch(const std::vector<Matrix3>& matrices)
+    {
+        resize(matrices.size());
+
+        for (std::size_t k = 0; k < matrices.size(); ++k)
+            set(k, matrices[k]);
+    }
+
+    /// @brief Removes every matrix from the batch.
+    void Matrix3Batch::clear()
+    {
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                m[i][j].clear();
+    }
+
+    /// @brief Checks whether the batch holds no matrices.
+    /// @return @c true if the batch is empty, @c false otherwise.
+    bool Matrix3Batch::empty() const
+    {
+        return m[0][0].empty();
+    }
+
+    /// @brief Appends a matrix to the end of the batch.
+    void Matrix3Batch::push_back(const Matrix3& matrix)
+    {
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                m[i][j].push_back(matrix(i, j));
+    }
+
+    /// @brief Reserves storage for at least the given number of matrices.
+    void Matrix3Batch::reserve(std::size_t size)
+    {
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                m[i][j].reserve(size);
+    }
+
+    /// @brief Resizes the batch, padding it with zero matrices if it grows.
+    void Matrix3Batch::resize(std::size_t size)
+    {
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                m[i][j].resize(size);
+    }
+
+    /// @brief Overwrites the matrix at the given index.
+    void Matrix3Batch::set(std::size_t index, const Matrix3& matrix)
+    {
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                m[i][j][index] = matrix(i, j);
+    }
+
+    /// @brief The number of matrices in the batch.
+    std::size_t Matrix3Batch::size() const
+    {
+        return m[0][0].size();
+    }
+
+    /// @brief Converts the batch back into an array of structures.
+    /// @return A std::vector holding a copy of every matrix in the batch.
+    std::vector<Matrix3> Matrix3Batch::to_vector() const
+    {
+        std::vector<Matrix3> matrices;
+        matrices.reserve(size());
+
+        for (std::size_t k = 0; k < size(); ++k)
+            matrices.push_back((*this)[k]);
+
+        return matrices;
+    }
+
+    /// @brief Overload for the brackets operator.
+    Matrix3 Matrix3Batch::operator[](std::size_t index) const
+    {
+        return Matrix3(
+            m[0][0][index], m[0][1][index], m[0][2][index],
+            m[1][0][index], m[1][1][index], m[1][2][index],
+            m[2][0][index], m[2][1][index], m[2][2][index]);
+    }
+}
@@ -0,0 +1,312 @@
+#include <atomic>
+#include <cstdint>
+#include <new>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "Memory.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    static std::atomic<std::size_t> allocation_count(0);
+    static std::atomic<std::size_t> deallocation_count(0);
+    static std::atomic<std::size_t> bytes_allocated(0);
+
+    static void count_allocation(std::size_t bytes)
+    {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    static void count_deallocation(std::size_t bytes)
+    {
+        deallocation_count.fetch_add(1, std::memory_order_relaxed);
+        bytes_allocated.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    /// @brief Reads the allocation counters.
+    ///
+    /// The counters are updated without synchronization beyond atomicity, so
+    /// a snapshot taken while other threads allocate may be slightly stale.
+    ///
+    /// @return The counters.
+    MemoryStats memory_stats()
+    {
+        MemoryStats stats;
+        stats.allocations = allocation_count.load(std::memory_order_relaxed);
+        stats.deallocations = deallocation_count.load(std::memory_order_relaxed);
+        stats.bytes_in_use = bytes_allocated.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    /// @brief Sets the allocation and deallocation counts back to zero.
+    ///
+    /// The number of bytes in use is a measure of live memory, not a count,
+    /// and is left untouched.
+    void reset_memory_stats()
+    {
+        allocation_count.store(0, std::memory_order_relaxed);
+        deallocation_count.store(0, std::memory_order_relaxed);
+    }
+
+    /// @brief Allocates aligned, uninitialized memory, counted in
+    /// memory_stats().
+    /// @param bytes The number of bytes.
+    /// @param alignment The alignment of the memory, a power of two.
+    /// @return The memory; release it with aligned_deallocate().
+    /// @throw std::bad_alloc If the memory cannot be allocated.
+    void* aligned_allocate(std::size_t bytes, std::size_t alignment)
+    {
+        void* p = ::operator new(bytes, std::align_val_t(alignment));
+        count_allocation(bytes);
+        return p;
+    }
+
+    /// @brief Releases memory allocated with aligned_allocate().
+    /// @param p The memory, or nullptr.
+    /// @param bytes The number of bytes it was allocated with.
+    /// @param alignment The alignment it was allocated with.
+    void aligned_deallocate(void* p, std::size_t bytes, std::size_t alignment)
+    {
+        if (p == nullptr)
+            return;
+
+        ::operator delete(p, std::align_val_t(alignment));
+        count_deallocation(bytes);
+    }
+
+    // The header at the start of every arena block; the allocations follow
+    // it, from the next simd_alignment boundary.
+    struct Arena::Block
+    {
+        Block* next;
+        std::size_t size;
+        bool mapped;
+        bool huge;
+    };
+
+    static const std::size_t block_header = simd_alignment;
+    static const std::size_t huge_page_size = 2 * 1024 * 1024;
+
+    // Maps size bytes of huge pages, rounding size up, or returns nullptr.
+    static void* map_huge_pages(std::size_t& size, bool& huge)
+    {
+        size = (size + huge_page_size - 1) & ~(huge_page_size - 1);
+
+#if defined(_WIN32)
+        const std::size_t large = GetLargePageMinimum();
+        if (large != 0)
+        {
+            const std::size_t rounded = (size + large - 1) & ~(large - 1);
+            void* p = VirtualAlloc(nullptr, rounded, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+            if (p != nullptr)
+            {
+                size = rounded;
+                huge = true;
+                return p;
+            }
+        }
+
+        // Large pages need a privilege most accounts lack; map ordinary ones.
+        huge = false;
+        return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+        void* p = MAP_FAILED;
+        huge = false;
+
+#if defined(MAP_HUGETLB)
+        p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        huge = p != MAP_FAILED;
+#endif
+
+        // No huge pages reserved; ask for transparent ones instead.
+        if (p == MAP_FAILED)
+        {
+            p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED)
+                return nullptr;
+
+#if defined(MADV_HUGEPAGE)
+            huge = ::madvise(p, size, MADV_HUGEPAGE) == 0;
+#endif
+        }
+
+        return p;
+#endif
+    }
+
+    static void unmap_pages(void* p, std::size_t size)
+    {
+#if defined(_WIN32)
+        (void)size;
+        VirtualFree(p, 0, MEM_RELEASE);
+#else
+        ::munmap(p, size);
+#endif
+    }
+
+    // Allocates a block of at least size bytes, header included, in front of
+    // next.
+    Arena::Block* Arena::new_block(std::size_t size, Block* next)
+    {
+        static_assert(sizeof(Block) <= block_header, "The block header must fit in front of the first allocation.");
+
+        void* p = nullptr;
+        bool mapped = false;
+        bool huge = false;
+
+        if (_pages == PageSize::Huge)
+        {
+            p = map_huge_pages(size, huge);
+            mapped = p != nullptr;
+
+            if (mapped)
+                count_allocation(size);
+        }
+
+        if (p == nullptr)
+            p = aligned_allocate(size, simd_alignment);
+
+        Block* block = static_cast<Block*>(p);
+        block->next = next;
+        block->size = size;
+        block->mapped = mapped;
+        block->huge = huge;
+
+        _capacity += size - block_header;
+        return block;
+    }
+
+    // Releases every block.
+    void Arena::release()
+    {
+        while (_block != nullptr)
+        {
+            Block* next = _block->next;
+
+            if (_block->mapped)
+            {
+                count_deallocation(_block->size);
+                unmap_pages(_block, _block->size);
+            }
+            else
+            {
+                aligned_deallocate(_block, _block->size, simd_alignment);
+            }
+
+            _block = next;
+        }
+
+        _capacity = 0;
+    }
+
+    /// @brief Arena constructor.
+    /// @param capacity The number of bytes to allocate up front; zero defers
+    /// the first block to the first allocation.
+    /// @param pages The pages backing the arena.
+    Arena::Arena(std::size_t capacity, PageSize pages) : _pages(pages)
+    {
+        if (capacity > 0)
+            _block = new_block(block_header + capacity, nullptr);
+
+        _offset = block_header;
+    }
+
+    /// @brief Arena destructor; releases every block.
+    Arena::~Arena()
+    {
+        release();
+    }
+
+    /// @brief The arena of the calling thread, created empty on first use and
+    /// released when the thread exits.
+    Arena& Arena::local()
+    {
+        static thread_local Arena arena;
+        return arena;
+    }
+
+    /// @brief Allocates uninitialized memory from the arena.
+    /// @param bytes The number of bytes.
+    /// @param alignment The alignment of the memory, a power of two; at least
+    /// simd_alignment is always used.
+    /// @return The memory, valid until the next reset().
+    /// @throw std::bad_alloc If a new block cannot be allocated.
+    void* Arena::allocate(std::size_t bytes, std::size_t alignment)
+    {
+        if (alignment < simd_alignment)
+            alignment = simd_alignment;
+
+        for (;;)
+        {
+            if (_block != nullptr)
+            {
+                const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(_block);
+                const std::uintptr_t start = (base + _offset + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+                const std::size_t end = static_cast<std::size_t>(start - base) + bytes;
+
+                if (end <= _block->size)
+                {
+                    _used += end - _offset;
+                    _offset = end;
+                    return reinterpret_cast<void*>(start);
+                }
+            }
+
+            // Chain a block twice the current capacity, or large enough.
+            std::size_t size = 2 * _capacity;
+            if (size < default_capacity)
+                size = default_capacity;
+            if (size < bytes + alignment)
+                size = bytes + alignment;
+
+            _block = new_block(block_header + size, _block);
+            _offset = block_header;
+        }
+    }
+
+    /// @brief The number of bytes the arena can hand out before it needs
+    /// another block, in all its blocks.
+    std::size_t Arena::capacity() const
+    {
+        return _capacity;
+    }
+
+    /// @brief Whether the arena's current block was mapped with huge pages,
+    /// explicit or transparent.
+    bool Arena::huge_pages() const
+    {
+        return _block != nullptr && _block->huge;
+    }
+
+    /// @brief Releases every allocation at once.
+    ///
+    /// Constant time, unless the arena chained blocks since the last reset;
+    /// they are then merged into one block of their combined capacity.
+    void Arena::reset()
+    {
+        if (_block != nullptr && _block->next != nullptr)
+        {
+            const std::size_t capacity = _capacity;
+            release();
+            _block = new_block(block_header + capacity, nullptr);
+        }
+
+        _offset = block_header;
+        _used = 0;
+    }
+
+    /// @brief The number of bytes allocated since the last reset, alignment
+    /// padding included.
+    std::size_t Arena::used() const
+    {
+        return _used;
+    }
+}
@@ -0,0 +1,138 @@
+#include <algorithm>
+
+#include "Kernels.h"
+#include "PackedNormal.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    // Number of vectors deinterleaved at a time by the array-of-structures
+    // conversions; small enough for the scratch arrays to stay in L1.
+    static const std::size_t packed_normal_block = 256;
+
+    // The kernels for each coordinate type.
+    static void encode_kernel(const float* x, const float* y, const float* z, std::int8_t* out, std::size_t n)
+    {
+        Kernels::active().oct_encode16(x, y, z, out, n);
+    }
+
+    static void encode_kernel(const float* x, const float* y, const float* z, std::int16_t* out, std::size_t n)
+    {
+        Kernels::active().oct_encode32(x, y, z, out, n);
+    }
+
+    static void decode_kernel(const std::int8_t* in, float* x, float* y, float* z, std::size_t n)
+    {
+        Kernels::active().oct_decode16(in, x, y, z, n);
+    }
+
+    static void decode_kernel(const std::int16_t* in, float* x, float* y, float* z, std::size_t n)
+    {
+        Kernels::active().oct_decode32(in, x, y, z, n);
+    }
+
+    static void dot_kernel(const std::int8_t* in, const float* v, float* out, std::size_t n)
+    {
+        Kernels::active().oct_dot16(in, v, out, n);
+    }
+
+    static void dot_kernel(const std::int16_t* in, const float* v, float* out, std::size_t n)
+    {
+        Kernels::active().oct_dot32(in, v, out, n);
+    }
+
+    /// @brief Encodes an array of vectors.
+    ///
+    /// The vectors are deinterleaved into blocks of component arrays, which
+    /// are encoded by the same vectorized kernel as the batch overload.
+    ///
+    /// @param in The array of vectors to encode; none may be the zero vector.
+    /// @param out The array receiving the encoded normals.
+    /// @param count The number of elements in both arrays.
+    template <typename C>
+    void PackedNormalT<C>::encode(const Vector3* in, PackedNormalT* out, std::size_t count)
+    {
+        float x[packed_normal_block], y[packed_normal_block], z[packed_normal_block];
+
+        for (std::size_t begin = 0; begin < count; begin += packed_normal_block)
+        {
+            const std::size_t n = std::min(packed_normal_block, count - begin);
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                x[i] = in[begin + i].x;
+                y[i] = in[begin + i].y;
+                z[i] = in[begin + i].z;
+            }
+
+            encode_kernel(x, y, z, &out[begin].u, n);
+        }
+    }
+
+    /// @brief Encodes every vector in a batch.
+    /// @param in The Vector3Batch to encode; none of its vectors may be the
+    /// zero vector.
+    /// @param out The array receiving the encoded normals; it must hold at
+    /// least in.size() elements.
+    template <typename C>
+    void PackedNormalT<C>::encode(const Vector3Batch& in, PackedNormalT* out)
+    {
+        encode_kernel(in.x.data(), in.y.data(), in.z.data(), &out->u, in.size());
+    }
+
+    /// @brief Decodes an array of normals to unit vectors.
+    /// @param in The array of encoded normals.
+    /// @param out The array receiving the vectors.
+    /// @param count The number of elements in both arrays.
+    template <typename C>
+    void PackedNormalT<C>::decode(const PackedNormalT* in, Vector3* out, std::size_t count)
+    {
+        float x[packed_normal_block], y[packed_normal_block], z[packed_normal_block];
+
+        for (std::size_t begin = 0; begin < count; begin += packed_normal_block)
+        {
+            const std::size_t n = std::min(packed_normal_block, count - begin);
+
+            decode_kernel(&in[begin].u, x, y, z, n);
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                out[begin + i].x = x[i];
+                out[begin + i].y = y[i];
+                out[begin + i].z = z[i];
+            }
+        }
+    }
+
+    /// @brief Decodes an array of normals into a batch.
+    /// @param in The array of encoded normals.
+    /// @param count The number of normals.
+    /// @param out The Vector3Batch receiving the vectors; it is resized to
+    /// @p count.
+    template <typename C>
+    void PackedNormalT<C>::decode(const PackedNormalT* in, std::size_t count, Vector3Batch& out)
+    {
+        out.resize(count);
+        decode_kernel(&in->u, out.x.data(), out.y.data(), out.z.data(), count);
+    }
+
+    /// @brief Computes the dot product of every decoded normal with a vector.
+    ///
+    /// The normals are decoded in registers and never stored, so the loop
+    /// reads 2 or 4 bytes per normal instead of 12; this is the shading
+    /// pattern, one light direction against many normals.
+    ///
+    /// @param in The array of encoded normals.
+    /// @param w The vector to take the dot products with.
+    /// @param out The array receiving the dot products.
+    /// @param count The number of elements in both arrays.
+    template <typename C>
+    void PackedNormalT<C>::dot(const PackedNormalT* in, const Vector3& w, float* out, std::size_t count)
+    {
+        const float v[3] = { w.x, w.y, w.z };
+        dot_kernel(&in->u, v, out, count);
+    }
+
+    template class PackedNormalT<std::int8_t>;
+    template class PackedNormalT<std::int16_t>;
+}
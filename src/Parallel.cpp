@@ -0,0 +1,684 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Config.h"
+#include "Kernels.h"
+#include "Parallel.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @namespace Math3D::Parallel
+    namespace Parallel
+    {
+        // Set on the threads currently running chunks, so that nested calls
+        // run serially instead of waiting on the pool they are part of.
+        static thread_local bool inside_chunk = false;
+
+        // A pool of worker threads, each owning a queue of chunk indices. The
+        // calling thread takes part as the owner of queue zero.
+        class Pool
+        {
+        private:
+            // A queue of chunk indices, which are dealt in contiguous runs and
+            // so held as the range [begin,end), without allocating; the owner
+            // pops from the front, and thieves steal from the back.
+            struct Queue
+            {
+                std::mutex mutex;
+                std::size_t begin = 0;
+                std::size_t end = 0;
+            };
+
+            std::vector<std::thread> _threads;
+            std::unique_ptr<Queue[]> _queues;
+            unsigned _size;
+
+            // Guards everything below.
+            std::mutex _mutex;
+            std::condition_variable _wake;
+            std::condition_variable _done;
+            ChunkFunction _function = nullptr;
+            void* _context = nullptr;
+            unsigned long long _generation = 0;
+            unsigned _active = 0;
+            bool _stopping = false;
+#if MATH3D_EXCEPTIONS
+            std::exception_ptr _error;
+#endif
+
+        public:
+            explicit Pool(unsigned size) : _queues{ new Queue[size] }, _size{ size }
+            {
+                for (unsigned i = 1; i < size; ++i)
+                    _threads.emplace_back(&Pool::work, this, i);
+            }
+
+            ~Pool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _stopping = true;
+                }
+
+                _wake.notify_all();
+
+                for (std::thread& thread : _threads)
+                    thread.join();
+            }
+
+            unsigned size() const
+            {
+                return _size;
+            }
+
+            void run(std::size_t chunks, ChunkFunction function, void* context)
+            {
+                {
+                    // A worker that woke up late for the previous call may
+                    // still hold its function; let it find the queues empty
+                    // before they are filled again.
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _done.wait(lock, [this] { return _active == 0; });
+
+                    // Deal contiguous runs of chunks, so that every thread
+                    // walks through memory in order until it has to steal.
+                    for (unsigned i = 0; i < _size; ++i)
+                    {
+                        std::lock_guard<std::mutex> queue_lock(_queues[i].mutex);
+                        _queues[i].begin = chunks * i / _size;
+                        _queues[i].end = chunks * (i + 1) / _size;
+                    }
+
+                    _function = function;
+                    _context = context;
+#if MATH3D_EXCEPTIONS
+                    _error = nullptr;
+#endif
+                    ++_generation;
+                    ++_active;
+                }
+
+                _wake.notify_all();
+                drain(0, function, context);
+
+                std::unique_lock<std::mutex> lock(_mutex);
+                --_active;
+                _done.wait(lock, [this] { return _active == 0; });
+
+#if MATH3D_EXCEPTIONS
+                if (_error)
+                    std::rethrow_exception(_error);
+#endif
+            }
+
+        private:
+            // The loop of every worker thread.
+            void work(unsigned self)
+            {
+                unsigned long long seen = 0;
+
+                for (;;)
+                {
+                    ChunkFunction function;
+                    void* context;
+
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        _wake.wait(lock, [this, seen] { return _stopping || _generation != seen; });
+
+                        if (_stopping)
+                            return;
+
+                        seen = _generation;
+                        function = _function;
+                        context = _context;
+                        ++_active;
+                    }
+
+                    drain(self, function, context);
+
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+
+                        if (--_active != 0)
+                            continue;
+                    }
+
+                    _done.notify_all();
+                }
+            }
+
+            // Runs chunks until every queue is empty.
+            void drain(unsigned self, ChunkFunction function, void* context)
+            {
+                std::size_t chunk;
+                inside_chunk = true;
+
+                while (next(self, chunk))
+                {
+#if MATH3D_EXCEPTIONS
+                    try
+                    {
+                        function(context, chunk);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+
+                        if (!_error)
+                            _error = std::current_exception();
+                    }
+#else
+                    function(context, chunk);
+#endif
+                }
+
+                inside_chunk = false;
+            }
+
+            // Takes the next chunk from the thread's own queue, or steals one
+            // from the back of another.
+            bool next(unsigned self, std::size_t& chunk)
+            {
+                {
+                    Queue& own = _queues[self];
+                    std::lock_guard<std::mutex> lock(own.mutex);
+
+                    if (own.begin != own.end)
+                    {
+                        chunk = own.begin++;
+                        return true;
+                    }
+                }
+
+                for (unsigned i = 1; i < _size; ++i)
+                {
+                    Queue& victim = _queues[(self + i) % _size];
+                    std::lock_guard<std::mutex> lock(victim.mutex);
+
+                    if (victim.begin != victim.end)
+                    {
+                        chunk = --victim.end;
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+        };
+
+        // The pool is created on first use, and serves one call at a time.
+        static std::mutex pool_mutex;
+        static std::unique_ptr<Pool> pool;
+        static unsigned requested_size = 0;
+
+        // The pool size used when none was requested.
+        static unsigned default_size()
+        {
+            const char* env = std::getenv("MATH3D_THREADS");
+
+            if (env != nullptr && std::atoi(env) > 0)
+                return static_cast<unsigned>(std::atoi(env));
+
+            return std::max(std::thread::hardware_concurrency(), 1u);
+        }
+
+        // Returns the pool, creating it if needed; pool_mutex must be held.
+        static Pool& get_pool()
+        {
+            if (!pool)
+                pool.reset(new Pool(requested_size != 0 ? requested_size : default_size()));
+
+            return *pool;
+        }
+
+        /// @brief The number of threads parallel work is spread over.
+        unsigned thread_count()
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            return get_pool().size();
+        }
+
+        /// @brief Resizes the pool.
+        void set_thread_count(unsigned count)
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            requested_size = count;
+            pool.reset();
+        }
+
+        /// @brief The number of elements per chunk for an operation touching
+        /// the given number of bytes per element.
+        std::size_t grain_size(std::size_t bytes_per_element)
+        {
+            const std::size_t elements = chunk_bytes / std::max<std::size_t>(bytes_per_element, 1);
+            return std::max<std::size_t>(elements / 64 * 64, 64);
+        }
+
+        /// @brief Runs a function for every chunk index, spread over the pool.
+        void run(std::size_t chunks, ChunkFunction function, void* context)
+        {
+            if (chunks == 0)
+                return;
+
+            if (chunks == 1 || inside_chunk)
+            {
+                for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+                    function(context, chunk);
+
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            Pool& p = get_pool();
+
+            if (p.size() == 1)
+            {
+                for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+                    function(context, chunk);
+
+                return;
+            }
+
+            p.run(chunks, function, context);
+        }
+
+        /// @brief Normalizes every vector in a batch, in parallel.
+        /// @param vectors The Vector3Batch to normalize.
+        void normalize(Vector3Batch& vectors)
+        {
+            const Kernels::Table& kernels = Kernels::active();
+
+            parallel_for(vectors.size(), grain_size(2 * sizeof(Vector3)), [&](std::size_t begin, std::size_t end) {
+                kernels.normalize(&vectors.x[begin], &vectors.y[begin], &vectors.z[begin], end - begin);
+            });
+        }
+
+        /// @brief Multiplies every vector in a batch by a matrix, in parallel.
+        /// @param m The Matrix3 to multiply by.
+        /// @param in The Vector3Batch to transform.
+        /// @param out The Vector3Batch receiving the transformed vectors; it is
+        /// resized to match the input, and may be the input itself.
+        void transform(const Matrix3& m, const Vector3Batch& in, Vector3Batch& out)
+        {
+            if (&in == &out)
+            {
+                transform(m, out);
+                return;
+            }
+
+            const Kernels::Table& kernels = Kernels::active();
+            out.resize(in.size());
+
+            parallel_for(in.size(), grain_size(2 * sizeof(Vector3)), [&](std::size_t begin, std::size_t end) {
+                kernels.transform(&m(0, 0),
+                    &in.x[begin], &in.y[begin], &in.z[begin],
+                    &out.x[begin], &out.y[begin], &out.z[begin], end - begin);
+            });
+        }
+
+        /// @brief Multiplies every vector in a batch by a matrix, in place and
+        /// in parallel.
+        void transform(const Matrix3& m, Vector3Batch& vectors)
+        {
+            const Kernels::Table& kernels = Kernels::active();
+
+            parallel_for(vectors.size(), grain_size(2 * sizeof(Vector3)), [&](std::size_t begin, std::size_t end) {
+                kernels.transform_in_place(&m(0, 0),
+                    &vectors.x[begin], &vectors.y[begin], &vectors.z[begin], end - begin);
+            });
+        }
+
+        /// @brief Transforms every point in a batch, in parallel.
+        /// @param t The Transform to apply.
+        /// @param in The Vector3Batch to transform.
+        /// @param out The Vector3Batch receiving the transformed points; it is
+        /// resized to match the input, and may be the input itself.
+        void transform_points(const Transform& t, const Vector3Batch& in, Vector3Batch& out)
+        {
+            if (&in == &out)
+            {
+                transform_points(t, out);
+                return;
+            }
+
+            const Kernels::Table& kernels = Kernels::active();
+            out.resize(in.size());
+
+            parallel_for(in.size(), grain_size(2 * sizeof(Vector3)), [&](std::size_t begin, std::size_t end) {
+                kernels.affine_transform(&t.linear(0, 0), &t.translation.x,
+                    &in.x[begin], &in.y[begin], &in.z[begin],
+                    &out.x[begin], &out.y[begin], &out.z[begin], end - begin);
+            });
+        }
+
+        /// @brief Transforms every point in a batch, in place and in parallel.
+        void transform_points(const Transform& t, Vector3Batch& points)
+        {
+            const Kernels::Table& kernels = Kernels::active();
+
+            parallel_for(points.size(), grain_size(2 * sizeof(Vector3)), [&](std::size_t begin, std::size_t end) {
+                kernels.affine_transform_in_place(&t.linear(0, 0), &t.translation.x,
+                    &points.x[begin], &points.y[begin], &points.z[begin], end - begin);
+            });
+        }
+
+        // Reductions.
+
+        // Whether the reductions run the reference kernels.
+        static std::atomic<bool> deterministic_mode(false);
+
+        /// @brief Whether the reductions are in deterministic mode; see
+        /// set_deterministic().
+        bool deterministic()
+        {
+            return deterministic_mode.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Switches the reductions to or from deterministic mode.
+        ///
+        /// Must not be called while a reduction is running.
+        ///
+        /// @param on True to run the scalar reference kernels on every CPU,
+        /// false to run the kernels of the active SIMD level.
+        void set_deterministic(bool on)
+        {
+            deterministic_mode.store(on, std::memory_order_relaxed);
+        }
+
+        static const Kernels::Table& reduction_kernels()
+        {
+            return deterministic() ? Kernels::Scalar::table : Kernels::active();
+        }
+
+        // The sums of a range of points, shifted: the three coordinate sums,
+        // then the outer product sums xx, xy, xz, yy, yz and zz.
+        struct Moments
+        {
+            double count;
+            double sums[9];
+        };
+
+        // Adds two partial sums.
+        static Moments add(Moments a, const Moments& b)
+        {
+            a.count += b.count;
+            for (int k = 0; k < 9; ++k)
+                a.sums[k] += b.sums[k];
+
+            return a;
+        }
+
+        // Adds the partial sums [first,last) pairwise, in a fixed tree.
+        static Moments combine(const Moments* first, const Moments* last)
+        {
+            if (last - first == 1)
+                return *first;
+
+            const Moments* middle = first + (last - first) / 2;
+            return add(combine(first, middle), combine(middle, last));
+        }
+
+        // Reduces count points, mapping every chunk [begin,end) to its partial
+        // sums. The partials of up to reduction_chunks chunks are added
+        // pairwise, on the stack, and the passes in order.
+        template <typename Map>
+        static Moments reduce_chunks(std::size_t count, std::size_t grain, Map map)
+        {
+            const std::size_t pass = reduction_chunks * grain;
+            Moments partials[reduction_chunks];
+            Moments result = Moments();
+
+            for (std::size_t first = 0; first < count; first += pass)
+            {
+                const std::size_t n = std::min(pass, count - first);
+
+                parallel_for(n, grain, [&](std::size_t begin, std::size_t end) {
+                    partials[begin / grain] = map(first + begin, first + end);
+                });
+
+                result = add(result, combine(partials, partials + (n + grain - 1) / grain));
+            }
+
+            return result;
+        }
+
+        // Number of packed vectors deinterleaved at a time by the array
+        // reductions; small enough for the scratch arrays to stay in L1.
+        static const std::size_t reduction_block = 256;
+
+        // Sums a batch, shifted by shift, and its outer products if second.
+        static Moments reduce(const Vector3Batch& points, const Vector3& shift, bool second)
+        {
+            const Kernels::VectorToMoments kernel = second ? reduction_kernels().moments : reduction_kernels().sum;
+            return reduce_chunks(points.size(), grain_size(sizeof(Vector3)), [&](std::size_t begin, std::size_t end) {
+                Moments partial = Moments();
+                partial.count = static_cast<double>(end - begin);
+                kernel(&points.x[begin], &points.y[begin], &points.z[begin], &shift.x, partial.sums, end - begin);
+                return partial;
+            });
+        }
+
+        // Sums an array of vectors; every chunk is deinterleaved in blocks.
+        static Moments reduce(const Vector3* points, std::size_t count, const Vector3& shift, bool second)
+        {
+            const Kernels::VectorToMoments kernel = second ? reduction_kernels().moments : reduction_kernels().sum;
+            return reduce_chunks(count, grain_size(sizeof(Vector3)), [&](std::size_t begin, std::size_t end) {
+                Moments partial = Moments();
+                float x[reduction_block], y[reduction_block], z[reduction_block];
+                double sums[9] = {};
+
+                partial.count = static_cast<double>(end - begin);
+
+                for (std::size_t first = begin; first < end; first += reduction_block)
+                {
+                    const std::size_t n = std::min(reduction_block, end - first);
+
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        x[i] = points[first + i].x;
+                        y[i] = points[first + i].y;
+                        z[i] = points[first + i].z;
+                    }
+
+                    kernel(x, y, z, &shift.x, sums, n);
+
+                    for (int k = 0; k < (second ? 9 : 3); ++k)
+                        partial.sums[k] += sums[k];
+                }
+
+                return partial;
+            });
+        }
+
+        // The sum of the points.
+        static Vector3 to_sum(const Moments& m)
+        {
+            return Vector3(static_cast<float>(m.sums[0]), static_cast<float>(m.sums[1]), static_cast<float>(m.sums[2]));
+        }
+
+        // The mean of the points, which were shifted by shift.
+        static Vector3 to_centroid(const Moments& m, const Vector3& shift)
+        {
+            if (m.count == 0.0)
+                return Vector3::zero;
+
+            return Vector3(
+                static_cast<float>(shift.x + m.sums[0] / m.count),
+                static_cast<float>(shift.y + m.sums[1] / m.count),
+                static_cast<float>(shift.z + m.sums[2] / m.count));
+        }
+
+        // The mean of the outer products of the points about the point c,
+        // given the sums of the points shifted by shift.
+        static Matrix3 to_moment(const Moments& m, const Vector3& shift, const Vector3d& c)
+        {
+            if (m.count == 0.0)
+                return Matrix3(Vector3::zero, Vector3::zero, Vector3::zero);
+
+            // With d = p - shift and e = shift - c, the mean of (p - c)(p - c)^T
+            // is the mean of dd^T + de^T + ed^T + ee^T.
+            const double n = m.count;
+            const double mean[3] = { m.sums[0] / n, m.sums[1] / n, m.sums[2] / n };
+            const double e[3] = { shift.x - c.x, shift.y - c.y, shift.z - c.z };
+            const double dd[3][3] = {
+                { m.sums[3], m.sums[4], m.sums[5] },
+                { m.sums[4], m.sums[6], m.sums[7] },
+                { m.sums[5], m.sums[7], m.sums[8] } };
+
+            float r[3][3];
+
+            for (int i = 0; i < 3; ++i)
+            {
+                for (int j = 0; j < 3; ++j)
+                    r[i][j] = static_cast<float>(dd[i][j] / n + mean[i] * e[j] + e[i] * mean[j] + e[i] * e[j]);
+            }
+
+            return Matrix3(
+                r[0][0], r[0][1], r[0][2],
+                r[1][0], r[1][1], r[1][2],
+                r[2][0], r[2][1], r[2][2]);
+        }
+
+        // The mean of the points, in double, given their sums about shift.
+        static Vector3d to_mean(const Moments& m, const Vector3& shift)
+        {
+            return Vector3d(
+                shift.x + m.sums[0] / m.count,
+                shift.y + m.sums[1] / m.count,
+                shift.z + m.sums[2] / m.count);
+        }
+
+        /// @brief Sums every vector in a batch, in parallel.
+        /// @param vectors The Vector3Batch to sum.
+        /// @return The sum of the vectors.
+        Vector3 sum(const Vector3Batch& vectors)
+        {
+            return to_sum(reduce(vectors, Vector3::zero, false));
+        }
+
+        /// @brief Sums an array of vectors, in parallel.
+        /// @param vectors The array of vectors.
+        /// @param count The number of vectors.
+        /// @return The sum of the vectors.
+        Vector3 sum(const Vector3* vectors, std::size_t count)
+        {
+            return to_sum(reduce(vectors, count, Vector3::zero, false));
+        }
+
+        /// @brief Computes the centroid of a batch of points, in parallel.
+        /// @param points The Vector3Batch of points.
+        /// @return The mean of the points, or the zero vector if there are
+        /// none.
+        Vector3 centroid(const Vector3Batch& points)
+        {
+            const Vector3 shift = points.empty() ? Vector3::zero : points[0];
+            return to_centroid(reduce(points, shift, false), shift);
+        }
+
+        /// @brief Computes the centroid of an array of points, in parallel.
+        /// @param points The array of points.
+        /// @param count The number of points.
+        /// @return The mean of the points, or the zero vector if there are
+        /// none.
+        Vector3 centroid(const Vector3* points, std::size_t count)
+        {
+            const Vector3 shift = count == 0 ? Vector3::zero : points[0];
+            return to_centroid(reduce(points, count, shift, false), shift);
+        }
+
+        /// @brief Computes the bounding box of a batch of points, in parallel.
+        ///
+        /// Minima and maxima are exact, so the result is the same in every
+        /// mode and at every SIMD level.
+        ///
+        /// @param points The Vector3Batch of points.
+        /// @return The smallest AABB containing every point; empty if there
+        /// are none.
+        AABB bounds(const Vector3Batch& points)
+        {
+            const Kernels::Table& kernels = Kernels::active();
+
+            return parallel_reduce(points.size(), grain_size(sizeof(Vector3)), AABB(),
+                [&](std::size_t begin, std::size_t end) {
+                    AABB box;
+                    kernels.bounds(&points.x[begin], &points.y[begin], &points.z[begin], &box.min.x, end - begin);
+                    return box;
+                },
+                AABB::merge);
+        }
+
+        /// @brief Computes the bounding box of an array of points, in
+        /// parallel.
+        /// @param points The array of points.
+        /// @param count The number of points.
+        /// @return The smallest AABB containing every point; empty if there
+        /// are none.
+        AABB bounds(const Vector3* points, std::size_t count)
+        {
+            const Kernels::Table& kernels = Kernels::active();
+
+            return parallel_reduce(count, grain_size(sizeof(Vector3)), AABB(),
+                [&](std::size_t begin, std::size_t end) {
+                    AABB box;
+                    kernels.bounds_packed(&points[begin].x, &box.min.x, end - begin);
+                    return box;
+                },
+                AABB::merge);
+        }
+
+        /// @brief Computes the covariance matrix of a batch of points, in
+        /// parallel.
+        /// @param points The Vector3Batch of points.
+        /// @return The mean of (p - c)(p - c)^T over the points p, where c is
+        /// their centroid; the zero matrix if there are none.
+        Matrix3 covariance(const Vector3Batch& points)
+        {
+            const Vector3 shift = points.empty() ? Vector3::zero : points[0];
+            const Moments m = reduce(points, shift, true);
+            return to_moment(m, shift, m.count == 0.0 ? Vector3d::zero : to_mean(m, shift));
+        }
+
+        /// @brief Computes the covariance matrix of an array of points, in
+        /// parallel; see covariance(const Vector3Batch&).
+        /// @param points The array of points.
+        /// @param count The number of points.
+        /// @return The covariance matrix.
+        Matrix3 covariance(const Vector3* points, std::size_t count)
+        {
+            const Vector3 shift = count == 0 ? Vector3::zero : points[0];
+            const Moments m = reduce(points, count, shift, true);
+            return to_moment(m, shift, m.count == 0.0 ? Vector3d::zero : to_mean(m, shift));
+        }
+
+        /// @brief Computes the second moment matrix of a batch of points, in
+        /// parallel.
+        /// @param points The Vector3Batch of points.
+        /// @return The mean of pp^T over the points p; the zero matrix if
+        /// there are none.
+        Matrix3 second_moment(const Vector3Batch& points)
+        {
+            const Vector3 shift = points.empty() ? Vector3::zero : points[0];
+            return to_moment(reduce(points, shift, true), shift, Vector3d::zero);
+        }
+
+        /// @brief Computes the second moment matrix of an array of points, in
+        /// parallel; see second_moment(const Vector3Batch&).
+        /// @param points The array of points.
+        /// @param count The number of points.
+        /// @return The second moment matrix.
+        Matrix3 second_moment(const Vector3* points, std::size_t count)
+        {
+            const Vector3 shift = count == 0 ? Vector3::zero : points[0];
+            return to_moment(reduce(points, count, shift, true), shift, Vector3d::zero);
+        }
+    }
+}
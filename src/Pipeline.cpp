@@ -0,0 +1,323 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "Config.h"
+#include "Kernels.h"
+#include "Pipeline.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    // Appends a step, after checking that it may follow the previous ones.
+    Pipeline& Pipeline::add(Stage stage, bool to_scalar, const float* parameters, std::size_t count)
+    {
+        if (_scalar && stage != Stage::Clamp)
+        {
+            MATH3D_THROW(std::logic_error("Only clamp() may follow a scalar stage."));
+        }
+
+        Step step;
+        step.stage = stage;
+        std::fill(std::begin(step.parameters), std::end(step.parameters), 0.0f);
+        std::copy(parameters, parameters + count, step.parameters);
+
+        _steps.push_back(step);
+        _scalar = _scalar || to_scalar;
+        return *this;
+    }
+
+    // Runs every step on a block of n vectors, read from the source arrays
+    // and updated in the work arrays, which may be the same; scalar steps
+    // write s. The first vector step reads the source directly when its
+    // kernel can, so the block is not copied before it is used.
+    void Pipeline::run_block(const float* sx, const float* sy, const float* sz,
+        float* x, float* y, float* z, float* s, std::size_t n) const
+    {
+        const Kernels::Table& kernels = Kernels::active();
+        bool scalar = false;
+
+        const auto copy_source = [&]()
+        {
+            if (sx != x)
+            {
+                std::memcpy(x, sx, n * sizeof(float));
+                std::memcpy(y, sy, n * sizeof(float));
+                std::memcpy(z, sz, n * sizeof(float));
+                sx = x;
+                sy = y;
+                sz = z;
+            }
+        };
+
+        for (const Step& step : _steps)
+        {
+            const float* p = step.parameters;
+
+            switch (step.stage)
+            {
+            case Stage::Transform:
+                if (sx != x)
+                    kernels.transform(p, sx, sy, sz, x, y, z, n);
+                else
+                    kernels.transform_in_place(p, x, y, z, n);
+                sx = x;
+                sy = y;
+                sz = z;
+                break;
+            case Stage::Affine:
+                if (sx != x)
+                    kernels.affine_transform(p, p + 9, sx, sy, sz, x, y, z, n);
+                else
+                    kernels.affine_transform_in_place(p, p + 9, x, y, z, n);
+                sx = x;
+                sy = y;
+                sz = z;
+                break;
+            case Stage::Normalize:
+                copy_source();
+                kernels.normalize(x, y, z, n);
+                break;
+            case Stage::Dot:
+                kernels.dot_constant(p, sx, sy, sz, s, n);
+                scalar = true;
+                break;
+            case Stage::Magnitude:
+                kernels.magnitude(sx, sy, sz, s, n);
+                scalar = true;
+                break;
+            case Stage::Clamp:
+                if (scalar)
+                {
+                    kernels.clamp(s, p[0], p[1], n);
+                }
+                else
+                {
+                    copy_source();
+                    kernels.clamp(x, p[0], p[1], n);
+                    kernels.clamp(y, p[0], p[1], n);
+                    kernels.clamp(z, p[0], p[1], n);
+                }
+                break;
+            }
+        }
+
+        if (!scalar)
+            copy_source();
+    }
+
+    /// @brief Adds a stage multiplying every vector by a matrix.
+    /// @param m The matrix.
+    /// @return This pipeline.
+    /// @throw std::logic_error If the pipeline is already scalar.
+    Pipeline& Pipeline::transform(const Matrix3& m)
+    {
+        return add(Stage::Transform, false, &m(0, 0), 9);
+    }
+
+    /// @brief Adds a stage applying a transform to every vector, taken as a
+    /// point.
+    /// @param t The transform.
+    /// @return This pipeline.
+    /// @throw std::logic_error If the pipeline is already scalar.
+    Pipeline& Pipeline::transform_points(const Transform& t)
+    {
+        float parameters[12];
+        std::memcpy(parameters, &t.linear(0, 0), 9 * sizeof(float));
+        parameters[9] = t.translation.x;
+        parameters[10] = t.translation.y;
+        parameters[11] = t.translation.z;
+
+        return add(Stage::Affine, false, parameters, 12);
+    }
+
+    /// @brief Adds a stage applying a transform to every vector, taken as a
+    /// direction: the translation is ignored.
+    /// @param t The transform.
+    /// @return This pipeline.
+    /// @throw std::logic_error If the pipeline is already scalar.
+    Pipeline& Pipeline::transform_directions(const Transform& t)
+    {
+        return transform(t.linear);
+    }
+
+    /// @brief Adds a stage turning every vector into a unit vector.
+    /// @return This pipeline.
+    /// @throw std::logic_error If the pipeline is already scalar.
+    Pipeline& Pipeline::normalize()
+    {
+        return add(Stage::Normalize, false, nullptr, 0);
+    }
+
+    /// @brief Adds a stage taking the dot product of every vector with a
+    /// constant one; the pipeline becomes scalar.
+    /// @param v The constant vector, such as a light direction.
+    /// @return This pipeline.
+    /// @throw std::logic_error If the pipeline is already scalar.
+    Pipeline& Pipeline::dot(const Vector3& v)
+    {
+        return add(Stage::Dot, true, &v.x, 3);
+    }
+
+    /// @brief Adds a stage taking the magnitude of every vector; the pipeline
+    /// becomes scalar.
+    /// @return This pipeline.
+    /// @throw std::logic_error If the pipeline is already scalar.
+    Pipeline& Pipeline::magnitude()
+    {
+        return add(Stage::Magnitude, true, nullptr, 0);
+    }
+
+    /// @brief Adds a stage clamping every scalar, or every component of every
+    /// vector, to a range; NaNs are passed through.
+    /// @param lo The lower bound.
+    /// @param hi The upper bound.
+    /// @return This pipeline.
+    /// @throw std::invalid_argument If @p lo is greater than @p hi.
+    Pipeline& Pipeline::clamp(float lo, float hi)
+    {
+        if (hi < lo)
+        {
+            MATH3D_THROW(std::invalid_argument("The lower bound is greater than the upper bound."));
+        }
+
+        const float parameters[2] = { lo, hi };
+        return add(Stage::Clamp, false, parameters, 2);
+    }
+
+    /// @brief Whether the pipeline has no stages, and copies its input.
+    bool Pipeline::empty() const
+    {
+        return _steps.empty();
+    }
+
+    /// @brief Whether the pipeline produces one float per vector rather than
+    /// a vector.
+    bool Pipeline::scalar() const
+    {
+        return _scalar;
+    }
+
+    /// @brief The number of stages.
+    std::size_t Pipeline::stages() const
+    {
+        return _steps.size();
+    }
+
+    /// @brief Runs the pipeline over a batch of vectors.
+    /// @param in The Vector3Batch to process.
+    /// @param out The Vector3Batch receiving the results; it is resized to
+    /// match the input, and may be the input itself.
+    /// @throw std::logic_error If the pipeline is scalar.
+    void Pipeline::run(const Vector3Batch& in, Vector3Batch& out) const
+    {
+        if (_scalar)
+        {
+            MATH3D_THROW(std::logic_error("The pipeline produces scalars, not vectors."));
+        }
+
+        const std::size_t count = in.size();
+        out.resize(count);
+
+        for (std::size_t begin = 0; begin < count; begin += block_size)
+        {
+            const std::size_t n = std::min(block_size, count - begin);
+
+            run_block(in.x.data() + begin, in.y.data() + begin, in.z.data() + begin,
+                out.x.data() + begin, out.y.data() + begin, out.z.data() + begin, nullptr, n);
+        }
+    }
+
+    /// @brief Runs a scalar pipeline over a batch of vectors.
+    /// @param in The Vector3Batch to process.
+    /// @param out The array receiving the results, of at least in.size()
+    /// floats.
+    /// @throw std::logic_error If the pipeline is not scalar.
+    void Pipeline::run(const Vector3Batch& in, float* out) const
+    {
+        if (!_scalar)
+        {
+            MATH3D_THROW(std::logic_error("The pipeline produces vectors, not scalars."));
+        }
+
+        alignas(simd_alignment) float x[block_size], y[block_size], z[block_size];
+        const std::size_t count = in.size();
+
+        for (std::size_t begin = 0; begin < count; begin += block_size)
+        {
+            const std::size_t n = std::min(block_size, count - begin);
+            run_block(in.x.data() + begin, in.y.data() + begin, in.z.data() + begin, x, y, z, out + begin, n);
+        }
+    }
+
+    /// @brief Runs the pipeline over an array of vectors.
+    ///
+    /// Every block is deinterleaved into component arrays before the stages
+    /// run, and interleaved back after; it is read before it is written, so
+    /// @p out may be the same array as @p in, but the two must not otherwise
+    /// overlap.
+    ///
+    /// @param in The array of vectors to process.
+    /// @param out The array receiving the results.
+    /// @param count The number of vectors in both arrays.
+    /// @throw std::logic_error If the pipeline is scalar.
+    void Pipeline::run(const Vector3* in, Vector3* out, std::size_t count) const
+    {
+        if (_scalar)
+        {
+            MATH3D_THROW(std::logic_error("The pipeline produces scalars, not vectors."));
+        }
+
+        alignas(simd_alignment) float x[block_size], y[block_size], z[block_size];
+
+        for (std::size_t begin = 0; begin < count; begin += block_size)
+        {
+            const std::size_t n = std::min(block_size, count - begin);
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                x[i] = in[begin + i].x;
+                y[i] = in[begin + i].y;
+                z[i] = in[begin + i].z;
+            }
+
+            run_block(x, y, z, x, y, z, nullptr, n);
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                out[begin + i].x = x[i];
+                out[begin + i].y = y[i];
+                out[begin + i].z = z[i];
+            }
+        }
+    }
+
+    /// @brief Runs a scalar pipeline over an array of vectors.
+    /// @param in The array of vectors to process.
+    /// @param out The array receiving the results.
+    /// @param count The number of elements in both arrays.
+    /// @throw std::logic_error If the pipeline is not scalar.
+    void Pipeline::run(const Vector3* in, float* out, std::size_t count) const
+    {
+        if (!_scalar)
+        {
+            MATH3D_THROW(std::logic_error("The pipeline produces vectors, not scalars."));
+        }
+
+        alignas(simd_alignment) float x[block_size], y[block_size], z[block_size];
+
+        for (std::size_t begin = 0; begin < count; begin += block_size)
+        {
+            const std::size_t n = std::min(block_size, count - begin);
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                x[i] = in[begin + i].x;
+                y[i] = in[begin + i].y;
+                z[i] = in[begin + i].z;
+            }
+
+            run_block(x, y, z, x, y, z, out + begin, n);
+        }
+    }
+}
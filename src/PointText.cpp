@@ -0,0 +1,310 @@
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+#include "Config.h"
+#include "Parallel.h"
+#include "PointText.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    // Whether a character may surround the coordinates of a line.
+    static bool is_blank(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    static const char* skip_blanks(const char* p, const char* end)
+    {
+        while (p != end && is_blank(*p))
+            ++p;
+
+        return p;
+    }
+
+    // The start of the line following the one p is in, or end.
+    static const char* next_line(const char* p, const char* end)
+    {
+        const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        return newline ? newline + 1 : end;
+    }
+
+    // Parses a coordinate at p, which must end at a blank, at the separator or
+    // at the end of the line, and moves p past it.
+    static bool parse_coordinate(const char*& p, const char* end, char separator, float& value)
+    {
+        if (p != end && *p == '+')
+            ++p;
+
+        const std::from_chars_result result = std::from_chars(p, end, value);
+
+        if (result.ec != std::errc() || (result.ptr != end && !is_blank(*result.ptr) && *result.ptr != separator))
+            return false;
+
+        p = result.ptr;
+        return true;
+    }
+
+    // Parses the three coordinates starting at p, up to the end of the line.
+    static bool parse_coordinates(const char* p, const char* end, char separator, Vector3& point)
+    {
+        float* coordinates[3] = { &point.x, &point.y, &point.z };
+
+        for (int i = 0; i < 3; ++i)
+        {
+            p = skip_blanks(p, end);
+
+            if (i > 0 && separator != ' ')
+            {
+                if (p == end || *p != separator)
+                    return false;
+
+                p = skip_blanks(p + 1, end);
+            }
+
+            if (!parse_coordinate(p, end, separator, *coordinates[i]))
+                return false;
+        }
+
+        return true;
+    }
+
+    // Parses the line [p,end), which holds no line break. Returns 1 and sets
+    // the point if the line holds one, 0 if the line is to be skipped, and -1
+    // if it is malformed.
+    static int parse_line(const char* p, const char* end, PointFormat format, Vector3& point)
+    {
+        p = skip_blanks(p, end);
+
+        if (p == end)
+            return 0;
+
+        switch (format)
+        {
+        case PointFormat::XYZ:
+            if (*p == '#')
+                return 0;
+            return parse_coordinates(p, end, ' ', point) ? 1 : -1;
+        case PointFormat::CSV:
+            if (*p == '#')
+                return 0;
+            return parse_coordinates(p, end, ',', point) ? 1 : -1;
+        case PointFormat::OBJ:
+            if (end - p < 2 || p[0] != 'v' || !is_blank(p[1]))
+                return 0;
+            return parse_coordinates(p + 1, end, ' ', point) ? 1 : -1;
+        }
+
+        return -1;
+    }
+
+    // Throws for the malformed line starting at p.
+    static void throw_malformed(const char* text, const char* p)
+    {
+        const std::size_t line = 1 + static_cast<std::size_t>(std::count(text, p, '\n'));
+        MATH3D_THROW(std::runtime_error("Malformed point at line " + std::to_string(line)));
+    }
+
+    // Parses the lines starting in [begin,end), appending the points to out.
+    static void parse_range(const char* text, const char* begin, const char* end, PointFormat format,
+        std::vector<Vector3>& out)
+    {
+        Vector3 point;
+
+        for (const char* p = begin; p != end; )
+        {
+            const char* line_end = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+            if (!line_end)
+                line_end = end;
+
+            const int parsed = parse_line(p, line_end, format, point);
+
+            if (parsed < 0)
+                throw_malformed(text, p);
+
+            if (parsed > 0)
+                out.push_back(point);
+
+            p = line_end == end ? end : line_end + 1;
+        }
+    }
+
+    /// @brief Parses a point list; see parse_points(const char*, std::size_t,
+    /// PointFormat).
+    std::vector<Vector3> parse_points(const char* text, std::size_t length, PointFormat format)
+    {
+        const char* const end = text + length;
+        const char* start = text;
+
+        // A CSV file may open with the names of its columns.
+        if (format == PointFormat::CSV)
+        {
+            const char* first = skip_blanks(text, end);
+            const char* first_end = next_line(text, end);
+            Vector3 point;
+
+            if (first != end && std::isalpha(static_cast<unsigned char>(*first)) &&
+                parse_line(text, first_end == end ? end : first_end - 1, format, point) < 0)
+                start = first_end;
+        }
+
+        const std::size_t size = static_cast<std::size_t>(end - start);
+        const std::size_t grain = Parallel::chunk_bytes;
+        std::vector<std::vector<Vector3>> parts((size + grain - 1) / grain);
+
+        // Every chunk parses the lines that start inside it, so a line split
+        // by a chunk boundary belongs to the chunk before it.
+        Parallel::parallel_for(size, grain, [&](std::size_t begin, std::size_t last) {
+            const char* first = begin == 0 ? start : next_line(start + begin - 1, end);
+            const char* stop = start + last == end ? end : next_line(start + last - 1, end);
+            std::vector<Vector3>& part = parts[begin / grain];
+
+            if (first < stop)
+            {
+                // A point takes at least six bytes, "0 0 0\n".
+                part.reserve(static_cast<std::size_t>(stop - first) / 6 + 1);
+                parse_range(text, first, stop, format, part);
+            }
+        });
+
+        if (parts.size() == 1)
+            return std::move(parts[0]);
+
+        std::size_t total = 0;
+        for (const std::vector<Vector3>& part : parts)
+            total += part.size();
+
+        std::vector<Vector3> points;
+        points.reserve(total);
+
+        for (const std::vector<Vector3>& part : parts)
+            points.insert(points.end(), part.begin(), part.end());
+
+        return points;
+    }
+
+    /// @brief Parses a point list held in a string.
+    /// @param text The text to parse.
+    /// @param format The format of the text.
+    /// @return The points, in the order they appear.
+    std::vector<Vector3> parse_points(const std::string& text, PointFormat format)
+    {
+        return parse_points(text.data(), text.size(), format);
+    }
+
+    // Formats one point at out, and returns the end of the text written.
+    static char* format_point(const Vector3& point, PointFormat format, char* out)
+    {
+        const char separator = format == PointFormat::CSV ? ',' : ' ';
+        char* const limit = out + max_point_chars;
+
+        if (format == PointFormat::OBJ)
+        {
+            *out++ = 'v';
+            *out++ = ' ';
+        }
+
+        out = std::to_chars(out, limit, point.x).ptr;
+        *out++ = separator;
+        out = std::to_chars(out, limit, point.y).ptr;
+        *out++ = separator;
+        out = std::to_chars(out, limit, point.z).ptr;
+        *out++ = '\n';
+        return out;
+    }
+
+    /// @brief Formats a point list into a buffer; see format_points(const
+    /// Vector3*, std::size_t, PointFormat, char*).
+    std::size_t format_points(const Vector3* points, std::size_t count, PointFormat format, char* out)
+    {
+        char* p = out;
+
+        for (std::size_t i = 0; i < count; ++i)
+            p = format_point(points[i], format, p);
+
+        return static_cast<std::size_t>(p - out);
+    }
+
+    /// @brief Formats a point list into a string.
+    ///
+    /// Large arrays are formatted in parallel: every chunk is formatted in
+    /// place, into room for its worst case, and the chunks are then moved
+    /// together.
+    ///
+    /// @param points The array of points.
+    /// @param count The number of points.
+    /// @param format The format to write.
+    /// @return The text.
+    std::string format_points(const Vector3* points, std::size_t count, PointFormat format)
+    {
+        const std::size_t grain = Parallel::grain_size(max_point_chars);
+        std::vector<std::size_t> lengths((count + grain - 1) / grain);
+        std::string text(count * max_point_chars, '\0');
+
+        Parallel::parallel_for(count, grain, [&](std::size_t begin, std::size_t end) {
+            lengths[begin / grain] = format_points(points + begin, end - begin, format, &text[begin * max_point_chars]);
+        });
+
+        std::size_t length = 0;
+
+        for (std::size_t chunk = 0; chunk < lengths.size(); ++chunk)
+        {
+            std::memmove(&text[length], &text[chunk * grain * max_point_chars], lengths[chunk]);
+            length += lengths[chunk];
+        }
+
+        text.resize(length);
+        return text;
+    }
+
+    /// @brief Reads a point list from a file.
+    /// @param path The path of the file.
+    /// @param format The format of the file.
+    /// @return The points, in the order they appear.
+    /// @throw std::runtime_error If the file cannot be read, or is malformed.
+    std::vector<Vector3> read_points(const std::string& path, PointFormat format)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+        if (!file)
+        {
+            MATH3D_THROW(std::runtime_error("Cannot open point file: " + path));
+        }
+
+        std::string text(static_cast<std::size_t>(file.tellg()), '\0');
+        file.seekg(0);
+        file.read(&text[0], static_cast<std::streamsize>(text.size()));
+
+        if (!file)
+        {
+            MATH3D_THROW(std::runtime_error("Cannot read point file: " + path));
+        }
+
+        return parse_points(text, format);
+    }
+
+    /// @brief Writes a point list to a file, replacing its contents.
+    /// @param path The path of the file.
+    /// @param points The array of points.
+    /// @param count The number of points.
+    /// @param format The format to write.
+    /// @throw std::runtime_error If the file cannot be written.
+    void write_points(const std::string& path, const Vector3* points, std::size_t count, PointFormat format)
+    {
+        const std::string text = format_points(points, count, format);
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+        file.write(text.data(), static_cast<std::streamsize>(text.size()));
+        file.close();
+
+        if (!file)
+        {
+            MATH3D_THROW(std::runtime_error("Cannot write point file: " + path));
+        }
+    }
+}
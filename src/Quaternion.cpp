@@ -0,0 +1,309 @@
+#include "Kernels.h"
+#include "Quaternion.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @brief Constructor for Quaternion.
+    Quaternion::Quaternion(float x, float y, float z, float w) : x{ x }, y{ y }, z{ z }, w{ w } {}
+
+    /// @brief Constructor for Quaternion.
+    /// @param v The vector part.
+    /// @param w The scalar part.
+    Quaternion::Quaternion(const Vector3& v, float w) : x{ v.x }, y{ v.y }, z{ v.z }, w{ w } {}
+
+    /// @brief Converts a rotation matrix into a quaternion.
+    ///
+    /// Uses Shepperd's method: the largest of the four diagonal combinations
+    /// is chosen for the square root, which keeps the division well away from
+    /// zero for every rotation.
+    ///
+    /// @param m A proper rotation matrix (orthonormal, determinant one).
+    /// @return The unit Quaternion representing the same rotation.
+    Quaternion Quaternion::from_matrix(const Matrix3& m)
+    {
+        const float trace = m(0, 0) + m(1, 1) + m(2, 2);
+
+        if (trace > 0.0f)
+        {
+            const float s = 0.5f / std::sqrt(trace + 1.0f);
+            return Quaternion(
+                (m(2, 1) - m(1, 2)) * s,
+                (m(0, 2) - m(2, 0)) * s,
+                (m(1, 0) - m(0, 1)) * s,
+                0.25f / s);
+        }
+
+        if (m(0, 0) > m(1, 1) && m(0, 0) > m(2, 2))
+        {
+            const float s = 2.0f * std::sqrt(1.0f + m(0, 0) - m(1, 1) - m(2, 2));
+            return Quaternion(
+                0.25f * s,
+                (m(0, 1) + m(1, 0)) / s,
+                (m(0, 2) + m(2, 0)) / s,
+                (m(2, 1) - m(1, 2)) / s);
+        }
+
+        if (m(1, 1) > m(2, 2))
+        {
+            const float s = 2.0f * std::sqrt(1.0f + m(1, 1) - m(0, 0) - m(2, 2));
+            return Quaternion(
+                (m(0, 1) + m(1, 0)) / s,
+                0.25f * s,
+                (m(1, 2) + m(2, 1)) / s,
+                (m(0, 2) - m(2, 0)) / s);
+        }
+
+        const float s = 2.0f * std::sqrt(1.0f + m(2, 2) - m(0, 0) - m(1, 1));
+        return Quaternion(
+            (m(0, 2) + m(2, 0)) / s,
+            (m(1, 2) + m(2, 1)) / s,
+            0.25f * s,
+            (m(1, 0) - m(0, 1)) / s);
+    }
+
+    /// @brief Spherical linear interpolation between two rotations.
+    ///
+    /// The result moves at a constant angular velocity along the shortest arc
+    /// between the inputs. When they are nearly parallel, the interpolation
+    /// falls back to nlerp, which is indistinguishable there and avoids the
+    /// division by a vanishing sine.
+    ///
+    /// @param a The first unit Quaternion.
+    /// @param b The second unit Quaternion.
+    /// @param t The interpolant parameter, clamped to [0,1].
+    /// @return The interpolated unit Quaternion.
+    Quaternion Quaternion::slerp(const Quaternion& a, const Quaternion& b, float t)
+    {
+        // Clamp t to [0,1]
+        t = std::fmax(t, 0.0f);
+        t = std::fmin(t, 1.0f);
+
+        float d = dot(a, b);
+        Quaternion c = b;
+
+        if (d < 0.0f)
+        {
+            d = -d;
+            c = -b;
+        }
+
+        if (d > 0.9995f)
+        {
+            return nlerp(a, c, t);
+        }
+
+        const float theta = std::acos(d);
+        const float inv_sin = 1.0f / std::sin(theta);
+
+        return a * (std::sin((1.0f - t) * theta) * inv_sin) + c * (std::sin(t * theta) * inv_sin);
+    }
+
+    /// @brief Rotates an array of vectors, each by its own quaternion.
+    ///
+    /// The rotations are computed by a vectorized kernel, directly on the
+    /// packed arrays. The arrays must not overlap.
+    ///
+    /// @param rotations The array of unit quaternions.
+    /// @param in The array of vectors to rotate.
+    /// @param out The array receiving the rotated vectors.
+    /// @param count The number of elements in every array.
+    void Quaternion::rotate(const Quaternion* rotations, const Vector3* in, Vector3* out, std::size_t count)
+    {
+        Kernels::active().quaternion_rotate(&rotations->x, &in->x, &out->x, count);
+    }
+
+    /// @brief Spherical linear interpolation between two arrays of rotations.
+    ///
+    /// The interpolation weights are evaluated with a polynomial series
+    /// instead of trigonometric functions, which lets the loop vectorize; the
+    /// results are within 1e-6 of slerp(). The arrays must not overlap.
+    ///
+    /// @param a The array of first unit quaternions.
+    /// @param b The array of second unit quaternions.
+    /// @param t The interpolant parameter, clamped to [0,1].
+    /// @param out The array receiving the interpolated quaternions.
+    /// @param count The number of elements in every array.
+    void Quaternion::slerp(const Quaternion* a, const Quaternion* b, float t, Quaternion* out, std::size_t count)
+    {
+        // Clamp t to [0,1]
+        t = std::fmax(t, 0.0f);
+        t = std::fmin(t, 1.0f);
+
+        Kernels::active().quaternion_slerp(&a->x, &b->x, t, &out->x, count);
+    }
+
+    /// @brief The conjugate of this quaternion.
+    /// @return A Quaternion with the vector part negated; for unit quaternions,
+    /// this is the inverse rotation.
+    Quaternion Quaternion::conjugate() const
+    {
+        return Quaternion(-x, -y, -z, w);
+    }
+
+    /// @brief The inverse of this quaternion.
+    /// @return The Quaternion that multiplied by this one yields the identity.
+    Quaternion Quaternion::inverse() const
+    {
+        return conjugate() * (1.0f / sqr_magnitude());
+    }
+
+    /// @brief The magnitude of this quaternion.
+    float Quaternion::magnitude() const
+    {
+        return std::sqrt(sqr_magnitude());
+    }
+
+    /// @brief Returns this quaternion with a magnitude of one.
+    Quaternion Quaternion::normalized() const
+    {
+        Quaternion q = *this;
+        Quaternion::normalize(q);
+        return q;
+    }
+
+    /// @brief Rotates a vector by this quaternion.
+    ///
+    /// This quaternion is assumed to have a magnitude of one.
+    ///
+    /// @return The rotated Vector3.
+    Vector3 Quaternion::rotate(const Vector3& v) const
+    {
+        const Vector3 u = vector();
+        const Vector3 t = Vector3::cross(u, v) * 2.0f;
+        return v + t * w + Vector3::cross(u, t);
+    }
+
+    /// @brief The squared magnitude of this quaternion.
+    float Quaternion::sqr_magnitude() const
+    {
+        return dot(*this, *this);
+    }
+
+    /// @brief Converts this quaternion into a rotation matrix.
+    ///
+    /// This quaternion is assumed to have a magnitude of one.
+    ///
+    /// @return The Matrix3 representing the same rotation.
+    Matrix3 Quaternion::to_matrix() const
+    {
+        const float xx = x * x, yy = y * y, zz = z * z;
+        const float xy = x * y, xz = x * z, yz = y * z;
+        const float wx = w * x, wy = w * y, wz = w * z;
+
+        return Matrix3(
+            1.0f - 2.0f * (yy + zz), 2.0f * (xy - wz), 2.0f * (xz + wy),
+            2.0f * (xy + wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz - wx),
+            2.0f * (xz - wy), 2.0f * (yz + wx), 1.0f - 2.0f * (xx + yy));
+    }
+
+    /// @brief The vector part of this quaternion.
+    Vector3 Quaternion::vector() const
+    {
+        return Vector3(x, y, z);
+    }
+
+    /// @brief Rotates an array of vectors by this quaternion.
+    ///
+    /// The quaternion is converted to a matrix once, and the vectors go
+    /// through the bulk Matrix3 transform; @p out may be the same array as
+    /// @p in.
+    ///
+    /// @param in The array of vectors to rotate.
+    /// @param out The array receiving the rotated vectors.
+    /// @param count The number of vectors in both arrays.
+    void Quaternion::rotate(const Vector3* in, Vector3* out, std::size_t count) const
+    {
+        to_matrix().transform(in, out, count);
+    }
+
+    /// @brief Rotates every vector in a batch by this quaternion.
+    /// @param in The Vector3Batch to rotate.
+    /// @param out The Vector3Batch receiving the rotated vectors; it is resized
+    /// to match the input, and may be the input itself.
+    void Quaternion::rotate(const Vector3Batch& in, Vector3Batch& out) const
+    {
+        to_matrix().transform(in, out);
+    }
+
+    /// @brief Overload for the addition operator.
+    Quaternion Quaternion::operator+(const Quaternion& other) const
+    {
+        return Quaternion(x + other.x, y + other.y, z + other.z, w + other.w);
+    }
+
+    /// @brief Overload for the subtraction operator.
+    Quaternion Quaternion::operator-(const Quaternion& other) const
+    {
+        return Quaternion(x - other.x, y - other.y, z - other.z, w - other.w);
+    }
+
+    /// @brief Overload for the unary negation operator.
+    ///
+    /// The negated quaternion represents the same rotation.
+    Quaternion Quaternion::operator-() const
+    {
+        return Quaternion(-x, -y, -z, -w);
+    }
+
+    /// @brief Overload for the multiplication operator.
+    ///
+    /// Computes the Hamilton product; the result applies @p other first, then
+    /// this rotation.
+    Quaternion Quaternion::operator*(const Quaternion& other) const
+    {
+        return Quaternion(
+            w * other.x + x * other.w + y * other.z - z * other.y,
+            w * other.y - x * other.z + y * other.w + z * other.x,
+            w * other.z + x * other.y - y * other.x + z * other.w,
+            w * other.w - x * other.x - y * other.y - z * other.z);
+    }
+
+    /// @brief Overload for the multiplication operator.
+    Quaternion Quaternion::operator*(const float s) const
+    {
+        return Quaternion(x * s, y * s, z * s, w * s);
+    }
+
+    /// @brief Overload for the multiplication operator.
+    /// @return The vector rotated by this quaternion.
+    Vector3 Quaternion::operator*(const Vector3& v) const
+    {
+        return rotate(v);
+    }
+
+    /// @brief Overload for the multiplication-assignment operator.
+    Quaternion& Quaternion::operator*=(const Quaternion& other)
+    {
+        return *this = *this * other;
+    }
+
+    /// @brief Overload for the equality comparison operator.
+    ///
+    /// Compares components; q and -q represent the same rotation but are not
+    /// considered equal.
+    bool Quaternion::operator==(const Quaternion& other) const
+    {
+        return
+            is_almost_equal(x, other.x) &&
+            is_almost_equal(y, other.y) &&
+            is_almost_equal(z, other.z) &&
+            is_almost_equal(w, other.w);
+    }
+
+    /// @brief Writes a textual representation of a quaternion to a stream.
+    std::ostream& to_string(std::ostream& os, const Quaternion& q)
+    {
+        return os << "("
+            << std::setw(1) << q.x << ", "
+            << std::setw(1) << q.y << ", "
+            << std::setw(1) << q.z << ", "
+            << std::setw(1) << q.w << ")";
+    }
+
+    /// @brief Override for the output stream insertion operator.
+    std::ostream& operator<<(std::ostream& os, const Quaternion& q)
+    {
+        return to_string(os, q);
+    }
+}
@@ -0,0 +1,223 @@
+#include <cmath>
+#include <limits>
+
+#include "Kernels.h"
+#include "Ray.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @brief Constructor for Ray.
+    /// @param origin The point the ray starts from.
+    /// @param direction The direction the ray travels along.
+    Ray::Ray(const Vector3& origin, const Vector3& direction) : origin{ origin }, direction{ direction } {}
+
+    /// @brief Tests this ray against a box, with the slab test.
+    ///
+    /// A direction component of zero is allowed; the ray then never leaves or
+    /// never enters the matching pair of planes. A ray running exactly along
+    /// a face of the box may be reported as a miss.
+    ///
+    /// @param box The AABB to test.
+    /// @param t Receives, on a hit, the distance at which the ray enters the
+    /// box, or zero if it starts inside.
+    /// @param t_max The largest distance considered, usually that of the
+    /// closest hit found so far.
+    /// @return @c true if the ray enters the box at most @p t_max away.
+    bool Ray::intersect(const AABB& box, float& t, float t_max) const
+    {
+        const float o[3] = { origin.x, origin.y, origin.z };
+        const float d[3] = { direction.x, direction.y, direction.z };
+        const float* lo = &box.min.x;
+        const float* hi = &box.max.x;
+
+        float enter = 0.0f, exit = t_max;
+
+        for (int c = 0; c < 3; ++c)
+        {
+            const float inv = 1.0f / d[c];
+            const float t1 = (lo[c] - o[c]) * inv, t2 = (hi[c] - o[c]) * inv;
+
+            // Written so that a NaN, from a zero times an infinity, leaves the
+            // distances unchanged; see the ray_box kernel.
+            const float near = t1 < t2 ? t1 : t2, far = t1 < t2 ? t2 : t1;
+            enter = near > enter ? near : enter;
+            exit = far < exit ? far : exit;
+        }
+
+        if (enter > exit)
+        {
+            return false;
+        }
+
+        t = enter;
+        return true;
+    }
+
+    /// @brief Tests this ray against a sphere.
+    /// @param sphere The Sphere to test.
+    /// @param t Receives, on a hit, the distance at which the ray enters the
+    /// sphere, or zero if it starts inside.
+    /// @param t_max The largest distance considered, usually that of the
+    /// closest hit found so far.
+    /// @return @c true if the ray enters the sphere at most @p t_max away.
+    bool Ray::intersect(const Sphere& sphere, float& t, float t_max) const
+    {
+        const Vector3 p = origin - sphere.center;
+
+        const float a = direction.sqr_magnitude();
+        const float b = Vector3::dot(p, direction);
+        const float c = p.sqr_magnitude() - sphere.radius * sphere.radius;
+        const float discriminant = b * b - a * c;
+
+        if (discriminant < 0.0f)
+        {
+            return false;
+        }
+
+        const float root = std::sqrt(discriminant);
+        const float t0 = (-b - root) / a;
+        const float t1 = (-b + root) / a;
+        const float enter = t0 > 0.0f ? t0 : 0.0f;
+
+        if (t1 < 0.0f || enter > t_max)
+        {
+            return false;
+        }
+
+        t = enter;
+        return true;
+    }
+
+    /// @brief The point of this ray at a given distance from its origin.
+    Vector3 Ray::point_at(float t) const
+    {
+        return origin + direction * t;
+    }
+
+    /// @brief Overload for the equality comparison operator.
+    bool Ray::operator==(const Ray& other) const
+    {
+        return origin == other.origin && direction == other.direction;
+    }
+
+    // The maximum distances of a packet test with no limit, shared by every
+    // packet width.
+    static const float unlimited[8] =
+    {
+        std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(),
+    };
+
+    /// @brief Default constructor for RayPacket; every lane holds Ray().
+    template <std::size_t N>
+    RayPacket<N>::RayPacket()
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            set(i, Ray());
+        }
+    }
+
+    /// @brief Constructor for RayPacket.
+    /// @param rays The array of N rays to store, in lane order.
+    template <std::size_t N>
+    RayPacket<N>::RayPacket(const Ray* rays)
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            set(i, rays[i]);
+        }
+    }
+
+    /// @brief Tests every ray in this packet against a box.
+    /// @param box The AABB to test.
+    /// @param t The array of N distances receiving, for every ray, the
+    /// distance at which it enters the box; only meaningful on a hit.
+    /// @param t_max The array of N largest distances considered, or @c
+    /// nullptr for no limit.
+    /// @return The mask of the rays hitting the box.
+    template <std::size_t N>
+    unsigned RayPacket<N>::intersect(const AABB& box, float* t, const float* t_max) const
+    {
+        if (t_max == nullptr)
+        {
+            t_max = unlimited;
+        }
+
+        const Kernels::Table& kernels = Kernels::active();
+        return (N == 4 ? kernels.ray_box4 : kernels.ray_box8)(
+            origin[0], origin[1], origin[2],
+            inv_direction[0], inv_direction[1], inv_direction[2],
+            &box.min.x, t_max, t);
+    }
+
+    /// @brief Tests every ray in this packet against a sphere.
+    /// @param sphere The Sphere to test.
+    /// @param t The array of N distances receiving, for every ray, the
+    /// distance at which it enters the sphere; only meaningful on a hit.
+    /// @param t_max The array of N largest distances considered, or @c
+    /// nullptr for no limit.
+    /// @return The mask of the rays hitting the sphere.
+    template <std::size_t N>
+    unsigned RayPacket<N>::intersect(const Sphere& sphere, float* t, const float* t_max) const
+    {
+        if (t_max == nullptr)
+        {
+            t_max = unlimited;
+        }
+
+        const Kernels::Table& kernels = Kernels::active();
+        return (N == 4 ? kernels.ray_sphere4 : kernels.ray_sphere8)(
+            origin[0], origin[1], origin[2],
+            direction[0], direction[1], direction[2],
+            &sphere.center.x, t_max, t);
+    }
+
+    /// @brief Stores a ray in one lane of this packet.
+    /// @param lane The lane, below N.
+    /// @param ray The Ray to store.
+    template <std::size_t N>
+    void RayPacket<N>::set(std::size_t lane, const Ray& ray)
+    {
+        origin[0][lane] = ray.origin.x;
+        origin[1][lane] = ray.origin.y;
+        origin[2][lane] = ray.origin.z;
+        direction[0][lane] = ray.direction.x;
+        direction[1][lane] = ray.direction.y;
+        direction[2][lane] = ray.direction.z;
+        inv_direction[0][lane] = 1.0f / ray.direction.x;
+        inv_direction[1][lane] = 1.0f / ray.direction.y;
+        inv_direction[2][lane] = 1.0f / ray.direction.z;
+    }
+
+    /// @brief Overload for the brackets operator.
+    /// @return The ray stored in a lane.
+    template <std::size_t N>
+    Ray RayPacket<N>::operator[](std::size_t lane) const
+    {
+        return Ray(
+            Vector3(origin[0][lane], origin[1][lane], origin[2][lane]),
+            Vector3(direction[0][lane], direction[1][lane], direction[2][lane]));
+    }
+
+    template <std::size_t N>
+    const std::size_t RayPacket<N>::size;
+
+    template class RayPacket<4>;
+    template class RayPacket<8>;
+
+    /// @brief Writes a textual representation of a ray to a stream.
+    std::ostream& to_string(std::ostream& os, const Ray& ray)
+    {
+        return os << "(" << ray.origin << ", " << ray.direction << ")";
+    }
+
+    /// @brief Override for the output stream insertion operator.
+    std::ostream& operator<<(std::ostream& os, const Ray& ray)
+    {
+        return to_string(os, ray);
+    }
+}
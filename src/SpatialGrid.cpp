@@ -0,0 +1,595 @@
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "Config.h"
+#include "Parallel.h"
+#include "SpatialGrid.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @brief The identifier padding the results of bulk nearest-neighbor
+    /// queries.
+    const std::size_t SpatialGrid::none = static_cast<std::size_t>(-1);
+
+    // Cell coordinates are clamped to 21 bits each, so that the three of them
+    // fit in a single key. Points beyond that range share the outermost cells,
+    // which only costs extra distance tests.
+    static const int min_coordinate = -(1 << 20);
+    static const int max_coordinate = (1 << 20) - 1;
+
+    // The number of bulk queries answered per parallel chunk.
+    static const std::size_t query_grain = 64;
+
+    // The squared distance between two points, spelled out so that it is
+    // inlined into the query loops.
+    static float sqr_distance(const Vector3& a, const Vector3& b)
+    {
+        const float dx = a.x - b.x, dy = a.y - b.y, dz = a.z - b.z;
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    // Packs three cell coordinates into a key.
+    static std::uint64_t pack(int x, int y, int z)
+    {
+        const std::uint64_t mask = (1 << 21) - 1;
+        return
+            ((static_cast<std::uint64_t>(x) & mask) << 42) |
+            ((static_cast<std::uint64_t>(y) & mask) << 21) |
+            (static_cast<std::uint64_t>(z) & mask);
+    }
+
+    // Picks a cell size holding about two points per occupied cell, assuming
+    // the points are spread evenly over their bounds. Flat dimensions are left
+    // out, so that planar and linear sets get sensible cells too.
+    static float automatic_cell_size(const Vector3* points, std::size_t count, float cell_size)
+    {
+        if (cell_size > 0.0f || count == 0)
+            return cell_size > 0.0f ? cell_size : 1.0f;
+
+        Vector3 lo = points[0], hi = points[0];
+
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            lo = Vector3(std::min(lo.x, points[i].x), std::min(lo.y, points[i].y), std::min(lo.z, points[i].z));
+            hi = Vector3(std::max(hi.x, points[i].x), std::max(hi.y, points[i].y), std::max(hi.z, points[i].z));
+        }
+
+        const float extents[] = { hi.x - lo.x, hi.y - lo.y, hi.z - lo.z };
+        const float largest = *std::max_element(extents, extents + 3);
+        double volume = 1.0;
+        int dimensions = 0;
+
+        for (float extent : extents)
+        {
+            if (extent > 1e-6f * largest)
+            {
+                volume *= extent;
+                ++dimensions;
+            }
+        }
+
+        if (dimensions == 0)
+            return 1.0f;
+
+        return static_cast<float>(std::pow(2.0 * volume / count, 1.0 / dimensions));
+    }
+
+    /// @brief Constructor for SpatialGrid.
+    /// @param cell_size The edge length of the cells, which must be positive.
+    SpatialGrid::SpatialGrid(float cell_size)
+        : _cell_size{ cell_size }, _inv_cell_size{ 1.0f / cell_size }, _size{ 0 },
+          _lo{ INT_MAX, INT_MAX, INT_MAX }, _hi{ INT_MIN, INT_MIN, INT_MIN }
+    {
+        if (!(cell_size > 0.0f))
+        {
+            MATH3D_THROW(std::invalid_argument("The cell size must be positive."));
+        }
+    }
+
+    /// @brief Constructor for SpatialGrid.
+    /// @param points The array of points to index; their identifiers are
+    /// their indices in the array.
+    /// @param count The number of points in the array.
+    /// @param cell_size The edge length of the cells; zero picks one from the
+    /// bounds of the points.
+    SpatialGrid::SpatialGrid(const Vector3* points, std::size_t count, float cell_size)
+        : SpatialGrid(automatic_cell_size(points, count, cell_size))
+    {
+        _points.reserve(count);
+        _keys.reserve(count);
+        _slots.reserve(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+            insert(points[i]);
+    }
+
+    /// @brief The edge length of the cells.
+    float SpatialGrid::cell_size() const
+    {
+        return _cell_size;
+    }
+
+    /// @brief Removes every point.
+    void SpatialGrid::clear()
+    {
+        _points.clear();
+        _keys.clear();
+        _slots.clear();
+        _free.clear();
+        _cells.clear();
+        _size = 0;
+
+        std::fill(_lo, _lo + 3, INT_MAX);
+        std::fill(_hi, _hi + 3, INT_MIN);
+    }
+
+    /// @brief Checks whether an identifier refers to a point in the grid.
+    bool SpatialGrid::contains(std::size_t id) const
+    {
+        return id < _slots.size() && _slots[id] != none;
+    }
+
+    /// @brief Checks whether the grid holds no points.
+    bool SpatialGrid::empty() const
+    {
+        return _size == 0;
+    }
+
+    /// @brief Adds a point.
+    /// @return The identifier of the new point.
+    std::size_t SpatialGrid::insert(const Vector3& p)
+    {
+        std::size_t id;
+
+        if (_free.empty())
+        {
+            id = _points.size();
+            _points.push_back(p);
+            _keys.push_back(0);
+            _slots.push_back(none);
+        }
+        else
+        {
+            id = _free.back();
+            _free.pop_back();
+            _points[id] = p;
+        }
+
+        add_to_cell(id);
+        ++_size;
+        return id;
+    }
+
+    /// @brief Removes a point.
+    /// @param id The identifier of the point, which must be in the grid.
+    void SpatialGrid::remove(std::size_t id)
+    {
+        if (!contains(id))
+        {
+            MATH3D_THROW(std::out_of_range("The point is not in the grid."));
+        }
+
+        remove_from_cell(id);
+        _free.push_back(id);
+        --_size;
+    }
+
+    /// @brief The number of points in the grid.
+    std::size_t SpatialGrid::size() const
+    {
+        return _size;
+    }
+
+    /// @brief Moves a point.
+    ///
+    /// Only points that leave their cell are moved between cells, so small
+    /// displacements are cheap.
+    ///
+    /// @param id The identifier of the point, which must be in the grid.
+    /// @param p The new position of the point.
+    void SpatialGrid::update(std::size_t id, const Vector3& p)
+    {
+        if (!contains(id))
+        {
+            MATH3D_THROW(std::out_of_range("The point is not in the grid."));
+        }
+
+        const std::uint64_t key = pack(cell_coordinate(p.x), cell_coordinate(p.y), cell_coordinate(p.z));
+
+        if (key == _keys[id])
+        {
+            _points[id] = p;
+            return;
+        }
+
+        remove_from_cell(id);
+        _points[id] = p;
+        add_to_cell(id);
+    }
+
+    /// @brief Finds the points inside an axis-aligned box.
+    /// @param min The corner of the box with the smallest coordinates.
+    /// @param max The corner of the box with the largest coordinates.
+    /// @return The identifiers of the points inside the box, boundary
+    /// included, in increasing order.
+    std::vector<std::size_t> SpatialGrid::box(const Vector3& min, const Vector3& max) const
+    {
+        std::vector<std::size_t> ids;
+        box(min, max, ids);
+        return ids;
+    }
+
+    /// @brief Finds the points inside an axis-aligned box.
+    ///
+    /// Same as the overload returning a vector, but reuses the storage of
+    /// @p out, which is cleared first.
+    void SpatialGrid::box(const Vector3& min, const Vector3& max, std::vector<std::size_t>& out) const
+    {
+        out.clear();
+
+        const int lo[] = { cell_coordinate(min.x), cell_coordinate(min.y), cell_coordinate(min.z) };
+        const int hi[] = { cell_coordinate(max.x), cell_coordinate(max.y), cell_coordinate(max.z) };
+
+        for_each_cell(lo, hi, [&](const std::vector<std::size_t>& ids) {
+            for (std::size_t id : ids)
+            {
+                const Vector3& p = _points[id];
+
+                if (min.x <= p.x && p.x <= max.x && min.y <= p.y && p.y <= max.y && min.z <= p.z && p.z <= max.z)
+                    out.push_back(id);
+            }
+        });
+
+        std::sort(out.begin(), out.end());
+    }
+
+    /// @brief Finds the nearest points to a position.
+    /// @param p The position to search around.
+    /// @param k The number of points to find.
+    /// @return The identifiers of the min(k, size()) points closest to @p p,
+    /// from the closest to the farthest; ties are broken by identifier.
+    std::vector<std::size_t> SpatialGrid::nearest(const Vector3& p, std::size_t k) const
+    {
+        std::vector<std::size_t> ids;
+        nearest(p, k, ids);
+        return ids;
+    }
+
+    /// @brief Finds the nearest points to a position.
+    ///
+    /// The cells are searched in rings of increasing size around the cell of
+    /// @p p, from the first ring reaching an occupied cell and only within the
+    /// bounds of the occupied cells, until the k-th closest point found so far
+    /// is closer than any cell not searched yet. When the rings would span
+    /// more cells than are occupied, every point is tested instead, so no
+    /// query costs much more than a linear scan however far from the points it
+    /// is. Reuses the storage of @p out, which is cleared first.
+    void SpatialGrid::nearest(const Vector3& p, std::size_t k, std::vector<std::size_t>& out) const
+    {
+        typedef std::pair<float, std::size_t> Candidate;
+
+        out.clear();
+        k = std::min(k, _size);
+
+        if (k == 0)
+            return;
+
+        const int c[] = { cell_coordinate(p.x), cell_coordinate(p.y), cell_coordinate(p.z) };
+        const float position[] = { p.x, p.y, p.z };
+
+        // A max-heap of the k best candidates found so far.
+        std::vector<Candidate> heap;
+        heap.reserve(k + 1);
+
+        auto consider = [&](const std::vector<std::size_t>& ids) {
+            for (std::size_t id : ids)
+            {
+                const Candidate candidate(sqr_distance(_points[id], p), id);
+
+                if (heap.size() < k)
+                {
+                    heap.push_back(candidate);
+                    std::push_heap(heap.begin(), heap.end());
+                }
+                else if (candidate < heap.front())
+                {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.back() = candidate;
+                    std::push_heap(heap.begin(), heap.end());
+                }
+            }
+        };
+
+        auto visit = [&](int x, int y, int z) {
+            // Skip cells that are farther than the k-th best candidate, which
+            // saves most of the table lookups in the outermost ring.
+            if (heap.size() == k)
+            {
+                const int cell_index[] = { x, y, z };
+                float d2 = 0.0f;
+
+                for (int a = 0; a < 3; ++a)
+                {
+                    const float lo = cell_index[a] * _cell_size;
+                    const float d = std::max(std::max(lo - position[a], position[a] - (lo + _cell_size)), 0.0f);
+                    d2 += d * d;
+                }
+
+                if (d2 > heap.front().first)
+                    return;
+            }
+
+            const CellMap::const_iterator cell = _cells.find(pack(x, y, z));
+
+            if (cell != _cells.end())
+                consider(cell->second);
+        };
+
+        // The number of occupied cells within a Chebyshev distance of r.
+        auto cells_within = [&](int r) {
+            double cells = 1.0;
+
+            for (int a = 0; a < 3; ++a)
+            {
+                const int from = std::max(c[a] - r, _lo[a]), to = std::min(c[a] + r, _hi[a]);
+
+                if (from > to)
+                    return 0.0;
+
+                cells *= to - from + 1.0;
+            }
+
+            return cells;
+        };
+
+        // The rings closer than the occupied cells hold no points, so the
+        // search starts at the Chebyshev distance from the cell of p to them.
+        int first = 0;
+
+        for (int a = 0; a < 3; ++a)
+            first = std::max(first, std::max(_lo[a] - c[a], c[a] - _hi[a]));
+
+        for (int r = first; ; ++r)
+        {
+            // Once the rings span more cells than are occupied, as when p is
+            // far from small cells, walking the table is cheaper; the search
+            // then starts over with every point.
+            if (cells_within(r) > _cells.size())
+            {
+                heap.clear();
+
+                for (const CellMap::value_type& cell : _cells)
+                    consider(cell.second);
+
+                break;
+            }
+
+            // Visit the occupied part of the cells at a Chebyshev distance of
+            // exactly r: the faces at x = c[0] +- r and y = c[1] +- r whole,
+            // and only the two caps at z = c[2] +- r between them.
+            int from[3], to[3];
+
+            for (int a = 0; a < 3; ++a)
+            {
+                from[a] = std::max(c[a] - r, _lo[a]);
+                to[a] = std::min(c[a] + r, _hi[a]);
+            }
+
+            for (int x = from[0]; x <= to[0]; ++x)
+            {
+                for (int y = from[1]; y <= to[1]; ++y)
+                {
+                    if (x == c[0] - r || x == c[0] + r || y == c[1] - r || y == c[1] + r)
+                    {
+                        for (int z = from[2]; z <= to[2]; ++z)
+                            visit(x, y, z);
+                    }
+                    else
+                    {
+                        if (c[2] - r >= _lo[2])
+                            visit(x, y, c[2] - r);
+                        if (c[2] + r <= _hi[2])
+                            visit(x, y, c[2] + r);
+                    }
+                }
+            }
+
+            bool covered = true;
+            float bound = std::numeric_limits<float>::max();
+
+            for (int a = 0; a < 3; ++a)
+            {
+                covered = covered && c[a] - r <= _lo[a] && c[a] + r >= _hi[a];
+                bound = std::min(bound, position[a] - (c[a] - r) * _cell_size);
+                bound = std::min(bound, (c[a] + r + 1) * _cell_size - position[a]);
+            }
+
+            // Every unvisited point is at least bound away; the bound is
+            // negative when p lies outside the clamped coordinate range.
+            if (covered || (heap.size() == k && bound >= 0.0f && heap.front().first <= bound * bound))
+                break;
+        }
+
+        std::sort_heap(heap.begin(), heap.end());
+
+        for (const Candidate& candidate : heap)
+            out.push_back(candidate.second);
+    }
+
+    /// @brief Finds the points within a distance of a position.
+    /// @param p The position to search around.
+    /// @param r The search radius.
+    /// @return The identifiers of the points at a distance of at most @p r,
+    /// in increasing order.
+    std::vector<std::size_t> SpatialGrid::radius(const Vector3& p, float r) const
+    {
+        std::vector<std::size_t> ids;
+        radius(p, r, ids);
+        return ids;
+    }
+
+    /// @brief Finds the points within a distance of a position.
+    ///
+    /// Same as the overload returning a vector, but reuses the storage of
+    /// @p out, which is cleared first.
+    void SpatialGrid::radius(const Vector3& p, float r, std::vector<std::size_t>& out) const
+    {
+        out.clear();
+
+        const float r2 = r * r;
+        const int lo[] = { cell_coordinate(p.x - r), cell_coordinate(p.y - r), cell_coordinate(p.z - r) };
+        const int hi[] = { cell_coordinate(p.x + r), cell_coordinate(p.y + r), cell_coordinate(p.z + r) };
+
+        for_each_cell(lo, hi, [&](const std::vector<std::size_t>& ids) {
+            for (std::size_t id : ids)
+            {
+                if (sqr_distance(_points[id], p) <= r2)
+                    out.push_back(id);
+            }
+        });
+
+        std::sort(out.begin(), out.end());
+    }
+
+    /// @brief Finds the nearest points to every position in an array, in
+    /// parallel.
+    /// @param queries The array of positions to search around.
+    /// @param count The number of positions.
+    /// @param k The number of points to find for every position.
+    /// @param out The array receiving @p k identifiers per position, laid out
+    /// one position after another, as returned by nearest(); the slots past
+    /// size() are set to SpatialGrid::none.
+    void SpatialGrid::nearest(const Vector3* queries, std::size_t count, std::size_t k, std::size_t* out) const
+    {
+        Parallel::parallel_for(count, query_grain, [&](std::size_t begin, std::size_t end) {
+            std::vector<std::size_t> ids;
+
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                nearest(queries[i], k, ids);
+                std::copy(ids.begin(), ids.end(), out + i * k);
+                std::fill(out + i * k + ids.size(), out + (i + 1) * k, none);
+            }
+        });
+    }
+
+    /// @brief Finds the points within a distance of every position in an
+    /// array, in parallel.
+    /// @param queries The array of positions to search around.
+    /// @param count The number of positions.
+    /// @param r The search radius.
+    /// @return For every position, the identifiers returned by radius().
+    std::vector<std::vector<std::size_t> > SpatialGrid::radius(const Vector3* queries, std::size_t count, float r) const
+    {
+        std::vector<std::vector<std::size_t> > results(count);
+
+        Parallel::parallel_for(count, query_grain, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i)
+                radius(queries[i], r, results[i]);
+        });
+
+        return results;
+    }
+
+    /// @brief Overload for the brackets operator.
+    /// @return The position of the point with the given identifier.
+    const Vector3& SpatialGrid::operator[](std::size_t id) const
+    {
+        if (!contains(id))
+        {
+            MATH3D_THROW(std::out_of_range("The point is not in the grid."));
+        }
+
+        return _points[id];
+    }
+
+    // Files a point under the cell containing it.
+    void SpatialGrid::add_to_cell(std::size_t id)
+    {
+        const Vector3& p = _points[id];
+        const int c[] = { cell_coordinate(p.x), cell_coordinate(p.y), cell_coordinate(p.z) };
+
+        std::vector<std::size_t>& cell = _cells[pack(c[0], c[1], c[2])];
+        _keys[id] = pack(c[0], c[1], c[2]);
+        _slots[id] = cell.size();
+        cell.push_back(id);
+
+        for (int a = 0; a < 3; ++a)
+        {
+            _lo[a] = std::min(_lo[a], c[a]);
+            _hi[a] = std::max(_hi[a], c[a]);
+        }
+    }
+
+    // Maps a coordinate to the index of the cell containing it.
+    int SpatialGrid::cell_coordinate(float v) const
+    {
+        const float c = std::floor(v * _inv_cell_size);
+        return static_cast<int>(std::max(std::min(c, static_cast<float>(max_coordinate)), static_cast<float>(min_coordinate)));
+    }
+
+    // Calls f with the points of every occupied cell in a range of cells,
+    // and possibly others; callers test every point they are given. When the
+    // range holds more cells than are occupied, walking the table is cheaper.
+    template <typename F>
+    void SpatialGrid::for_each_cell(const int* lo, const int* hi, F f) const
+    {
+        int from[3], to[3];
+        double cells = 1.0;
+
+        for (int a = 0; a < 3; ++a)
+        {
+            from[a] = std::max(lo[a], _lo[a]);
+            to[a] = std::min(hi[a], _hi[a]);
+
+            if (from[a] > to[a])
+                return;
+
+            cells *= to[a] - from[a] + 1.0;
+        }
+
+        if (cells > _cells.size())
+        {
+            for (const CellMap::value_type& cell : _cells)
+                f(cell.second);
+
+            return;
+        }
+
+        for (int x = from[0]; x <= to[0]; ++x)
+        {
+            for (int y = from[1]; y <= to[1]; ++y)
+            {
+                for (int z = from[2]; z <= to[2]; ++z)
+                {
+                    const CellMap::const_iterator cell = _cells.find(pack(x, y, z));
+
+                    if (cell != _cells.end())
+                        f(cell->second);
+                }
+            }
+        }
+    }
+
+    // Takes a point out of its cell, dropping the cell once empty.
+    void SpatialGrid::remove_from_cell(std::size_t id)
+    {
+        const CellMap::iterator cell = _cells.find(_keys[id]);
+        std::vector<std::size_t>& ids = cell->second;
+
+        const std::size_t slot = _slots[id];
+        const std::size_t last = ids.back();
+        ids[slot] = last;
+        _slots[last] = slot;
+        ids.pop_back();
+        _slots[id] = none;
+
+        if (ids.empty())
+            _cells.erase(cell);
+    }
+}
@@ -0,0 +1,55 @@
+#include "Sphere.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @brief Constructor for Sphere.
+    /// @param center The center of the sphere.
+    /// @param radius The radius of the sphere.
+    Sphere::Sphere(const Vector3& center, float radius) : center{ center }, radius{ radius } {}
+
+    /// @brief The smallest AABB containing this sphere.
+    AABB Sphere::bounds() const
+    {
+        const Vector3 r(radius, radius, radius);
+        return AABB(center - r, center + r);
+    }
+
+    /// @brief Checks whether a point lies inside this sphere, boundary
+    /// included.
+    bool Sphere::contains(const Vector3& p) const
+    {
+        return (p - center).sqr_magnitude() <= radius * radius;
+    }
+
+    /// @brief Checks whether this sphere and another share at least one point.
+    bool Sphere::overlaps(const Sphere& other) const
+    {
+        const float r = radius + other.radius;
+        return (other.center - center).sqr_magnitude() <= r * r;
+    }
+
+    /// @brief Checks whether this sphere and a box share at least one point.
+    bool Sphere::overlaps(const AABB& box) const
+    {
+        return box.sqr_distance(center) <= radius * radius;
+    }
+
+    /// @brief Overload for the equality comparison operator.
+    bool Sphere::operator==(const Sphere& other) const
+    {
+        return center == other.center && is_almost_equal(radius, other.radius);
+    }
+
+    /// @brief Writes a textual representation of a sphere to a stream.
+    std::ostream& to_string(std::ostream& os, const Sphere& sphere)
+    {
+        return os << "(" << sphere.center << ", " << sphere.radius << ")";
+    }
+
+    /// @brief Override for the output stream insertion operator.
+    std::ostream& operator<<(std::ostream& os, const Sphere& sphere)
+    {
+        return to_string(os, sphere);
+    }
+}
@@ -0,0 +1,232 @@
+#include "Blocks.h"
+#include "Kernels.h"
+#include "Transform.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    /// @brief Constructor for Transform.
+    /// @param linear The linear part, applied first.
+    /// @param translation The translation, applied last.
+    Transform::Transform(const Matrix3& linear, const Vector3& translation)
+        : linear{ linear }, translation{ translation } {}
+
+    /// @brief Constructor for Transform.
+    /// @param rotation The rotation, as a unit Quaternion.
+    /// @param translation The translation, applied after the rotation.
+    Transform::Transform(const Quaternion& rotation, const Vector3& translation)
+        : linear{ rotation.to_matrix() }, translation{ translation } {}
+
+    /// @brief Creates a transform from a 4x4 homogeneous matrix.
+    ///
+    /// The bottom row is assumed to be (0, 0, 0, 1) and is ignored.
+    ///
+    /// @param m The sixteen elements of the matrix, in row-major order.
+    /// @return The equivalent Transform.
+    Transform Transform::from_matrix4(const float* m)
+    {
+        return Transform(
+            Matrix3(m[0], m[1], m[2], m[4], m[5], m[6], m[8], m[9], m[10]),
+            Vector3(m[3], m[7], m[11]));
+    }
+
+    /// @brief The inverse of this transform.
+    ///
+    /// Works for any invertible linear part, including scales and shears, at
+    /// the cost of a full matrix inversion. Prefer rigid_inverse() when the
+    /// linear part is known to be a rotation.
+    ///
+    /// @return The Transform that undoes this one.
+    /// @throw const char* If the linear part is singular.
+    Transform Transform::inverse() const
+    {
+        const Matrix3 m = linear.inverse();
+        return Transform(m, -(m * translation));
+    }
+
+    /// @brief The inverse of this transform, assuming it is rigid.
+    ///
+    /// The inverse of a rotation is its transpose, so only a transpose and a
+    /// matrix-vector product are needed. The result is meaningless when the
+    /// linear part is not orthonormal.
+    ///
+    /// @return The Transform that undoes this one.
+    Transform Transform::rigid_inverse() const
+    {
+        const Matrix3 m = linear.transposed();
+        return Transform(m, -(m * translation));
+    }
+
+    /// @brief Writes this transform as a 4x4 homogeneous matrix.
+    /// @param out The array receiving the sixteen elements, in row-major
+    /// order.
+    void Transform::to_matrix4(float* out) const
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+                out[4 * i + j] = linear(i, j);
+        }
+
+        out[3] = translation.x;
+        out[7] = translation.y;
+        out[11] = translation.z;
+
+        out[12] = 0.0f;
+        out[13] = 0.0f;
+        out[14] = 0.0f;
+        out[15] = 1.0f;
+    }
+
+    /// @brief The inverse of this transform, if it has one.
+    ///
+    /// The non-throwing counterpart of inverse().
+    ///
+    /// @return The Transform that undoes this one, or an empty optional if
+    /// the linear part is singular.
+    std::optional<Transform> Transform::try_inverse() const
+    {
+        const std::optional<Matrix3> m = linear.try_inverse();
+
+        if (!m)
+        {
+            return std::nullopt;
+        }
+
+        return Transform(*m, -(*m * translation));
+    }
+
+    /// @brief Transforms a direction; the translation does not apply.
+    /// @return The transformed Vector3.
+    Vector3 Transform::transform_direction(const Vector3& v) const
+    {
+        return linear * v;
+    }
+
+    /// @brief Transforms a point.
+    /// @return The transformed Vector3.
+    Vector3 Transform::transform_point(const Vector3& p) const
+    {
+        return linear * p + translation;
+    }
+
+    /// @brief Transforms an array of directions.
+    ///
+    /// Same as Matrix3::transform() with the linear part; @p out may be the
+    /// same array as @p in.
+    ///
+    /// @param in The array of directions to transform.
+    /// @param out The array receiving the transformed directions.
+    /// @param count The number of vectors in both arrays.
+    void Transform::transform_directions(const Vector3* in, Vector3* out, std::size_t count) const
+    {
+        linear.transform(in, out, count);
+    }
+
+    /// @brief Transforms an array of directions, in place.
+    void Transform::transform_directions(Vector3* vectors, std::size_t count) const
+    {
+        linear.transform(vectors, count);
+    }
+
+    /// @brief Transforms every direction in a batch.
+    /// @param in The Vector3Batch to transform.
+    /// @param out The Vector3Batch receiving the transformed directions; it is
+    /// resized to match the input, and may be the input itself.
+    void Transform::transform_directions(const Vector3Batch& in, Vector3Batch& out) const
+    {
+        linear.transform(in, out);
+    }
+
+    /// @brief Transforms every direction in a batch, in place.
+    void Transform::transform_directions(Vector3Batch& vectors) const
+    {
+        linear.transform(vectors);
+    }
+
+    /// @brief Transforms an array of points.
+    ///
+    /// The points are deinterleaved into blocks of component arrays, which
+    /// are transformed by the same vectorized kernel as the batch overloads.
+    /// Every block is read before it is written, so @p out may be the same
+    /// array as @p in, but the two must not otherwise overlap.
+    ///
+    /// @param in The array of points to transform.
+    /// @param out The array receiving the transformed points.
+    /// @param count The number of points in both arrays.
+    void Transform::transform_points(const Vector3* in, Vector3* out, std::size_t count) const
+    {
+        const Kernels::Table& kernels = Kernels::active();
+
+        Blocks::transform(in, out, count, [&](float* x, float* y, float* z, std::size_t n) {
+            kernels.affine_transform_in_place(&linear(0, 0), &translation.x, x, y, z, n);
+        });
+    }
+
+    /// @brief Transforms an array of points, in place.
+    /// @param points The array of points to transform.
+    /// @param count The number of points in the array.
+    void Transform::transform_points(Vector3* points, std::size_t count) const
+    {
+        transform_points(points, points, count);
+    }
+
+    /// @brief Transforms every point in a batch.
+    /// @param in The Vector3Batch to transform.
+    /// @param out The Vector3Batch receiving the transformed points; it is
+    /// resized to match the input, and may be the input itself.
+    void Transform::transform_points(const Vector3Batch& in, Vector3Batch& out) const
+    {
+        if (&in == &out)
+        {
+            transform_points(out);
+            return;
+        }
+
+        out.resize(in.size());
+        Kernels::active().affine_transform(&linear(0, 0), &translation.x,
+            in.x.data(), in.y.data(), in.z.data(),
+            out.x.data(), out.y.data(), out.z.data(), in.size());
+    }
+
+    /// @brief Transforms every point in a batch, in place.
+    /// @param points The Vector3Batch to transform.
+    void Transform::transform_points(Vector3Batch& points) const
+    {
+        Kernels::active().affine_transform_in_place(&linear(0, 0), &translation.x,
+            points.x.data(), points.y.data(), points.z.data(), points.size());
+    }
+
+    /// @brief Overload for the multiplication operator.
+    ///
+    /// Composes two transforms; the result applies @p other first, then this
+    /// transform.
+    Transform Transform::operator*(const Transform& other) const
+    {
+        return Transform(linear * other.linear, linear * other.translation + translation);
+    }
+
+    /// @brief Overload for the multiplication-assignment operator.
+    Transform& Transform::operator*=(const Transform& other)
+    {
+        return *this = *this * other;
+    }
+
+    /// @brief Overload for the equality comparison operator.
+    bool Transform::operator==(const Transform& other) const
+    {
+        return linear == other.linear && translation == other.translation;
+    }
+
+    /// @brief Writes a textual representation of a transform to a stream.
+    std::ostream& to_string(std::ostream& os, const Transform& t)
+    {
+        return os << t.linear << t.translation;
+    }
+
+    /// @brief Override for the output stream insertion operator.
+    std::ostream& operator<<(std::ostream& os, const Transform& t)
+    {
+        return to_string(os, t);
+    }
+}
@@ -0,0 +1,371 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "Config.h"
+#include "Parallel.h"
+#include "TransformHierarchy.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    // Throws if a node is not in the hierarchy.
+    void TransformHierarchy::check(std::size_t node) const
+    {
+        if (!contains(node))
+        {
+            MATH3D_THROW(std::out_of_range("The node is not in the hierarchy."));
+        }
+    }
+
+    // Queues a node for the next update, once.
+    void TransformHierarchy::mark_dirty(std::size_t node)
+    {
+        if (!_dirty[node])
+        {
+            _dirty[node] = 1;
+            _dirty_nodes.push_back(node);
+        }
+    }
+
+    // Recomputes the world transforms of the positions [begin,end), whose
+    // parents come first or are already up to date.
+    void TransformHierarchy::recompose(std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const std::size_t parent = _parent[i];
+            _world[i] = parent == none ? _local[i] : _world[parent] * _local[i];
+        }
+    }
+
+    // Sorts the arrays back into depth-first order, keeping siblings in the
+    // order they were, and recomputes the subtree ranges.
+    void TransformHierarchy::reorder()
+    {
+        const std::size_t count = _node.size();
+
+        // The children of every position, grouped by parent.
+        std::vector<std::size_t> first(count + 1, 0), children(count), roots;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (_parent[i] == none)
+                roots.push_back(i);
+            else
+                ++first[_parent[i] + 1];
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+            first[i + 1] += first[i];
+
+        std::vector<std::size_t> cursor(first.begin(), first.end() - 1);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (_parent[i] != none)
+                children[cursor[_parent[i]]++] = i;
+        }
+
+        // Depth-first walk, from the first root and the first child down.
+        std::vector<std::size_t> order, stack(roots.rbegin(), roots.rend()), position(count);
+        order.reserve(count);
+
+        while (!stack.empty())
+        {
+            const std::size_t i = stack.back();
+            stack.pop_back();
+            position[i] = order.size();
+            order.push_back(i);
+
+            for (std::size_t c = first[i + 1]; c > first[i]; --c)
+                stack.push_back(children[c - 1]);
+        }
+
+        std::vector<Transform> local(count), world(count);
+        std::vector<std::size_t> parent(count), node(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const std::size_t old = order[i];
+            local[i] = _local[old];
+            world[i] = _world[old];
+            parent[i] = _parent[old] == none ? none : position[_parent[old]];
+            node[i] = _node[old];
+            _position[node[i]] = i;
+        }
+
+        // A parent precedes its descendants, so the subtree sizes are summed
+        // back to front.
+        std::vector<std::size_t> end(count, 1);
+
+        for (std::size_t i = count; i-- > 0;)
+        {
+            if (parent[i] != none)
+                end[parent[i]] += end[i];
+
+            end[i] += i;
+        }
+
+        _local.swap(local);
+        _world.swap(world);
+        _parent.swap(parent);
+        _node.swap(node);
+        _end.swap(end);
+        _ordered = true;
+    }
+
+    /// @brief Adds a node.
+    /// @param local The transform of the node relative to its parent.
+    /// @param parent The parent of the node, or none to add a root.
+    /// @return The identifier of the node; its world transform is computed
+    /// by the next update().
+    /// @throw std::out_of_range If the parent is not in the hierarchy.
+    std::size_t TransformHierarchy::add(const Transform& local, std::size_t parent)
+    {
+        if (parent != none)
+            check(parent);
+
+        const std::size_t node = _position.size();
+        const std::size_t position = _node.size();
+
+        _local.push_back(local);
+        _world.push_back(local);
+        _parent.push_back(parent == none ? none : _position[parent]);
+        _end.push_back(position + 1);
+        _node.push_back(node);
+        _position.push_back(position);
+        _dirty.push_back(0);
+
+        // A root appended at the end keeps the order depth-first; a child
+        // lands outside its parent's range.
+        if (parent != none)
+            _ordered = false;
+
+        mark_dirty(node);
+        return node;
+    }
+
+    /// @brief Removes every node.
+    void TransformHierarchy::clear()
+    {
+        _local.clear();
+        _world.clear();
+        _parent.clear();
+        _end.clear();
+        _node.clear();
+        _position.clear();
+        _dirty.clear();
+        _dirty_nodes.clear();
+        _ordered = true;
+    }
+
+    /// @brief Whether a node is in the hierarchy.
+    bool TransformHierarchy::contains(std::size_t node) const
+    {
+        return node < _position.size();
+    }
+
+    /// @brief Whether the hierarchy has no nodes.
+    bool TransformHierarchy::empty() const
+    {
+        return _position.empty();
+    }
+
+    /// @brief The transform of a node relative to its parent.
+    /// @throw std::out_of_range If the node is not in the hierarchy.
+    const Transform& TransformHierarchy::local(std::size_t node) const
+    {
+        check(node);
+        return _local[_position[node]];
+    }
+
+    /// @brief The parent of a node, or none for a root.
+    /// @throw std::out_of_range If the node is not in the hierarchy.
+    std::size_t TransformHierarchy::parent(std::size_t node) const
+    {
+        check(node);
+        const std::size_t position = _parent[_position[node]];
+        return position == none ? none : _node[position];
+    }
+
+    /// @brief Reserves room for a number of nodes.
+    void TransformHierarchy::reserve(std::size_t count)
+    {
+        _local.reserve(count);
+        _world.reserve(count);
+        _parent.reserve(count);
+        _end.reserve(count);
+        _node.reserve(count);
+        _position.reserve(count);
+        _dirty.reserve(count);
+    }
+
+    /// @brief Changes the transform of a node relative to its parent; the
+    /// world transforms of the node and its descendants are recomputed by the
+    /// next update().
+    /// @param node The node.
+    /// @param local Its new local transform.
+    /// @throw std::out_of_range If the node is not in the hierarchy.
+    void TransformHierarchy::set_local(std::size_t node, const Transform& local)
+    {
+        check(node);
+        _local[_position[node]] = local;
+        mark_dirty(node);
+    }
+
+    /// @brief Moves a node, and its descendants, under another parent.
+    ///
+    /// The local transform is kept, so the node moves with its new parent;
+    /// its world transform is recomputed by the next update().
+    ///
+    /// @param node The node.
+    /// @param parent The new parent, or none to make the node a root.
+    /// @throw std::out_of_range If either node is not in the hierarchy.
+    /// @throw std::invalid_argument If the new parent is the node itself or
+    /// one of its descendants.
+    void TransformHierarchy::set_parent(std::size_t node, std::size_t parent)
+    {
+        check(node);
+        const std::size_t position = _position[node];
+
+        if (parent != none)
+        {
+            check(parent);
+
+            for (std::size_t p = _position[parent]; p != none; p = _parent[p])
+            {
+                if (p == position)
+                {
+                    MATH3D_THROW(std::invalid_argument("A node cannot be moved under its own subtree."));
+                }
+            }
+        }
+
+        _parent[position] = parent == none ? none : _position[parent];
+        _ordered = false;
+        mark_dirty(node);
+    }
+
+    /// @brief The number of nodes.
+    std::size_t TransformHierarchy::size() const
+    {
+        return _position.size();
+    }
+
+    /// @brief Recomputes the world transforms of every node changed since the
+    /// last update, and of their descendants.
+    ///
+    /// The outermost dirty subtrees are recomposed in parallel, split at their
+    /// roots until no piece is larger than chunk_nodes; with fewer than
+    /// chunk_nodes nodes to recompose, the calling thread does all the work.
+    ///
+    /// @return The number of world transforms recomputed.
+    std::size_t TransformHierarchy::update()
+    {
+        if (!_ordered)
+            reorder();
+
+        if (_dirty_nodes.empty())
+            return 0;
+
+        // The dirty positions, in order. When many nodes changed, sweeping
+        // the flags in depth-first order is cheaper than sorting.
+        const std::size_t count = _node.size();
+
+        if (_dirty_nodes.size() > count / 16)
+        {
+            _dirty_nodes.clear();
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (_dirty[_node[i]])
+                {
+                    _dirty[_node[i]] = 0;
+                    _dirty_nodes.push_back(i);
+                }
+            }
+        }
+        else
+        {
+            for (std::size_t& node : _dirty_nodes)
+            {
+                _dirty[node] = 0;
+                node = _position[node];
+            }
+
+            std::sort(_dirty_nodes.begin(), _dirty_nodes.end());
+        }
+
+        // Cut the outermost dirty subtrees into ranges of at most chunk_nodes
+        // nodes. A subtree too large is entered: its root is recomposed here,
+        // and the walk continues with its first child.
+        std::size_t recomposed = 0;
+        std::size_t covered = 0;
+        _ranges.clear();
+
+        for (std::size_t root : _dirty_nodes)
+        {
+            if (root < covered)
+                continue;
+
+            covered = _end[root];
+
+            for (std::size_t i = root; i < covered;)
+            {
+                if (_end[i] - i <= chunk_nodes)
+                {
+                    _ranges.push_back(Range{ i, _end[i] });
+                    recomposed += _end[i] - i;
+                    i = _end[i];
+                }
+                else
+                {
+                    recompose(i, i + 1);
+                    ++recomposed;
+                    ++i;
+                }
+            }
+        }
+
+        _dirty_nodes.clear();
+
+        // Group consecutive ranges into batches of about chunk_nodes nodes.
+        _batches.clear();
+        std::size_t batch_nodes = chunk_nodes;
+
+        for (std::size_t r = 0; r < _ranges.size(); ++r)
+        {
+            if (batch_nodes >= chunk_nodes)
+            {
+                _batches.push_back(r);
+                batch_nodes = 0;
+            }
+
+            batch_nodes += _ranges[r].end - _ranges[r].begin;
+        }
+
+        _batches.push_back(_ranges.size());
+
+        const std::size_t batches = _batches.size() - 1;
+        const auto run_batches = [this](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t r = _batches[begin]; r < _batches[end]; ++r)
+                recompose(_ranges[r].begin, _ranges[r].end);
+        };
+
+        if (batches == 1)
+            run_batches(0, 1);
+        else if (batches > 1)
+            Parallel::parallel_for(batches, 1, run_batches);
+
+        return recomposed;
+    }
+
+    /// @brief The world transform of a node, as of the last update().
+    /// @throw std::out_of_range If the node is not in the hierarchy.
+    const Transform& TransformHierarchy::world(std::size_t node) const
+    {
+        check(node);
+        return _world[_position[node]];
+    }
+}
@@ -0,0 +1,207 @@
+#include <stdexcept>
+#include <utility>
+
+#include "Config.h"
+#include "Kernels.h"
+#include "Vector3Batch.h"
+
+/// @namespace Math3D
+namespace Math3D
+{
+    // Throws if the two batches do not hold the same number of vectors.
+    static void check_sizes(const Vector3Batch& v, const Vector3Batch& w)
+    {
+        if (v.size() != w.size())
+        {
+            MATH3D_THROW(std::invalid_argument("Batch sizes do not match."));
+        }
+    }
+
+    // Runs a binary kernel, going through a temporary when the output aliases
+    // one of the inputs, since the kernels assume disjoint arrays.
+    static void apply(Kernels::VectorVectorToVector kernel, const Vector3Batch& v, const Vector3Batch& w, Vector3Batch& out)
+    {
+        check_sizes(v, w);
+
+        if (&out == &v || &out == &w)
+        {
+            Vector3Batch tmp;
+            apply(kernel, v, w, tmp);
+            out = std::move(tmp);
+            return;
+        }
+
+        out.resize(v.size());
+        kernel(
+            v.x.data(), v.y.data(), v.z.data(),
+            w.x.data(), w.y.data(), w.z.data(),
+            out.x.data(), out.y.data(), out.z.data(), v.size());
+    }
+
+    /// @brief Computes the cross product of every pair of vectors.
+    void Vector3Batch::cross(const Vector3Batch& v, const Vector3Batch& w, Vector3Batch& out)
+    {
+        apply(Kernels::active().cross, v, w, out);
+    }
+
+    /// @brief Computes the distance between every pair of points.
+    void Vector3Batch::distance(const Vector3Batch& v, const Vector3Batch& w, float* out)
+    {
+        check_sizes(v, w);
+        Kernels::active().distance(
+            v.x.data(), v.y.data(), v.z.data(),
+            w.x.data(), w.y.data(), w.z.data(), out, v.size());
+    }
+
+    /// @brief Computes the dot product of every pair of vectors.
+    void Vector3Batch::dot(const Vector3Batch& v, const Vector3Batch& w, float* out)
+    {
+        check_sizes(v, w);
+        Kernels::active().dot(
+            v.x.data(), v.y.data(), v.z.data(),
+            w.x.data(), w.y.data(), w.z.data(), out, v.size());
+    }
+
+    /// @brief Linearly interpolates between every pair of points.
+    void Vector3Batch::lerp(const Vector3Batch& v, const Vector3Batch& w, float t, Vector3Batch& out)
+    {
+        check_sizes(v, w);
+
+        if (&out == &v || &out == &w)
+        {
+            Vector3Batch tmp;
+            lerp(v, w, t, tmp);
+            out = std::move(tmp);
+            return;
+        }
+
+        // Clamp t to [0,1]
+        t = std::fmax(t, 0.0f);
+        t = std::fmin(t, 1.0f);
+
+        out.resize(v.size());
+        Kernels::active().lerp(
+            v.x.data(), v.y.data(), v.z.data(),
+            w.x.data(), w.y.data(), w.z.data(), t,
+            out.x.data(), out.y.data(), out.z.data(), v.size());
+    }
+
+    /// @brief Computes the magnitude of every vector.
+    void Vector3Batch::magnitude(const Vector3Batch& v, float* out)
+    {
+        Kernels::active().magnitude(v.x.data(), v.y.data(), v.z.data(), out, v.size());
+    }
+
+    /// @brief Turns every vector in the batch into a unit vector.
+    void Vector3Batch::normalize(Vector3Batch& v)
+    {
+        Kernels::active().normalize(v.x.data(), v.y.data(), v.z.data(), v.size());
+    }
+
+    /// @brief Computes the projection of every vector onto another.
+    void Vector3Batch::project(const Vector3Batch& v, const Vector3Batch& w, Vector3Batch& out)
+    {
+        apply(Kernels::active().project, v, w, out);
+    }
+
+    /// @brief Computes the rejection of every vector onto another.
+    void Vector3Batch::reject(const Vector3Batch& v, const Vector3Batch& w, Vector3Batch& out)
+    {
+        apply(Kernels::active().reject, v, w, out);
+    }
+
+    /// @brief Multiplies every pair of vectors component-wise.
+    void Vector3Batch::scale(const Vector3Batch& v, const Vector3Batch& w, Vector3Batch& out)
+    {
+        apply(Kernels::active().scale, v, w, out);
+    }
+
+    /// @brief Constructor for Vector3Batch.
+    /// @param size The number of zero vectors in the batch.
+    Vector3Batch::Vector3Batch(std::size_t size) : x(size), y(size), z(size) {}
+
+    /// @brief Constructor for Vector3Batch.
+    /// @param vectors The vectors to copy into the batch.
+    Vector3Batch::Vector3Batch(const std::vector<Vector3>& vectors)
+        : x(vectors.size()), y(vectors.size()), z(vectors.size())
+    {
+        for (std::size_t i = 0; i < vectors.size(); ++i)
+        {
+            x[i] = vectors[i].x;
+            y[i] = vectors[i].y;
+            z[i] = vectors[i].z;
+        }
+    }
+
+    /// @brief Removes every vector from the batch.
+    void Vector3Batch::clear()
+    {
+        x.clear();
+        y.clear();
+        z.clear();
+    }
+
+    /// @brief Checks whether the batch holds no vectors.
+    /// @return @c true if the batch is empty, @c false otherwise.
+    bool Vector3Batch::empty() const
+    {
+        return x.empty();
+    }
+
+    /// @brief Appends a vector to the end of the batch.
+    void Vector3Batch::push_back(const Vector3& v)
+    {
+        x.push_back(v.x);
+        y.push_back(v.y);
+        z.push_back(v.z);
+    }
+
+    /// @brief Reserves storage for at least the given number of vectors.
+    void Vector3Batch::reserve(std::size_t size)
+    {
+        x.reserve(size);
+        y.reserve(size);
+        z.reserve(size);
+    }
+
+    /// @brief Resizes the batch, padding it with zero vectors if it grows.
+    void Vector3Batch::resize(std::size_t size)
+    {
+        x.resize(size);
+        y.resize(size);
+        z.resize(size);
+    }
+
+    /// @brief Overwrites the vector at the given index.
+    void Vector3Batch::set(std::size_t index, const Vector3& v)
+    {
+        x[index] = v.x;
+        y[index] = v.y;
+        z[index] = v.z;
+    }
+
+    /// @brief The number of vectors in the batch.
+    std::size_t Vector3Batch::size() const
+    {
+        return x.size();
+    }
+
+    /// @brief Converts the batch back into an array of structures.
+    /// @return A std::vector holding a copy of every vector in the batch.
+    std::vector<Vector3> Vector3Batch::to_vector() const
+    {
+        std::vector<Vector3> vectors;
+        vectors.reserve(size());
+
+        for (std::size_t i = 0; i < size(); ++i)
+            vectors.push_back(Vector3(x[i], y[i], z[i]));
+
+        return vectors;
+    }
+
+    /// @brief Overload for the brackets operator.
+    Vector3 Vector3Batch::operator[](std::size_t index) const
+    {
+        return Vector3(x[index], y[index], z[index]);
+    }
+}
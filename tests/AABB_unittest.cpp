@@ -0,0 +1,139 @@
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "AABB.h"
+#include "MathObject.h"
+
+namespace Math3D
+{
+    namespace Math3DTests
+    {
+        class AABBTest : public testing::Test
+        {
+        protected:
+            AABB a, b;
+            std::vector<Vector3> points;
+
+            virtual void SetUp()
+            {
+                a = AABB(Vector3(-1.0f, -2.0f, -3.0f), Vector3(1.0f, 2.0f, 3.0f));
+                b = AABB(Vector3(0.5f, 1.0f, 2.0f), Vector3(4.0f, 5.0f, 6.0f));
+
+                // Not a multiple of the kernel block, so the tail runs too.
+                std::srand(41);
+                for (int i = 0; i < 1001; ++i)
+                {
+                    points.push_back(Vector3(random(), random(), random()));
+                }
+            }
+
+            static float random()
+            {
+                return 20.0f * std::rand() / RAND_MAX - 10.0f;
+            }
+
+            // The bounds of an array of points, one point at a time.
+            static AABB reference_bounds(const std::vector<Vector3>& points)
+            {
+                AABB box;
+                for (const Vector3& p : points)
+                {
+                    box.expand(p);
+                }
+                return box;
+            }
+        };
+
+        TEST_F(AABBTest, DefaultIsEmpty)
+        {
+            EXPECT_TRUE(AABB().empty());
+            EXPECT_FALSE(AABB().contains(Vector3::zero));
+            EXPECT_FALSE(a.empty());
+            EXPECT_EQ(AABB(), AABB(Vector3::one, Vector3::zero))
+                << "Every empty box should compare equal.";
+        }
+
+        TEST_F(AABBTest, ExpandingEmptyBoxByPointGivesThatPoint)
+        {
+            AABB box;
+            box.expand(Vector3(1.0f, 2.0f, 3.0f));
+            EXPECT_EQ(box, AABB(Vector3(1.0f, 2.0f, 3.0f), Vector3(1.0f, 2.0f, 3.0f)));
+        }
+
+        TEST_F(AABBTest, Measurements)
+        {
+            EXPECT_EQ(a.center(), Vector3::zero);
+            EXPECT_EQ(a.extents(), Vector3(1.0f, 2.0f, 3.0f));
+            EXPECT_FLOAT_EQ(a.volume(), 48.0f);
+            EXPECT_FLOAT_EQ(a.surface_area(), 2.0f * (8.0f + 24.0f + 12.0f));
+        }
+
+        TEST_F(AABBTest, ContainmentAndOverlap)
+        {
+            EXPECT_TRUE(a.contains(Vector3(1.0f, 2.0f, 3.0f))) << "The boundary belongs to the box.";
+            EXPECT_FALSE(a.contains(Vector3(1.1f, 0.0f, 0.0f)));
+            EXPECT_TRUE(a.overlaps(b));
+            EXPECT_TRUE(b.overlaps(a));
+            EXPECT_FALSE(a.contains(b));
+            EXPECT_TRUE(AABB::merge(a, b).contains(a));
+            EXPECT_TRUE(AABB::merge(a, b).contains(b));
+            EXPECT_FALSE(a.overlaps(AABB(Vector3(1.5f, 0.0f, 0.0f), Vector3(2.0f, 1.0f, 1.0f))));
+        }
+
+        TEST_F(AABBTest, ClosestPointAndDistance)
+        {
+            EXPECT_EQ(a.closest_point(Vector3(0.5f, 0.5f, 0.5f)), Vector3(0.5f, 0.5f, 0.5f));
+            EXPECT_EQ(a.closest_point(Vector3(4.0f, 0.0f, -7.0f)), Vector3(1.0f, 0.0f, -3.0f));
+            EXPECT_FLOAT_EQ(a.sqr_distance(Vector3(4.0f, 0.0f, -7.0f)), 9.0f + 16.0f);
+            EXPECT_FLOAT_EQ(a.sqr_distance(Vector3::zero), 0.0f);
+        }
+
+        TEST_F(AABBTest, BoundsMatchExpandingOneByOne)
+        {
+            const AABB expected = reference_bounds(points);
+
+            EXPECT_EQ(AABB::from_points(points.data(), points.size()), expected);
+            EXPECT_EQ(AABB::from_points(Vector3Batch(points)), expected);
+
+            for (const Vector3& p : points)
+            {
+                EXPECT_TRUE(expected.contains(p));
+            }
+        }
+
+        TEST_F(AABBTest, BoundsOfShortAndEmptyArrays)
+        {
+            EXPECT_TRUE(AABB::from_points(points.data(), 0).empty());
+            EXPECT_TRUE(AABB::from_points(Vector3Batch()).empty());
+
+            for (std::size_t n = 1; n < 40; ++n)
+            {
+                const std::vector<Vector3> head(points.begin(), points.begin() + n);
+                EXPECT_EQ(AABB::from_points(head.data(), n), reference_bounds(head)) << "count " << n;
+            }
+        }
+
+        TEST_F(AABBTest, BulkOverlapMatchesScalar)
+        {
+            std::vector<AABB> boxes;
+            for (std::size_t i = 0; i + 1 < points.size(); i += 2)
+            {
+                AABB box(points[i], points[i]);
+                box.expand(points[i + 1]);
+                boxes.push_back(box);
+            }
+
+            std::vector<unsigned char> out(boxes.size());
+            const std::size_t count = AABB::overlaps(a, boxes.data(), boxes.size(), out.data());
+
+            std::size_t expected = 0;
+            for (std::size_t i = 0; i < boxes.size(); ++i)
+            {
+                EXPECT_EQ(out[i] != 0, a.overlaps(boxes[i])) << "index " << i;
+                expected += a.overlaps(boxes[i]);
+            }
+            EXPECT_EQ(count, expected);
+        }
+    }
+}
@@ -0,0 +1,181 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Expect.h"
+#include "ArrayFile.h"
+#include "MathObject.h"
+
+namespace Math3D
+{
+    namespace Math3DTests
+    {
+        class ArrayFileTest : public testing::Test
+        {
+        protected:
+            std::string path;
+            std::vector<Vector3> vectors;
+            std::vector<Matrix3> matrices;
+
+            virtual void SetUp()
+            {
+                path = testing::TempDir() + "math3d_array_file_test.bin";
+
+                std::srand(53);
+                for (int i = 0; i < 1000; ++i)
+                {
+                    vectors.push_back(Vector3(random(), random(), random()));
+                    matrices.push_back(Matrix3(
+                        random(), random(), random(),
+                        random(), random(), random(),
+                        random(), random(), random()));
+                }
+            }
+
+            virtual void TearDown()
+            {
+                std::remove(path.c_str());
+            }
+
+            static float random()
+            {
+                return 20.0f * std::rand() / RAND_MAX - 10.0f;
+            }
+
+            // Overwrites part of the file at the given offset.
+            void patch(std::size_t offset, const void* bytes, std::size_t size)
+            {
+                std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+                file.seekp(static_cast<std::streamoff>(offset));
+                file.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+            }
+        };
+
+        TEST_F(ArrayFileTest, WrittenVectorsAreMappedBack)
+        {
+            {
+                ArrayWriter<Vector3> writer(path);
+                writer.write(vectors.data(), 600);
+                for (std::size_t i = 600; i < vectors.size(); ++i)
+                    writer.write(vectors[i]);
+                EXPECT_EQ(writer.size(), vectors.size());
+                writer.close();
+            }
+
+            const MappedArray<Vector3> mapped(path);
+            ASSERT_EQ(mapped.size(), vectors.size());
+            EXPECT_EQ(std::memcmp(mapped.data(), vectors.data(), vectors.size() * sizeof(Vector3)), 0)
+                << "The elements should be stored exactly as they are in memory.";
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(mapped.data()) % ArrayFileHeader::data_alignment, 0u)
+                << "The mapped elements should be aligned to a cache line.";
+        }
+
+        TEST_F(ArrayFileTest, WrittenMatricesAreMappedBack)
+        {
+            {
+                ArrayWriter<Matrix3> writer(path);
+                writer.write(matrices.data(), matrices.size());
+            }
+
+            const MappedArray<Matrix3> mapped(path);
+            ASSERT_EQ(mapped.size(), matrices.size());
+
+            std::size_t i = 0;
+            for (const Matrix3& m : mapped)
+                EXPECT_EQ(m, matrices[i++]);
+        }
+
+        TEST_F(ArrayFileTest, HalfPrecisionVectorsTakeHalfTheSpace)
+        {
+            std::vector<Vector3Half> packed(vectors.size());
+            Vector3Half::pack(vectors.data(), packed.data(), vectors.size());
+
+            {
+                ArrayWriter<Vector3Half> writer(path);
+                writer.write(packed.data(), packed.size());
+            }
+
+            const MappedArray<Vector3Half> mapped(path);
+            ASSERT_EQ(mapped.size(), vectors.size());
+
+            std::vector<Vector3> unpacked(mapped.size());
+            Vector3Half::unpack(mapped.data(), unpacked.data(), mapped.size());
+
+            for (std::size_t i = 0; i < vectors.size(); ++i)
+                EXPECT_TRUE(is_almost_equal(unpacked[i].x, vectors[i].x, 0.01f)) << "Mismatch at index " << i << ".";
+
+            MATH3D_EXPECT_THROW(MappedArray<Vector3> wrong(path), std::runtime_error);
+        }
+
+        TEST_F(ArrayFileTest, EmptyArrayRoundTrips)
+        {
+            ArrayWriter<Vector3>(path).close();
+
+            const MappedArray<Vector3> mapped(path);
+            EXPECT_TRUE(mapped.empty());
+            EXPECT_EQ(mapped.begin(), mapped.end());
+        }
+
+        TEST_F(ArrayFileTest, WritingAfterCloseThrows)
+        {
+            ArrayWriter<Vector3> writer(path);
+            writer.close();
+            MATH3D_EXPECT_THROW(writer.write(vectors[0]), std::runtime_error);
+        }
+
+        TEST_F(ArrayFileTest, MismatchedFilesAreRejected)
+        {
+            {
+                ArrayWriter<Vector3> writer(path);
+                writer.write(vectors.data(), vectors.size());
+            }
+
+            MATH3D_EXPECT_THROW(MappedArray<Matrix3> mapped(path), std::runtime_error)
+                << "A file of vectors should not map as matrices.";
+            MATH3D_EXPECT_THROW(MappedArray<Vector3> mapped(path + ".missing"), std::runtime_error);
+
+            const std::uint32_t swapped = 0x04030201;
+            patch(8, &swapped, sizeof(swapped));
+            MATH3D_EXPECT_THROW(MappedArray<Vector3> mapped(path), std::runtime_error)
+                << "A file written with the other byte order should be rejected.";
+
+            patch(0, "NOTARRAY", 8);
+            MATH3D_EXPECT_THROW(MappedArray<Vector3> mapped(path), std::runtime_error);
+        }
+
+        TEST_F(ArrayFileTest, TruncatedFilesAreRejected)
+        {
+            {
+                ArrayWriter<Vector3> writer(path);
+                writer.write(vectors.data(), vectors.size());
+            }
+
+            const std::uint64_t count = vectors.size() + 1;
+            patch(offsetof(ArrayFileHeader, count), &count, sizeof(count));
+            MATH3D_EXPECT_THROW(MappedArray<Vector3> mapped(path), std::runtime_error);
+        }
+
+        TEST_F(ArrayFileTest, MappedArraysCanBeMoved)
+        {
+            {
+                ArrayWriter<Vector3> writer(path);
+                writer.write(vectors.data(), vectors.size());
+            }
+
+            MappedArray<Vector3> a(path);
+            MappedArray<Vector3> b(std::move(a));
+            EXPECT_TRUE(a.empty());
+            ASSERT_EQ(b.size(), vectors.size());
+            EXPECT_EQ(b[10], vectors[10]);
+
+            a = std::move(b);
+            EXPECT_TRUE(b.empty());
+            EXPECT_EQ(a[999], vectors[999]);
+        }
+    }
+}
@@ -0,0 +1,296 @@
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "AABB.h"
+#include "Dispatch.h"
+#include "Fast.h"
+#include "Half.h"
+#include "MathObject.h"
+#include "PackedNormal.h"
+#include "Matrix3Batch.h"
+#include "Quaternion.h"
+#include "Ray.h"
+#include "Transform.h"
+#include "Vector3Batch.h"
+
+namespace Math3D
+{
+    namespace Math3DTests
+    {
+        // Every bulk result, computed at one SIMD level.
+        struct BulkResults
+        {
+            Vector3Batch cross, fast_normalized, lerp, normalized, project, reject, scale, transformed, affine;
+            std::vector<float> distance, dot, magnitude, determinant, fast_angle, fast_magnitude;
+            Matrix3Batch inverse;
+            std::vector<unsigned char> singular;
+            Vector3Batch eigenvalues, eigenvectors[3];
+            Matrix3Batch rotation, stretch, orthonormalized;
+            std::vector<Vector3> rotated;
+            std::vector<Quaternion> slerped;
+            AABB bounds, packed_bounds;
+            std::vector<unsigned char> box_overlaps;
+            std::vector<unsigned> box_hits, sphere_hits;
+            std::vector<float> box_t, sphere_t;
+            std::vector<Vector3Half> packed;
+            std::vector<Vector3> unpacked;
+            std::vector<PackedNormal16> normals16;
+            std::vector<PackedNormal32> normals32;
+            Vector3Batch decoded16, decoded32;
+            std::vector<float> normal_dot16, normal_dot32;
+        };
+
+        class DispatchTest : public testing::Test
+        {
+        protected:
+            SimdLevel original;
+            Vector3Batch v, w;
+            Matrix3Batch m;
+            std::vector<Quaternion> p, q;
+
+            virtual void SetUp()
+            {
+                original = simd_level();
+
+                // Not a multiple of any vector width, so the tails run too.
+                std::srand(7);
+                for (int i = 0; i < 1003; ++i)
+                {
+                    v.push_back(Vector3(random(), random(), random()));
+                    w.push_back(Vector3(random(), random(), random()));
+                    // Dominant diagonals keep the matrices well-conditioned.
+                    m.push_back(Matrix3(
+                        20.0f + random(), random(), random(),
+                        random(), 20.0f + random(), random(),
+                        random(), random(), 20.0f + random()));
+                    p.push_back(Quaternion(random(), random(), random(), random()).normalized());
+                    q.push_back(Quaternion(random(), random(), random(), random()).normalized());
+                }
+
+                m.set(500, Matrix3());
+            }
+
+            virtual void TearDown()
+            {
+                set_simd_level(original);
+            }
+
+            static float random()
+            {
+                return 20.0f * std::rand() / RAND_MAX - 10.0f;
+            }
+
+            BulkResults compute(SimdLevel level)
+            {
+                EXPECT_TRUE(set_simd_level(level));
+
+                BulkResults r;
+                r.distance.resize(v.size());
+                r.dot.resize(v.size());
+                r.magnitude.resize(v.size());
+                r.fast_angle.resize(v.size());
+                r.fast_magnitude.resize(v.size());
+                r.determinant.resize(m.size());
+                r.singular.resize(m.size());
+                r.rotated.resize(p.size());
+                r.slerped.resize(p.size());
+                r.box_overlaps.resize(v.size());
+                r.box_t.resize(v.size());
+                r.sphere_t.resize(v.size());
+                r.packed.resize(v.size());
+                r.unpacked.resize(v.size());
+                r.normals16.resize(v.size());
+                r.normals32.resize(v.size());
+                r.normal_dot16.resize(v.size());
+                r.normal_dot32.resize(v.size());
+
+                Vector3Batch::cross(v, w, r.cross);
+                Vector3Batch::distance(v, w, r.distance.data());
+                Vector3Batch::dot(v, w, r.dot.data());
+                Vector3Batch::lerp(v, w, 0.3f, r.lerp);
+                Vector3Batch::magnitude(v, r.magnitude.data());
+                r.normalized = v;
+                Vector3Batch::normalize(r.normalized);
+                Vector3Batch::project(v, w, r.project);
+                Vector3Batch::reject(v, w, r.reject);
+                Vector3Batch::scale(v, w, r.scale);
+                Fast::angle(v, w, r.fast_angle.data());
+                Fast::magnitude(v, r.fast_magnitude.data());
+                r.fast_normalized = v;
+                Fast::normalize(r.fast_normalized);
+                m[0].transform(v, r.transformed);
+                Transform(m[1], Vector3(1.0f, -2.0f, 3.0f)).transform_points(v, r.affine);
+                Matrix3Batch::determinant(m, r.determinant.data());
+                Matrix3Batch::inverse(m, r.inverse, r.singular.data());
+                Matrix3Batch::symmetric_eigen(m, r.eigenvalues, r.eigenvectors);
+                Matrix3Batch::polar(m, r.rotation, r.stretch);
+                r.orthonormalized = r.rotation;
+                Matrix3Batch::orthonormalize(r.orthonormalized);
+
+                const std::vector<Vector3> vectors = v.to_vector();
+                Quaternion::rotate(p.data(), vectors.data(), r.rotated.data(), p.size());
+                Quaternion::slerp(p.data(), q.data(), 0.3f, r.slerped.data(), p.size());
+
+                r.bounds = AABB::from_points(v);
+                r.packed_bounds = AABB::from_points(vectors.data(), vectors.size());
+
+                std::vector<AABB> boxes;
+                std::vector<Ray> rays;
+                for (std::size_t i = 0; i < v.size(); ++i)
+                {
+                    boxes.push_back(AABB(v[i], v[i] + Vector3(2.0f, 2.0f, 2.0f)));
+                    rays.push_back(Ray(v[i], w[i]));
+                }
+                AABB::overlaps(AABB(Vector3(-3.0f, -3.0f, -3.0f), Vector3(2.0f, 2.0f, 2.0f)),
+                    boxes.data(), boxes.size(), r.box_overlaps.data());
+
+                const AABB box(Vector3(-2.0f, -3.0f, -1.0f), Vector3(3.0f, 2.0f, 4.0f));
+                const Sphere sphere(Vector3(1.0f, -1.0f, 0.5f), 3.0f);
+                for (std::size_t i = 0; i + RayPacket8::size <= rays.size(); i += RayPacket8::size)
+                {
+                    const RayPacket8 packet(&rays[i]);
+                    r.box_hits.push_back(packet.intersect(box, &r.box_t[i]));
+                    r.sphere_hits.push_back(packet.intersect(sphere, &r.sphere_t[i]));
+                }
+
+                Vector3Half::pack(vectors.data(), r.packed.data(), vectors.size());
+                Vector3Half::unpack(r.packed.data(), r.unpacked.data(), r.packed.size());
+
+                const Vector3 light = Vector3(1.0f, 2.0f, -2.0f).normalized();
+                PackedNormal16::encode(vectors.data(), r.normals16.data(), vectors.size());
+                PackedNormal16::decode(r.normals16.data(), r.normals16.size(), r.decoded16);
+                PackedNormal16::dot(r.normals16.data(), light, r.normal_dot16.data(), r.normals16.size());
+                PackedNormal32::encode(v, r.normals32.data());
+                PackedNormal32::decode(r.normals32.data(), r.normals32.size(), r.decoded32);
+                PackedNormal32::dot(r.normals32.data(), light, r.normal_dot32.data(), r.normals32.size());
+
+                return r;
+            }
+        };
+
+        TEST_F(DispatchTest, ActiveLevelIsSupported)
+        {
+            EXPECT_LE(simd_level(), detect_simd_level())
+                << "The active level should never exceed what the CPU supports.";
+            EXPECT_TRUE(set_simd_level(SimdLevel::Scalar))
+                << "The scalar reference level should always be available.";
+            EXPECT_EQ(simd_level(), SimdLevel::Scalar);
+        }
+
+        TEST_F(DispatchTest, UnsupportedLevelsAreRejected)
+        {
+            if (detect_simd_level() == SimdLevel::AVX512)
+                return;
+
+            set_simd_level(SimdLevel::Scalar);
+
+            EXPECT_FALSE(set_simd_level(SimdLevel::AVX512))
+                << "Selecting a level the CPU lacks should fail.";
+            EXPECT_EQ(simd_level(), SimdLevel::Scalar)
+                << "A failed switch should leave the active level unchanged.";
+        }
+
+        TEST_F(DispatchTest, EveryLevelMatchesScalarReference)
+        {
+            const BulkResults expected = compute(SimdLevel::Scalar);
+            const SimdLevel levels[] = { SimdLevel::SSE42, SimdLevel::AVX2, SimdLevel::AVX512 };
+
+            for (SimdLevel level : levels)
+            {
+                if (level > detect_simd_level())
+                    continue;
+
+                SCOPED_TRACE(simd_level_name(level));
+                const BulkResults actual = compute(level);
+
+                for (std::size_t i = 0; i < v.size(); ++i)
+                {
+                    EXPECT_EQ(actual.cross[i], expected.cross[i]) << "cross, index " << i;
+                    EXPECT_EQ(actual.lerp[i], expected.lerp[i]) << "lerp, index " << i;
+                    EXPECT_EQ(actual.normalized[i], expected.normalized[i]) << "normalize, index " << i;
+                    EXPECT_EQ(actual.project[i], expected.project[i]) << "project, index " << i;
+                    EXPECT_EQ(actual.reject[i], expected.reject[i]) << "reject, index " << i;
+                    EXPECT_EQ(actual.scale[i], expected.scale[i]) << "scale, index " << i;
+                    EXPECT_EQ(actual.transformed[i], expected.transformed[i]) << "transform, index " << i;
+                    EXPECT_EQ(actual.affine[i], expected.affine[i]) << "affine transform, index " << i;
+                    EXPECT_TRUE(is_almost_equal(actual.distance[i], expected.distance[i])) << "distance, index " << i;
+                    EXPECT_TRUE(is_almost_equal(actual.dot[i], expected.dot[i])) << "dot, index " << i;
+                    EXPECT_TRUE(is_almost_equal(actual.magnitude[i], expected.magnitude[i])) << "magnitude, index " << i;
+                    EXPECT_EQ(actual.fast_normalized[i], expected.fast_normalized[i]) << "fast normalize, index " << i;
+                    EXPECT_TRUE(is_almost_equal(actual.fast_angle[i], expected.fast_angle[i])) << "fast angle, index " << i;
+                    EXPECT_TRUE(is_almost_equal(actual.fast_magnitude[i], expected.fast_magnitude[i])) << "fast magnitude, index " << i;
+                    EXPECT_EQ(actual.packed[i].y.bits, expected.packed[i].y.bits) << "half pack, index " << i;
+                    EXPECT_EQ(actual.unpacked[i].z, expected.unpacked[i].z) << "half unpack, index " << i;
+
+                    // FMA contraction may round a coordinate across a tie.
+                    EXPECT_LE(std::abs(actual.normals16[i].u - expected.normals16[i].u), 1) << "octahedral 16, index " << i;
+                    EXPECT_LE(std::abs(actual.normals32[i].v - expected.normals32[i].v), 1) << "octahedral 32, index " << i;
+                    if (actual.normals16[i] == expected.normals16[i])
+                    {
+                        EXPECT_EQ(actual.decoded16[i], expected.decoded16[i]) << "octahedral decode, index " << i;
+                        EXPECT_TRUE(is_almost_equal(actual.normal_dot16[i], expected.normal_dot16[i])) << "octahedral dot, index " << i;
+                    }
+                    if (actual.normals32[i] == expected.normals32[i])
+                    {
+                        EXPECT_EQ(actual.decoded32[i], expected.decoded32[i]) << "octahedral decode, index " << i;
+                        EXPECT_TRUE(is_almost_equal(actual.normal_dot32[i], expected.normal_dot32[i])) << "octahedral dot, index " << i;
+                    }
+                }
+
+                for (std::size_t i = 0; i < m.size(); ++i)
+                {
+                    // FMA contraction may round differently; allow for it.
+                    const float tolerance = 1e-5f * std::fmax(1.0f, std::fabs(expected.determinant[i]));
+                    EXPECT_NEAR(actual.determinant[i], expected.determinant[i], tolerance) << "determinant, index " << i;
+                    EXPECT_EQ(actual.inverse[i], expected.inverse[i]) << "inverse, index " << i;
+                    EXPECT_EQ(actual.singular[i], expected.singular[i]) << "singular mask, index " << i;
+
+                    const Vector3 values = expected.eigenvalues[i];
+                    const float eigen_tolerance = 1e-5f * std::fmax(std::fabs(values.x), std::fabs(values.z));
+                    EXPECT_NEAR(actual.eigenvalues[i].x, values.x, eigen_tolerance) << "eigenvalues, index " << i;
+                    EXPECT_NEAR(actual.eigenvalues[i].y, values.y, eigen_tolerance) << "eigenvalues, index " << i;
+                    EXPECT_NEAR(actual.eigenvalues[i].z, values.z, eigen_tolerance) << "eigenvalues, index " << i;
+
+                    EXPECT_EQ(actual.rotation[i], expected.rotation[i]) << "polar rotation, index " << i;
+                    EXPECT_EQ(actual.stretch[i], expected.stretch[i]) << "polar stretch, index " << i;
+                    EXPECT_EQ(actual.orthonormalized[i], expected.orthonormalized[i]) << "orthonormalize, index " << i;
+
+                    // Eigenvectors of close eigenvalues are ill-conditioned.
+                    if (values.y - values.x > 1.0f && values.z - values.y > 1.0f)
+                    {
+                        for (int k = 0; k < 3; ++k)
+                            EXPECT_NEAR(std::fabs(Vector3::dot(actual.eigenvectors[k][i], expected.eigenvectors[k][i])), 1.0f, 1e-4f)
+                                << "eigenvector " << k << ", index " << i;
+                    }
+                }
+
+                for (std::size_t i = 0; i < p.size(); ++i)
+                {
+                    EXPECT_EQ(actual.rotated[i], expected.rotated[i]) << "quaternion rotate, index " << i;
+                    EXPECT_EQ(actual.slerped[i], expected.slerped[i]) << "quaternion slerp, index " << i;
+                }
+
+                EXPECT_EQ(actual.bounds, expected.bounds) << "bounds";
+                EXPECT_EQ(actual.packed_bounds, expected.packed_bounds) << "packed bounds";
+                EXPECT_EQ(actual.box_overlaps, expected.box_overlaps) << "box overlaps";
+                EXPECT_EQ(actual.box_hits, expected.box_hits) << "ray box";
+                EXPECT_EQ(actual.sphere_hits, expected.sphere_hits) << "ray sphere";
+
+                for (std::size_t i = 0; i < 8 * actual.box_hits.size(); ++i)
+                {
+                    if (actual.box_hits[i / 8] & (1u << i % 8))
+                    {
+                        EXPECT_TRUE(is_almost_equal(actual.box_t[i], expected.box_t[i])) << "ray box, index " << i;
+                    }
+
+                    if (actual.sphere_hits[i / 8] & (1u << i % 8))
+                    {
+                        EXPECT_TRUE(is_almost_equal(actual.sphere_t[i], expected.sphere_t[i])) << "ray sphere, index " << i;
+                    }
+                }
+            }
+        }
+    }
+}
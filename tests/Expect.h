@@ -0,0 +1,17 @@
+/// @file Expect.h
+/// @brief This header file contains the assertions shared by the tests.
+/// @author David Moncada
+
+#pragma once
+
+#include "gtest/gtest.h"
+#include "Config.h"
+
+/// @def MATH3D_EXPECT_THROW
+/// @brief Expects a statement to throw the given exception or, in builds
+/// without exceptions, where the library aborts instead, to die.
+#if MATH3D_EXCEPTIONS
+#define MATH3D_EXPECT_THROW(statement, exception) EXPECT_THROW(statement, exception)
+#else
+#define MATH3D_EXPECT_THROW(statement, exception) EXPECT_DEATH(statement, "")
+#endif
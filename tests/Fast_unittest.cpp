@@ -0,0 +1,103 @@
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Expect.h"
+#include "Fast.h"
+#include "MathObject.h"
+
+namespace Math3D
+{
+    namespace Math3DTests
+    {
+        class FastTest : public testing::Test
+        {
+        protected:
+            Vector3Batch v, w;
+
+            virtual void SetUp()
+            {
+                std::srand(29);
+                for (int i = 0; i < 10007; ++i)
+                {
+                    v.push_back(Vector3(random(), random(), random()));
+                    // Every fourth pair is nearly parallel, the worst case for
+                    // the angle.
+                    w.push_back(i % 4 == 0 ? v[i] * 2.0f + Vector3(1e-4f * random(), 0.0f, 0.0f)
+                                           : Vector3(random(), random(), random()));
+                }
+            }
+
+            static float random()
+            {
+                return 20.0f * std::rand() / RAND_MAX - 10.0f;
+            }
+
+            // The angle between two vectors, computed in double precision.
+            static double reference_angle(const Vector3& a, const Vector3& b)
+            {
+                const double ab = static_cast<double>(a.x) * b.x + static_cast<double>(a.y) * b.y + static_cast<double>(a.z) * b.z;
+                const double aa = static_cast<double>(a.x) * a.x + static_cast<double>(a.y) * a.y + static_cast<double>(a.z) * a.z;
+                const double bb = static_cast<double>(b.x) * b.x + static_cast<double>(b.y) * b.y + static_cast<double>(b.z) * b.z;
+                const double c = std::fmax(-1.0, std::fmin(1.0, ab / std::sqrt(aa * bb)));
+                return std::acos(c) * 180.0 / 3.14159265358979323846;
+            }
+        };
+
+        TEST_F(FastTest, RsqrtIsWithinBound)
+        {
+            for (float x = 1e-30f; x < 1e30f; x *= 1.01f)
+            {
+                const double expected = 1.0 / std::sqrt(static_cast<double>(x));
+                ASSERT_LE(std::fabs(Fast::rsqrt(x) / expected - 1.0), Fast::rsqrt_max_error) << "x " << x;
+            }
+        }
+
+        TEST_F(FastTest, AcosIsWithinBound)
+        {
+            for (int i = -10000; i <= 10000; ++i)
+            {
+                const float x = i / 10000.0f;
+                ASSERT_LE(std::fabs(Fast::acos(x) - std::acos(static_cast<double>(x))), Fast::acos_max_error) << "x " << x;
+            }
+        }
+
+        TEST_F(FastTest, ScalarFunctionsAreWithinBounds)
+        {
+            for (std::size_t i = 0; i < v.size(); ++i)
+            {
+                const Vector3 a = v[i], b = w[i];
+
+                EXPECT_LE(std::fabs(Fast::magnitude(a) / a.magnitude() - 1.0f), Fast::rsqrt_max_error + 1e-6f) << "index " << i;
+                EXPECT_LE(std::fabs(Fast::normalized(a).magnitude() - 1.0f), Fast::rsqrt_max_error + 1e-6f) << "index " << i;
+                EXPECT_LE(std::fabs(Fast::angle(a, b) - reference_angle(a, b)), Fast::angle_max_error) << "index " << i;
+            }
+        }
+
+        TEST_F(FastTest, BulkFunctionsAreWithinBounds)
+        {
+            std::vector<float> magnitudes(v.size()), angles(v.size());
+            Vector3Batch normalized = v;
+
+            Fast::magnitude(v, magnitudes.data());
+            Fast::angle(v, w, angles.data());
+            Fast::normalize(normalized);
+
+            for (std::size_t i = 0; i < v.size(); ++i)
+            {
+                EXPECT_LE(std::fabs(magnitudes[i] / v[i].magnitude() - 1.0f), Fast::rsqrt_max_error + 1e-6f) << "index " << i;
+                EXPECT_LE(std::fabs(normalized[i].magnitude() - 1.0f), Fast::rsqrt_max_error + 1e-6f) << "index " << i;
+                EXPECT_LE(std::fabs(angles[i] - reference_angle(v[i], w[i])), Fast::angle_max_error) << "index " << i;
+            }
+        }
+
+        TEST_F(FastTest, BulkAngleChecksSizes)
+        {
+            std::vector<float> angles(v.size());
+            w.resize(3);
+
+            MATH3D_EXPECT_THROW(Fast::angle(v, w, angles.data()), std::invalid_argument);
+        }
+    }
+}
@@ -0,0 +1,152 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Dispatch.h"
+#include "Half.h"
+
+namespace Math3D
+{
+    namespace Math3DTests
+    {
+        class HalfTest : public testing::Test
+        {
+        protected:
+            SimdLevel original;
+            std::vector<float> floats;
+
+            virtual void SetUp()
+            {
+                original = simd_level();
+
+                // Every exponent a half can produce, and then some, with
+                // random mantissas, plus the values that need special care.
+                std::srand(29);
+                for (int i = 0; i < 20000; ++i)
+                {
+                    const std::uint32_t bits =
+                        (static_cast<std::uint32_t>(std::rand()) & 1u) << 31 |
+                        static_cast<std::uint32_t>(90 + std::rand() % 60) << 23 |
+                        (static_cast<std::uint32_t>(std::rand()) & 0x7fffffu);
+                    float f;
+                    std::memcpy(&f, &bits, sizeof(f));
+                    floats.push_back(f);
+                }
+
+                const float specials[] = {
+                    0.0f, -0.0f, 1.0f, -2.5f, 65504.0f, 65519.0f, 65520.0f, 1e9f,
+                    6.103515625e-05f, 6.1e-05f, 5.9604644775390625e-08f, 2.98e-08f, 1e-30f,
+                    1.0009765625f, 1.00048828125f, 1.00146484375f,
+                    std::numeric_limits<float>::infinity(),
+                    -std::numeric_limits<float>::infinity(),
+                    std::numeric_limits<float>::quiet_NaN(),
+                    std::numeric_limits<float>::denorm_min() };
+                floats.insert(floats.end(), std::begin(specials), std::end(specials));
+            }
+
+            virtual void TearDown()
+            {
+                set_simd_level(original);
+            }
+
+            static bool same_bits(float a, float b)
+            {
+                return std::memcmp(&a, &b, sizeof(a)) == 0;
+            }
+        };
+
+        TEST_F(HalfTest, ConversionsMatchKnownValues)
+        {
+            EXPECT_EQ(Half(1.0f).bits, 0x3c00);
+            EXPECT_EQ(Half(-2.0f).bits, 0xc000);
+            EXPECT_EQ(Half(65504.0f).bits, 0x7bff) << "The largest half.";
+            EXPECT_EQ(Half(65520.0f).bits, 0x7c00) << "Rounds up to infinity.";
+            EXPECT_EQ(Half(5.9604644775390625e-08f).bits, 0x0001) << "The smallest subnormal.";
+            EXPECT_EQ(Half(2.98e-08f).bits, 0x0000) << "Rounds down to zero.";
+            EXPECT_EQ(Half(1.00048828125f).bits, 0x3c00) << "A tie rounds to even, down.";
+            EXPECT_EQ(Half(1.00146484375f).bits, 0x3c02) << "A tie rounds to even, up.";
+            EXPECT_EQ(Half(std::numeric_limits<float>::quiet_NaN()).bits & 0x7e00, 0x7e00);
+
+            EXPECT_EQ(static_cast<float>(Half::from_bits(0x3555)), 0.333251953125f);
+            EXPECT_EQ(static_cast<float>(Half::from_bits(0x8001)), -5.9604644775390625e-08f);
+            EXPECT_TRUE(std::isinf(static_cast<float>(Half::from_bits(0xfc00))));
+            EXPECT_TRUE(std::isnan(static_cast<float>(Half::from_bits(0x7e00))));
+        }
+
+        TEST_F(HalfTest, EveryHalfRoundTrips)
+        {
+            for (std::uint32_t bits = 0; bits <= 0xffff; ++bits)
+            {
+                const Half h = Half::from_bits(static_cast<std::uint16_t>(bits));
+                const float f = static_cast<float>(h);
+
+                if (std::isnan(f))
+                    EXPECT_EQ(Half(f).bits & 0x7e00, 0x7e00) << "NaN " << bits;
+                else
+                    EXPECT_EQ(Half(f).bits, bits);
+            }
+        }
+
+        TEST_F(HalfTest, BulkConversionsMatchScalarAtEveryLevel)
+        {
+            std::vector<Half> every(0x10000);
+            for (std::uint32_t bits = 0; bits <= 0xffff; ++bits)
+                every[bits] = Half::from_bits(static_cast<std::uint16_t>(bits));
+
+            const SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::SSE42, SimdLevel::AVX2, SimdLevel::AVX512 };
+
+            for (SimdLevel level : levels)
+            {
+                if (level > detect_simd_level())
+                    continue;
+
+                SCOPED_TRACE(simd_level_name(level));
+                ASSERT_TRUE(set_simd_level(level));
+
+                std::vector<Half> halves(floats.size());
+                Half::from_floats(floats.data(), halves.data(), floats.size());
+
+                for (std::size_t i = 0; i < floats.size(); ++i)
+                    EXPECT_EQ(halves[i].bits, Half(floats[i]).bits) << "float " << floats[i];
+
+                std::vector<float> back(every.size());
+                Half::to_floats(every.data(), back.data(), every.size());
+
+                for (std::size_t i = 0; i < every.size(); ++i)
+                {
+                    const float expected = static_cast<float>(every[i]);
+                    if (std::isnan(expected))
+                        EXPECT_TRUE(std::isnan(back[i])) << "half " << i;
+                    else
+                        EXPECT_TRUE(same_bits(back[i], expected)) << "half " << i;
+                }
+            }
+        }
+
+        TEST_F(HalfTest, PackedVectorsHalveTheStorage)
+        {
+            std::vector<Vector3> vectors;
+            for (std::size_t i = 0; i + 2 < floats.size() && i < 3000; i += 3)
+                vectors.push_back(Vector3(floats[i], floats[i + 1], floats[i + 2]));
+
+            std::vector<Vector3Half> packed(vectors.size());
+            std::vector<Vector3> unpacked(vectors.size());
+            Vector3Half::pack(vectors.data(), packed.data(), vectors.size());
+            Vector3Half::unpack(packed.data(), unpacked.data(), packed.size());
+
+            EXPECT_EQ(sizeof(Vector3Half) * 2, sizeof(Vector3));
+
+            for (std::size_t i = 0; i < vectors.size(); ++i)
+            {
+                const Vector3Half h(vectors[i]);
+                EXPECT_EQ(packed[i].x.bits, h.x.bits);
+                EXPECT_EQ(packed[i].z.bits, h.z.bits);
+                EXPECT_TRUE(same_bits(unpacked[i].y, static_cast<Vector3>(h).y));
+            }
+        }
+    }
+}
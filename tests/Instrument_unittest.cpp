@@ -0,0 +1,206 @@
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Instrument.h"
+#include "Matrix3.h"
+#include "Matrix3Batch.h"
+#include "Vector3Batch.h"
+
+namespace Math3D
+{
+    namespace Math3DTests
+    {
+        class InstrumentTest : public testing::Test
+        {
+        protected:
+            virtual void SetUp()
+            {
+                Instrument::reset();
+            }
+
+            // The totals of an operation, zero if it was not called.
+            static Instrument::OperationStats stats(const char* name)
+            {
+                for (const Instrument::OperationStats& s : Instrument::snapshot())
+                {
+                    if (std::strcmp(s.name, name) == 0)
+                        return s;
+                }
+
+                Instrument::OperationStats none;
+                none.name = name;
+                return none;
+            }
+        };
+
+        TEST_F(InstrumentTest, UninstrumentedBuildsRecordNothing)
+        {
+            if (Instrument::enabled)
+                GTEST_SKIP() << "The build is instrumented.";
+
+            Vector3 v(1.0f, 2.0f, 3.0f);
+            Vector3::normalize(v);
+            const Matrix3 m = Matrix3(2.0f, 0.0f, 0.0f, 0.0f, 3.0f, 0.0f, 0.0f, 0.0f, 4.0f).inverse();
+            Vector3Batch batch(16);
+            Vector3Batch::normalize(batch);
+
+            EXPECT_TRUE(Instrument::snapshot().empty());
+            EXPECT_EQ(m * v, m * v);
+
+            std::ostringstream json;
+            Instrument::dump_json(json);
+            EXPECT_NE(json.str().find("\"enabled\": false"), std::string::npos) << json.str();
+            EXPECT_NE(json.str().find("\"operations\": [\n  ]"), std::string::npos) << json.str();
+        }
+
+        TEST_F(InstrumentTest, CountsHeaderOperations)
+        {
+            if (!Instrument::enabled)
+                GTEST_SKIP() << "The build is not instrumented.";
+
+            const Matrix3 m(2.0f, 0.0f, 1.0f, 0.0f, 3.0f, 0.0f, 0.0f, 0.0f, 4.0f);
+            const Matrix3 singular(1.0f, 2.0f, 3.0f, 2.0f, 4.0f, 6.0f, 0.0f, 0.0f, 1.0f);
+            Vector3 v(1.0f, 2.0f, 3.0f);
+
+            for (int i = 0; i < 3; ++i)
+                (void)m.inverse();
+
+            EXPECT_FALSE(singular.try_inverse());
+            (void)(m * m);
+            (void)(m * v);
+            (void)(m * v);
+            Vector3::normalize(v);
+            (void)Vector3::angle(v, Vector3::up);
+
+            EXPECT_EQ(stats("Matrix3::inverse").calls, 3u);
+            EXPECT_EQ(stats("Matrix3::inverse failures").calls, 1u);
+            EXPECT_GE(stats("Matrix3::operator*(Matrix3)").calls, 1u);
+            EXPECT_EQ(stats("Matrix3::operator*(Vector3)").calls, 2u);
+            EXPECT_EQ(stats("Vector3::normalize").calls, 1u);
+            EXPECT_EQ(stats("Vector3::angle").calls, 1u);
+            EXPECT_GT(stats("Matrix3::inverse").ticks, 0u);
+        }
+
+        TEST_F(InstrumentTest, ConstantEvaluationsAreNotRecorded)
+        {
+            constexpr Matrix3 m(2.0f, 0.0f, 0.0f, 0.0f, 4.0f, 0.0f, 0.0f, 0.0f, 8.0f);
+            constexpr Matrix3 inverse = m.inverse();
+            static_assert(inverse(1, 1) == 0.25f, "inverse() must stay constexpr.");
+
+            EXPECT_TRUE(Instrument::snapshot().empty());
+        }
+
+        TEST_F(InstrumentTest, CountsKernelsAndBatchFailures)
+        {
+            if (!Instrument::enabled)
+                GTEST_SKIP() << "The build is not instrumented.";
+
+            Matrix3Batch matrices;
+            matrices.push_back(Matrix3::identity());
+            matrices.push_back(Matrix3(0, 0, 0, 0, 0, 0, 0, 0, 0));
+            matrices.push_back(Matrix3(0, 0, 0, 0, 0, 0, 0, 0, 0));
+
+            Matrix3Batch inverses;
+            EXPECT_EQ(Matrix3Batch::inverse(matrices, inverses), 2u);
+
+            Vector3Batch vectors(100);
+            Vector3Batch::normalize(vectors);
+            Vector3Batch::normalize(vectors);
+
+            EXPECT_EQ(stats("kernel.inverse").calls, 1u);
+            EXPECT_EQ(stats("Matrix3::inverse failures").calls, 2u);
+            EXPECT_EQ(stats("kernel.normalize").calls, 2u);
+            EXPECT_EQ(stats("kernel.transform").calls, 0u);
+        }
+
+        TEST_F(InstrumentTest, MergesEveryThread)
+        {
+            if (!Instrument::enabled)
+                GTEST_SKIP() << "The build is not instrumented.";
+
+            const int thread_count = 4;
+            const int calls = 250;
+
+            // Two threads exit before the snapshot and two are still alive
+            // when it is taken.
+            std::vector<std::thread> exited;
+            for (int t = 0; t < 2; ++t)
+            {
+                exited.emplace_back([]()
+                {
+                    Vector3 v(1.0f, 1.0f, 1.0f);
+                    for (int i = 0; i < calls; ++i)
+                        Vector3::normalize(v);
+                });
+            }
+
+            for (std::thread& t : exited)
+                t.join();
+
+            std::atomic<int> done(0);
+            std::atomic<bool> release(false);
+            std::vector<std::thread> alive;
+            for (int t = 2; t < thread_count; ++t)
+            {
+                alive.emplace_back([&]()
+                {
+                    Vector3 v(1.0f, 1.0f, 1.0f);
+                    for (int i = 0; i < calls; ++i)
+                        Vector3::normalize(v);
+
+                    ++done;
+                    while (!release)
+                        std::this_thread::yield();
+                });
+            }
+
+            while (done < thread_count - 2)
+                std::this_thread::yield();
+
+            EXPECT_EQ(stats("Vector3::normalize").calls, static_cast<std::uint64_t>(thread_count * calls));
+
+            release = true;
+            for (std::thread& t : alive)
+                t.join();
+
+            EXPECT_EQ(stats("Vector3::normalize").calls, static_cast<std::uint64_t>(thread_count * calls));
+        }
+
+        TEST_F(InstrumentTest, ResetClearsEveryCounter)
+        {
+            if (!Instrument::enabled)
+                GTEST_SKIP() << "The build is not instrumented.";
+
+            std::thread([]() { (void)Vector3::angle(Vector3::up, Vector3::right); }).join();
+            (void)Matrix3::identity().inverse();
+            ASSERT_EQ(Instrument::snapshot().size(), 2u);
+
+            Instrument::reset();
+            EXPECT_TRUE(Instrument::snapshot().empty());
+        }
+
+        TEST_F(InstrumentTest, JsonListsEveryCalledOperation)
+        {
+            if (!Instrument::enabled)
+                GTEST_SKIP() << "The build is not instrumented.";
+
+            Vector3 v(3.0f, 4.0f, 0.0f);
+            Vector3::normalize(v);
+            Vector3Batch batch(8);
+            Vector3Batch::normalize(batch);
+
+            std::ostringstream json;
+            Instrument::dump_json(json);
+
+            EXPECT_NE(json.str().find("\"enabled\": true"), std::string::npos) << json.str();
+            EXPECT_NE(json.str().find("{\"name\": \"Vector3::normalize\", \"calls\": 1, "), std::string::npos) << json.str();
+            EXPECT_NE(json.str().find("{\"name\": \"kernel.normalize\", \"calls\": 1, "), std::string::npos) << json.str();
+        }
+    }
+}
@@ -0,0 +1,176 @@
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Expect.h"
+#include "MathObject.h"
+#include "Matrix3Batch.h"
+
+namespace Math3D
+{
+    namespace Math3DTests
+    {
+        class Matrix3BatchTest : public testing::Test
+        {
+        protected:
+            std::vector<Matrix3> ms;
+            Matrix3Batch m, o;
+
+            virtual void SetUp()
+            {
+                // An odd count, so that the kernels also run their tails.
+                for (int i = 0; i < 37; ++i)
+                    ms.push_back(Matrix3(
+                        3.0f + i, 1.0f, 0.5f * i,
+                        -1.0f, 2.0f + 0.25f * i, 1.0f,
+                        0.125f * i, -2.0f, 4.0f));
+
+                m = Matrix3Batch(ms);
+            }
+
+            // virtual void TearDown() {}
+        };
+
+        TEST_F(Matrix3BatchTest, ConversionRoundTripsThroughStdVector)
+        {
+            std::vector<Matrix3> back = m.to_vector();
+
+            ASSERT_EQ(back.size(), ms.size());
+            for (std::size_t i = 0; i < ms.size(); ++i)
+                EXPECT_EQ(back[i], ms[i]) << "Mismatch at index " << i << ".";
+        }
+
+        TEST_F(Matrix3BatchTest, DeterminantMatchesScalar)
+        {
+            std::vector<float> dets(ms.size());
+            Matrix3Batch::determinant(m, dets.data());
+
+            for (std::size_t i = 0; i < ms.size(); ++i)
+                EXPECT_NEAR(dets[i], ms[i].determinant(), 1e-5f * std::fabs(dets[i]))
+                    << "Mismatch at index " << i << ".";
+        }
+
+        TEST_F(Matrix3BatchTest, InverseMatchesScalar)
+        {
+            std::vector<unsigned char> singular(ms.size(), 1);
+
+            EXPECT_EQ(Matrix3Batch::inverse(m, o, singular.data()), 0u)
+                << "None of the matrices should be reported as singular.";
+
+            ASSERT_EQ(o.size(), ms.size());
+            for (std::size_t i = 0; i < ms.size(); ++i)
+            {
+                EXPECT_EQ(o[i], ms[i].inverse()) << "Mismatch at index " << i << ".";
+                EXPECT_EQ(singular[i], 0) << "Mismatch at index " << i << ".";
+            }
+        }
+
+        TEST_F(Matrix3BatchTest, InverseMayAliasItsInput)
+        {
+            Matrix3Batch::inverse(m, m);
+
+            for (std::size_t i = 0; i < ms.size(); ++i)
+                EXPECT_EQ(m[i], ms[i].inverse()) << "Mismatch at index " << i << ".";
+        }
+
+        TEST_F(Matrix3BatchTest, SingularMatricesAreMaskedInsteadOfThrowing)
+        {
+            const Matrix3 singular_matrix(1.0f, 2.0f, 3.0f, 2.0f, 4.0f, 6.0f, 0.0f, 1.0f, 1.0f);
+            m.set(3, singular_matrix);
+            m.set(20, Matrix3());
+
+            std::vector<unsigned char> singular(ms.size());
+
+            EXPECT_EQ(Matrix3Batch::inverse(m, o, singular.data()), 2u)
+                << "Both singular matrices should be counted.";
+
+            for (std::size_t i = 0; i < ms.size(); ++i)
+            {
+                if (i == 3 || i == 20)
+                {
+                    EXPECT_EQ(singular[i], 1) << "Index " << i << " should be flagged.";
+                    EXPECT_EQ(o[i], Matrix3()) << "Singular entries should be zeroed.";
+                }
+                else
+                {
+                    EXPECT_EQ(singular[i], 0) << "Index " << i << " should not be flagged.";
+                    EXPECT_EQ(o[i], ms[i].inverse()) << "Mismatch at index " << i << ".";
+                }
+            }
+        }
+
+        TEST_F(Matrix3BatchTest, SymmetricEigenMatchesArrays)
+        {
+            std::vector<SymmetricEigen> expected(ms.size());
+            Matrix3::symmetric_eigen(ms.data(), expected.data(), ms.size());
+
+            Vector3Batch values, vectors[3];
+            Matrix3Batch::symmetric_eigen(m, values, vectors);
+
+            ASSERT_EQ(values.size(), ms.size());
+            for (std::size_t i = 0; i < ms.size(); ++i)
+            {
+                EXPECT_EQ(values[i], expected[i].values) << "Mismatch at index " << i << ".";
+                for (int k = 0; k < 3; ++k)
+                    EXPECT_EQ(vectors[k][i], expected[i].vectors[k]) << "Mismatch at index " << i << ".";
+            }
+        }
+
+        TEST_F(Matrix3BatchTest, SvdAndPolarMatchArrays)
+        {
+            std::vector<Svd> svds(ms.size());
+            std::vector<PolarDecomposition> polars(ms.size());
+            Matrix3::svd(ms.data(), svds.data(), ms.size());
+            Matrix3::polar(ms.data(), polars.data(), ms.size());
+
+            Matrix3Batch u, v, rotation;
+            Vector3Batch s;
+            Matrix3Batch::svd(m, u, s, v);
+            Matrix3Batch::polar(m, rotation, m);
+
+            ASSERT_EQ(s.size(), ms.size());
+            for (std::size_t i = 0; i < ms.size(); ++i)
+            {
+                EXPECT_EQ(u[i], svds[i].u) << "Mismatch at index " << i << ".";
+                EXPECT_EQ(s[i], svds[i].singular_values) << "Mismatch at index " << i << ".";
+                EXPECT_EQ(v[i], svds[i].v) << "Mismatch at index " << i << ".";
+                EXPECT_EQ(rotation[i], polars[i].rotation) << "Mismatch at index " << i << ".";
+                EXPECT_EQ(m[i], polars[i].stretch) << "Mismatch at index " << i << ".";
+            }
+        }
+
+        TEST_F(Matrix3BatchTest, SvdAndPolarRejectSharedOutputs)
+        {
+            Matrix3Batch r;
+            Vector3Batch s;
+
+            MATH3D_EXPECT_THROW(Matrix3Batch::svd(m, r, s, r), std::invalid_argument);
+            MATH3D_EXPECT_THROW(Matrix3Batch::polar(m, r, r), std::invalid_argument);
+        }
+
+        TEST_F(Matrix3BatchTest, OrthonormalizeMatchesArrays)
+        {
+            std::vector<PolarDecomposition> polars(ms.size());
+            Matrix3::polar(ms.data(), polars.data(), ms.size());
+
+            std::vector<Matrix3> rotations;
+            for (const PolarDecomposition& p : polars)
+            {
+                // Perturbed, as if by drift.
+                Matrix3 r = p.rotation;
+                r(1, 2) += 1e-3f;
+                rotations.push_back(r);
+            }
+
+            m = Matrix3Batch(rotations);
+            Matrix3Batch::orthonormalize(m);
+            Matrix3::orthonormalize(rotations.data(), rotations.size());
+
+            for (std::size_t i = 0; i < ms.size(); ++i)
+            {
+                EXPECT_EQ(m[i], rotations[i]) << "Mismatch at index " << i << ".";
+                EXPECT_EQ(m[i], polars[i].rotation) << "Mismatch at index " << i << ".";
+            }
+        }
+    }
+}
@@ -1,6 +1,13 @@
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+#include <vector>
+
 #include "gtest/gtest.h"
+#include "Expect.h"
 #include "MathObject.h"
 #include "Matrix3.h"
+#include "Quaternion.h"
 
 namespace Math3D
 {
@@ -14,6 +21,151 @@ namespace Math3D
 
             // virtual void SetUp() {}
             // virtual void TearDown() {}
+
+            // A random unit vector.
+            static Vector3d random_direction()
+            {
+                const double z = 2.0 * std::rand() / RAND_MAX - 1.0;
+                const double phi = 2.0 * 3.14159265358979323846 * std::rand() / RAND_MAX;
+                const double r = std::sqrt(std::fmax(0.0, 1.0 - z * z));
+                return Vector3d(r * std::cos(phi), r * std::sin(phi), z);
+            }
+
+            // The symmetric matrix with the given eigenvalues and a random
+            // orthonormal basis of eigenvectors, built in double precision.
+            static Matrix3d symmetric(const Vector3d& values)
+            {
+                const Vector3d e0 = random_direction();
+                const Vector3d e1 = Vector3d::cross(e0, random_direction()).normalized();
+                const Vector3d e2 = Vector3d::cross(e0, e1);
+                const Vector3d e[3] = { e0, e1, e2 };
+                const double l[3] = { values.x, values.y, values.z };
+
+                double a[3][3] = {};
+                for (int k = 0; k < 3; ++k)
+                {
+                    const double c[3] = { e[k].x, e[k].y, e[k].z };
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        for (int j = 0; j < 3; ++j)
+                            a[i][j] += l[k] * c[i] * c[j];
+                    }
+                }
+
+                return Matrix3d(a[0][0], a[0][1], a[0][2], a[1][0], a[1][1], a[1][2], a[2][0], a[2][1], a[2][2]);
+            }
+
+            // Checks a single precision eigendecomposition of a against the
+            // double precision one of the same matrix: the eigenvalues to a
+            // few ulps of the largest, the eigenvectors by their residuals,
+            // orthonormality and, where the eigenvalues are well separated,
+            // their directions.
+            static void expect_eigen(const Matrix3& a, const SymmetricEigen& e)
+            {
+                const Matrix3d ad(a);
+                const SymmetricEigend reference = ad.symmetric_eigen();
+                const double f[3] = { e.values.x, e.values.y, e.values.z };
+                const double d[3] = { reference.values.x, reference.values.y, reference.values.z };
+                const double norm = std::fmax(std::fabs(d[0]), std::fabs(d[2]));
+                const double tolerance = 1e-5 * norm;
+
+                EXPECT_TRUE(f[0] <= f[1] && f[1] <= f[2]) << e.values;
+
+                for (int i = 0; i < 3; ++i)
+                {
+                    const Vector3d vi(e.vectors[i]);
+                    EXPECT_NEAR(f[i], d[i], tolerance) << "eigenvalue " << i;
+                    EXPECT_NEAR(vi.magnitude(), 1.0, 1e-5) << "eigenvector " << i;
+                    EXPECT_LE((ad * vi - f[i] * vi).magnitude(), tolerance) << "eigenvector " << i;
+
+                    for (int j = i + 1; j < 3; ++j)
+                        EXPECT_NEAR(Vector3d::dot(vi, Vector3d(e.vectors[j])), 0.0, 1e-5) << "eigenvectors " << i << ", " << j;
+
+                    const double gap = std::fmin(i > 0 ? d[i] - d[i - 1] : norm, i < 2 ? d[i + 1] - d[i] : norm);
+                    if (gap > 1e-2 * norm)
+                    {
+                        EXPECT_NEAR(std::fabs(Vector3d::dot(vi, reference.vectors[i])), 1.0, 1e-6) << "eigenvector " << i;
+                    }
+                }
+            }
+
+            // The largest absolute element of a matrix.
+            static double largest(const Matrix3d& a)
+            {
+                double l = 0.0;
+                for (int i = 0; i < 3; ++i)
+                {
+                    for (int j = 0; j < 3; ++j)
+                        l = std::fmax(l, std::fabs(a(i, j)));
+                }
+
+                return l;
+            }
+
+            // Checks that a matrix is a rotation, to single precision.
+            static void expect_rotation(const Matrix3d& r)
+            {
+                EXPECT_LE(largest(r.transposed() * r - Matrix3d::identity()), 1e-5) << r;
+                EXPECT_NEAR(r.determinant(), 1.0, 1e-5) << r;
+            }
+
+            // Checks a single precision SVD of a: rotations, ordering, the
+            // reconstruction of a and, against the double precision SVD of the
+            // same matrix, the singular values.
+            static void expect_svd(const Matrix3& a, const Svd& d)
+            {
+                const Matrix3d ad(a);
+                const Svdd reference = ad.svd();
+                const Vector3d s(d.singular_values);
+                const double norm = std::fmax(largest(ad), 1e-300);
+
+                expect_rotation(Matrix3d(d.u));
+                expect_rotation(Matrix3d(d.v));
+
+                EXPECT_TRUE(s.x >= s.y && s.y >= std::fabs(s.z)) << s;
+                EXPECT_NEAR(s.x, reference.singular_values.x, 1e-5 * std::fabs(reference.singular_values.x));
+                EXPECT_NEAR(s.y, reference.singular_values.y, 1e-5 * std::fabs(reference.singular_values.x));
+                EXPECT_NEAR(s.z, reference.singular_values.z, 1e-5 * std::fabs(reference.singular_values.x));
+
+                const Matrix3d sigma(s.x, 0.0, 0.0, 0.0, s.y, 0.0, 0.0, 0.0, s.z);
+                EXPECT_LE(largest(Matrix3d(d.u) * sigma * Matrix3d(d.v).transposed() - ad), 1e-5 * norm);
+            }
+
+            // Random matrices: general ones, reflections, rank-deficient ones
+            // and scales far from one.
+            static std::vector<Matrix3> random_matrices()
+            {
+                std::srand(5);
+                std::vector<Matrix3> matrices;
+
+                for (int i = 0; i < 1000; ++i)
+                {
+                    float e[9];
+                    for (float& x : e)
+                        x = 2.0f * std::rand() / RAND_MAX - 1.0f;
+
+                    // Make the third row a combination of the first two.
+                    if (i % 7 == 3)
+                    {
+                        for (int j = 0; j < 3; ++j)
+                            e[6 + j] = 0.5f * e[j] - 2.0f * e[3 + j];
+                    }
+
+                    const float scale = i % 11 == 5 ? 1e-20f : (i % 13 == 6 ? 1e18f : 1.0f);
+                    matrices.push_back(Matrix3(e[0], e[1], e[2], e[3], e[4], e[5], e[6], e[7], e[8]));
+                    for (int r = 0; r < 3; ++r)
+                    {
+                        for (int c = 0; c < 3; ++c)
+                            matrices.back()(r, c) *= scale;
+                    }
+                }
+
+                matrices.push_back(Matrix3(Vector3::zero, Vector3::zero, Vector3::zero));
+                matrices.push_back(Matrix3::identity());
+                matrices.push_back(Matrix3(-1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f));
+                matrices.push_back(Matrix3(2.0f, 0.0f, 0.0f, 0.0f, 2.0f, 0.0f, 0.0f, 0.0f, 2.0f));
+                return matrices;
+            }
         };
 
         TEST_F(Matrix3Test, MatrixDeterminant)
@@ -33,6 +185,37 @@ namespace Math3D
                 << "The computed inverse is incorrect.";
         }
 
+        TEST_F(Matrix3Test, TryInverseReportsSingularMatrices)
+        {
+            m = Matrix3(1.0f, 1.0f, 2.0f, 1.0f, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f);
+            ASSERT_TRUE(m.try_inverse().has_value());
+            EXPECT_EQ(*m.try_inverse(), m.inverse());
+
+            n = Matrix3(1.0f, 2.0f, 3.0f, 2.0f, 4.0f, 6.0f, 0.0f, 1.0f, 0.0f);
+            EXPECT_FALSE(n.try_inverse().has_value())
+                << "A singular matrix should have no inverse.";
+            MATH3D_EXPECT_THROW(n.inverse(), const char*);
+
+            static_assert(!Matrix3(0, 0, 0, 0, 0, 0, 0, 0, 0).try_inverse(), "");
+        }
+
+        TEST_F(Matrix3Test, ElementAccess)
+        {
+            m = Matrix3(1.0f, 5.0f, 3.0f, 2.0f, 4.0f, 7.0f, 4.0f, 6.0f, 2.0f);
+
+            EXPECT_EQ(m(1, 2), 7.0f);
+            EXPECT_EQ(m.at(2, 0), 4.0f);
+            m.at(0, 1) = 8.0f;
+            EXPECT_EQ(m(0, 1), 8.0f);
+
+            MATH3D_EXPECT_THROW(m.at(3, 0), std::out_of_range);
+            MATH3D_EXPECT_THROW(m.at(0, -1), std::out_of_range);
+#if MATH3D_CHECKED
+            MATH3D_EXPECT_THROW(m(3, 0), std::out_of_range)
+                << "Checked builds should check the parenthesis operator too.";
+#endif
+        }
+
         TEST_F(Matrix3Test, MatrixTranspose)
         {
             m = Matrix3(1.0f, 5.0f, 3.0f, 2.0f, 4.0f, 7.0f, 4.0f, 6.0f, 2.0f);
@@ -72,5 +255,262 @@ namespace Math3D
                 << "When two matrices are inverse to one another, their product should "
                 << "be the identity matrix.";
         }
+
+        TEST_F(Matrix3Test, BulkTransformMatchesMatrixVectorProduct)
+        {
+            m = Matrix3(1.0f, 5.0f, 3.0f, 2.0f, 4.0f, 7.0f, 4.0f, 6.0f, 2.0f);
+
+            // Spans several blocks, with a partial one at the end.
+            std::vector<Vector3> in, out(600);
+            for (int i = 0; i < 600; ++i)
+                in.push_back(Vector3(0.5f * i, 1.0f - i, 0.25f * i + 2.0f));
+
+            m.transform(in.data(), out.data(), in.size());
+
+            for (std::size_t i = 0; i < in.size(); ++i)
+                EXPECT_EQ(out[i], m * in[i]) << "Mismatch at index " << i << ".";
+        }
+
+        TEST_F(Matrix3Test, BulkTransformInPlace)
+        {
+            m = Matrix3(1.0f, 5.0f, 3.0f, 2.0f, 4.0f, 7.0f, 4.0f, 6.0f, 2.0f);
+
+            std::vector<Vector3> in;
+            for (int i = 0; i < 300; ++i)
+                in.push_back(Vector3(0.5f * i, 1.0f - i, 0.25f * i + 2.0f));
+
+            std::vector<Vector3> vectors = in;
+            m.transform(vectors.data(), vectors.size());
+
+            Vector3Batch batch(in);
+            m.transform(batch);
+
+            for (std::size_t i = 0; i < in.size(); ++i)
+            {
+                EXPECT_EQ(vectors[i], m * in[i]) << "Mismatch at index " << i << ".";
+                EXPECT_EQ(batch[i], m * in[i]) << "Mismatch at index " << i << ".";
+            }
+        }
+
+        TEST_F(Matrix3Test, BatchTransformMatchesMatrixVectorProduct)
+        {
+            m = Matrix3(-32, -2.5, -6.2, -11.7, 1.6, 18.1, -0.3, 46.2, -18.6);
+
+            std::vector<Vector3> in;
+            for (int i = 0; i < 37; ++i)
+                in.push_back(Vector3(0.5f * i, 1.0f - i, 0.25f * i + 2.0f));
+
+            Vector3Batch batch(in), out;
+            m.transform(batch, out);
+
+            ASSERT_EQ(out.size(), in.size());
+            for (std::size_t i = 0; i < in.size(); ++i)
+                EXPECT_EQ(out[i], m * in[i]) << "Mismatch at index " << i << ".";
+        }
+
+        TEST_F(Matrix3Test, MatricesAreEvaluatedAtCompileTime)
+        {
+            constexpr Matrix3 r(0.0f, -1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+            static_assert(r.determinant() == 1.0f,
+                "Matrix3 functions should be usable in constant expressions.");
+            static_assert(r * r.transposed() == Matrix3::identity(), "");
+            static_assert(r.inverse() == r.transposed(), "");
+            static_assert(r * Vector3::right == Vector3::up, "");
+            static_assert(r(0, 1) == -1.0f, "");
+
+            EXPECT_EQ(r * r * r * r, Matrix3::identity());
+        }
+
+        TEST_F(Matrix3Test, StreamInsertionPrintsRows)
+        {
+            std::ostringstream os;
+            os << Matrix3::identity();
+
+            EXPECT_EQ(os.str(),
+                "| 1.000000 0.000000 0.000000 |\n"
+                "| 0.000000 1.000000 0.000000 |\n"
+                "| 0.000000 0.000000 1.000000 |\n");
+        }
+
+        TEST_F(Matrix3Test, DoublePrecisionMatrices)
+        {
+            const Matrix3d a(1.0, 1.0, 2.0, 1.0, 2.0, 2.0, 2.0, 2.0, 2.0);
+
+            EXPECT_EQ(a * a.inverse(), Matrix3d::identity());
+            EXPECT_EQ(Matrix3(a).inverse(), Matrix3(a.inverse()))
+                << "Both precisions should agree on a well-conditioned matrix.";
+
+            std::vector<Vector3d> points = { Vector3d(1.0, 2.0, 3.0), Vector3d(1e8, 0.0, -1e8) };
+            a.transform(points.data(), points.size());
+            EXPECT_EQ(points[0], Vector3d(9.0, 11.0, 12.0));
+            EXPECT_EQ(points[1], a * Vector3d(1e8, 0.0, -1e8));
+        }
+
+        TEST_F(Matrix3Test, SymmetricEigenOfDiagonalMatrixIsExact)
+        {
+            m = Matrix3(3.0f, 0.0f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f, 0.0f, 2.0f);
+            const SymmetricEigen e = m.symmetric_eigen();
+
+            EXPECT_TRUE(e.values.x == -1.0f && e.values.y == 2.0f && e.values.z == 3.0f) << e.values;
+            EXPECT_EQ(e.vectors[0], Vector3::up);
+            EXPECT_EQ(e.vectors[1], Vector3::forward);
+            EXPECT_EQ(e.vectors[2], Vector3::right);
+        }
+
+        TEST_F(Matrix3Test, SymmetricEigenMatchesDoublePrecisionReference)
+        {
+            // Random spectra, and the hard cases of point covariances: planar
+            // and linear neighbourhoods, exactly and nearly repeated
+            // eigenvalues, and scales far from one.
+            std::vector<Vector3d> spectra = {
+                Vector3d(1e-4, 1.0, 1.5), Vector3d(1e-6, 1e-6, 1.0), Vector3d(1.0, 1.0, 1.0),
+                Vector3d(1.0, 1.0, 5.0), Vector3d(-2.0, 3.0, 3.0), Vector3d(1.0, 1.0 + 1e-4, 3.0),
+                Vector3d(0.0, 0.0, 0.0), Vector3d(1e-20, 2e-20, 3e-20), Vector3d(-1e18, 1e18, 2e18) };
+
+            std::srand(7);
+            for (int i = 0; i < 1000; ++i)
+            {
+                double l[3];
+                for (double& li : l)
+                    li = 20.0 * std::rand() / RAND_MAX - 10.0;
+                spectra.push_back(Vector3d(l[0], l[1], l[2]));
+            }
+
+            std::vector<Matrix3> matrices;
+            for (const Vector3d& values : spectra)
+                matrices.push_back(Matrix3(symmetric(values)));
+
+            std::vector<SymmetricEigen> bulk(matrices.size());
+            Matrix3::symmetric_eigen(matrices.data(), bulk.data(), matrices.size());
+
+            for (std::size_t i = 0; i < matrices.size(); ++i)
+            {
+                SCOPED_TRACE(testing::Message() << "matrix " << i << ", eigenvalues " << spectra[i]);
+                expect_eigen(matrices[i], matrices[i].symmetric_eigen());
+                expect_eigen(matrices[i], bulk[i]);
+            }
+        }
+
+        TEST_F(Matrix3Test, SymmetricEigenReconstructsTheMatrix)
+        {
+            std::srand(11);
+            const Matrix3d a = symmetric(Vector3d(-0.5, 2.0, 7.0));
+            const SymmetricEigend e = a.symmetric_eigen();
+
+            EXPECT_NEAR(e.values.x, -0.5, 1e-12);
+            EXPECT_NEAR(e.values.y, 2.0, 1e-12);
+            EXPECT_NEAR(e.values.z, 7.0, 1e-12);
+
+            const Matrix3d v(e.vectors[0], e.vectors[1], e.vectors[2]);
+            const Matrix3d l(e.values.x, 0.0, 0.0, 0.0, e.values.y, 0.0, 0.0, 0.0, e.values.z);
+            EXPECT_EQ(v * l * v.transposed(), a);
+        }
+
+        TEST_F(Matrix3Test, SvdMatchesDoublePrecisionReference)
+        {
+            const std::vector<Matrix3> matrices = random_matrices();
+            std::vector<Svd> bulk(matrices.size());
+            Matrix3::svd(matrices.data(), bulk.data(), matrices.size());
+
+            for (std::size_t i = 0; i < matrices.size(); ++i)
+            {
+                SCOPED_TRACE(testing::Message() << "matrix " << i << "\n" << matrices[i]);
+                expect_svd(matrices[i], matrices[i].svd());
+                expect_svd(matrices[i], bulk[i]);
+            }
+        }
+
+        TEST_F(Matrix3Test, SvdOfReflectionHasNegativeSingularValue)
+        {
+            m = Matrix3(0.0f, 2.0f, 0.0f, 3.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+            const Svd d = m.svd();
+
+            EXPECT_NEAR(d.singular_values.x, 3.0f, 1e-6f);
+            EXPECT_NEAR(d.singular_values.y, 2.0f, 1e-6f);
+            EXPECT_NEAR(d.singular_values.z, -1.0f, 1e-6f);
+            EXPECT_NEAR(d.u.determinant(), 1.0f, 1e-6f);
+            EXPECT_NEAR(d.v.determinant(), 1.0f, 1e-6f);
+        }
+
+        TEST_F(Matrix3Test, PolarRecoversRotationAndStretch)
+        {
+            const Matrix3 rotation = Quaternion::angle_axis(40.0f, Vector3(1.0f, -2.0f, 0.5f).normalized()).to_matrix();
+            const Matrix3 stretch(2.0f, 0.3f, -0.1f, 0.3f, 1.0f, 0.2f, -0.1f, 0.2f, 0.5f);
+            m = rotation * stretch;
+
+            const PolarDecomposition p = m.polar();
+            EXPECT_EQ(p.rotation, rotation);
+            EXPECT_EQ(p.stretch, stretch);
+
+            PolarDecomposition bulk;
+            Matrix3::polar(&m, &bulk, 1);
+            EXPECT_EQ(bulk.rotation, rotation);
+            EXPECT_EQ(bulk.stretch, stretch);
+        }
+
+        TEST_F(Matrix3Test, PolarRotationIsProperForEveryMatrix)
+        {
+            const std::vector<Matrix3> matrices = random_matrices();
+            std::vector<PolarDecomposition> bulk(matrices.size());
+            Matrix3::polar(matrices.data(), bulk.data(), matrices.size());
+
+            for (std::size_t i = 0; i < matrices.size(); ++i)
+            {
+                SCOPED_TRACE(testing::Message() << "matrix " << i << "\n" << matrices[i]);
+                const Matrix3d a(matrices[i]);
+                const PolarDecomposition p[] = { matrices[i].polar(), bulk[i] };
+
+                for (const PolarDecomposition& pi : p)
+                {
+                    const Matrix3d r(pi.rotation), s(pi.stretch);
+                    expect_rotation(r);
+                    EXPECT_LE(largest(s - s.transposed()), 1e-5 * largest(a));
+                    EXPECT_LE(largest(r * s - a), 1e-5 * largest(a));
+                }
+            }
+        }
+
+        TEST_F(Matrix3Test, OrthonormalizedRemovesDrift)
+        {
+            // A rotation accumulated through many small steps drifts away
+            // from orthonormality in single precision.
+            const Matrix3 step = Quaternion::angle_axis(0.37f, Vector3(0.3f, 1.0f, -0.2f).normalized()).to_matrix();
+            std::vector<Matrix3> drifted;
+            m = Matrix3::identity();
+            for (int i = 0; i < 20000; ++i)
+            {
+                m = m * step;
+                if (i % 1000 == 999)
+                    drifted.push_back(m);
+            }
+
+            // And so does one perturbed on purpose.
+            n = drifted.back();
+            n(0, 1) += 0.02f;
+            n(2, 2) -= 0.03f;
+            drifted.push_back(n);
+
+            std::vector<Matrix3> bulk = drifted;
+            Matrix3::orthonormalize(bulk.data(), bulk.size());
+
+            for (std::size_t i = 0; i < drifted.size(); ++i)
+            {
+                SCOPED_TRACE(testing::Message() << "matrix " << i);
+                const Matrix3d closest(drifted[i].polar().rotation);
+
+                for (const Matrix3& r : { drifted[i].orthonormalized(), bulk[i] })
+                {
+                    EXPECT_LE(largest(Matrix3d(r).transposed() * Matrix3d(r) - Matrix3d::identity()), 1e-6);
+                    EXPECT_LE(largest(Matrix3d(r) - closest), 1e-5);
+                }
+            }
+        }
+
+        TEST_F(Matrix3Test, OrthonormalizedLeavesRotationsAlone)
+        {
+            m = Quaternion::angle_axis(120.0f, Vector3(1.0f, 1.0f, 0.0f).normalized()).to_matrix();
+            EXPECT_EQ(m.orthonormalized(), m);
+            EXPECT_EQ(Matrix3::identity().orthonormalized(), Matrix3::identity());
+        }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,258 @@
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Matrix3.h"
+#include "Matrix3Batch.h"
+#include "Memory.h"
+#include "Parallel.h"
+#include "Vector3Batch.h"
+
+// Every unaligned allocation of the test program goes through here, so that
+// the tests can check for heap allocations memory_stats() does not see.
+static std::atomic<std::size_t> heap_allocations(0);
+
+void* operator new(std::size_t bytes)
+{
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* p = std::malloc(bytes != 0 ? bytes : 1))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace Math3D
+{
+    namespace Math3DTests
+    {
+        class MemoryTest : public testing::Test
+        {
+        protected:
+            virtual void TearDown()
+            {
+                Parallel::set_thread_count(0);
+            }
+
+            static bool is_aligned(const void* p)
+            {
+                return reinterpret_cast<std::uintptr_t>(p) % simd_alignment == 0;
+            }
+        };
+
+        TEST_F(MemoryTest, AlignedVectorsAreAligned)
+        {
+            for (std::size_t n = 1; n < 100; n += 7)
+            {
+                AlignedVector<float> floats(n);
+                AlignedVector<Vector3> vectors(n);
+
+                EXPECT_TRUE(is_aligned(floats.data())) << "size " << n;
+                EXPECT_TRUE(is_aligned(vectors.data())) << "size " << n;
+            }
+
+            Vector3Batch v(13);
+            Matrix3Batch m(5);
+            EXPECT_TRUE(is_aligned(v.x.data()) && is_aligned(v.y.data()) && is_aligned(v.z.data()));
+            EXPECT_TRUE(is_aligned(m.m[2][1].data()));
+        }
+
+        TEST_F(MemoryTest, AlignedAllocationsAreCounted)
+        {
+            reset_memory_stats();
+            const MemoryStats before = memory_stats();
+
+            {
+                AlignedVector<float> floats(1000);
+                const MemoryStats during = memory_stats();
+
+                EXPECT_EQ(during.allocations, 1u);
+                EXPECT_EQ(during.deallocations, 0u);
+                EXPECT_EQ(during.bytes_in_use, before.bytes_in_use + 1000 * sizeof(float));
+            }
+
+            const MemoryStats after = memory_stats();
+            EXPECT_EQ(after.deallocations, 1u);
+            EXPECT_EQ(after.bytes_in_use, before.bytes_in_use);
+        }
+
+        TEST_F(MemoryTest, ArenaAllocationsAreAlignedAndDisjoint)
+        {
+            Arena arena(4096);
+            char* a = arena.allocate<char>(3);
+            float* b = arena.allocate<float>(100);
+            Vector3* c = arena.allocate<Vector3>(10);
+
+            EXPECT_TRUE(is_aligned(a) && is_aligned(b) && is_aligned(c));
+            EXPECT_GE(reinterpret_cast<char*>(b), a + 3);
+            EXPECT_GE(reinterpret_cast<char*>(c), reinterpret_cast<char*>(b + 100));
+            EXPECT_GE(arena.used(), 3 + 100 * sizeof(float) + 10 * sizeof(Vector3));
+
+            void* wide = arena.allocate(16, 256);
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(wide) % 256, 0u)
+                << "Alignments above simd_alignment should be honored.";
+        }
+
+        TEST_F(MemoryTest, ArenaResetReusesItsBlock)
+        {
+            Arena arena(1024);
+            float* first = arena.allocate<float>(64);
+
+            arena.reset();
+            EXPECT_EQ(arena.used(), 0u);
+
+            reset_memory_stats();
+            EXPECT_EQ(arena.allocate<float>(64), first)
+                << "After a reset, allocations should start over from the same block.";
+            EXPECT_EQ(memory_stats().allocations, 0u);
+        }
+
+        TEST_F(MemoryTest, ArenaGrowsAndMergesOnReset)
+        {
+            Arena arena(1024);
+
+            // A frame larger than the arena chains blocks...
+            for (int i = 0; i < 10; ++i)
+                std::memset(arena.allocate<float>(1000), 0, 1000 * sizeof(float));
+
+            const std::size_t grown = arena.capacity();
+            EXPECT_GE(grown, 10 * 1000 * sizeof(float));
+
+            // ...which the reset merges into one block...
+            arena.reset();
+            EXPECT_EQ(arena.capacity(), grown);
+
+            // ...so the same frame no longer allocates.
+            reset_memory_stats();
+            for (int i = 0; i < 10; ++i)
+                std::memset(arena.allocate<float>(1000), 0, 1000 * sizeof(float));
+            arena.reset();
+
+            EXPECT_EQ(memory_stats().allocations, 0u);
+            EXPECT_EQ(arena.capacity(), grown);
+        }
+
+        TEST_F(MemoryTest, HugePageArenaIsUsable)
+        {
+            const MemoryStats before = memory_stats();
+
+            {
+                Arena arena(1024 * 1024, PageSize::Huge);
+                float* p = arena.allocate<float>(200000);
+
+                EXPECT_TRUE(is_aligned(p));
+                std::memset(p, 0, 200000 * sizeof(float));
+                EXPECT_GE(arena.capacity(), 1024u * 1024u);
+                EXPECT_GT(memory_stats().bytes_in_use, before.bytes_in_use);
+            }
+
+            EXPECT_EQ(memory_stats().bytes_in_use, before.bytes_in_use)
+                << "Mapped pages should be released, and counted as such.";
+        }
+
+        TEST_F(MemoryTest, ArenaAllocatorBacksStandardContainers)
+        {
+            Arena arena;
+            std::vector<Vector3, ArenaAllocator<Vector3>> vectors{ ArenaAllocator<Vector3>(arena) };
+
+            for (int i = 0; i < 1000; ++i)
+                vectors.push_back(Vector3(1.0f * i, 0.0f, 0.0f));
+
+            EXPECT_TRUE(is_aligned(vectors.data()));
+            EXPECT_EQ(vectors[999].x, 999.0f);
+            EXPECT_GT(arena.used(), 1000 * sizeof(Vector3));
+        }
+
+        TEST_F(MemoryTest, LocalArenasAreDistinctPerThread)
+        {
+            Arena* main_arena = &Arena::local();
+            Arena* other_arena = nullptr;
+
+            std::thread thread([&] { other_arena = &Arena::local(); });
+            thread.join();
+
+            EXPECT_EQ(&Arena::local(), main_arena);
+            EXPECT_NE(other_arena, main_arena);
+        }
+
+        TEST_F(MemoryTest, SteadyStateFramesDoNotAllocate)
+        {
+            Arena arena;
+            Vector3Batch batch;
+            Matrix3Batch matrices, inverses;
+            const Matrix3 rotation(0.0f, -1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+
+            // A cloud large enough for the parallel operations to split it
+            // over the pool.
+            Parallel::set_thread_count(4);
+            Vector3Batch cloud(100000), moved;
+            for (std::size_t i = 0; i < cloud.size(); ++i)
+                cloud.set(i, Vector3(1.0f, 2.0f, 0.001f * i));
+
+            std::size_t heap_allocations_before = 0;
+
+            // Every frame a different number of points, none more than the
+            // first two frames saw.
+            const std::size_t sizes[] = { 900, 1000, 500, 1000, 20, 999 };
+            std::size_t frame = 0;
+
+            for (std::size_t n : sizes)
+            {
+                if (frame++ == 2)
+                {
+                    reset_memory_stats();
+                    heap_allocations_before = heap_allocations.load();
+                }
+
+                Vector3* points = arena.allocate<Vector3>(n);
+                Vector3* rotated = arena.allocate<Vector3>(n);
+                for (std::size_t i = 0; i < n; ++i)
+                    points[i] = Vector3(1.0f, 2.0f, 1.0f * i);
+
+                rotation.transform(points, rotated, n);
+                batch.clear();
+                for (std::size_t i = 0; i < n; ++i)
+                    batch.push_back(rotated[i]);
+                Vector3Batch::normalize(batch);
+
+                matrices.resize(n);
+                for (std::size_t i = 0; i < n; ++i)
+                    matrices.set(i, Matrix3(1.0f + i, 0.0f, 0.0f, 0.0f, 1.0f + i, 0.0f, 0.0f, 0.0f, 1.0f + i));
+                Matrix3Batch::inverse(matrices, inverses);
+
+                Parallel::transform(rotation, cloud, moved);
+                const Vector3 sum = Parallel::sum(cloud);
+                const Matrix3 covariance = Parallel::covariance(moved);
+                const AABB bounds = Parallel::bounds(points, n);
+
+                EXPECT_EQ(rotated[n - 1], Vector3(-2.0f, 1.0f, n - 1.0f));
+                EXPECT_FLOAT_EQ(inverses[n - 1](2, 2), 1.0f / n);
+                EXPECT_EQ(moved[1], Vector3(-2.0f, 1.0f, 0.001f));
+                EXPECT_EQ(sum.x, 100000.0f);
+                EXPECT_EQ(covariance(0, 0), 0.0f);
+                EXPECT_EQ(bounds.max.z, n - 1.0f);
+                arena.reset();
+            }
+
+            EXPECT_EQ(memory_stats().allocations, 0u)
+                << "Frames no larger than the ones before should not allocate.";
+            EXPECT_EQ(heap_allocations.load() - heap_allocations_before, 0u)
+                << "Steady-state frames should not allocate from the heap either.";
+        }
+    }
+}
@@ -0,0 +1,195 @@
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Dispatch.h"
+#include "MathObject.h"
+#include "PackedNormal.h"
+
+namespace Math3D
+{
+    namespace Math3DTests
+    {
+        class PackedNormalTest : public testing::Test
+        {
+        protected:
+            SimdLevel original;
+            std::vector<Vector3> normals;
+
+            virtual void SetUp()
+            {
+                original = simd_level();
+
+                // Uniformly distributed directions, plus the axes, the
+                // octahedron's edges and the seam where its halves fold.
+                std::srand(31);
+                for (int i = 0; i < 200000; ++i)
+                {
+                    const float z = 2.0f * std::rand() / RAND_MAX - 1.0f;
+                    const float phi = 2.0f * pi * std::rand() / RAND_MAX;
+                    const float r = std::sqrt(std::fmax(0.0f, 1.0f - z * z));
+                    normals.push_back(Vector3(r * std::cos(phi), r * std::sin(phi), z));
+                }
+
+                const Vector3 specials[] = {
+                    Vector3::right, Vector3::left, Vector3::up, Vector3::down, Vector3::forward, Vector3::back,
+                    Vector3(1.0f, 1.0f, 0.0f).normalized(), Vector3(-1.0f, 1.0f, 0.0f).normalized(),
+                    Vector3(1.0f, 0.0f, -1.0f).normalized(), Vector3(0.0f, -1.0f, -1.0f).normalized(),
+                    Vector3(1.0f, 1.0f, 1.0f).normalized(), Vector3(-1.0f, -1.0f, -1.0f).normalized(),
+                    Vector3(0.3f, -0.4f, -1e-7f).normalized() };
+                normals.insert(normals.end(), std::begin(specials), std::end(specials));
+            }
+
+            virtual void TearDown()
+            {
+                set_simd_level(original);
+            }
+
+            // The angle between two unit vectors, in degrees. Measured in
+            // double precision, since the float acos cannot resolve angles
+            // this small.
+            static double error(const Vector3& exact, const Vector3& decoded)
+            {
+                return Vector3d::angle(Vector3d(exact), Vector3d(decoded));
+            }
+
+            template <typename Normal>
+            double max_error(SimdLevel level) const
+            {
+                set_simd_level(level);
+
+                std::vector<Normal> encoded(normals.size());
+                std::vector<Vector3> decoded(normals.size());
+                Normal::encode(normals.data(), encoded.data(), normals.size());
+                Normal::decode(encoded.data(), decoded.data(), encoded.size());
+
+                // std::fmax drops NaNs, so a NaN decoding is reported here.
+                double worst = 0.0;
+                for (std::size_t i = 0; i < normals.size(); ++i)
+                {
+                    const double e = error(normals[i], decoded[i]);
+                    if (std::isnan(e))
+                    {
+                        ADD_FAILURE() << normals[i] << " decodes to " << decoded[i];
+                        return e;
+                    }
+
+                    worst = std::fmax(worst, e);
+                }
+
+                return worst;
+            }
+        };
+
+        TEST_F(PackedNormalTest, AxesRoundTripExactly)
+        {
+            const Vector3 axes[] = { Vector3::right, Vector3::left, Vector3::up, Vector3::down, Vector3::forward, Vector3::back };
+
+            for (const Vector3& axis : axes)
+            {
+                const Vector3 n16 = static_cast<Vector3>(PackedNormal16(axis));
+                const Vector3 n32 = static_cast<Vector3>(PackedNormal32(axis));
+
+                EXPECT_TRUE(n16.x == axis.x && n16.y == axis.y && n16.z == axis.z) << "16-bit " << axis;
+                EXPECT_TRUE(n32.x == axis.x && n32.y == axis.y && n32.z == axis.z) << "32-bit " << axis;
+            }
+        }
+
+        TEST_F(PackedNormalTest, AngularErrorIsWithinDocumentedBound)
+        {
+            double worst16 = 0.0, worst32 = 0.0;
+
+            for (const Vector3& n : normals)
+            {
+                const double e16 = error(n, static_cast<Vector3>(PackedNormal16(n)));
+                const double e32 = error(n, static_cast<Vector3>(PackedNormal32(n)));
+                ASSERT_FALSE(std::isnan(e16)) << "16-bit " << n;
+                ASSERT_FALSE(std::isnan(e32)) << "32-bit " << n;
+
+                worst16 = std::fmax(worst16, e16);
+                worst32 = std::fmax(worst32, e32);
+            }
+
+            EXPECT_LE(worst16, PackedNormal16::max_angle_error);
+            EXPECT_LE(worst32, PackedNormal32::max_angle_error);
+            EXPECT_GT(worst16, 0.5 * PackedNormal16::max_angle_error) << "The bound should be tight.";
+            EXPECT_GT(worst32, 0.5 * PackedNormal32::max_angle_error) << "The bound should be tight.";
+        }
+
+        TEST_F(PackedNormalTest, BulkErrorIsWithinDocumentedBoundAtEveryLevel)
+        {
+            const SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::SSE42, SimdLevel::AVX2, SimdLevel::AVX512 };
+
+            for (SimdLevel level : levels)
+            {
+                if (level > detect_simd_level())
+                    continue;
+
+                SCOPED_TRACE(simd_level_name(level));
+                EXPECT_LE(max_error<PackedNormal16>(level), PackedNormal16::max_angle_error);
+                EXPECT_LE(max_error<PackedNormal32>(level), PackedNormal32::max_angle_error);
+            }
+        }
+
+        TEST_F(PackedNormalTest, EncodingIgnoresLength)
+        {
+            const Vector3 n = Vector3(0.2f, -0.7f, -0.4f).normalized();
+
+            EXPECT_EQ(PackedNormal16(n), PackedNormal16(250.0f * n));
+            EXPECT_EQ(PackedNormal32(n), PackedNormal32(0.01f * n));
+        }
+
+        TEST_F(PackedNormalTest, BulkEncodingMatchesScalar)
+        {
+            std::vector<PackedNormal16> encoded(normals.size());
+            PackedNormal16::encode(normals.data(), encoded.data(), normals.size());
+
+            for (std::size_t i = 0; i < normals.size(); ++i)
+            {
+                // FMA contraction may round a coordinate across a tie.
+                const PackedNormal16 expected(normals[i]);
+                EXPECT_LE(std::abs(encoded[i].u - expected.u), 1) << "index " << i;
+                EXPECT_LE(std::abs(encoded[i].v - expected.v), 1) << "index " << i;
+            }
+        }
+
+        TEST_F(PackedNormalTest, BatchOverloadsMatchArrays)
+        {
+            Vector3Batch batch;
+            for (const Vector3& n : normals)
+                batch.push_back(n);
+
+            std::vector<PackedNormal32> from_array(normals.size()), from_batch(normals.size());
+            PackedNormal32::encode(normals.data(), from_array.data(), normals.size());
+            PackedNormal32::encode(batch, from_batch.data());
+
+            std::vector<Vector3> decoded(normals.size());
+            Vector3Batch decoded_batch;
+            PackedNormal32::decode(from_array.data(), decoded.data(), from_array.size());
+            PackedNormal32::decode(from_array.data(), from_array.size(), decoded_batch);
+
+            ASSERT_EQ(decoded_batch.size(), normals.size());
+            for (std::size_t i = 0; i < normals.size(); ++i)
+            {
+                EXPECT_EQ(from_batch[i], from_array[i]) << "index " << i;
+                EXPECT_EQ(decoded_batch[i], decoded[i]) << "index " << i;
+            }
+        }
+
+        TEST_F(PackedNormalTest, DotMatchesDotOfDecodedVectors)
+        {
+            const Vector3 light = Vector3(-0.5f, 0.25f, 1.0f).normalized();
+
+            std::vector<PackedNormal16> encoded(normals.size());
+            std::vector<Vector3> decoded(normals.size());
+            std::vector<float> dots(normals.size());
+            PackedNormal16::encode(normals.data(), encoded.data(), normals.size());
+            PackedNormal16::decode(encoded.data(), decoded.data(), encoded.size());
+            PackedNormal16::dot(encoded.data(), light, dots.data(), encoded.size());
+
+            for (std::size_t i = 0; i < normals.size(); ++i)
+                EXPECT_NEAR(dots[i], Vector3::dot(decoded[i], light), 1e-6f) << "index " << i;
+        }
+    }
+}
@@ -0,0 +1,308 @@
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Config.h"
+#include "Dispatch.h"
+#include "MathObject.h"
+#include "Parallel.h"
+
+namespace Math3D
+{
+    namespace Math3DTests
+    {
+        class ParallelTest : public testing::Test
+        {
+        protected:
+            Vector3Batch v;
+
+            virtual void SetUp()
+            {
+                // Spans several chunks, and ends with a partial one.
+                std::srand(23);
+                for (std::size_t i = 0; i < 5 * Parallel::grain_size(2 * sizeof(Vector3)) + 77; ++i)
+                    v.push_back(Vector3(random(), random(), random()));
+            }
+
+            virtual void TearDown()
+            {
+                Parallel::set_thread_count(0);
+                Parallel::set_deterministic(false);
+                set_simd_level(detect_simd_level());
+            }
+
+            static float random()
+            {
+                return 20.0f * std::rand() / RAND_MAX - 10.0f;
+            }
+
+            // Every reduction of v, through both overloads.
+            struct Reductions
+            {
+                Vector3 sum, packed_sum, centroid, packed_centroid;
+                AABB bounds, packed_bounds;
+                Matrix3 covariance, packed_covariance, second_moment, packed_second_moment;
+
+                bool operator==(const Reductions& other) const
+                {
+                    return std::memcmp(this, &other, sizeof(*this)) == 0;
+                }
+            };
+
+            // operator== compares bytes, which holds only without padding.
+            static_assert(sizeof(Reductions) == (4 * 3 + 2 * 6 + 4 * 9) * sizeof(float),
+                "Reductions must hold nothing but floats.");
+
+            Reductions reduce() const
+            {
+                const std::vector<Vector3> packed = v.to_vector();
+
+                Reductions r;
+                r.sum = Parallel::sum(v);
+                r.packed_sum = Parallel::sum(packed.data(), packed.size());
+                r.centroid = Parallel::centroid(v);
+                r.packed_centroid = Parallel::centroid(packed.data(), packed.size());
+                r.bounds = Parallel::bounds(v);
+                r.packed_bounds = Parallel::bounds(packed.data(), packed.size());
+                r.covariance = Parallel::covariance(v);
+                r.packed_covariance = Parallel::covariance(packed.data(), packed.size());
+                r.second_moment = Parallel::second_moment(v);
+                r.packed_second_moment = Parallel::second_moment(packed.data(), packed.size());
+                return r;
+            }
+
+            // Expects every element of a to be within a relative tolerance of
+            // the double-precision b.
+            static void expect_near(const Matrix3& a, const double (&b)[3][3], double tolerance)
+            {
+                for (int i = 0; i < 3; ++i)
+                {
+                    for (int j = 0; j < 3; ++j)
+                        EXPECT_NEAR(a(i, j), b[i][j], tolerance * (1.0 + std::fabs(b[i][j]))) << "element " << i << ", " << j;
+                }
+            }
+        };
+
+        TEST_F(ParallelTest, ThreadCountIsConfigurable)
+        {
+            Parallel::set_thread_count(3);
+            EXPECT_EQ(Parallel::thread_count(), 3u);
+
+            Parallel::set_thread_count(0);
+            EXPECT_GE(Parallel::thread_count(), 1u)
+                << "The default pool should have at least the calling thread.";
+        }
+
+        TEST_F(ParallelTest, ParallelForVisitsEveryIndexOnce)
+        {
+            Parallel::set_thread_count(4);
+            std::vector<std::atomic<int> > visits(10007);
+
+            for (std::atomic<int>& count : visits)
+                count = 0;
+
+            Parallel::parallel_for(visits.size(), 64, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i)
+                    ++visits[i];
+            });
+
+            for (std::size_t i = 0; i < visits.size(); ++i)
+                EXPECT_EQ(visits[i], 1) << "index " << i;
+        }
+
+        TEST_F(ParallelTest, ResultsMatchSerialPath)
+        {
+            const Matrix3 m(1.0f, 2.0f, 3.0f, -1.0f, 0.5f, 2.0f, 0.0f, 1.0f, -3.0f);
+            const Transform t(m, Vector3(1.0f, -2.0f, 3.0f));
+
+            Vector3Batch transformed, points, normalized = v;
+            m.transform(v, transformed);
+            t.transform_points(v, points);
+            Vector3Batch::normalize(normalized);
+
+            Parallel::set_thread_count(1);
+            const Vector3 serial_sum = Parallel::sum(v);
+            const unsigned counts[] = { 2, 3, 8 };
+
+            for (unsigned count : counts)
+            {
+                SCOPED_TRACE(count);
+                Parallel::set_thread_count(count);
+
+                Vector3Batch parallel_transformed, parallel_points, parallel_normalized = v;
+                Parallel::transform(m, v, parallel_transformed);
+                Parallel::transform_points(t, v, parallel_points);
+                Parallel::normalize(parallel_normalized);
+
+                EXPECT_TRUE(parallel_transformed.x == transformed.x && parallel_transformed.y == transformed.y &&
+                    parallel_transformed.z == transformed.z) << "transform should be bit-identical.";
+                EXPECT_TRUE(parallel_points.x == points.x && parallel_points.y == points.y &&
+                    parallel_points.z == points.z) << "transform_points should be bit-identical.";
+                EXPECT_TRUE(parallel_normalized.x == normalized.x && parallel_normalized.y == normalized.y &&
+                    parallel_normalized.z == normalized.z) << "normalize should be bit-identical.";
+
+                const Vector3 s = Parallel::sum(v);
+                EXPECT_TRUE(s.x == serial_sum.x && s.y == serial_sum.y && s.z == serial_sum.z)
+                    << "The sum should not depend on the thread count.";
+            }
+        }
+
+        TEST_F(ParallelTest, ReductionsMatchDoublePrecisionReference)
+        {
+            // Far from the origin, where naive second moments cancel badly.
+            for (std::size_t i = 0; i < v.size(); ++i)
+                v.set(i, v[i] * 0.1f + Vector3(1000.0f, -2000.0f, 500.0f));
+
+            const std::size_t n = v.size();
+            double mean[3] = {}, cov[3][3] = {}, second[3][3] = {};
+            AABB box;
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const double p[3] = { v.x[i], v.y[i], v.z[i] };
+                for (int a = 0; a < 3; ++a)
+                {
+                    mean[a] += p[a] / n;
+                    for (int b = 0; b < 3; ++b)
+                        second[a][b] += p[a] * p[b] / n;
+                }
+                box.expand(v[i]);
+            }
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const double d[3] = { v.x[i] - mean[0], v.y[i] - mean[1], v.z[i] - mean[2] };
+                for (int a = 0; a < 3; ++a)
+                {
+                    for (int b = 0; b < 3; ++b)
+                        cov[a][b] += d[a] * d[b] / n;
+                }
+            }
+
+            const Reductions r = reduce();
+
+            const Vector3* sums[] = { &r.sum, &r.packed_sum };
+            const Vector3* centroids[] = { &r.centroid, &r.packed_centroid };
+
+            for (int k = 0; k < 2; ++k)
+            {
+                const float s[3] = { sums[k]->x, sums[k]->y, sums[k]->z };
+                const float c[3] = { centroids[k]->x, centroids[k]->y, centroids[k]->z };
+
+                for (int a = 0; a < 3; ++a)
+                {
+                    EXPECT_NEAR(s[a], mean[a] * n, 1e-6 * std::fabs(mean[a] * n));
+                    EXPECT_NEAR(c[a], mean[a], 1e-6 * std::fabs(mean[a]));
+                }
+            }
+
+            EXPECT_EQ(r.bounds, box);
+            EXPECT_EQ(r.packed_bounds, box);
+            expect_near(r.covariance, cov, 1e-4);
+            expect_near(r.packed_covariance, cov, 1e-4);
+            expect_near(r.second_moment, second, 1e-6);
+            expect_near(r.packed_second_moment, second, 1e-6);
+        }
+
+        TEST_F(ParallelTest, SumsAreCompensated)
+        {
+            // A float running sum of a million tenths is off by almost 1%.
+            const std::vector<Vector3> tenths(1000000, Vector3(0.1f, 0.1f, 0.1f));
+            const double exact = 1e6 * static_cast<double>(0.1f);
+
+            const Vector3 s = Parallel::sum(tenths.data(), tenths.size());
+            EXPECT_NEAR(s.x, exact, 1e-6 * exact);
+
+            const Vector3 c = Parallel::centroid(tenths.data(), tenths.size());
+            EXPECT_EQ(c.y, 0.1f);
+        }
+
+        TEST_F(ParallelTest, ReductionsOfNothing)
+        {
+            const Vector3Batch empty;
+
+            EXPECT_EQ(Parallel::sum(empty), Vector3::zero);
+            EXPECT_EQ(Parallel::centroid(empty), Vector3::zero);
+            EXPECT_TRUE(Parallel::bounds(empty).empty());
+            EXPECT_EQ(Parallel::covariance(empty), Matrix3(Vector3::zero, Vector3::zero, Vector3::zero));
+            EXPECT_EQ(Parallel::second_moment(nullptr, 0), Matrix3(Vector3::zero, Vector3::zero, Vector3::zero));
+        }
+
+        TEST_F(ParallelTest, ReductionsDoNotDependOnThreadCount)
+        {
+            const bool modes[] = { false, true };
+
+            for (bool deterministic : modes)
+            {
+                SCOPED_TRACE(deterministic ? "deterministic" : "default");
+                Parallel::set_deterministic(deterministic);
+                Parallel::set_thread_count(1);
+                const Reductions serial = reduce();
+                const unsigned counts[] = { 2, 3, 8 };
+
+                for (unsigned count : counts)
+                {
+                    SCOPED_TRACE(count);
+                    Parallel::set_thread_count(count);
+                    EXPECT_TRUE(reduce() == serial) << "Reductions should be bit-identical.";
+                }
+            }
+        }
+
+        TEST_F(ParallelTest, DeterministicReductionsDoNotDependOnSimdLevel)
+        {
+            Parallel::set_deterministic(true);
+            EXPECT_TRUE(Parallel::deterministic());
+
+            set_simd_level(SimdLevel::Scalar);
+            const Reductions reference = reduce();
+            const SimdLevel levels[] = { SimdLevel::SSE42, SimdLevel::AVX2, SimdLevel::AVX512 };
+
+            for (SimdLevel level : levels)
+            {
+                if (level > detect_simd_level())
+                    continue;
+
+                SCOPED_TRACE(simd_level_name(level));
+                set_simd_level(level);
+                Parallel::set_thread_count(static_cast<unsigned>(level) + 2);
+                EXPECT_TRUE(reduce() == reference) << "Reductions should be bit-identical.";
+            }
+        }
+
+        TEST_F(ParallelTest, NestedCallsRunSerially)
+        {
+            Parallel::set_thread_count(4);
+            std::atomic<int> total(0);
+
+            Parallel::parallel_for(8, 1, [&](std::size_t, std::size_t) {
+                Parallel::parallel_for(100, 10, [&](std::size_t begin, std::size_t end) {
+                    total += static_cast<int>(end - begin);
+                });
+            });
+
+            EXPECT_EQ(total, 800);
+        }
+
+#if MATH3D_EXCEPTIONS
+        TEST_F(ParallelTest, ExceptionsReachTheCaller)
+        {
+            Parallel::set_thread_count(4);
+
+            EXPECT_THROW(Parallel::parallel_for(1000, 10, [](std::size_t begin, std::size_t) {
+                if (begin == 500)
+                    throw std::runtime_error("chunk failed");
+            }), std::runtime_error);
+
+            // The pool should still be usable afterwards.
+            EXPECT_EQ(Parallel::parallel_reduce(1000, 10, 0,
+                [](std::size_t begin, std::size_t end) { return static_cast<int>(end - begin); },
+                [](int a, int b) { return a + b; }), 1000);
+        }
+#endif
+    }
+}
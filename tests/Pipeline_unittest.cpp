@@ -0,0 +1,187 @@
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Dispatch.h"
+#include "Expect.h"
+#include "Pipeline.h"
+#include "Quaternion.h"
+
+namespace Math3D
+{
+    namespace Math3DTests
+    {
+        class PipelineTest : public testing::Test
+        {
+        protected:
+            SimdLevel original;
+            std::vector<Vector3> points;
+            Vector3Batch batch;
+            Matrix3 m;
+            Transform t;
+            Vector3 light;
+
+            virtual void SetUp()
+            {
+                original = simd_level();
+
+                // Not a multiple of the block size, so the last block is partial.
+                std::srand(57);
+                for (std::size_t i = 0; i < 2 * Pipeline::block_size + 37; ++i)
+                {
+                    points.push_back(Vector3(
+                        2.0f * std::rand() / RAND_MAX - 1.0f,
+                        2.0f * std::rand() / RAND_MAX - 1.0f,
+                        2.0f * std::rand() / RAND_MAX - 1.0f));
+                }
+
+                batch = Vector3Batch(points);
+                m = Matrix3(1.5f, 0.2f, -0.3f, 0.1f, 0.8f, 0.4f, -0.2f, 0.3f, 1.1f);
+                t = Transform(Quaternion::angle_axis(30.0f, Vector3(1.0f, 2.0f, 3.0f).normalized()), Vector3(0.5f, -2.0f, 4.0f));
+                light = Vector3(-0.5f, 0.25f, 1.0f).normalized();
+            }
+
+            virtual void TearDown()
+            {
+                set_simd_level(original);
+            }
+        };
+
+        TEST_F(PipelineTest, MatchesSeparatePassesAtEveryLevel)
+        {
+            const SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::SSE42, SimdLevel::AVX2, SimdLevel::AVX512 };
+            const Pipeline shade = Pipeline().transform(m).normalize().dot(light).clamp(0.0f, 1.0f);
+
+            for (SimdLevel level : levels)
+            {
+                if (level > detect_simd_level())
+                    continue;
+
+                SCOPED_TRACE(simd_level_name(level));
+                set_simd_level(level);
+
+                Vector3Batch normals;
+                m.transform(batch, normals);
+                Vector3Batch::normalize(normals);
+
+                const Vector3Batch lights(std::vector<Vector3>(normals.size(), light));
+                std::vector<float> expected(normals.size());
+                Vector3Batch::dot(normals, lights, expected.data());
+
+                std::vector<float> fused(batch.size());
+                shade.run(batch, fused.data());
+
+                for (std::size_t i = 0; i < expected.size(); ++i)
+                {
+                    const float clamped = expected[i] < 0.0f ? 0.0f : expected[i] > 1.0f ? 1.0f : expected[i];
+                    EXPECT_NEAR(fused[i], clamped, 1e-6f) << "index " << i;
+                }
+            }
+        }
+
+        TEST_F(PipelineTest, VectorStagesMatchBulkOperations)
+        {
+            Vector3Batch expected;
+            t.transform_points(batch, expected);
+            Vector3Batch::normalize(expected);
+            t.transform_directions(expected);
+
+            Vector3Batch fused;
+            Pipeline().transform_points(t).normalize().transform_directions(t).run(batch, fused);
+
+            ASSERT_EQ(fused.size(), expected.size());
+            for (std::size_t i = 0; i < expected.size(); ++i)
+                EXPECT_EQ(fused[i], expected[i]) << "index " << i;
+        }
+
+        TEST_F(PipelineTest, ArraysMatchBatches)
+        {
+            const Pipeline p = Pipeline().transform(m).normalize();
+            const Pipeline lengths = Pipeline().transform_points(t).magnitude();
+
+            Vector3Batch from_batch;
+            p.run(batch, from_batch);
+            std::vector<Vector3> from_array(points.size());
+            p.run(points.data(), from_array.data(), points.size());
+
+            std::vector<float> batch_lengths(points.size()), array_lengths(points.size());
+            lengths.run(batch, batch_lengths.data());
+            lengths.run(points.data(), array_lengths.data(), points.size());
+
+            for (std::size_t i = 0; i < points.size(); ++i)
+            {
+                EXPECT_EQ(from_array[i], from_batch[i]) << "index " << i;
+                EXPECT_EQ(array_lengths[i], batch_lengths[i]) << "index " << i;
+            }
+        }
+
+        TEST_F(PipelineTest, RunsInPlace)
+        {
+            const Pipeline p = Pipeline().transform(m).clamp(-0.5f, 0.5f);
+
+            Vector3Batch expected;
+            p.run(batch, expected);
+
+            std::vector<Vector3> in_place = points;
+            p.run(in_place.data(), in_place.data(), in_place.size());
+            p.run(batch, batch);
+
+            for (std::size_t i = 0; i < points.size(); ++i)
+            {
+                EXPECT_EQ(batch[i], expected[i]) << "index " << i;
+                EXPECT_EQ(in_place[i], expected[i]) << "index " << i;
+                EXPECT_LE(std::fabs(expected[i].x), 0.5f);
+                EXPECT_LE(std::fabs(expected[i].y), 0.5f);
+                EXPECT_LE(std::fabs(expected[i].z), 0.5f);
+            }
+        }
+
+        TEST_F(PipelineTest, EmptyPipelineCopies)
+        {
+            const Pipeline p;
+            EXPECT_TRUE(p.empty());
+            EXPECT_FALSE(p.scalar());
+
+            Vector3Batch out;
+            p.run(batch, out);
+
+            ASSERT_EQ(out.size(), batch.size());
+            for (std::size_t i = 0; i < batch.size(); ++i)
+                EXPECT_EQ(out[i], batch[i]);
+
+            p.run(Vector3Batch(), out);
+            EXPECT_TRUE(out.empty());
+        }
+
+        TEST_F(PipelineTest, TracksStagesAndShape)
+        {
+            Pipeline p;
+            p.transform(m).normalize();
+            EXPECT_EQ(p.stages(), 2u);
+            EXPECT_FALSE(p.scalar());
+
+            p.dot(light).clamp(0.0f, 1.0f);
+            EXPECT_EQ(p.stages(), 4u);
+            EXPECT_TRUE(p.scalar());
+        }
+
+        TEST_F(PipelineTest, RejectsMisuse)
+        {
+            Pipeline scalar;
+            scalar.magnitude();
+            Pipeline vector;
+            vector.normalize();
+
+            std::vector<float> floats(batch.size());
+            Vector3Batch out;
+
+            MATH3D_EXPECT_THROW(scalar.normalize(), std::logic_error);
+            MATH3D_EXPECT_THROW(scalar.dot(light), std::logic_error);
+            MATH3D_EXPECT_THROW(scalar.run(batch, out), std::logic_error);
+            MATH3D_EXPECT_THROW(vector.run(batch, floats.data()), std::logic_error);
+            MATH3D_EXPECT_THROW(vector.clamp(1.0f, 0.0f), std::invalid_argument);
+        }
+    }
+}
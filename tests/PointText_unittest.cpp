@@ -0,0 +1,169 @@
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Expect.h"
+#include "Parallel.h"
+#include "PointText.h"
+
+namespace Math3D
+{
+    namespace Math3DTests
+    {
+        class PointTextTest : public testing::Test
+        {
+        protected:
+            std::vector<Vector3> points;
+
+            virtual void SetUp()
+            {
+                std::srand(71);
+                for (int i = 0; i < 1000; ++i)
+                    points.push_back(Vector3(random(), random(), random()));
+
+                points.push_back(Vector3(0.0f, -0.0f, 1e-45f));
+                points.push_back(Vector3(
+                    std::numeric_limits<float>::max(),
+                    std::numeric_limits<float>::lowest(),
+                    std::numeric_limits<float>::min()));
+            }
+
+            static float random()
+            {
+                return 2000.0f * std::rand() / RAND_MAX - 1000.0f;
+            }
+
+            // Checks that every point was read back bit for bit.
+            void expect_identical(const std::vector<Vector3>& read)
+            {
+                ASSERT_EQ(read.size(), points.size());
+                for (std::size_t i = 0; i < points.size(); ++i)
+                {
+                    EXPECT_EQ(read[i].x, points[i].x);
+                    EXPECT_EQ(read[i].y, points[i].y);
+                    EXPECT_EQ(read[i].z, points[i].z);
+                }
+            }
+        };
+
+        TEST_F(PointTextTest, FormattedPointsParseBackExactly)
+        {
+            for (PointFormat format : { PointFormat::XYZ, PointFormat::CSV, PointFormat::OBJ })
+            {
+                const std::string text = format_points(points.data(), points.size(), format);
+                expect_identical(parse_points(text, format));
+            }
+        }
+
+        TEST_F(PointTextTest, FormatsAreWrittenAsDocumented)
+        {
+            const Vector3 p(1.5f, -2.0f, 0.1f);
+
+            EXPECT_EQ(format_points(&p, 1, PointFormat::XYZ), "1.5 -2 0.1\n");
+            EXPECT_EQ(format_points(&p, 1, PointFormat::CSV), "1.5,-2,0.1\n");
+            EXPECT_EQ(format_points(&p, 1, PointFormat::OBJ), "v 1.5 -2 0.1\n");
+        }
+
+        TEST_F(PointTextTest, BufferHoldsTheWorstCase)
+        {
+            const Vector3 p(-1.17549435e-38f, -3.40282347e+38f, -1.23456789e-5f);
+            char buffer[max_point_chars];
+
+            const std::size_t length = format_points(&p, 1, PointFormat::OBJ, buffer);
+            EXPECT_LE(length, max_point_chars);
+            EXPECT_EQ(parse_points(buffer, length, PointFormat::OBJ)[0], p);
+        }
+
+        TEST_F(PointTextTest, SkippedLinesAndExtraColumnsAreIgnored)
+        {
+            const std::vector<Vector3> xyz = parse_points(
+                "# scan\n"
+                "1 2 3 255 0 0\r\n"
+                "\n"
+                "\t+4\t5e1  -6 \n"
+                "7 8 9", PointFormat::XYZ);
+            ASSERT_EQ(xyz.size(), 3u);
+            EXPECT_EQ(xyz[0], Vector3(1.0f, 2.0f, 3.0f));
+            EXPECT_EQ(xyz[1], Vector3(4.0f, 50.0f, -6.0f));
+            EXPECT_EQ(xyz[2], Vector3(7.0f, 8.0f, 9.0f));
+
+            const std::vector<Vector3> csv = parse_points(
+                "x,y,z\n"
+                "1, 2 ,3\n"
+                "4,5,6,extra\n", PointFormat::CSV);
+            ASSERT_EQ(csv.size(), 2u);
+            EXPECT_EQ(csv[0], Vector3(1.0f, 2.0f, 3.0f));
+            EXPECT_EQ(csv[1], Vector3(4.0f, 5.0f, 6.0f));
+
+            const std::vector<Vector3> obj = parse_points(
+                "o cube\n"
+                "v 1 2 3 1.0\n"
+                "vn 0 0 1\n"
+                "vt 0.5 0.5\n"
+                "v 4 5 6\n"
+                "f 1 2 3\n", PointFormat::OBJ);
+            ASSERT_EQ(obj.size(), 2u);
+            EXPECT_EQ(obj[0], Vector3(1.0f, 2.0f, 3.0f));
+            EXPECT_EQ(obj[1], Vector3(4.0f, 5.0f, 6.0f));
+        }
+
+        TEST_F(PointTextTest, MalformedLinesThrow)
+        {
+            MATH3D_EXPECT_THROW(parse_points("1 2 3\n1 2\n", PointFormat::XYZ), std::runtime_error);
+            MATH3D_EXPECT_THROW(parse_points("1 2 3x\n", PointFormat::XYZ), std::runtime_error);
+            MATH3D_EXPECT_THROW(parse_points("1,2,3\n", PointFormat::XYZ), std::runtime_error);
+            MATH3D_EXPECT_THROW(parse_points("1 2 3\n", PointFormat::CSV), std::runtime_error);
+            MATH3D_EXPECT_THROW(parse_points("1,2,3\nx,y,z\n", PointFormat::CSV), std::runtime_error)
+                << "Only the first line may hold column names.";
+            MATH3D_EXPECT_THROW(parse_points("v 1 2 1e39\n", PointFormat::OBJ), std::runtime_error);
+
+#if MATH3D_EXCEPTIONS
+            try
+            {
+                parse_points("1 2 3\n4 5 6\n# note\n7 8\n", PointFormat::XYZ);
+                FAIL() << "A short line should throw.";
+            }
+            catch (const std::runtime_error& e)
+            {
+                EXPECT_NE(std::string(e.what()).find("line 4"), std::string::npos) << e.what();
+            }
+#endif
+        }
+
+        TEST_F(PointTextTest, ParallelParsingMatchesSerial)
+        {
+            // Large enough to span several chunks, with lines of varying
+            // length, so that the chunk boundaries fall mid-line.
+            std::vector<Vector3> many;
+            for (int i = 0; i < 100; ++i)
+                many.insert(many.end(), points.begin(), points.end());
+
+            const std::string text = format_points(many.data(), many.size(), PointFormat::XYZ);
+            ASSERT_GT(text.size(), 4 * Parallel::chunk_bytes);
+
+            Parallel::set_thread_count(1);
+            const std::vector<Vector3> serial = parse_points(text, PointFormat::XYZ);
+            Parallel::set_thread_count(4);
+            const std::vector<Vector3> parallel = parse_points(text, PointFormat::XYZ);
+            Parallel::set_thread_count(0);
+
+            ASSERT_EQ(serial.size(), many.size());
+            EXPECT_EQ(parallel, serial);
+        }
+
+        TEST_F(PointTextTest, FilesRoundTrip)
+        {
+            const std::string path = testing::TempDir() + "math3d_point_text_test.obj";
+
+            write_points(path, points.data(), points.size(), PointFormat::OBJ);
+            expect_identical(read_points(path, PointFormat::OBJ));
+            std::remove(path.c_str());
+
+            MATH3D_EXPECT_THROW(read_points(path, PointFormat::OBJ), std::runtime_error);
+        }
+    }
+}
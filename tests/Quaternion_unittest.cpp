@@ -0,0 +1,185 @@
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "MathObject.h"
+#include "Quaternion.h"
+
+namespace Math3D
+{
+    namespace Math3DTests
+    {
+        class QuaternionTest : public testing::Test
+        {
+        protected:
+            Quaternion p, q;
+            Vector3 v;
+
+            // virtual void SetUp() {}
+            // virtual void TearDown() {}
+
+            static Quaternion random_rotation()
+            {
+                return Quaternion(random(), random(), random(), random()).normalized();
+            }
+
+            static float random()
+            {
+                return 2.0f * std::rand() / RAND_MAX - 1.0f;
+            }
+        };
+
+        TEST_F(QuaternionTest, DefaultIsIdentity)
+        {
+            v = Vector3(1.0f, 2.0f, 3.0f);
+
+            EXPECT_EQ(q, Quaternion::identity())
+                << "A default-constructed quaternion should be the identity.";
+            EXPECT_EQ(q * v, v)
+                << "The identity should leave every vector unchanged.";
+        }
+
+        TEST_F(QuaternionTest, AngleAxisRotatesVector)
+        {
+            q = Quaternion::angle_axis(90.0f, Vector3::up);
+
+            EXPECT_EQ(q * Vector3::forward, Vector3::right)
+                << "A quarter turn around the y axis should take z to x.";
+            EXPECT_TRUE(is_almost_equal(Quaternion::angle(Quaternion::identity(), q), 90.0f))
+                << "The angle to the identity should be the angle of the rotation.";
+        }
+
+        TEST_F(QuaternionTest, ProductComposesRotations)
+        {
+            p = Quaternion::angle_axis(30.0f, Vector3(1.0f, 2.0f, 3.0f));
+            q = Quaternion::angle_axis(70.0f, Vector3(-2.0f, 1.0f, 0.5f));
+            v = Vector3(1.0f, -2.0f, 3.0f);
+
+            EXPECT_EQ((p * q) * v, p * (q * v))
+                << "The product should apply the right-hand rotation first.";
+            EXPECT_EQ((p * q).to_matrix(), p.to_matrix() * q.to_matrix())
+                << "The product should match the product of the matrices.";
+        }
+
+        TEST_F(QuaternionTest, InverseUndoesRotation)
+        {
+            q = Quaternion::angle_axis(123.0f, Vector3(1.0f, 1.0f, 0.0f));
+
+            EXPECT_EQ(q * q.inverse(), Quaternion::identity())
+                << "The product of a quaternion and its inverse should be the identity.";
+            EXPECT_EQ(q.inverse(), q.conjugate())
+                << "The inverse of a unit quaternion should be its conjugate.";
+        }
+
+        TEST_F(QuaternionTest, MatrixRoundTrip)
+        {
+            std::srand(11);
+
+            for (int i = 0; i < 100; ++i)
+            {
+                q = random_rotation();
+                // q and -q are the same rotation; compare with a consistent sign.
+                p = Quaternion::from_matrix(q.to_matrix());
+                if (Quaternion::dot(p, q) < 0.0f)
+                    p = -p;
+
+                EXPECT_EQ(p, q) << "Converting to a matrix and back should be lossless.";
+            }
+        }
+
+        TEST_F(QuaternionTest, RotationMatchesMatrix)
+        {
+            q = Quaternion::angle_axis(47.0f, Vector3(0.3f, -1.0f, 2.0f));
+            v = Vector3(4.0f, 5.0f, -6.0f);
+
+            EXPECT_EQ(q * v, q.to_matrix() * v)
+                << "Rotating by a quaternion should match rotating by its matrix.";
+        }
+
+        TEST_F(QuaternionTest, SlerpEndpointsAndMidpoint)
+        {
+            p = Quaternion::angle_axis(10.0f, Vector3::up);
+            q = Quaternion::angle_axis(110.0f, Vector3::up);
+
+            EXPECT_EQ(Quaternion::slerp(p, q, 0.0f), p);
+            EXPECT_EQ(Quaternion::slerp(p, q, 1.0f), q);
+            EXPECT_EQ(Quaternion::slerp(p, q, 0.5f), Quaternion::angle_axis(60.0f, Vector3::up))
+                << "Slerp should move at constant angular velocity.";
+            EXPECT_EQ(Quaternion::slerp(p, -q, 0.5f), Quaternion::angle_axis(60.0f, Vector3::up))
+                << "Slerp should follow the shortest path.";
+        }
+
+        TEST_F(QuaternionTest, NlerpReturnsUnitQuaternion)
+        {
+            p = Quaternion::angle_axis(10.0f, Vector3::right);
+            q = Quaternion::angle_axis(150.0f, Vector3::forward);
+
+            EXPECT_TRUE(is_almost_equal(Quaternion::nlerp(p, q, 0.4f).magnitude(), 1.0f));
+        }
+
+        TEST_F(QuaternionTest, BulkRotateMatchesScalar)
+        {
+            std::srand(13);
+            std::vector<Quaternion> rotations;
+            std::vector<Vector3> in, out(1003), shared(1003);
+
+            for (int i = 0; i < 1003; ++i)
+            {
+                rotations.push_back(random_rotation());
+                in.push_back(Vector3(10.0f * random(), 10.0f * random(), 10.0f * random()));
+            }
+
+            Quaternion::rotate(rotations.data(), in.data(), out.data(), in.size());
+            rotations[0].rotate(in.data(), shared.data(), in.size());
+
+            for (std::size_t i = 0; i < in.size(); ++i)
+            {
+                EXPECT_EQ(out[i], rotations[i] * in[i]) << "index " << i;
+                EXPECT_EQ(shared[i], rotations[0] * in[i]) << "index " << i;
+            }
+        }
+
+        TEST_F(QuaternionTest, BulkSlerpMatchesScalar)
+        {
+            std::srand(17);
+            std::vector<Quaternion> a, b;
+
+            for (int i = 0; i < 1003; ++i)
+            {
+                a.push_back(random_rotation());
+                b.push_back(random_rotation());
+            }
+
+            // Include the nearly parallel and the antipodal cases.
+            b[0] = a[0];
+            b[1] = -a[1];
+
+            const float ts[] = { 0.0f, 0.3f, 0.5f, 1.0f };
+            std::vector<Quaternion> out(a.size());
+
+            for (float t : ts)
+            {
+                Quaternion::slerp(a.data(), b.data(), t, out.data(), a.size());
+
+                for (std::size_t i = 0; i < a.size(); ++i)
+                {
+                    const Quaternion expected = Quaternion::slerp(a[i], b[i], t);
+                    EXPECT_NEAR(out[i].x, expected.x, 1e-5f) << "t " << t << ", index " << i;
+                    EXPECT_NEAR(out[i].y, expected.y, 1e-5f) << "t " << t << ", index " << i;
+                    EXPECT_NEAR(out[i].z, expected.z, 1e-5f) << "t " << t << ", index " << i;
+                    EXPECT_NEAR(out[i].w, expected.w, 1e-5f) << "t " << t << ", index " << i;
+                }
+            }
+        }
+
+        TEST_F(QuaternionTest, WritesToStream)
+        {
+            std::ostringstream os;
+            os << Quaternion(1.0f, 2.0f, 3.0f, 4.0f);
+
+            EXPECT_EQ(os.str(), "(1, 2, 3, 4)");
+        }
+    }
+}
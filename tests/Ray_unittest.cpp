@@ -0,0 +1,156 @@
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "MathObject.h"
+#include "Ray.h"
+
+namespace Math3D
+{
+    namespace Math3DTests
+    {
+        class RayTest : public testing::Test
+        {
+        protected:
+            AABB box;
+            Sphere sphere;
+            std::vector<Ray> rays;
+
+            virtual void SetUp()
+            {
+                box = AABB(Vector3(-1.0f, -2.0f, -3.0f), Vector3(1.0f, 2.0f, 3.0f));
+                sphere = Sphere(Vector3(1.0f, -1.0f, 0.5f), 2.5f);
+
+                // Rays from around the volumes, aimed roughly at them, so that
+                // about half of them hit.
+                std::srand(17);
+                for (int i = 0; i < 4096; ++i)
+                {
+                    const Vector3 origin(random(), random(), random());
+                    const Vector3 target(0.4f * random(), 0.4f * random(), 0.4f * random());
+                    rays.push_back(Ray(origin, target - origin));
+                }
+
+                // Axis-aligned directions, whose reciprocals are infinite.
+                rays[0] = Ray(Vector3(0.0f, 0.0f, -10.0f), Vector3(0.0f, 0.0f, 1.0f));
+                rays[1] = Ray(Vector3(5.0f, 0.0f, -10.0f), Vector3(0.0f, 0.0f, 1.0f));
+                rays[2] = Ray(Vector3(0.0f, 0.0f, 0.0f), Vector3(-1.0f, 0.0f, 0.0f));
+            }
+
+            static float random()
+            {
+                return 20.0f * std::rand() / RAND_MAX - 10.0f;
+            }
+
+            template <std::size_t N>
+            void expect_packets_match_scalar()
+            {
+                for (std::size_t i = 0; i + N <= rays.size(); i += N)
+                {
+                    const RayPacket<N> packet(&rays[i]);
+                    float box_t[N], sphere_t[N], limits[N];
+                    for (std::size_t j = 0; j < N; ++j)
+                    {
+                        limits[j] = 4.0f * (j + 1);
+                    }
+
+                    const unsigned box_hits = packet.intersect(box, box_t);
+                    const unsigned sphere_hits = packet.intersect(sphere, sphere_t, limits);
+
+                    for (std::size_t j = 0; j < N; ++j)
+                    {
+                        float t = 0.0f;
+                        const bool hit = rays[i + j].intersect(box, t);
+                        ASSERT_EQ((box_hits >> j & 1u) != 0, hit) << "box, ray " << i + j;
+                        if (hit)
+                        {
+                            EXPECT_TRUE(is_almost_equal(box_t[j], t)) << "box, ray " << i + j;
+                        }
+
+                        const bool sphere_hit = rays[i + j].intersect(sphere, t, limits[j]);
+                        ASSERT_EQ((sphere_hits >> j & 1u) != 0, sphere_hit) << "sphere, ray " << i + j;
+                        if (sphere_hit)
+                        {
+                            EXPECT_TRUE(is_almost_equal(sphere_t[j], t)) << "sphere, ray " << i + j;
+                        }
+                    }
+                }
+            }
+        };
+
+        TEST_F(RayTest, PointAtWalksAlongDirection)
+        {
+            const Ray ray(Vector3(1.0f, 2.0f, 3.0f), Vector3(0.0f, 2.0f, 0.0f));
+            EXPECT_EQ(ray.point_at(0.0f), ray.origin);
+            EXPECT_EQ(ray.point_at(1.5f), Vector3(1.0f, 5.0f, 3.0f));
+        }
+
+        TEST_F(RayTest, HitsBoxAtEntry)
+        {
+            float t = 0.0f;
+            EXPECT_TRUE(rays[0].intersect(box, t));
+            EXPECT_FLOAT_EQ(t, 7.0f);
+            EXPECT_FALSE(rays[1].intersect(box, t))
+                << "A ray parallel to a slab and outside it should miss.";
+            EXPECT_FALSE(Ray(Vector3(0.0f, 0.0f, 10.0f), Vector3(0.0f, 0.0f, 1.0f)).intersect(box, t))
+                << "A box behind the ray should be missed.";
+        }
+
+        TEST_F(RayTest, RayInsideBoxHitsAtZero)
+        {
+            float t = -1.0f;
+            EXPECT_TRUE(rays[2].intersect(box, t));
+            EXPECT_FLOAT_EQ(t, 0.0f);
+        }
+
+        TEST_F(RayTest, BoxHitsBeyondLimitAreIgnored)
+        {
+            float t = 0.0f;
+            EXPECT_FALSE(rays[0].intersect(box, t, 6.9f));
+            EXPECT_TRUE(rays[0].intersect(box, t, 7.1f));
+        }
+
+        TEST_F(RayTest, HitsSphereAtEntry)
+        {
+            const Sphere unit(Vector3::zero, 1.0f);
+            float t = 0.0f;
+
+            EXPECT_TRUE(rays[0].intersect(unit, t));
+            EXPECT_FLOAT_EQ(t, 9.0f);
+            EXPECT_TRUE(Ray(Vector3(0.0f, 0.0f, -10.0f), Vector3(0.0f, 0.0f, 4.0f)).intersect(unit, t));
+            EXPECT_FLOAT_EQ(t, 2.25f) << "Distances are in multiples of the direction.";
+            EXPECT_FALSE(rays[1].intersect(unit, t));
+            EXPECT_FALSE(Ray(Vector3(0.0f, 0.0f, 10.0f), Vector3(0.0f, 0.0f, 1.0f)).intersect(unit, t));
+            EXPECT_FALSE(rays[0].intersect(unit, t, 8.0f));
+        }
+
+        TEST_F(RayTest, RayInsideSphereHitsAtZero)
+        {
+            float t = -1.0f;
+            EXPECT_TRUE(rays[2].intersect(Sphere(Vector3::zero, 1.0f), t));
+            EXPECT_FLOAT_EQ(t, 0.0f);
+        }
+
+        TEST_F(RayTest, PacketStoresRays)
+        {
+            RayPacket4 packet(rays.data());
+            EXPECT_EQ(packet[3], rays[3]);
+
+            packet.set(3, rays[7]);
+            EXPECT_EQ(packet[3], rays[7]);
+            EXPECT_EQ(packet[0], rays[0]);
+            EXPECT_EQ(RayPacket8()[5], Ray());
+        }
+
+        TEST_F(RayTest, FourRayPacketsMatchScalar)
+        {
+            expect_packets_match_scalar<4>();
+        }
+
+        TEST_F(RayTest, EightRayPacketsMatchScalar)
+        {
+            expect_packets_match_scalar<8>();
+        }
+    }
+}
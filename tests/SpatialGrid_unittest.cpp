@@ -0,0 +1,219 @@
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Expect.h"
+#include "SpatialGrid.h"
+
+namespace Math3D
+{
+    namespace Math3DTests
+    {
+        class SpatialGridTest : public testing::Test
+        {
+        protected:
+            std::vector<Vector3> points;
+
+            virtual void SetUp()
+            {
+                std::srand(31);
+                for (int i = 0; i < 2000; ++i)
+                    points.push_back(Vector3(random(), random(), random()));
+            }
+
+            static float random()
+            {
+                return 20.0f * std::rand() / RAND_MAX - 10.0f;
+            }
+
+            // The k nearest points, by brute force.
+            static std::vector<std::size_t> brute_nearest(const std::vector<Vector3>& points, const Vector3& p, std::size_t k)
+            {
+                std::vector<std::pair<float, std::size_t> > all;
+
+                for (std::size_t i = 0; i < points.size(); ++i)
+                    all.push_back(std::make_pair((points[i] - p).sqr_magnitude(), i));
+
+                std::sort(all.begin(), all.end());
+                std::vector<std::size_t> ids;
+
+                for (std::size_t i = 0; i < std::min(k, all.size()); ++i)
+                    ids.push_back(all[i].second);
+
+                return ids;
+            }
+
+            // The points within a radius, by brute force.
+            static std::vector<std::size_t> brute_radius(const std::vector<Vector3>& points, const Vector3& p, float r)
+            {
+                std::vector<std::size_t> ids;
+
+                for (std::size_t i = 0; i < points.size(); ++i)
+                    if ((points[i] - p).sqr_magnitude() <= r * r)
+                        ids.push_back(i);
+
+                return ids;
+            }
+        };
+
+        TEST_F(SpatialGridTest, NonPositiveCellSizeThrows)
+        {
+            MATH3D_EXPECT_THROW(SpatialGrid(0.0f), std::invalid_argument);
+            MATH3D_EXPECT_THROW(SpatialGrid(-1.0f), std::invalid_argument);
+        }
+
+        TEST_F(SpatialGridTest, NearestMatchesBruteForce)
+        {
+            const SpatialGrid grid(points.data(), points.size());
+
+            for (int i = 0; i < 200; ++i)
+            {
+                // Some queries fall well outside the points.
+                const Vector3 p = Vector3(random(), random(), random()) * (i % 10 == 0 ? 5.0f : 1.0f);
+                EXPECT_EQ(grid.nearest(p, 8), brute_nearest(points, p, 8)) << "query " << i;
+            }
+
+            EXPECT_EQ(grid.nearest(Vector3::zero, 5000).size(), points.size())
+                << "Asking for more points than stored should return all of them.";
+        }
+
+        TEST_F(SpatialGridTest, NearestFarFromThePointsMatchesBruteForce)
+        {
+            // Small cells put these queries thousands of cells away from the
+            // points; the last ones lie beyond the clamped coordinate range.
+            const SpatialGrid grid(points.data(), points.size(), 0.05f);
+            const Vector3 queries[] = {
+                Vector3(1000.0f, 0.0f, 0.0f), Vector3(-300.0f, 450.0f, 20.0f), Vector3(5.0f, 5.0f, -2000.0f),
+                Vector3(1e9f, 0.0f, 0.0f), Vector3(-1e9f, 1e9f, 3.0f), Vector3(1e12f, -1e12f, 1e12f)
+            };
+
+            for (const Vector3& p : queries)
+            {
+                EXPECT_EQ(grid.nearest(p, 1), brute_nearest(points, p, 1)) << p;
+                EXPECT_EQ(grid.nearest(p, 8), brute_nearest(points, p, 8)) << p;
+            }
+
+            std::vector<std::size_t> bulk(6 * 8);
+            grid.nearest(queries, 6, 8, bulk.data());
+
+            for (std::size_t i = 0; i < 6; ++i)
+            {
+                const std::vector<std::size_t> expected = brute_nearest(points, queries[i], 8);
+                EXPECT_TRUE(std::equal(expected.begin(), expected.end(), bulk.begin() + i * 8)) << queries[i];
+            }
+        }
+
+        TEST_F(SpatialGridTest, RadiusAndBoxMatchBruteForce)
+        {
+            const SpatialGrid grid(points.data(), points.size(), 1.5f);
+
+            for (int i = 0; i < 200; ++i)
+            {
+                const Vector3 p(random(), random(), random());
+                const float r = 0.1f * (i % 40);
+                EXPECT_EQ(grid.radius(p, r), brute_radius(points, p, r)) << "query " << i;
+
+                const Vector3 min = p - Vector3::one * r, max = p + Vector3(2.0f, 1.0f, 0.5f) * r;
+                std::vector<std::size_t> expected;
+
+                for (std::size_t j = 0; j < points.size(); ++j)
+                {
+                    const Vector3& q = points[j];
+                    if (min.x <= q.x && q.x <= max.x && min.y <= q.y && q.y <= max.y && min.z <= q.z && q.z <= max.z)
+                        expected.push_back(j);
+                }
+
+                EXPECT_EQ(grid.box(min, max), expected) << "query " << i;
+            }
+        }
+
+        TEST_F(SpatialGridTest, InsertRemoveAndUpdateKeepQueriesExact)
+        {
+            SpatialGrid grid(0.7f);
+            std::vector<Vector3> alive;
+            std::vector<std::size_t> ids;
+
+            for (const Vector3& p : points)
+                ids.push_back(grid.insert(p));
+
+            // Remove every third point, and move every other one.
+            for (std::size_t i = 0; i < points.size(); ++i)
+            {
+                if (i % 3 == 0)
+                {
+                    grid.remove(ids[i]);
+                    continue;
+                }
+
+                if (i % 2 == 0)
+                    points[i] += Vector3(random(), random(), random()) * 0.2f;
+
+                grid.update(ids[i], points[i]);
+            }
+
+            EXPECT_EQ(grid.size(), points.size() - (points.size() + 2) / 3);
+            EXPECT_FALSE(grid.contains(ids[0]));
+            MATH3D_EXPECT_THROW(grid.remove(ids[0]), std::out_of_range);
+            MATH3D_EXPECT_THROW(grid[ids[0]], std::out_of_range);
+
+            // Compare against brute force over the remaining points.
+            std::vector<std::size_t> remaining;
+            for (std::size_t i = 0; i < points.size(); ++i)
+                if (i % 3 != 0)
+                    remaining.push_back(i);
+
+            for (int q = 0; q < 100; ++q)
+            {
+                const Vector3 p(random(), random(), random());
+                std::vector<Vector3> subset;
+
+                for (std::size_t i : remaining)
+                    subset.push_back(points[i]);
+
+                std::vector<std::size_t> expected;
+                for (std::size_t i : brute_nearest(subset, p, 4))
+                    expected.push_back(ids[remaining[i]]);
+
+                EXPECT_EQ(grid.nearest(p, 4), expected) << "query " << q;
+            }
+
+            // Removed identifiers are reused.
+            EXPECT_EQ(grid.insert(Vector3::zero) % 3, 0u);
+        }
+
+        TEST_F(SpatialGridTest, BulkQueriesMatchSingleQueries)
+        {
+            const SpatialGrid grid(points.data(), points.size());
+            std::vector<Vector3> queries;
+
+            for (int i = 0; i < 1000; ++i)
+                queries.push_back(Vector3(random(), random(), random()));
+
+            const std::size_t k = 6;
+            std::vector<std::size_t> nearest(queries.size() * k);
+            grid.nearest(queries.data(), queries.size(), k, nearest.data());
+            const std::vector<std::vector<std::size_t> > within = grid.radius(queries.data(), queries.size(), 1.0f);
+
+            for (std::size_t i = 0; i < queries.size(); ++i)
+            {
+                EXPECT_EQ(std::vector<std::size_t>(nearest.begin() + i * k, nearest.begin() + (i + 1) * k),
+                    grid.nearest(queries[i], k)) << "query " << i;
+                EXPECT_EQ(within[i], grid.radius(queries[i], 1.0f)) << "query " << i;
+            }
+        }
+
+        TEST_F(SpatialGridTest, BulkNearestPadsMissingResults)
+        {
+            const SpatialGrid grid(points.data(), 3);
+            std::vector<std::size_t> out(5);
+
+            grid.nearest(&points[10], 1, 5, out.data());
+
+            EXPECT_EQ(out[3], SpatialGrid::none);
+            EXPECT_EQ(out[4], SpatialGrid::none);
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#include "gtest/gtest.h"
+#include "MathObject.h"
+#include "Sphere.h"
+
+namespace Math3D
+{
+    namespace Math3DTests
+    {
+        class SphereTest : public testing::Test
+        {
+        protected:
+            Sphere s;
+
+            virtual void SetUp()
+            {
+                s = Sphere(Vector3(1.0f, 2.0f, 3.0f), 2.0f);
+            }
+        };
+
+        TEST_F(SphereTest, ContainsPointsWithinRadius)
+        {
+            EXPECT_TRUE(s.contains(Vector3(1.0f, 2.0f, 3.0f)));
+            EXPECT_TRUE(s.contains(Vector3(3.0f, 2.0f, 3.0f))) << "The boundary belongs to the sphere.";
+            EXPECT_FALSE(s.contains(Vector3(2.5f, 3.5f, 3.0f)));
+        }
+
+        TEST_F(SphereTest, OverlapsSpheres)
+        {
+            EXPECT_TRUE(s.overlaps(Sphere(Vector3(4.0f, 2.0f, 3.0f), 1.0f)));
+            EXPECT_FALSE(s.overlaps(Sphere(Vector3(4.0f, 2.0f, 3.0f), 0.9f)));
+        }
+
+        TEST_F(SphereTest, OverlapsBoxes)
+        {
+            EXPECT_TRUE(s.overlaps(AABB(Vector3(2.0f, 1.0f, 2.0f), Vector3(5.0f, 5.0f, 5.0f))));
+            EXPECT_TRUE(s.overlaps(AABB(Vector3(-9.0f, -9.0f, -9.0f), Vector3(9.0f, 9.0f, 9.0f))))
+                << "A box around the sphere overlaps it.";
+            // The corner (2.5, 3.5, 3) is outside, even though the bounds overlap.
+            const AABB corner(Vector3(2.5f, 3.5f, 0.0f), Vector3(5.0f, 5.0f, 5.0f));
+            EXPECT_TRUE(s.bounds().overlaps(corner));
+            EXPECT_FALSE(s.overlaps(corner));
+        }
+
+        TEST_F(SphereTest, BoundsTouchSphere)
+        {
+            EXPECT_EQ(s.bounds(), AABB(Vector3(-1.0f, 0.0f, 1.0f), Vector3(3.0f, 4.0f, 5.0f)));
+        }
+    }
+}
@@ -0,0 +1,211 @@
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Expect.h"
+#include "Parallel.h"
+#include "Quaternion.h"
+#include "TransformHierarchy.h"
+
+namespace Math3D
+{
+    namespace Math3DTests
+    {
+        class TransformHierarchyTest : public testing::Test
+        {
+        protected:
+            virtual void TearDown()
+            {
+                Parallel::set_thread_count(0);
+            }
+
+            static Transform random_transform()
+            {
+                const Vector3 axis(
+                    2.0f * std::rand() / RAND_MAX - 1.0f,
+                    2.0f * std::rand() / RAND_MAX - 1.0f,
+                    1.0f);
+                return Transform(Quaternion::angle_axis(360.0f * std::rand() / RAND_MAX, axis.normalized()),
+                    Vector3(std::rand() % 7 - 3.0f, std::rand() % 5 - 2.0f, std::rand() % 3 - 1.0f));
+            }
+
+            // A random forest: every node picks its parent among the nodes
+            // added before it, or becomes a root.
+            static TransformHierarchy random_hierarchy(std::size_t count, unsigned seed)
+            {
+                std::srand(seed);
+                TransformHierarchy h;
+
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    const std::size_t parent = i == 0 || std::rand() % 50 == 0 ? TransformHierarchy::none : std::rand() % i;
+                    h.add(random_transform(), parent);
+                }
+
+                return h;
+            }
+
+            // The world transform of a node, composed from its root down.
+            static Transform naive_world(const TransformHierarchy& h, std::size_t node)
+            {
+                const std::size_t parent = h.parent(node);
+                return parent == TransformHierarchy::none ? h.local(node) : naive_world(h, parent) * h.local(node);
+            }
+
+            static void expect_worlds_match(const TransformHierarchy& h)
+            {
+                for (std::size_t i = 0; i < h.size(); ++i)
+                    EXPECT_EQ(h.world(i), naive_world(h, i)) << "node " << i;
+            }
+        };
+
+        TEST_F(TransformHierarchyTest, WorldsMatchNaiveComposition)
+        {
+            TransformHierarchy h = random_hierarchy(2000, 3);
+
+            EXPECT_EQ(h.update(), 2000u);
+            expect_worlds_match(h);
+        }
+
+        TEST_F(TransformHierarchyTest, OnlyDirtySubtreesAreRecomposed)
+        {
+            TransformHierarchy h;
+            const std::size_t root = h.add(Transform::identity());
+            const std::size_t arm = h.add(random_transform(), root);
+            const std::size_t hand = h.add(random_transform(), arm);
+            const std::size_t finger = h.add(random_transform(), hand);
+            const std::size_t leg = h.add(random_transform(), root);
+            h.update();
+
+            EXPECT_EQ(h.update(), 0u);
+
+            h.set_local(finger, random_transform());
+            EXPECT_EQ(h.update(), 1u);
+
+            h.set_local(hand, random_transform());
+            h.set_local(finger, random_transform());
+            h.set_local(hand, random_transform());
+            EXPECT_EQ(h.update(), 2u);
+
+            h.set_local(arm, random_transform());
+            h.set_local(leg, random_transform());
+            EXPECT_EQ(h.update(), 4u);
+
+            h.set_local(root, random_transform());
+            EXPECT_EQ(h.update(), 5u);
+            expect_worlds_match(h);
+        }
+
+        TEST_F(TransformHierarchyTest, IncrementalUpdatesMatchFullRecomputation)
+        {
+            TransformHierarchy h = random_hierarchy(20000, 5);
+            h.update();
+
+            for (int frame = 0; frame < 4; ++frame)
+            {
+                // Move 5% of the nodes.
+                for (int i = 0; i < 1000; ++i)
+                    h.set_local(std::rand() % h.size(), random_transform());
+
+                const std::size_t recomposed = h.update();
+                EXPECT_GE(recomposed, 1000u / 2);
+                EXPECT_LT(recomposed, h.size());
+            }
+
+            expect_worlds_match(h);
+        }
+
+        TEST_F(TransformHierarchyTest, ParallelUpdatesMatchSerial)
+        {
+            TransformHierarchy serial = random_hierarchy(50000, 7);
+            TransformHierarchy parallel = random_hierarchy(50000, 7);
+
+            Parallel::set_thread_count(1);
+            serial.update();
+            Parallel::set_thread_count(4);
+            parallel.update();
+
+            // Moving the first root dirties a subtree much larger than a
+            // chunk, which is split at its children.
+            const Transform moved = Transform(Quaternion::angle_axis(10.0f, Vector3::up), Vector3(1.0f, 0.0f, 0.0f));
+            serial.set_local(0, moved);
+            parallel.set_local(0, moved);
+
+            Parallel::set_thread_count(1);
+            const std::size_t serial_count = serial.update();
+            Parallel::set_thread_count(4);
+            const std::size_t parallel_count = parallel.update();
+
+            EXPECT_EQ(parallel_count, serial_count);
+            EXPECT_GT(parallel_count, TransformHierarchy::chunk_nodes);
+
+            for (std::size_t i = 0; i < serial.size(); ++i)
+            {
+                const Transform& s = serial.world(i);
+                const Transform& p = parallel.world(i);
+                for (int r = 0; r < 3; ++r)
+                    for (int c = 0; c < 3; ++c)
+                        ASSERT_EQ(s.linear(r, c), p.linear(r, c)) << "node " << i;
+                ASSERT_TRUE(s.translation.x == p.translation.x && s.translation.y == p.translation.y &&
+                    s.translation.z == p.translation.z) << "node " << i;
+            }
+        }
+
+        TEST_F(TransformHierarchyTest, ReparentingMovesTheSubtree)
+        {
+            TransformHierarchy h;
+            const std::size_t a = h.add(Transform(Matrix3::identity(), Vector3(10.0f, 0.0f, 0.0f)));
+            const std::size_t b = h.add(Transform(Matrix3::identity(), Vector3(0.0f, 10.0f, 0.0f)));
+            const std::size_t child = h.add(Transform(Matrix3::identity(), Vector3(1.0f, 0.0f, 0.0f)), a);
+            const std::size_t grandchild = h.add(Transform(Matrix3::identity(), Vector3(0.0f, 0.0f, 1.0f)), child);
+            h.update();
+
+            EXPECT_EQ(h.world(grandchild).translation, Vector3(11.0f, 0.0f, 1.0f));
+
+            h.set_parent(child, b);
+            EXPECT_EQ(h.parent(child), b);
+            EXPECT_EQ(h.update(), 2u);
+            EXPECT_EQ(h.world(grandchild).translation, Vector3(1.0f, 10.0f, 1.0f));
+
+            h.set_parent(child, TransformHierarchy::none);
+            h.update();
+            EXPECT_EQ(h.parent(child), TransformHierarchy::none);
+            EXPECT_EQ(h.world(grandchild).translation, Vector3(1.0f, 0.0f, 1.0f));
+            expect_worlds_match(h);
+        }
+
+        TEST_F(TransformHierarchyTest, NodesAddedLaterKeepEarlierIdentifiers)
+        {
+            TransformHierarchy h = random_hierarchy(500, 11);
+            h.update();
+
+            // Children of early nodes move ahead of later nodes in the
+            // depth-first order; the identifiers must not change.
+            for (std::size_t i = 0; i < 100; ++i)
+                h.add(random_transform(), i % 7);
+
+            EXPECT_EQ(h.size(), 600u);
+            EXPECT_EQ(h.update(), 100u);
+            EXPECT_EQ(h.parent(599), 99u % 7);
+            expect_worlds_match(h);
+        }
+
+        TEST_F(TransformHierarchyTest, RejectsInvalidNodes)
+        {
+            TransformHierarchy h;
+            const std::size_t root = h.add(Transform::identity());
+            const std::size_t child = h.add(Transform::identity(), root);
+
+            MATH3D_EXPECT_THROW(h.add(Transform::identity(), 5), std::out_of_range);
+            MATH3D_EXPECT_THROW(h.world(2), std::out_of_range);
+            MATH3D_EXPECT_THROW(h.set_local(2, Transform::identity()), std::out_of_range);
+            MATH3D_EXPECT_THROW(h.set_parent(root, child), std::invalid_argument);
+            MATH3D_EXPECT_THROW(h.set_parent(root, root), std::invalid_argument);
+
+            h.clear();
+            EXPECT_TRUE(h.empty());
+            EXPECT_EQ(h.update(), 0u);
+        }
+    }
+}
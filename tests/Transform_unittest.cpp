@@ -0,0 +1,116 @@
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Expect.h"
+#include "MathObject.h"
+#include "Transform.h"
+
+namespace Math3D
+{
+    namespace Math3DTests
+    {
+        class TransformTest : public testing::Test
+        {
+        protected:
+            Transform a, b;
+            Vector3 p;
+
+            virtual void SetUp()
+            {
+                a = Transform(Quaternion::angle_axis(35.0f, Vector3(1.0f, 2.0f, -1.0f)), Vector3(1.0f, -2.0f, 3.0f));
+                b = Transform(Matrix3(2.0f, 0.5f, 0.0f, 0.0f, 1.5f, 0.0f, 0.3f, 0.0f, 0.5f), Vector3(-4.0f, 0.0f, 2.0f));
+                p = Vector3(3.0f, -1.0f, 2.0f);
+            }
+
+            static float random()
+            {
+                return 20.0f * std::rand() / RAND_MAX - 10.0f;
+            }
+        };
+
+        TEST_F(TransformTest, DefaultIsIdentity)
+        {
+            EXPECT_EQ(Transform(), Transform::identity());
+            EXPECT_EQ(Transform().transform_point(p), p);
+        }
+
+        TEST_F(TransformTest, DirectionsIgnoreTranslation)
+        {
+            EXPECT_EQ(a.transform_point(p), a.linear * p + a.translation);
+            EXPECT_EQ(a.transform_direction(p), a.linear * p)
+                << "Directions should not be translated.";
+        }
+
+        TEST_F(TransformTest, CompositionAppliesRightHandSideFirst)
+        {
+            EXPECT_EQ((a * b).transform_point(p), a.transform_point(b.transform_point(p)));
+
+            Transform c = a;
+            c *= b;
+            EXPECT_EQ(c, a * b);
+        }
+
+        TEST_F(TransformTest, RigidInverseMatchesAffineInverse)
+        {
+            EXPECT_EQ(a.rigid_inverse(), a.inverse())
+                << "For a rotation, the transpose should be the inverse.";
+            EXPECT_EQ(a * a.rigid_inverse(), Transform::identity());
+        }
+
+        TEST_F(TransformTest, AffineInverseUndoesTransform)
+        {
+            EXPECT_EQ(b.inverse().transform_point(b.transform_point(p)), p);
+            EXPECT_EQ(b.inverse() * b, Transform::identity());
+        }
+
+        TEST_F(TransformTest, InverseOfSingularTransformThrows)
+        {
+            b.linear = Matrix3(1.0f, 2.0f, 3.0f, 2.0f, 4.0f, 6.0f, 0.0f, 1.0f, 0.0f);
+
+            MATH3D_EXPECT_THROW(b.inverse(), const char*);
+            EXPECT_FALSE(b.try_inverse().has_value());
+            ASSERT_TRUE(a.try_inverse().has_value());
+            EXPECT_EQ(*a.try_inverse(), a.inverse());
+        }
+
+        TEST_F(TransformTest, Matrix4RoundTrip)
+        {
+            float m[16];
+            b.to_matrix4(m);
+
+            EXPECT_EQ(m[3], b.translation.x);
+            EXPECT_EQ(m[15], 1.0f);
+            EXPECT_EQ(Transform::from_matrix4(m), b);
+        }
+
+        TEST_F(TransformTest, BulkTransformsMatchScalar)
+        {
+            std::srand(19);
+            std::vector<Vector3> points;
+
+            // Not a multiple of the block size, so the tail runs too.
+            for (int i = 0; i < 1003; ++i)
+                points.push_back(Vector3(random(), random(), random()));
+
+            std::vector<Vector3> transformed(points.size()), directions(points.size()), in_place = points;
+            Vector3Batch batch(points), batch_out;
+
+            b.transform_points(points.data(), transformed.data(), points.size());
+            b.transform_directions(points.data(), directions.data(), points.size());
+            b.transform_points(in_place.data(), in_place.size());
+            b.transform_points(batch, batch_out);
+            b.transform_points(batch);
+
+            for (std::size_t i = 0; i < points.size(); ++i)
+            {
+                const Vector3 expected = b.transform_point(points[i]);
+                EXPECT_EQ(transformed[i], expected) << "index " << i;
+                EXPECT_EQ(in_place[i], expected) << "index " << i;
+                EXPECT_EQ(batch_out[i], expected) << "index " << i;
+                EXPECT_EQ(batch[i], expected) << "index " << i;
+                EXPECT_EQ(directions[i], b.transform_direction(points[i])) << "index " << i;
+            }
+        }
+    }
+}
@@ -0,0 +1,132 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Expect.h"
+#include "MathObject.h"
+#include "Vector3Batch.h"
+
+namespace Math3D
+{
+    namespace Math3DTests
+    {
+        class Vector3BatchTest : public testing::Test
+        {
+        protected:
+            std::vector<Vector3> vs, ws;
+            Vector3Batch v, w, o;
+
+            virtual void SetUp()
+            {
+                // An odd count, so that the kernels also run their tails.
+                for (int i = 0; i < 37; ++i)
+                {
+                    vs.push_back(Vector3(1.0f + i, 2.0f - 0.5f * i, 0.25f * i - 3.0f));
+                    ws.push_back(Vector3(0.5f * i - 4.0f, 3.0f, 1.0f + 0.125f * i));
+                }
+
+                v = Vector3Batch(vs);
+                w = Vector3Batch(ws);
+            }
+
+            // virtual void TearDown() {}
+        };
+
+        TEST_F(Vector3BatchTest, ConversionRoundTripsThroughStdVector)
+        {
+            std::vector<Vector3> back = v.to_vector();
+
+            ASSERT_EQ(back.size(), vs.size());
+            for (std::size_t i = 0; i < vs.size(); ++i)
+                EXPECT_EQ(back[i], vs[i]) << "Mismatch at index " << i << ".";
+        }
+
+        TEST_F(Vector3BatchTest, CrossMatchesScalar)
+        {
+            Vector3Batch::cross(v, w, o);
+
+            ASSERT_EQ(o.size(), vs.size());
+            for (std::size_t i = 0; i < vs.size(); ++i)
+                EXPECT_EQ(o[i], Vector3::cross(vs[i], ws[i])) << "Mismatch at index " << i << ".";
+        }
+
+        TEST_F(Vector3BatchTest, CrossMayAliasItsInput)
+        {
+            Vector3Batch::cross(v, w, v);
+
+            for (std::size_t i = 0; i < vs.size(); ++i)
+                EXPECT_EQ(v[i], Vector3::cross(vs[i], ws[i])) << "Mismatch at index " << i << ".";
+        }
+
+        TEST_F(Vector3BatchTest, DotAndDistanceMatchScalar)
+        {
+            std::vector<float> dots(vs.size()), distances(vs.size());
+            Vector3Batch::dot(v, w, dots.data());
+            Vector3Batch::distance(v, w, distances.data());
+
+            for (std::size_t i = 0; i < vs.size(); ++i)
+            {
+                EXPECT_TRUE(is_almost_equal(dots[i], Vector3::dot(vs[i], ws[i])))
+                    << "Dot product mismatch at index " << i << ".";
+                EXPECT_TRUE(is_almost_equal(distances[i], Vector3::distance(vs[i], ws[i])))
+                    << "Distance mismatch at index " << i << ".";
+            }
+        }
+
+        TEST_F(Vector3BatchTest, LerpMatchesScalarAndClamps)
+        {
+            Vector3Batch::lerp(v, w, 0.3f, o);
+            for (std::size_t i = 0; i < vs.size(); ++i)
+                EXPECT_EQ(o[i], Vector3::lerp(vs[i], ws[i], 0.3f)) << "Mismatch at index " << i << ".";
+
+            Vector3Batch::lerp(v, w, 2.0f, o);
+            for (std::size_t i = 0; i < vs.size(); ++i)
+                EXPECT_EQ(o[i], ws[i]) << "The interpolant should be clamped to one.";
+        }
+
+        TEST_F(Vector3BatchTest, NormalizedBatchMagnitudesAreOne)
+        {
+            std::vector<float> magnitudes(vs.size());
+            Vector3Batch::normalize(v);
+            Vector3Batch::magnitude(v, magnitudes.data());
+
+            for (std::size_t i = 0; i < vs.size(); ++i)
+            {
+                EXPECT_EQ(v[i], vs[i].normalized()) << "Mismatch at index " << i << ".";
+                EXPECT_TRUE(is_almost_equal(magnitudes[i], 1.0f))
+                    << "The magnitude of a normalized vector should be one";
+            }
+        }
+
+        TEST_F(Vector3BatchTest, ProjectionAndRejectionAddUpToInput)
+        {
+            Vector3Batch p, r;
+            Vector3Batch::project(v, w, p);
+            Vector3Batch::reject(v, w, r);
+
+            for (std::size_t i = 0; i < vs.size(); ++i)
+            {
+                EXPECT_EQ(p[i], Vector3::project(vs[i], ws[i])) << "Mismatch at index " << i << ".";
+                EXPECT_EQ(p[i] + r[i], vs[i])
+                    << "The projection and the rejection should add up to the input.";
+                EXPECT_TRUE(is_almost_equal(Vector3::dot(r[i], ws[i]), 0.0f))
+                    << "The rejection should be perpendicular to the other vector.";
+            }
+        }
+
+        TEST_F(Vector3BatchTest, ScaleMatchesScalar)
+        {
+            Vector3Batch::scale(v, w, o);
+
+            for (std::size_t i = 0; i < vs.size(); ++i)
+                EXPECT_EQ(o[i], Vector3::scale(vs[i], ws[i])) << "Mismatch at index " << i << ".";
+        }
+
+        TEST_F(Vector3BatchTest, MismatchedSizesThrow)
+        {
+            w.push_back(Vector3::one);
+
+            MATH3D_EXPECT_THROW(Vector3Batch::cross(v, w, o), std::invalid_argument)
+                << "Combining batches of different sizes should throw.";
+        }
+    }
+}
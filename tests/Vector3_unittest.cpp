@@ -1,3 +1,6 @@
+#include <cstring>
+#include <sstream>
+
 #include "gtest/gtest.h"
 #include "MathObject.h"
 #include "Vector3.h"
@@ -70,5 +73,55 @@ namespace Math3D
                 << "Squaring Vector3::magnitude() should yield the same result as "
                 << "Vector3::sqr_magnitude()";
         }
+
+        TEST_F(Vector3Test, StreamInsertionPrintsComponents)
+        {
+            v = Vector3(1.0f, 2.5f, -3.0f);
+            std::ostringstream os;
+            os << v;
+
+            EXPECT_EQ(os.str(), "(1, 2.5, -3)")
+                << "The vector should be printed as a parenthesized triple.";
+        }
+
+        TEST_F(Vector3Test, ArraysOfVectorsCanBeCopiedBytewise)
+        {
+            const Vector3 src[2] = { Vector3(1.0f, 2.0f, 3.0f), Vector3(4.0f, 5.0f, 6.0f) };
+            float raw[6];
+            std::memcpy(raw, src, sizeof(src));
+
+            EXPECT_EQ(raw[3], 4.0f)
+                << "Vectors should be tightly packed, without any hidden members.";
+        }
+
+        TEST_F(Vector3Test, ArithmeticIsEvaluatedAtCompileTime)
+        {
+            constexpr Vector3 a = Vector3::cross(Vector3::right, Vector3::up) * 2.0f + Vector3::one;
+            static_assert(a.x == 1.0f && a.y == 1.0f && a.z == 3.0f,
+                "Vector3 arithmetic should be usable in constant expressions.");
+            static_assert(Vector3::dot(a, Vector3::forward) == 3.0f, "");
+            static_assert(Vector3::project(a, Vector3::up) == Vector3::up, "");
+            static_assert(-Vector3::forward == Vector3::back, "");
+
+            EXPECT_EQ(a, Vector3(1.0f, 1.0f, 3.0f));
+        }
+
+        TEST_F(Vector3Test, DoublePrecisionResolvesLargeCoordinates)
+        {
+            // At 10^8, consecutive floats are 8 apart; doubles still resolve
+            // a thousandth.
+            const Vector3d origin(1e8, 0.0, 0.0);
+            const Vector3d offset = origin + Vector3d(0.001, 0.0, 0.0);
+
+            EXPECT_NEAR((offset - origin).x, 0.001, 1e-8);
+            EXPECT_NEAR(Vector3d::distance(offset, origin), 0.001, 1e-8);
+            EXPECT_EQ(Vector3(offset) - Vector3(origin), Vector3::zero)
+                << "Converting to single precision should lose the offset.";
+
+            static_assert(Vector3d::cross(Vector3d::right, Vector3d::up) == Vector3d::forward, "");
+            static_assert(sizeof(Vector3d) == 24, "");
+            EXPECT_DOUBLE_EQ(Vector3d::angle(Vector3d::right, Vector3d::up), 90.0);
+            EXPECT_EQ(2 * Vector3d::one, Vector3d(2.0, 2.0, 2.0));
+        }
     }
 }